@@ -0,0 +1,330 @@
+/// @file bench_batch_decomposition.cpp
+///
+/// Cholesky and QR factorizations of `batch_size` small matrices, as in
+/// per-point normal estimation: one `Cholesky` or `QR` per matrix stored as
+/// an array of `Matrix`, against the batched kernels running one matrix per
+/// SIMD lane on a `MatrixSoA`. Every iteration also copies the matrices it
+/// factors in place.
+///
+/// The 3x3 singular value and polar decompositions run on deformation
+/// gradients as in corotational FEM, a quarter of them inverted. Their
+/// counters give the largest errors of the batched results against a double
+/// precision reference with twice the Jacobi sweeps, relative to the
+/// largest singular value: of the singular values, of the reconstruction
+/// `U * diag(sigma) * Vᵀ` and of `Uᵀ * U` and `Vᵀ * V` from the identity.
+///
+/// The symmetric eigendecompositions run on the covariances of the
+/// neighborhoods of a grid point cloud, whose normals are then estimated
+/// three ways: per point with `SymmetricEigen3`, by storing the covariances
+/// in a `MatrixSoA` for `batch::symmetric_eigen`, and by the fused
+/// `batch::neighborhood_normals`.
+
+#include <dklib/math/batch_decomposition.hpp>
+#include <dklib/math/decomposition.hpp>
+#include <dklib/math/vector3_soa.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+constexpr std::size_t batch_size = 4096;
+
+/// Diagonally dominant with a positive diagonal, so positive definite.
+template <typename T, std::size_t N>
+Matrix<T, N, N> spd_matrix(std::size_t seed) {
+    Matrix<T, N, N> result;
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            result[i, j] = static_cast<T>(static_cast<int>((i + j + seed) % 7) - 3) / T(8);
+        }
+        result[i, i] += static_cast<T>(N);
+    }
+    return result;
+}
+
+template <typename T, std::size_t N>
+void bench_batch(dk::bench::Reporter &reporter, const std::string &type) {
+    std::vector<Matrix<T, N, N>> mats;
+    for (std::size_t p = 0; p < batch_size; ++p) {
+        mats.push_back(spd_matrix<T, N>(p));
+    }
+    const MatrixSoA<T, N, N> lanes(mats);
+
+    std::vector<Matrix<T, N, N>> factors(batch_size);
+    MatrixSoA<T, N, N> work(batch_size);
+    VectorSoA<T, N> tau;
+    const double items = batch_size;
+    const double bytes = 2.0 * sizeof(T) * N * N * items;
+    const auto suffix = "<" + type + ", " + std::to_string(N) + ">";
+
+    const auto per_matrix_cholesky = dk::bench::measure([&] {
+        for (std::size_t p = 0; p < batch_size; ++p) {
+            factors[p] = Cholesky<T, N>(mats[p]).factor();
+        }
+        dk::bench::do_not_optimize(factors);
+    });
+    reporter.add({ "batch/cholesky_per_matrix" + suffix, per_matrix_cholesky, {}, items, bytes });
+
+    const auto batched_cholesky = dk::bench::measure([&] {
+        work = lanes;
+        dk::bench::do_not_optimize(batch::cholesky(work));
+        dk::bench::do_not_optimize(work);
+    });
+    reporter.add({ "batch/cholesky" + suffix, batched_cholesky, {}, items, bytes });
+
+    const auto per_matrix_qr = dk::bench::measure([&] {
+        for (std::size_t p = 0; p < batch_size; ++p) {
+            factors[p] = QR<T, N, N>(mats[p]).factors();
+        }
+        dk::bench::do_not_optimize(factors);
+    });
+    reporter.add({ "batch/qr_per_matrix" + suffix, per_matrix_qr, {}, items, bytes });
+
+    const auto batched_qr = dk::bench::measure([&] {
+        work = lanes;
+        batch::qr(work, tau);
+        dk::bench::do_not_optimize(work);
+    });
+    reporter.add({ "batch/qr" + suffix, batched_qr, {}, items, bytes });
+}
+
+/// Identity plus a perturbation, inverted by flipping a row for every
+/// fourth `seed`.
+template <typename T>
+Matrix<T, 3, 3> deformation_gradient(std::size_t seed) {
+    Matrix<T, 3, 3> result;
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            const T offset = static_cast<T>(static_cast<int>((i * 5 + j * 3 + seed * 7) % 17) - 8) / T(16);
+            result[i, j] = (i == j ? T(1) : T(0)) + offset;
+        }
+    }
+    if (seed % 4 == 0) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            result[2, j] = -result[2, j];
+        }
+    }
+    return result;
+}
+
+/// Error counters of the batched decompositions, see the file comment.
+template <typename T>
+std::map<std::string, double> svd_errors(const std::vector<Matrix<T, 3, 3>> &mats, const MatrixSoA<T, 3, 3> &u, const VectorSoA<T, 3> &sigma, const MatrixSoA<T, 3, 3> &v) {
+    double sigma_error = 0.0;
+    double residual = 0.0;
+    double orthogonality = 0.0;
+    for (std::size_t p = 0; p < mats.size(); ++p) {
+        double a[9];
+        for (std::size_t i = 0; i < 9; ++i) {
+            a[i] = static_cast<double>(mats[p][i]);
+        }
+        double ref_u[9];
+        double ref_sigma[3];
+        double ref_v[9];
+        svd3::decompose<double, 2 * svd3::sweeps>(a, ref_u, ref_sigma, ref_v);
+        const auto left = u[p];
+        const auto values = sigma[p];
+        const auto right = v[p];
+        const double scale = std::abs(ref_sigma[0]);
+        for (std::size_t i = 0; i < 3; ++i) {
+            sigma_error = std::max(sigma_error, std::abs(values[i] - ref_sigma[i]) / scale);
+            for (std::size_t j = 0; j < 3; ++j) {
+                double product = 0.0;
+                double left_gram = 0.0;
+                double right_gram = 0.0;
+                for (std::size_t k = 0; k < 3; ++k) {
+                    product += static_cast<double>(left[i, k]) * values[k] * right[j, k];
+                    left_gram += static_cast<double>(left[k, i]) * left[k, j];
+                    right_gram += static_cast<double>(right[k, i]) * right[k, j];
+                }
+                const double identity = i == j ? 1.0 : 0.0;
+                residual = std::max(residual, std::abs(product - a[3 * i + j]) / scale);
+                orthogonality = std::max({ orthogonality, std::abs(left_gram - identity), std::abs(right_gram - identity) });
+            }
+        }
+    }
+    return { { "sigma_error", sigma_error }, { "residual", residual }, { "orthogonality", orthogonality } };
+}
+
+template <typename T>
+void bench_svd(dk::bench::Reporter &reporter, const std::string &type) {
+    std::vector<Matrix<T, 3, 3>> mats;
+    for (std::size_t p = 0; p < batch_size; ++p) {
+        mats.push_back(deformation_gradient<T>(p));
+    }
+    const MatrixSoA<T, 3, 3> lanes(mats);
+
+    std::vector<Matrix<T, 3, 3>> rotations(batch_size);
+    MatrixSoA<T, 3, 3> u(batch_size);
+    VectorSoA<T, 3> sigma(batch_size);
+    MatrixSoA<T, 3, 3> v(batch_size);
+    const double items = batch_size;
+    const auto suffix = "<" + type + ">";
+
+    const auto per_matrix_svd = dk::bench::measure([&] {
+        for (std::size_t p = 0; p < batch_size; ++p) {
+            rotations[p] = SVD3<T>(mats[p]).u();
+        }
+        dk::bench::do_not_optimize(rotations);
+    });
+    reporter.add({ "batch/svd3_per_matrix" + suffix, per_matrix_svd, {}, items, sizeof(T) * 18.0 * items });
+
+    const auto batched_svd = dk::bench::measure([&] {
+        batch::svd(lanes, u, sigma, v);
+        dk::bench::do_not_optimize(u);
+        dk::bench::do_not_optimize(sigma);
+        dk::bench::do_not_optimize(v);
+    });
+    reporter.add({ "batch/svd3" + suffix, batched_svd, svd_errors(mats, u, sigma, v), items, sizeof(T) * 30.0 * items });
+
+    const auto per_matrix_polar = dk::bench::measure([&] {
+        for (std::size_t p = 0; p < batch_size; ++p) {
+            rotations[p] = Polar3<T>(mats[p]).rotation();
+        }
+        dk::bench::do_not_optimize(rotations);
+    });
+    reporter.add({ "batch/polar3_per_matrix" + suffix, per_matrix_polar, {}, items, sizeof(T) * 18.0 * items });
+
+    const auto batched_polar = dk::bench::measure([&] {
+        batch::polar(lanes, u, v);
+        dk::bench::do_not_optimize(u);
+        dk::bench::do_not_optimize(v);
+    });
+    reporter.add({ "batch/polar3" + suffix, batched_polar, {}, items, sizeof(T) * 27.0 * items });
+}
+
+/// Points of a `normal_side x normal_side` grid on a curved surface, with
+/// the `(2 * normal_radius + 1)²` grid points around them as neighbors.
+constexpr std::size_t normal_side = 128;
+constexpr std::size_t normal_radius = 2;
+
+template <typename T>
+void normal_cloud(Vector3SoA<T> &points, std::vector<std::size_t> &offsets, std::vector<std::size_t> &neighbors) {
+    for (std::size_t i = 0; i < normal_side; ++i) {
+        for (std::size_t j = 0; j < normal_side; ++j) {
+            const T x = static_cast<T>(i) / T(16);
+            const T y = static_cast<T>(j) / T(16);
+            points.push_back({ x, y, std::sin(x) * std::cos(y) });
+        }
+    }
+    offsets.assign(1, 0);
+    for (std::size_t i = 0; i < normal_side; ++i) {
+        for (std::size_t j = 0; j < normal_side; ++j) {
+            const std::size_t first_i = i < normal_radius ? 0 : i - normal_radius;
+            const std::size_t first_j = j < normal_radius ? 0 : j - normal_radius;
+            for (std::size_t ni = first_i; ni <= std::min(i + normal_radius, normal_side - 1); ++ni) {
+                for (std::size_t nj = first_j; nj <= std::min(j + normal_radius, normal_side - 1); ++nj) {
+                    neighbors.push_back(ni * normal_side + nj);
+                }
+            }
+            offsets.push_back(neighbors.size());
+        }
+    }
+}
+
+template <typename T>
+Matrix<T, 3, 3> neighborhood_covariance(const Vector3SoA<T> &points, const std::size_t *first, const std::size_t *last) {
+    Vector3<T> mean { T(0) };
+    for (const std::size_t *k = first; k != last; ++k) {
+        mean += points[*k];
+    }
+    mean /= static_cast<T>(last - first);
+    Matrix<T, 3, 3> covariance { T(0) };
+    for (const std::size_t *k = first; k != last; ++k) {
+        const Vector3<T> d = points[*k] - mean;
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                covariance[i, j] += d[i] * d[j];
+            }
+        }
+    }
+    return covariance;
+}
+
+template <typename T>
+void bench_normals(dk::bench::Reporter &reporter, const std::string &type) {
+    Vector3SoA<T> points;
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> neighbors;
+    normal_cloud(points, offsets, neighbors);
+    const std::size_t count = points.size();
+    const double items = static_cast<double>(count);
+    const double bytes = sizeof(T) * 3.0 * (static_cast<double>(neighbors.size()) + items) + sizeof(std::size_t) * static_cast<double>(neighbors.size());
+    const auto suffix = "<" + type + ">";
+
+    MatrixSoA<T, 3, 3> covariances(count);
+    for (std::size_t p = 0; p < count; ++p) {
+        covariances.set(p, neighborhood_covariance(points, neighbors.data() + offsets[p], neighbors.data() + offsets[p + 1]));
+    }
+    VectorSoA<T, 3> values;
+    MatrixSoA<T, 3, 3> vectors;
+    std::vector<Matrix<T, 3, 3>> per_matrix(count);
+    const auto covariance_list = covariances.to_vector();
+
+    const auto per_matrix_eigen = dk::bench::measure([&] {
+        for (std::size_t p = 0; p < count; ++p) {
+            per_matrix[p] = SymmetricEigen3<T>(covariance_list[p]).eigenvectors();
+        }
+        dk::bench::do_not_optimize(per_matrix);
+    });
+    reporter.add({ "batch/eigen3_per_matrix" + suffix, per_matrix_eigen, {}, items, sizeof(T) * 18.0 * items });
+
+    const auto batched_eigen = dk::bench::measure([&] {
+        batch::symmetric_eigen(covariances, values, vectors);
+        dk::bench::do_not_optimize(values);
+        dk::bench::do_not_optimize(vectors);
+    });
+    reporter.add({ "batch/eigen3" + suffix, batched_eigen, {}, items, sizeof(T) * 21.0 * items });
+
+    Vector3SoA<T> normals(count);
+    const auto per_point = dk::bench::measure([&] {
+        for (std::size_t p = 0; p < count; ++p) {
+            const auto covariance = neighborhood_covariance(points, neighbors.data() + offsets[p], neighbors.data() + offsets[p + 1]);
+            const auto eigenvectors = SymmetricEigen3<T>(covariance).eigenvectors();
+            normals.set(p, { eigenvectors[0, 0], eigenvectors[1, 0], eigenvectors[2, 0] });
+        }
+        dk::bench::do_not_optimize(normals);
+    });
+    reporter.add({ "batch/normals_per_point" + suffix, per_point, {}, items, bytes });
+
+    const auto unfused = dk::bench::measure([&] {
+        for (std::size_t p = 0; p < count; ++p) {
+            covariances.set(p, neighborhood_covariance(points, neighbors.data() + offsets[p], neighbors.data() + offsets[p + 1]));
+        }
+        batch::symmetric_eigen(covariances, values, vectors);
+        dk::bench::do_not_optimize(vectors);
+    });
+    reporter.add({ "batch/normals_unfused" + suffix, unfused, {}, items, bytes });
+
+    const auto fused = dk::bench::measure([&] {
+        batch::neighborhood_normals<T>(points, offsets, neighbors, normals);
+        dk::bench::do_not_optimize(normals);
+    });
+    reporter.add({ "batch/normals_fused" + suffix, fused, {}, items, bytes });
+}
+
+} // namespace
+
+DK_BENCHMARK("batch_decomposition/float") {
+    bench_batch<float, 3>(reporter, "float");
+    bench_batch<float, 4>(reporter, "float");
+    bench_batch<float, 6>(reporter, "float");
+    bench_svd<float>(reporter, "float");
+    bench_normals<float>(reporter, "float");
+}
+
+DK_BENCHMARK("batch_decomposition/double") {
+    bench_batch<double, 3>(reporter, "double");
+    bench_batch<double, 4>(reporter, "double");
+    bench_batch<double, 6>(reporter, "double");
+    bench_svd<double>(reporter, "double");
+    bench_normals<double>(reporter, "double");
+}
@@ -0,0 +1,94 @@
+/// @file bench_covariance.cpp
+///
+/// Mean and covariance of a point cloud too large for the caches with
+/// `CovarianceAccumulator`: point by point with Welford's update, in chunks
+/// of packed `Vector3` points and of `Vector3SoA` lanes, and in parallel.
+/// The byte rates compare with the memory bandwidth, the chunked passes run
+/// on data that is already in L1.
+
+#include <dklib/math/covariance.hpp>
+#include <dklib/math/execution.hpp>
+#include <dklib/math/vector3_soa.hpp>
+
+#include <cmath>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+constexpr std::size_t point_count = std::size_t { 1 } << 22;
+
+template <typename T>
+void bench_covariance(dk::bench::Reporter &reporter, const std::string &type) {
+    std::vector<Vector3<T>> points;
+    points.reserve(point_count);
+    for (std::size_t k = 0; k < point_count; ++k) {
+        const T t = static_cast<T>(k % 4096) / T(64);
+        points.emplace_back(T(100) + std::cos(t), T(-50) + std::sin(t), static_cast<T>(k % 7) / T(8));
+    }
+    const Vector3SoA<T> soa { points };
+    const double items = static_cast<double>(point_count);
+    const double bytes = 3.0 * sizeof(T) * items;
+    const auto suffix = "<" + type + ">";
+
+    const auto per_point = dk::bench::measure([&] {
+        CovarianceAccumulator<T, 3> accumulator;
+        for (const auto &point : points) {
+            accumulator.add(point);
+        }
+        dk::bench::do_not_optimize(accumulator);
+    });
+    reporter.add({ "covariance/per_point" + suffix, per_point, {}, items, bytes });
+
+    const auto packed = dk::bench::measure([&] {
+        CovarianceAccumulator<T, 3> accumulator;
+        accumulator.add(points);
+        dk::bench::do_not_optimize(accumulator);
+    });
+    reporter.add({ "covariance/packed" + suffix, packed, {}, items, bytes });
+
+    const auto lanes = dk::bench::measure([&] {
+        CovarianceAccumulator<T, 3> accumulator;
+        accumulator.add(soa);
+        dk::bench::do_not_optimize(accumulator);
+    });
+    reporter.add({ "covariance/soa" + suffix, lanes, {}, items, bytes });
+
+    const auto parallel_packed = dk::bench::measure([&] {
+        CovarianceAccumulator<T, 3> accumulator;
+        accumulator.add(execution::par, points);
+        dk::bench::do_not_optimize(accumulator);
+    });
+    reporter.add(
+        { "covariance/packed_parallel" + suffix, parallel_packed, { { "speedup", packed.ns_per_op() / parallel_packed.ns_per_op() } }, items, bytes }
+    );
+
+    const std::array<std::span<const T>, 3> soa_lanes {
+        std::span<const T> { soa.x(), soa.size() },
+        std::span<const T> { soa.y(), soa.size() },
+        std::span<const T> { soa.z(), soa.size() },
+    };
+    const auto parallel_lanes = dk::bench::measure([&] {
+        CovarianceAccumulator<T, 3> accumulator;
+        accumulator.add(execution::par, soa_lanes);
+        dk::bench::do_not_optimize(accumulator);
+    });
+    reporter.add(
+        { "covariance/soa_parallel" + suffix, parallel_lanes, { { "speedup", lanes.ns_per_op() / parallel_lanes.ns_per_op() } }, items, bytes }
+    );
+}
+
+} // namespace
+
+DK_BENCHMARK("covariance/float") {
+    bench_covariance<float>(reporter, "float");
+}
+
+DK_BENCHMARK("covariance/double") {
+    bench_covariance<double>(reporter, "double");
+}
@@ -0,0 +1,140 @@
+/// @file bench_decomposition.cpp
+///
+/// LU, Cholesky and QR factorizations of dynamic matrices, column by column
+/// and with the blocked variants whose trailing updates run on the GEMM, in
+/// GFLOP/s. Every iteration also copies the matrix it factors in place.
+
+#include <dklib/math/decomposition.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+template <typename T>
+void bench_lu(dk::bench::Reporter &reporter, const std::string &type, std::size_t n) {
+    DynMatrix<T> mat(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            mat[i, j] = static_cast<T>(static_cast<int>((i * 7 + j * 3) % 11) - 5);
+        }
+        mat[i, i] += static_cast<T>(n);
+    }
+    DynMatrix<T> work(n, n);
+    std::vector<std::size_t> pivots(n);
+
+    const double flops = 2.0 / 3.0 * static_cast<double>(n) * n * n;
+    const double bytes = 2.0 * n * n * sizeof(T);
+    const auto suffix = "<" + type + ", " + std::to_string(n) + ">";
+    const auto run = [&](const std::string &name, std::size_t panel_width) {
+        const auto measurement = dk::bench::measure([&] {
+            std::copy(mat.data(), mat.data() + mat.size(), work.data());
+            dk::bench::do_not_optimize(lu::factor(work.data(), n, n, pivots.data(), panel_width));
+            dk::bench::do_not_optimize(work);
+        });
+        reporter.add({ name + suffix, measurement, {}, 1.0, bytes, flops });
+    };
+
+    run("lu/unblocked", n);
+    run("lu/blocked", lu::block_size);
+}
+
+template <typename T>
+void bench_cholesky(dk::bench::Reporter &reporter, const std::string &type, std::size_t n) {
+    // Diagonally dominant with a positive diagonal, so positive definite.
+    DynMatrix<T> mat(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            mat[i, j] = static_cast<T>(static_cast<int>((i + j) % 11) - 5) / T(8);
+        }
+        mat[i, i] += static_cast<T>(n);
+    }
+    DynMatrix<T> work(n, n);
+
+    const double flops = 1.0 / 3.0 * static_cast<double>(n) * n * n;
+    const double bytes = 2.0 * n * n * sizeof(T);
+    const auto suffix = "<" + type + ", " + std::to_string(n) + ">";
+    const auto run = [&](const std::string &name, std::size_t panel_width) {
+        const auto measurement = dk::bench::measure([&] {
+            std::copy(mat.data(), mat.data() + mat.size(), work.data());
+            dk::bench::do_not_optimize(cholesky::factor(work.data(), n, n, panel_width));
+            dk::bench::do_not_optimize(work);
+        });
+        reporter.add({ name + suffix, measurement, {}, 1.0, bytes, flops });
+    };
+
+    run("cholesky/unblocked", n);
+    run("cholesky/blocked", cholesky::block_size);
+}
+
+template <typename T>
+void bench_qr(dk::bench::Reporter &reporter, const std::string &type, std::size_t n) {
+    const std::size_t rows = 2 * n;
+    // Strongly diagonal, so that the columns stay far from dependent.
+    DynMatrix<T> mat(rows, n);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            mat[i, j] = static_cast<T>(static_cast<int>((i * 7 + j * 3) % 11) - 5) / T(8) + (i == j ? T(4) : T(0));
+        }
+    }
+    DynMatrix<T> work(rows, n);
+    std::vector<T> tau(n), scratch(n);
+
+    const double flops = 2.0 * static_cast<double>(n) * n * (static_cast<double>(rows) - n / 3.0);
+    const double bytes = 2.0 * rows * n * sizeof(T);
+    const auto suffix = "<" + type + ", " + std::to_string(rows) + "x" + std::to_string(n) + ">";
+    const auto run = [&](const std::string &name, std::size_t panel_width) {
+        const auto measurement = dk::bench::measure([&] {
+            std::copy(mat.data(), mat.data() + mat.size(), work.data());
+            qr::factor(work.data(), rows, n, n, tau.data(), scratch.data(), panel_width);
+            dk::bench::do_not_optimize(work);
+        });
+        reporter.add({ name + suffix, measurement, {}, 1.0, bytes, flops });
+    };
+
+    run("qr/unblocked", n);
+    run("qr/blocked", qr::block_size);
+}
+
+} // namespace
+
+DK_BENCHMARK("lu/float") {
+    for (std::size_t n : { 64, 256, 512 }) {
+        bench_lu<float>(reporter, "float", n);
+    }
+}
+
+DK_BENCHMARK("lu/double") {
+    for (std::size_t n : { 64, 256, 512 }) {
+        bench_lu<double>(reporter, "double", n);
+    }
+}
+
+DK_BENCHMARK("cholesky/float") {
+    for (std::size_t n : { 64, 256, 512 }) {
+        bench_cholesky<float>(reporter, "float", n);
+    }
+}
+
+DK_BENCHMARK("cholesky/double") {
+    for (std::size_t n : { 64, 256, 512 }) {
+        bench_cholesky<double>(reporter, "double", n);
+    }
+}
+
+DK_BENCHMARK("qr/float") {
+    for (std::size_t n : { 64, 256 }) {
+        bench_qr<float>(reporter, "float", n);
+    }
+}
+
+DK_BENCHMARK("qr/double") {
+    for (std::size_t n : { 64, 256 }) {
+        bench_qr<double>(reporter, "double", n);
+    }
+}
@@ -0,0 +1,67 @@
+/// @file bench_expression.cpp
+///
+/// Compares `a + b * 2 - c` evaluated through fused expression templates with
+/// the eager evaluation that creates one temporary per operator.
+
+#include <dklib/math/vector.hpp>
+
+#include <memory>
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+template <typename T, std::size_t N>
+void bench_axpy(dk::bench::Reporter &reporter, const std::string &type) {
+    using V = Vector<T, N>;
+    auto a = std::make_unique<V>(T(1));
+    auto b = std::make_unique<V>(T(2));
+    auto c = std::make_unique<V>(T(3));
+    auto result = std::make_unique<V>();
+    auto scaled = std::make_unique<V>();
+    auto sum = std::make_unique<V>();
+
+    const auto suffix = "<" + type + ", " + std::to_string(N) + ">";
+    const double elements = static_cast<double>(N);
+    // One multiply, one add and one subtract per element.
+    const double flops = 3.0 * elements;
+    const double pass = elements * sizeof(T);
+
+    const auto eager = dk::bench::measure([&] {
+        // What the free operators did before, minus the allocations, every
+        // copy and compound operator is a full pass over memory.
+        *scaled = *b;
+        *scaled *= T(2);
+        *sum = *a;
+        *sum += *scaled;
+        *sum -= *c;
+        *result = *sum;
+        dk::bench::do_not_optimize(*result);
+    });
+    // Three copies and three compound operators, eight reads and six writes
+    // over six vectors.
+    reporter.add({ "expression/eager" + suffix, eager, {}, elements, 14.0 * pass, flops, 6.0 * pass });
+
+    const auto fused = dk::bench::measure([&] {
+        *result = *a + *b * T(2) - *c;
+        dk::bench::do_not_optimize(*result);
+    });
+    reporter.add({ "expression/fused" + suffix, fused, {}, elements, 4.0 * pass, flops });
+}
+
+} // namespace
+
+DK_BENCHMARK("expression/float") {
+    bench_axpy<float, 1024>(reporter, "float");
+    bench_axpy<float, 65536>(reporter, "float");
+    bench_axpy<float, 1048576>(reporter, "float");
+}
+
+DK_BENCHMARK("expression/double") {
+    bench_axpy<double, 1024>(reporter, "double");
+    bench_axpy<double, 65536>(reporter, "double");
+    bench_axpy<double, 1048576>(reporter, "double");
+}
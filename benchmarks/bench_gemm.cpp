@@ -0,0 +1,106 @@
+/// @file bench_gemm.cpp
+///
+/// Compares the blocked `operator*` of `Matrix` with the naive triple loop it
+/// replaced, in GFLOP/s, and products with a transposed operand built by
+/// `transpose()` with the lazy `transposed()` ones.
+
+#include <dklib/math/matrix.hpp>
+
+#include <memory>
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+/// The i-j-k loop `operator*` used before the blocked kernel.
+template <typename T, std::size_t N>
+void reference_multiply(const Matrix<T, N, N> &lhs, const Matrix<T, N, N> &rhs, Matrix<T, N, N> &result) {
+    result = Matrix<T, N, N> { 0 };
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            for (std::size_t k = 0; k < N; ++k) {
+                result[i, j] += lhs[i, k] * rhs[k, j];
+            }
+        }
+    }
+}
+
+template <typename T, std::size_t N>
+void bench_square(dk::bench::Reporter &reporter, const std::string &type) {
+    auto lhs = std::make_unique<Matrix<T, N, N>>();
+    auto rhs = std::make_unique<Matrix<T, N, N>>();
+    auto result = std::make_unique<Matrix<T, N, N>>();
+    for (std::size_t i = 0; i < N * N; ++i) {
+        (*lhs)[i] = static_cast<T>(i % 7) * T(0.5);
+        (*rhs)[i] = static_cast<T>(i % 5) - T(2);
+    }
+
+    const double flops = 2.0 * N * N * N;
+    const double bytes = 3.0 * N * N * sizeof(T);
+    const auto suffix = "<" + type + ", " + std::to_string(N) + ">";
+
+    const auto naive = dk::bench::measure([&] {
+        reference_multiply(*lhs, *rhs, *result);
+        dk::bench::do_not_optimize(*result);
+    });
+    reporter.add({ "gemm/naive" + suffix, naive, {}, 1.0, bytes, flops });
+
+    const auto blocked = dk::bench::measure([&] {
+        *result = *lhs * *rhs;
+        dk::bench::do_not_optimize(*result);
+    });
+    reporter.add({ "gemm/blocked" + suffix, blocked, {}, 1.0, bytes, flops });
+}
+
+template <typename T, std::size_t N>
+void bench_transposed(dk::bench::Reporter &reporter, const std::string &type) {
+    auto lhs = std::make_unique<Matrix<T, N, N>>();
+    auto rhs = std::make_unique<Matrix<T, N, N>>();
+    auto result = std::make_unique<Matrix<T, N, N>>();
+    for (std::size_t i = 0; i < N * N; ++i) {
+        (*lhs)[i] = static_cast<T>(i % 7) * T(0.5);
+        (*rhs)[i] = static_cast<T>(i % 5) - T(2);
+    }
+
+    const double flops = 2.0 * N * N * N;
+    const double bytes = 3.0 * N * N * sizeof(T);
+    const auto suffix = "<" + type + ", " + std::to_string(N) + ">";
+    const auto run = [&](const std::string &name, auto &&product) {
+        const auto measurement = dk::bench::measure([&] {
+            *result = product();
+            dk::bench::do_not_optimize(*result);
+        });
+        reporter.add({ name + suffix, measurement, {}, 1.0, bytes, flops });
+    };
+
+    run("gemm/at_b/copy", [&] { return lhs->transpose() * *rhs; });
+    run("gemm/at_b/lazy", [&] { return transposed(*lhs) * *rhs; });
+    run("gemm/a_bt/copy", [&] { return *lhs * rhs->transpose(); });
+    run("gemm/a_bt/lazy", [&] { return *lhs * transposed(*rhs); });
+}
+
+} // namespace
+
+DK_BENCHMARK("gemm/float") {
+    bench_square<float, 16>(reporter, "float");
+    bench_square<float, 64>(reporter, "float");
+    bench_square<float, 128>(reporter, "float");
+    bench_square<float, 256>(reporter, "float");
+}
+
+DK_BENCHMARK("gemm/double") {
+    bench_square<double, 16>(reporter, "double");
+    bench_square<double, 64>(reporter, "double");
+    bench_square<double, 128>(reporter, "double");
+    bench_square<double, 256>(reporter, "double");
+}
+
+DK_BENCHMARK("gemm/transposed") {
+    bench_transposed<float, 8>(reporter, "float");
+    bench_transposed<float, 128>(reporter, "float");
+    bench_transposed<double, 8>(reporter, "double");
+    bench_transposed<double, 128>(reporter, "double");
+}
@@ -0,0 +1,73 @@
+/// @file bench_inverse.cpp
+///
+/// Inverses of batches of `Matrix4` transformations, as view and model
+/// matrices are inverted every frame: the general cofactor expansion, the
+/// affine path, which only inverts the 3x3 part, and the rigid path, which
+/// only transposes the rotation. All three are given the same rigid
+/// transformations, so they compute the same results. The LU factorization
+/// the free `inverse` used for order four before is the baseline.
+
+#include <dklib/math/decomposition.hpp>
+#include <dklib/math/matrix4d.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+constexpr std::size_t batch_size = 1024;
+
+template <typename T>
+std::vector<Matrix4<T>> rigid_transforms() {
+    std::vector<Matrix4<T>> result(batch_size);
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        const T angle = static_cast<T>(i) * T(0.01);
+        const T c = std::cos(angle), s = std::sin(angle);
+        result[i] = {
+            { c, -s, T(0), static_cast<T>(i % 7) },
+            { s, c, T(0), T(-2) },
+            { T(0), T(0), T(1), T(0.5) },
+            { T(0), T(0), T(0), T(1) },
+        };
+    }
+    return result;
+}
+
+template <typename T>
+void bench_inverse(dk::bench::Reporter &reporter, const std::string &type) {
+    const auto transforms = rigid_transforms<T>();
+    std::vector<Matrix4<T>> inverses(batch_size);
+    const double items = batch_size;
+    const double bytes = 2.0 * sizeof(Matrix4<T>) * items;
+    const auto suffix = "<" + type + ">";
+
+    const auto run = [&](const std::string &name, auto &&invert) {
+        const auto measurement = dk::bench::measure([&] {
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                inverses[i] = invert(transforms[i]);
+            }
+            dk::bench::do_not_optimize(inverses);
+        });
+        reporter.add({ name + suffix, measurement, {}, items, bytes });
+    };
+
+    run("inverse/lu", [](const Matrix4<T> &mat) { return Matrix4<T>(LU<T, 4>(mat).inverse()); });
+    run("inverse/general", [](const Matrix4<T> &mat) { return mat.inverse(); });
+    run("inverse/affine", [](const Matrix4<T> &mat) { return mat.inverse_affine(); });
+    run("inverse/rigid", [](const Matrix4<T> &mat) { return mat.inverse_rigid(); });
+}
+
+} // namespace
+
+DK_BENCHMARK("inverse/float") {
+    bench_inverse<float>(reporter, "float");
+}
+
+DK_BENCHMARK("inverse/double") {
+    bench_inverse<double>(reporter, "double");
+}
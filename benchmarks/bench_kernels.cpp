@@ -0,0 +1,278 @@
+/// @file bench_kernels.cpp
+///
+/// Sweep over the public element-wise kernels: `Vector*` arithmetic, `dot`,
+/// `cross` and `normalize`, `Matrix*` multiply and transpose, `Quaternion`
+/// multiply and rotate and `Angle` conversions. Every kernel call processes a
+/// whole array of `count` objects so the loop itself is what gets measured,
+/// ops/s counts objects and bytes/s the bytes the call reads and writes.
+/// Floating point kernels also declare their FLOP count for `--roofline`.
+
+#include <dklib/math/angle.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/matrix4d.hpp>
+#include <dklib/math/quaternion.hpp>
+#include <dklib/math/rotation.hpp>
+#include <dklib/math/vector2d.hpp>
+#include <dklib/math/vector3d.hpp>
+#include <dklib/math/vector4d.hpp>
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+/// Short enough for the whole sweep to finish in about a minute.
+constexpr double min_seconds = 0.05;
+
+/// One array resident in L1 and one well beyond the last level cache.
+constexpr std::size_t sweep_counts[] = { 256, 1 << 18 };
+
+template <typename T>
+constexpr std::string_view type_name() {
+    if constexpr (std::is_same_v<T, float>) {
+        return "f32";
+    } else if constexpr (std::is_same_v<T, double>) {
+        return "f64";
+    } else {
+        return "i32";
+    }
+}
+
+template <typename T>
+std::string suffix(std::size_t count) {
+    return "/" + std::string(type_name<T>()) + "/" + std::to_string(count);
+}
+
+/// Small nonzero values, so normalization and division are always defined.
+template <typename T>
+T sample_value(std::size_t i) {
+    return static_cast<T>(1 + i % 7) / static_cast<T>(1 + i % 3);
+}
+
+template <typename V>
+std::vector<V> sample_vectors(std::size_t count, std::size_t seed) {
+    std::vector<V> vectors(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t d = 0; d < vectors[i].size(); ++d) {
+            vectors[i][d] = sample_value<typename V::value_type>(i + d + seed);
+        }
+    }
+    return vectors;
+}
+
+template <typename T, std::size_t N>
+std::vector<Matrix<T, N, N>> sample_matrices(std::size_t count, std::size_t seed) {
+    std::vector<Matrix<T, N, N>> matrices(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t e = 0; e < N * N; ++e) {
+            matrices[i][e] = sample_value<T>(i + e + seed);
+        }
+    }
+    return matrices;
+}
+
+/// @brief Returns the FLOP count of `count` objects, integer kernels do not
+/// have any.
+template <typename T>
+double flops(std::size_t count, double per_item) {
+    return std::is_floating_point_v<T> ? per_item * static_cast<double>(count) : 0.0;
+}
+
+template <typename F>
+void run(dk::bench::Reporter &reporter, std::string name, std::size_t count, double bytes, double flops, F &&kernel) {
+    const auto measurement = dk::bench::measure(kernel, min_seconds);
+    reporter.add({ std::move(name), measurement, {}, static_cast<double>(count), bytes, flops });
+}
+
+template <typename V>
+void bench_vectors(dk::bench::Reporter &reporter, std::string_view prefix, std::size_t count) {
+    using T = typename V::value_type;
+    const auto tail = suffix<T>(count);
+    const double size = static_cast<double>(sizeof(V) * count);
+    const double dims = static_cast<double>(V {}.size());
+
+    const auto lhs = sample_vectors<V>(count, 0);
+    const auto rhs = sample_vectors<V>(count, 5);
+    std::vector<V> out(count);
+    std::vector<double> values(count);
+
+    run(reporter, std::string(prefix) + "/add" + tail, count, 3 * size, flops<T>(count, dims), [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = lhs[i] + rhs[i];
+        }
+        dk::bench::do_not_optimize(out);
+    });
+
+    run(reporter, std::string(prefix) + "/scale" + tail, count, 2 * size, flops<T>(count, dims), [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = lhs[i] * T(3);
+        }
+        dk::bench::do_not_optimize(out);
+    });
+
+    run(reporter, std::string(prefix) + "/dot" + tail, count, 2 * size + sizeof(double) * count, flops<T>(count, 2 * dims - 1), [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i] = dot(lhs[i], rhs[i]);
+        }
+        dk::bench::do_not_optimize(values);
+    });
+
+    if constexpr (std::is_floating_point_v<T> and requires(const V &v) { v.normalized(); }) {
+        run(reporter, std::string(prefix) + "/normalize" + tail, count, 2 * size, flops<T>(count, 3 * dims + 1), [&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = lhs[i].normalized();
+            }
+            dk::bench::do_not_optimize(out);
+        });
+    }
+
+    if constexpr (std::is_same_v<V, Vector3<T>>) {
+        run(reporter, std::string(prefix) + "/cross" + tail, count, 3 * size, flops<T>(count, 9), [&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = lhs[i].cross(rhs[i]);
+            }
+            dk::bench::do_not_optimize(out);
+        });
+    }
+}
+
+template <typename T>
+void bench_vector_types(dk::bench::Reporter &reporter, std::size_t count) {
+    bench_vectors<Vector2<T>>(reporter, "vector2", count);
+    bench_vectors<Vector3<T>>(reporter, "vector3", count);
+    bench_vectors<Vector4<T>>(reporter, "vector4", count);
+    bench_vectors<Vector<T, 8>>(reporter, "vector8", count);
+}
+
+template <typename T, std::size_t N>
+void bench_matrices(dk::bench::Reporter &reporter, std::size_t count) {
+    using M = Matrix<T, N, N>;
+    const auto tail = "/" + std::to_string(N) + suffix<T>(count);
+    const double size = static_cast<double>(sizeof(M) * count);
+
+    auto lhs = sample_matrices<T, N>(count, 0);
+    const auto rhs = sample_matrices<T, N>(count, 3);
+    std::vector<M> out(count);
+
+    run(reporter, "matrix/multiply" + tail, count, 3 * size, flops<T>(count, 2.0 * N * N * N), [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = lhs[i] * rhs[i];
+        }
+        dk::bench::do_not_optimize(out);
+    });
+
+    run(reporter, "matrix/transpose" + tail, count, 2 * size, 0.0, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = lhs[i].transpose();
+        }
+        dk::bench::do_not_optimize(out);
+    });
+}
+
+template <typename T>
+void bench_matrix_sizes(dk::bench::Reporter &reporter, std::size_t count) {
+    bench_matrices<T, 2>(reporter, count);
+    bench_matrices<T, 3>(reporter, count);
+    bench_matrices<T, 4>(reporter, count);
+    bench_matrices<T, 8>(reporter, count);
+}
+
+void bench_quaternions(dk::bench::Reporter &reporter, std::size_t count) {
+    const auto tail = suffix<float>(count);
+    const double size = static_cast<double>(sizeof(Quaternion) * count);
+
+    std::vector<Quaternion> lhs(count);
+    std::vector<Quaternion> rhs(count);
+    std::vector<Quaternion> out(count);
+    const auto vectors = sample_vectors<Vector3D>(count, 0);
+    std::vector<Vector3D> rotated(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        lhs[i] = Quaternion(vectors[i], sample_value<float>(i + 1));
+        rhs[i] = Quaternion(vectors[i], sample_value<float>(i + 2)).normalized();
+    }
+
+    run(reporter, "quaternion/multiply" + tail, count, 3 * size, flops<float>(count, 28), [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = lhs[i] * rhs[i];
+        }
+        dk::bench::do_not_optimize(out);
+    });
+
+    const auto axis = Vector3D(1.0f, 2.0f, 3.0f);
+    const double vector_bytes = 2.0 * sizeof(Vector3D) * static_cast<double>(count);
+    run(reporter, "quaternion/rotate" + tail, count, vector_bytes, flops<float>(count, 30), [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            rotated[i] = Quaternion::rotate(vectors[i], 30_deg, axis);
+        }
+        dk::bench::do_not_optimize(rotated);
+    });
+
+    const Rotation rotation { 30_deg, axis };
+    run(reporter, "quaternion/rotate_prepared" + tail, count, vector_bytes, flops<float>(count, 30), [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            rotated[i] = rotation(vectors[i]);
+        }
+        dk::bench::do_not_optimize(rotated);
+    });
+}
+
+void bench_angles(dk::bench::Reporter &reporter, std::size_t count) {
+    const auto tail = suffix<double>(count);
+    const double size = static_cast<double>(sizeof(double) * count);
+
+    std::vector<double> degrees(count);
+    std::vector<double> radians(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        degrees[i] = static_cast<double>(i % 360);
+    }
+
+    run(reporter, "angle/from_degrees" + tail, count, 2 * size, flops<double>(count, 1), [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            radians[i] = Angle::from<Degrees>(degrees[i]);
+        }
+        dk::bench::do_not_optimize(radians);
+    });
+
+    run(reporter, "angle/as_degrees" + tail, count, 2 * size, flops<double>(count, 1), [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            degrees[i] = Angle::as<Degrees>(radians[i]);
+        }
+        dk::bench::do_not_optimize(degrees);
+    });
+}
+
+} // namespace
+
+DK_BENCHMARK("vector") {
+    for (const auto count : sweep_counts) {
+        bench_vector_types<float>(reporter, count);
+        bench_vector_types<double>(reporter, count);
+        bench_vector_types<int>(reporter, count);
+    }
+}
+
+DK_BENCHMARK("matrix") {
+    for (const auto count : sweep_counts) {
+        bench_matrix_sizes<float>(reporter, count);
+        bench_matrix_sizes<double>(reporter, count);
+        bench_matrix_sizes<int>(reporter, count);
+    }
+}
+
+DK_BENCHMARK("quaternion") {
+    for (const auto count : sweep_counts) {
+        bench_quaternions(reporter, count);
+    }
+}
+
+DK_BENCHMARK("angle") {
+    for (const auto count : sweep_counts) {
+        bench_angles(reporter, count);
+    }
+}
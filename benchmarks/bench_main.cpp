@@ -0,0 +1,171 @@
+/// @file bench_main.cpp
+///
+/// Entry point of `bench_dklib`, it runs every registered benchmark whose name
+/// contains the optional filter and prints the results as a table. With
+/// `--json <file>` the results are also written as JSON, `-` stands for the
+/// standard output, in which case the table is omitted. `--perf` reads
+/// hardware counters around every benchmark, see `perf_counters.hpp`, and
+/// `--roofline` measures the machine peaks and places every benchmark that
+/// declares its FLOP and byte counts on the roofline, see `roofline.hpp`.
+///
+///     bench_dklib [--json <file>] [--perf] [--roofline] [filter]
+
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <dklib/math/dispatch.hpp>
+
+#include "benchmark.hpp"
+#include "roofline.hpp"
+
+namespace {
+
+void print_table(const dk::bench::Reporter &reporter, const std::optional<dk::bench::MachinePeak> &peak) {
+    if (peak) {
+        std::printf("peak: %.4g GFLOP/s\n", peak->gflops);
+        for (const auto &roof : peak->memory) {
+            std::printf("%-6s %.4g GB/s, ridge at %.3g FLOP/byte\n", roof.level.c_str(), roof.gbytes_per_second, peak->ridge(roof));
+        }
+        std::printf("\n");
+    }
+    std::printf("%-48s %14s %12s %12s %12s\n", "benchmark", "ns/op", "iterations", "ops/s", "bytes/s");
+    for (const auto &result : reporter.results()) {
+        std::printf(
+            "%-48s %14.2f %12zu %12.4g %12.4g", result.name.c_str(), result.measurement.ns_per_op(),
+            result.measurement.iterations, result.ops_per_second(), result.bytes_per_second()
+        );
+        for (const auto &[counter, value] : result.counters) {
+            std::printf("  %s=%.4g", counter.c_str(), value);
+        }
+        if (not result.bound.empty()) {
+            std::printf("  %s bound", result.bound.c_str());
+        }
+        std::printf("\n");
+    }
+}
+
+void print_json_string(std::FILE *file, std::string_view value) {
+    std::fputc('"', file);
+    for (const char c : value) {
+        if (c == '"' or c == '\\') {
+            std::fputc('\\', file);
+            std::fputc(c, file);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            std::fprintf(file, "\\u%04x", static_cast<unsigned>(c));
+        } else {
+            std::fputc(c, file);
+        }
+    }
+    std::fputc('"', file);
+}
+
+void print_json(std::FILE *file, const dk::bench::Reporter &reporter, const std::optional<dk::bench::MachinePeak> &peak) {
+    std::fprintf(file, "{\n  \"context\": {\"isa\": ");
+    print_json_string(file, dk::math::dispatch::to_string(dk::math::dispatch::active_isa()));
+    if (peak) {
+        std::fprintf(
+            file, ", \"peak_gflops\": %.9g, \"peak_gbytes_per_second\": %.9g, \"memory_roofs\": {", peak->gflops,
+            peak->memory.back().gbytes_per_second
+        );
+        const char *roof_separator = "";
+        for (const auto &roof : peak->memory) {
+            std::fprintf(file, "%s", roof_separator);
+            print_json_string(file, roof.level);
+            std::fprintf(file, ": %.9g", roof.gbytes_per_second);
+            roof_separator = ", ";
+        }
+        std::fprintf(file, "}");
+    }
+    std::fprintf(file, "},\n  \"benchmarks\": [");
+    const char *separator = "\n";
+    for (const auto &result : reporter.results()) {
+        std::fprintf(file, "%s    {\"name\": ", separator);
+        print_json_string(file, result.name);
+        std::fprintf(
+            file, ", \"iterations\": %zu, \"seconds\": %.9g, \"ns_per_op\": %.9g, \"ops_per_second\": %.9g, \"bytes_per_second\": %.9g",
+            result.measurement.iterations, result.measurement.seconds, result.measurement.ns_per_op(), result.ops_per_second(),
+            result.bytes_per_second()
+        );
+        std::fprintf(file, ", \"counters\": {");
+        const char *counter_separator = "";
+        for (const auto &[counter, value] : result.counters) {
+            std::fprintf(file, "%s", counter_separator);
+            print_json_string(file, counter);
+            std::fprintf(file, ": %.9g", value);
+            counter_separator = ", ";
+        }
+        std::fprintf(file, "}");
+        if (not result.bound.empty()) {
+            std::fprintf(file, ", \"bound\": ");
+            print_json_string(file, result.bound);
+        }
+        std::fprintf(file, "}");
+        separator = ",\n";
+    }
+    std::fprintf(file, "\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string_view filter;
+    const char *json_path = nullptr;
+    bool perf = false;
+    bool roofline = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 and i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--perf") == 0) {
+            perf = true;
+        } else if (std::strcmp(argv[i], "--roofline") == 0) {
+            roofline = true;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    std::optional<dk::bench::PerfCounters> counters;
+    if (perf) {
+        counters.emplace();
+        if (counters->available()) {
+            dk::bench::active_perf_counters() = &*counters;
+        } else {
+            std::fprintf(stderr, "hardware counters are unavailable, reporting timings only\n");
+        }
+    }
+
+    dk::bench::Reporter reporter;
+    for (const auto &benchmark : dk::bench::registry()) {
+        if (benchmark.name.find(filter) != std::string::npos) {
+            benchmark.run(reporter);
+        }
+    }
+
+    std::optional<dk::bench::MachinePeak> peak;
+    if (roofline) {
+        peak = dk::bench::measure_machine_peak();
+        for (auto &result : reporter.results()) {
+            dk::bench::annotate_roofline(result, *peak);
+        }
+    }
+
+    const bool to_stdout = json_path != nullptr and std::strcmp(json_path, "-") == 0;
+    if (not to_stdout) {
+        print_table(reporter, peak);
+    }
+    if (json_path != nullptr) {
+        std::FILE *file = to_stdout ? stdout : std::fopen(json_path, "w");
+        if (file == nullptr) {
+            std::perror(json_path);
+            return 1;
+        }
+        print_json(file, reporter, peak);
+        if (not to_stdout) {
+            std::fclose(file);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+/// @file bench_parallel.cpp
+///
+/// Strong scaling of the parallel GEMM from one participant up to one per
+/// hardware thread, and the overhead of an empty `parallel_for`.
+
+#include <dklib/math/execution.hpp>
+#include <dklib/math/thread_pool.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+std::vector<std::size_t> thread_counts() {
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> counts;
+    for (std::size_t threads = 1; threads < hardware; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(hardware);
+    return counts;
+}
+
+template <typename T>
+void bench_scaling(dk::bench::Reporter &reporter, const std::string &type, std::size_t n) {
+    std::vector<T> a(n * n);
+    std::vector<T> b(n * n);
+    std::vector<T> c(n * n);
+    for (std::size_t i = 0; i < n * n; ++i) {
+        a[i] = static_cast<T>(i % 7) * T(0.5);
+        b[i] = static_cast<T>(i % 5) - T(2);
+    }
+    const double flops = 2.0 * n * n * n;
+    const double bytes = 3.0 * n * n * sizeof(T);
+
+    double single = 0.0;
+    for (auto threads : thread_counts()) {
+        ThreadPool pool { threads };
+        const auto policy = execution::on(pool);
+        const auto measurement = dk::bench::measure([&] {
+            gemm::multiply<T>(policy, n, n, n, { a.data(), n, 1 }, { b.data(), n, 1 }, c.data(), n);
+            dk::bench::do_not_optimize(c.data());
+        });
+        if (threads == 1) {
+            single = measurement.ns_per_op();
+        }
+        reporter.add(
+            { "parallel/gemm<" + type + ", " + std::to_string(n) + ">/threads=" + std::to_string(threads),
+              measurement,
+              { { "speedup", single / measurement.ns_per_op() } },
+              1.0,
+              bytes,
+              flops }
+        );
+    }
+}
+
+} // namespace
+
+DK_BENCHMARK("parallel/gemm") {
+    bench_scaling<float>(reporter, "float", 1024);
+    bench_scaling<double>(reporter, "double", 1024);
+}
+
+DK_BENCHMARK("parallel/overhead") {
+    auto &pool = ThreadPool::global();
+    std::vector<int> sink(pool.size() * 16);
+    const auto measurement = dk::bench::measure([&] {
+        pool.parallel_for(sink.size(), [&](std::size_t i) { ++sink[i]; });
+    });
+    reporter.add({ "parallel/empty_for/threads=" + std::to_string(pool.size()), measurement, {} });
+}
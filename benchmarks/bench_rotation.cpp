@@ -0,0 +1,66 @@
+/// @file bench_rotation.cpp
+///
+/// Rotating a mesh by one orientation, `Quaternion::rotate` per vertex versus
+/// a prepared `Rotation` over spans and SoA lanes, in vectors per nanosecond.
+
+#include <dklib/math/rotation.hpp>
+
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+void bench_rotation(dk::bench::Reporter &reporter, std::size_t count) {
+    const auto suffix = "/" + std::to_string(count);
+    auto rate = [count](const dk::bench::Measurement &m) {
+        return std::map<std::string, double> { { "vectors/ns", static_cast<double>(count) / m.ns_per_op() } };
+    };
+    // Two cross products, three scalings and two additions per vector, the
+    // per call setup of `Quaternion::rotate` is not counted.
+    const double items = static_cast<double>(count);
+    const double bytes = 2.0 * sizeof(Vector3D) * items;
+    const double flops = 30.0 * items;
+
+    std::vector<Vector3D> vectors;
+    vectors.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<float>(i % 1000);
+        vectors.emplace_back(v, 1.0f - v, 0.5f * v);
+    }
+    auto out = vectors;
+    Vector3Stream stream { std::span<const Vector3D>(vectors) };
+    const auto axis = Vector3D(1.0f, 2.0f, 3.0f);
+
+    const auto per_call = dk::bench::measure([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = Quaternion::rotate(vectors[i], 30_deg, axis);
+        }
+        dk::bench::do_not_optimize(out);
+    });
+    reporter.add({ "rotation/per_call" + suffix, per_call, rate(per_call), items, bytes, flops });
+
+    const auto prepared = dk::bench::measure([&] {
+        const Rotation rotation { 30_deg, axis };
+        rotation(vectors, out);
+        dk::bench::do_not_optimize(out);
+    });
+    reporter.add({ "rotation/prepared" + suffix, prepared, rate(prepared), items, bytes, flops });
+
+    const auto lanes = dk::bench::measure([&] {
+        const Rotation rotation { 30_deg, axis };
+        rotation(stream, stream);
+        dk::bench::do_not_optimize(stream);
+    });
+    reporter.add({ "rotation/prepared_soa" + suffix, lanes, rate(lanes), items, bytes, flops, bytes / 2 });
+}
+
+} // namespace
+
+DK_BENCHMARK("rotation") {
+    bench_rotation(reporter, 4096);
+    bench_rotation(reporter, 1 << 20);
+}
@@ -0,0 +1,108 @@
+/// @file bench_soa.cpp
+///
+/// Compares batched operations on `std::vector<Vector3D>` with the same
+/// operations on a `Vector3Stream`, in vectors per nanosecond.
+
+#include <dklib/math/vector3_soa.hpp>
+
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+std::vector<Vector3D> sample_vectors(std::size_t count) {
+    std::vector<Vector3D> vectors;
+    vectors.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<float>(i % 1000);
+        vectors.emplace_back(0.5f + v, 1.0f - 0.25f * v, 2.0f + 0.125f * v);
+    }
+    return vectors;
+}
+
+void bench_vectors(dk::bench::Reporter &reporter, std::size_t count) {
+    const auto suffix = "/" + std::to_string(count);
+    const double vectors = static_cast<double>(count);
+    auto rate = [vectors](const dk::bench::Measurement &m) {
+        return std::map<std::string, double> { { "vectors/ns", vectors / m.ns_per_op() } };
+    };
+    // Bytes of one xyz triplet and of the scalar results.
+    const double triplet = 3.0 * sizeof(float) * vectors;
+    const double scalar = sizeof(float) * vectors;
+
+    const auto lhs = sample_vectors(count);
+    const auto rhs = sample_vectors(count);
+    auto aos = lhs;
+    std::vector<float> values(count);
+
+    const Vector3Stream a { std::span<const Vector3D>(lhs) };
+    const Vector3Stream b { std::span<const Vector3D>(rhs) };
+    Vector3Stream out { count };
+
+    const auto aos_dot = dk::bench::measure([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i] = static_cast<float>(lhs[i].dot(rhs[i]));
+        }
+        dk::bench::do_not_optimize(values);
+    });
+    reporter.add({ "soa/aos_dot" + suffix, aos_dot, rate(aos_dot), vectors, 2 * triplet + scalar, 5 * vectors });
+
+    const auto soa_dot = dk::bench::measure([&] {
+        batch::dot(a, b, std::span<float>(values));
+        dk::bench::do_not_optimize(values);
+    });
+    reporter.add({ "soa/soa_dot" + suffix, soa_dot, rate(soa_dot), vectors, 2 * triplet + scalar, 5 * vectors });
+
+    const auto aos_cross = dk::bench::measure([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            aos[i] = lhs[i].cross(rhs[i]);
+        }
+        dk::bench::do_not_optimize(aos);
+    });
+    reporter.add({ "soa/aos_cross" + suffix, aos_cross, rate(aos_cross), vectors, 3 * triplet, 9 * vectors });
+
+    const auto soa_cross = dk::bench::measure([&] {
+        batch::cross(a, b, out);
+        dk::bench::do_not_optimize(out);
+    });
+    reporter.add({ "soa/soa_cross" + suffix, soa_cross, rate(soa_cross), vectors, 3 * triplet, 9 * vectors });
+
+    const auto aos_normalize = dk::bench::measure([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            aos[i] = lhs[i].normalized();
+        }
+        dk::bench::do_not_optimize(aos);
+    });
+    reporter.add({ "soa/aos_normalize" + suffix, aos_normalize, rate(aos_normalize), vectors, 2 * triplet, 10 * vectors });
+
+    const auto soa_normalize = dk::bench::measure([&] {
+        out = a;
+        batch::normalize(out);
+        dk::bench::do_not_optimize(out);
+    });
+    // The copy into `out` adds a read and a write of every triplet.
+    reporter.add({ "soa/soa_normalize" + suffix, soa_normalize, rate(soa_normalize), vectors, 4 * triplet, 10 * vectors });
+
+    const auto gather = dk::bench::measure([&] {
+        out.gather(lhs);
+        dk::bench::do_not_optimize(out);
+    });
+    reporter.add({ "soa/gather" + suffix, gather, rate(gather), vectors, 2 * triplet });
+
+    const auto scatter = dk::bench::measure([&] {
+        a.scatter(aos);
+        dk::bench::do_not_optimize(aos);
+    });
+    reporter.add({ "soa/scatter" + suffix, scatter, rate(scatter), vectors, 2 * triplet });
+}
+
+} // namespace
+
+DK_BENCHMARK("soa") {
+    bench_vectors(reporter, 4096);
+    bench_vectors(reporter, 1 << 20);
+}
@@ -0,0 +1,162 @@
+/// @file bench_sparse_matrix.cpp
+///
+/// Sparse products on the graph Laplacian of a triangulated grid, seven
+/// elements per row like the Laplacians of triangle meshes: assembly from
+/// triplets, SpMV on CSR and CSC matrices, sequential and parallel, the
+/// transposed products with and without a converted matrix, and SpMM with
+/// vertex positions compared with one SpMV per coordinate.
+
+#include <dklib/math/dyn_matrix.hpp>
+#include <dklib/math/dyn_vector.hpp>
+#include <dklib/math/execution.hpp>
+#include <dklib/math/sparse_matrix.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+constexpr std::size_t grid_side = 1024;
+
+template <typename T>
+TripletBuilder<T> laplacian_triplets(std::size_t side) {
+    TripletBuilder<T> builder(side * side, side * side);
+    builder.reserve(12 * side * side);
+    auto edge = [&](std::size_t a, std::size_t b) {
+        builder.add(a, b, T(-1));
+        builder.add(b, a, T(-1));
+        builder.add(a, a, T(1));
+        builder.add(b, b, T(1));
+    };
+    for (std::size_t i = 0; i < side; ++i) {
+        for (std::size_t j = 0; j < side; ++j) {
+            const std::size_t v = i * side + j;
+            if (j + 1 < side) {
+                edge(v, v + 1);
+            }
+            if (i + 1 < side) {
+                edge(v, v + side);
+            }
+            if (i + 1 < side and j + 1 < side) {
+                edge(v, v + side + 1);
+            }
+        }
+    }
+    return builder;
+}
+
+template <typename T>
+void bench_sparse(dk::bench::Reporter &reporter, const std::string &type) {
+    const auto builder = laplacian_triplets<T>(grid_side);
+    const std::size_t n = grid_side * grid_side;
+    const auto suffix = "<" + type + ">";
+
+    CsrMatrix<T> csr;
+    const auto assemble = dk::bench::measure([&] {
+        csr = builder.to_csr();
+        dk::bench::do_not_optimize(csr);
+    });
+    const double rows = static_cast<double>(n);
+    const double nonzeros = static_cast<double>(csr.nonzeros());
+    reporter.add({ "sparse/assemble_csr" + suffix, assemble, { { "nonzeros/row", nonzeros / rows } }, static_cast<double>(builder.size()) });
+
+    const auto csc = csr.to_csc();
+    // Values and indices once, `x` and `y` once each and the offsets.
+    const double bytes = nonzeros * (sizeof(T) + sizeof(sparse::index_type)) + rows * (2 * sizeof(T) + sizeof(std::size_t));
+    const double flops = 2.0 * nonzeros;
+
+    DynVector<T> x(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = static_cast<T>(std::sin(static_cast<double>(i) * 0.01));
+    }
+    DynVector<T> y(n);
+
+    const auto csr_spmv = dk::bench::measure([&] {
+        multiply_into(csr, x, y);
+        dk::bench::do_not_optimize(y);
+    });
+    reporter.add({ "sparse/spmv_csr" + suffix, csr_spmv, {}, rows, bytes, flops });
+
+    const auto csr_parallel = dk::bench::measure([&] {
+        multiply_into(execution::par, csr, x, y);
+        dk::bench::do_not_optimize(y);
+    });
+    reporter.add(
+        { "sparse/spmv_csr_parallel" + suffix, csr_parallel, { { "speedup", csr_spmv.ns_per_op() / csr_parallel.ns_per_op() } }, rows,
+          bytes, flops }
+    );
+
+    const auto csc_spmv = dk::bench::measure([&] {
+        multiply_into(csc, x, y);
+        dk::bench::do_not_optimize(y);
+    });
+    reporter.add({ "sparse/spmv_csc" + suffix, csc_spmv, {}, rows, bytes, flops });
+
+    const auto csr_transposed = dk::bench::measure([&] {
+        multiply_into(transposed(csr), x, y);
+        dk::bench::do_not_optimize(y);
+    });
+    reporter.add({ "sparse/spmv_transposed_csr" + suffix, csr_transposed, {}, rows, bytes, flops });
+
+    const auto csc_transposed = dk::bench::measure([&] {
+        multiply_into(execution::par, transposed(csc), x, y);
+        dk::bench::do_not_optimize(y);
+    });
+    reporter.add({ "sparse/spmv_transposed_csc_parallel" + suffix, csc_transposed, {}, rows, bytes, flops });
+
+    // Vertex positions, SpMM against one SpMV per coordinate.
+    DynMatrix<T> positions(n, 3);
+    for (std::size_t i = 0; i < n * 3; ++i) {
+        positions[i] = static_cast<T>(std::cos(static_cast<double>(i) * 0.01));
+    }
+    DynMatrix<T> result(n, 3);
+    std::vector<DynVector<T>> coordinates(3, DynVector<T>(n));
+    std::vector<DynVector<T>> products(3, DynVector<T>(n));
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            coordinates[j][i] = positions[i, j];
+        }
+    }
+    const double spmm_bytes = nonzeros * (sizeof(T) + sizeof(sparse::index_type)) + rows * (6 * sizeof(T) + sizeof(std::size_t));
+
+    const auto per_coordinate = dk::bench::measure([&] {
+        for (std::size_t j = 0; j < 3; ++j) {
+            multiply_into(csr, coordinates[j], products[j]);
+        }
+        dk::bench::do_not_optimize(products);
+    });
+    reporter.add({ "sparse/spmv_x3" + suffix, per_coordinate, {}, rows, 3 * bytes, 3 * flops });
+
+    const auto spmm = dk::bench::measure([&] {
+        multiply_into(csr, view(positions), view(result));
+        dk::bench::do_not_optimize(result);
+    });
+    reporter.add(
+        { "sparse/spmm_csr_n3" + suffix, spmm, { { "speedup", per_coordinate.ns_per_op() / spmm.ns_per_op() } }, rows, spmm_bytes,
+          3 * flops }
+    );
+
+    const auto spmm_parallel = dk::bench::measure([&] {
+        multiply_into(execution::par, csr, view(positions), view(result));
+        dk::bench::do_not_optimize(result);
+    });
+    reporter.add(
+        { "sparse/spmm_csr_n3_parallel" + suffix, spmm_parallel, { { "speedup", spmm.ns_per_op() / spmm_parallel.ns_per_op() } }, rows,
+          spmm_bytes, 3 * flops }
+    );
+}
+
+} // namespace
+
+DK_BENCHMARK("sparse/float") {
+    bench_sparse<float>(reporter, "float");
+}
+
+DK_BENCHMARK("sparse/double") {
+    bench_sparse<double>(reporter, "double");
+}
@@ -0,0 +1,72 @@
+/// @file bench_strassen.cpp
+///
+/// Compares Strassen-Winograd with the blocked GEMM for several crossover
+/// sizes and reports the maximal absolute error against the blocked result.
+/// GFLOP/s count the `2n^3` operations of the classic product, so they are
+/// comparable between the two algorithms.
+
+#include <dklib/math/gemm.hpp>
+#include <dklib/math/strassen.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+void bench_size(dk::bench::Reporter &reporter, std::size_t n) {
+    std::vector<double> a(n * n);
+    std::vector<double> b(n * n);
+    for (std::size_t i = 0; i < n * n; ++i) {
+        a[i] = std::sin(static_cast<double>(i));
+        b[i] = std::cos(static_cast<double>(i) * 0.5);
+    }
+    std::vector<double> classic(n * n);
+    std::vector<double> c(n * n);
+
+    const double flops = 2.0 * n * n * n;
+    const double bytes = 3.0 * n * n * sizeof(double);
+    const auto suffix = "<double, " + std::to_string(n) + ">";
+
+    const auto blocked = dk::bench::measure([&] {
+        gemm::multiply<double>(n, n, n, { a.data(), n, 1 }, { b.data(), n, 1 }, classic.data(), n);
+        dk::bench::do_not_optimize(classic.data());
+    });
+    reporter.add({ "strassen/blocked" + suffix, blocked, {}, 1.0, bytes, flops });
+
+    for (std::size_t crossover : { 64u, 128u, 256u }) {
+        if (crossover >= n) {
+            continue;
+        }
+        std::vector<double> scratch(strassen::scratch_size(n, crossover));
+        const auto measurement = dk::bench::measure([&] {
+            strassen::multiply<double>(n, a.data(), n, b.data(), n, c.data(), n, scratch, crossover);
+            dk::bench::do_not_optimize(c.data());
+        });
+        double max_error = 0.0;
+        for (std::size_t i = 0; i < c.size(); ++i) {
+            max_error = std::max(max_error, std::fabs(c[i] - classic[i]));
+        }
+        reporter.add(
+            { "strassen/crossover=" + std::to_string(crossover) + suffix,
+              measurement,
+              { { "max abs error", max_error } },
+              1.0,
+              bytes,
+              flops }
+        );
+    }
+}
+
+} // namespace
+
+DK_BENCHMARK("strassen") {
+    for (std::size_t n : { 256u, 512u, 1024u }) {
+        bench_size(reporter, n);
+    }
+}
@@ -0,0 +1,115 @@
+/// @file bench_structured.cpp
+///
+/// Products and inverses of the structured matrices of
+/// `structured_matrix.hpp` next to the same operation on their dense form:
+/// diagonal times dense is a row scaling instead of a GEMM, affine
+/// compositions skip the known last row and rotations invert by a transpose.
+/// Transformations are measured in batches of `batch_size`.
+
+#include <dklib/math/decomposition.hpp>
+#include <dklib/math/structured_matrix.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+template <typename T, std::size_t N>
+void bench_diagonal(dk::bench::Reporter &reporter, const std::string &type) {
+    Vector<T, N> values;
+    for (std::size_t i = 0; i < N; ++i) {
+        values[i] = static_cast<T>(i % 5 + 1);
+    }
+    const DiagonalMatrix<T, N> diagonal { values };
+    const auto dense = std::make_unique<Matrix<T, N, N>>(diagonal.to_dense());
+    const auto rhs = std::make_unique<Matrix<T, N, N>>(T(0.5));
+    auto result = std::make_unique<Matrix<T, N, N>>();
+
+    const auto suffix = "<" + type + ", " + std::to_string(N) + ">";
+    const double bytes = 2.0 * N * N * sizeof(T);
+
+    const auto dense_product = dk::bench::measure([&] {
+        *result = *dense * *rhs;
+        dk::bench::do_not_optimize(*result);
+    });
+    reporter.add({ "structured/diagonal_dense" + suffix, dense_product, {}, 1.0, bytes });
+
+    const auto scaled = dk::bench::measure([&] {
+        *result = diagonal * *rhs;
+        dk::bench::do_not_optimize(*result);
+    });
+    reporter.add({ "structured/diagonal" + suffix, scaled, {}, 1.0, bytes });
+}
+
+constexpr std::size_t batch_size = 1024;
+
+/// Runs `op` on every element of `inputs` and stores its `Result`s.
+template <typename Result, typename Input, typename Op>
+void run_batch(dk::bench::Reporter &reporter, const std::string &name, const std::vector<Input> &inputs, Op op) {
+    std::vector<Result> results(inputs.size());
+    const auto measurement = dk::bench::measure([&] {
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            results[i] = op(inputs[i]);
+        }
+        dk::bench::do_not_optimize(results);
+    });
+    reporter.add({ name, measurement, {}, static_cast<double>(inputs.size()) });
+}
+
+template <typename T>
+void bench_transforms(dk::bench::Reporter &reporter, const std::string &type) {
+    std::vector<RotationMatrix3<T>> rotations;
+    std::vector<AffineMatrix4<T>> transforms;
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        const auto rotation = RotationMatrix3<T>::about(Vector<T, 3> { { T(1), T(2), static_cast<T>(i % 3) } }, Angle { 0.01 * i });
+        rotations.push_back(rotation);
+        transforms.emplace_back(rotation, Vector<T, 3> { { T(3), T(-2), static_cast<T>(i % 7) } });
+    }
+    std::vector<Matrix4<T>> dense_transforms;
+    std::vector<Matrix<T, 3, 3>> dense_rotations;
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        dense_transforms.push_back(transforms[i].to_dense());
+        dense_rotations.push_back(rotations[i].to_dense());
+    }
+    const auto &view = transforms.front();
+    const auto &dense_view = dense_transforms.front();
+    const auto suffix = "<" + type + ">";
+
+    run_batch<Matrix<T, 4, 4>>(reporter, "structured/affine_product_dense" + suffix, dense_transforms, [&](const Matrix4<T> &mat) {
+        return dense_view * mat;
+    });
+    run_batch<AffineMatrix4<T>>(reporter, "structured/affine_product" + suffix, transforms, [&](const AffineMatrix4<T> &mat) {
+        return view * mat;
+    });
+    run_batch<Matrix4<T>>(reporter, "structured/affine_inverse_dense" + suffix, dense_transforms, [](const Matrix4<T> &mat) {
+        return mat.inverse();
+    });
+    run_batch<AffineMatrix4<T>>(reporter, "structured/affine_inverse" + suffix, transforms, [](const AffineMatrix4<T> &mat) {
+        return mat.inverse();
+    });
+    run_batch<Matrix<T, 3, 3>>(reporter, "structured/rotation_inverse_dense" + suffix, dense_rotations, [](const Matrix<T, 3, 3> &mat) {
+        return inverse(mat);
+    });
+    run_batch<RotationMatrix3<T>>(reporter, "structured/rotation_inverse" + suffix, rotations, [](const RotationMatrix3<T> &mat) {
+        return mat.inverse();
+    });
+}
+
+} // namespace
+
+DK_BENCHMARK("structured/float") {
+    bench_diagonal<float, 4>(reporter, "float");
+    bench_diagonal<float, 64>(reporter, "float");
+    bench_transforms<float>(reporter, "float");
+}
+
+DK_BENCHMARK("structured/double") {
+    bench_diagonal<double, 4>(reporter, "double");
+    bench_diagonal<double, 64>(reporter, "double");
+    bench_transforms<double>(reporter, "double");
+}
@@ -0,0 +1,76 @@
+/// @file bench_transform.cpp
+///
+/// Throughput of the batched `Matrix4<float>` transforms in millions of
+/// vertices per second, compared with calling `operator*` per vertex.
+
+#include <dklib/math/transform.hpp>
+
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+void bench_vertices(dk::bench::Reporter &reporter, std::size_t count) {
+    const auto suffix = "/" + std::to_string(count);
+    auto rate = [count](const dk::bench::Measurement &m) {
+        return std::map<std::string, double> { { "Mvertices/s", 1e3 * static_cast<double>(count) / m.ns_per_op() } };
+    };
+    // A 4x4 matrix-vector product is 16 multiplies and 12 adds, points skip
+    // the multiplies by w = 1.
+    const double vertices = static_cast<double>(count);
+    // Every vertex is read and written back in place.
+    const double bytes4 = 2.0 * sizeof(Vector4D) * vertices;
+    const double bytes3 = 2.0 * sizeof(Vector3D) * vertices;
+
+    const Matrix4<float> matrix {
+        { 0.5f, -1.0f, 2.0f, 3.0f },
+        { 1.5f, 0.25f, -0.5f, -2.0f },
+        { -1.0f, 2.0f, 0.75f, 1.0f },
+        { 0.0f, 0.5f, 0.25f, 1.0f },
+    };
+    std::vector<Vector4D> vertices4(count);
+    std::vector<Vector3D> vertices3(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<float>(i % 1000);
+        vertices4[i] = { v, 1.0f - v, 0.5f * v, 1.0f };
+        vertices3[i] = { v, 1.0f - v, 0.5f * v };
+    }
+    Vector3Stream stream { std::span<const Vector3D>(vertices3) };
+
+    const auto single = dk::bench::measure([&] {
+        for (auto &vertex : vertices4) {
+            vertex = matrix * vertex;
+        }
+        dk::bench::do_not_optimize(vertices4);
+    });
+    reporter.add({ "transform/operator*" + suffix, single, rate(single), vertices, bytes4, 28 * vertices, bytes4 / 2 });
+
+    const auto batched4 = dk::bench::measure([&] {
+        batch::transform(matrix, vertices4, vertices4);
+        dk::bench::do_not_optimize(vertices4);
+    });
+    reporter.add({ "transform/vector4" + suffix, batched4, rate(batched4), vertices, bytes4, 28 * vertices, bytes4 / 2 });
+
+    const auto points = dk::bench::measure([&] {
+        batch::transform_points(matrix, vertices3, vertices3);
+        dk::bench::do_not_optimize(vertices3);
+    });
+    reporter.add({ "transform/points" + suffix, points, rate(points), vertices, bytes3, 18 * vertices, bytes3 / 2 });
+
+    const auto lanes = dk::bench::measure([&] {
+        batch::transform_points(matrix, stream, stream);
+        dk::bench::do_not_optimize(stream);
+    });
+    reporter.add({ "transform/points_soa" + suffix, lanes, rate(lanes), vertices, bytes3, 18 * vertices, bytes3 / 2 });
+}
+
+} // namespace
+
+DK_BENCHMARK("transform") {
+    bench_vertices(reporter, 4096);
+    bench_vertices(reporter, 1 << 20);
+}
@@ -0,0 +1,75 @@
+/// @file bench_transpose.cpp
+///
+/// Compares the naive transpose loop with the cache-oblivious kernels of
+/// `transpose.hpp`, out of place as `transpose()` runs it and in place
+/// through `transpose_inplace()`. The largest sizes do not fit in L2, which
+/// is where the strided side of the naive loop misses on every access.
+///
+/// The out of place kernel writes into heap storage directly, a 2048 x 2048
+/// result returned by value would not fit on the stack.
+
+#include <dklib/math/matrix.hpp>
+
+#include <memory>
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace dk::math;
+
+namespace {
+
+/// The loop `transpose()` used before the blocked kernel.
+template <typename T, std::size_t N>
+void reference_transpose(const Matrix<T, N, N> &mat, Matrix<T, N, N> &result) {
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            result[i, j] = mat[j, i];
+        }
+    }
+}
+
+template <typename T, std::size_t N>
+void bench_transpose(dk::bench::Reporter &reporter, const std::string &type) {
+    auto mat = std::make_unique<Matrix<T, N, N>>();
+    auto result = std::make_unique<Matrix<T, N, N>>();
+    for (std::size_t i = 0; i < N * N; ++i) {
+        (*mat)[i] = static_cast<T>(i % 11);
+    }
+
+    // Every element is read and written once.
+    const double bytes = 2.0 * N * N * sizeof(T);
+    const auto suffix = "<" + type + ", " + std::to_string(N) + ">";
+
+    const auto naive = dk::bench::measure([&] {
+        reference_transpose(*mat, *result);
+        dk::bench::do_not_optimize(*result);
+    });
+    reporter.add({ "transpose/naive" + suffix, naive, {}, 1.0, bytes });
+
+    const auto blocked = dk::bench::measure([&] {
+        transposition::transpose_into(mat->data(), N, N, N, result->data(), N);
+        dk::bench::do_not_optimize(*result);
+    });
+    reporter.add({ "transpose/blocked" + suffix, blocked, {}, 1.0, bytes });
+
+    const auto inplace = dk::bench::measure([&] {
+        mat->transpose_inplace();
+        dk::bench::do_not_optimize(*mat);
+    });
+    reporter.add({ "transpose/inplace" + suffix, inplace, {}, 1.0, bytes });
+}
+
+} // namespace
+
+DK_BENCHMARK("transpose/float") {
+    bench_transpose<float, 64>(reporter, "float");
+    bench_transpose<float, 512>(reporter, "float");
+    bench_transpose<float, 2048>(reporter, "float");
+}
+
+DK_BENCHMARK("transpose/double") {
+    bench_transpose<double, 64>(reporter, "double");
+    bench_transpose<double, 512>(reporter, "double");
+    bench_transpose<double, 2048>(reporter, "double");
+}
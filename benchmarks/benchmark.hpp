@@ -0,0 +1,167 @@
+#ifndef DK_MATH_BENCHMARK_HPP
+#define DK_MATH_BENCHMARK_HPP
+
+/// @file benchmark.hpp
+///
+/// Minimal harness for the `bench_dklib` executable. Benchmarks register
+/// themselves with `DK_BENCHMARK` and report their measurements to a shared
+/// `Reporter`, which prints them once all benchmarks have finished, either as
+/// a table or as JSON for tracking regressions between releases.
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "perf_counters.hpp"
+
+namespace dk::bench {
+
+/// Counters read around every measured batch, null unless `bench_dklib` was
+/// started with `--perf` and the counters are available.
+inline PerfCounters *&active_perf_counters() {
+    static PerfCounters *counters = nullptr;
+    return counters;
+}
+
+/// Prevents the compiler from optimizing away a computed value.
+///
+/// Only the address escapes, passing the value itself may copy large tensors
+/// to the stack.
+template <typename T>
+inline void do_not_optimize(const T &value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+struct Measurement {
+    std::size_t iterations = 0;
+    double seconds = 0.0;
+    /// Hardware event totals of the reported batch.
+    PerfSample events;
+
+    [[nodiscard]] double ns_per_op() const noexcept {
+        return iterations == 0 ? 0.0 : seconds * 1e9 / static_cast<double>(iterations);
+    }
+};
+
+/// @brief Runs `kernel` repeatedly until it took at least `min_seconds`.
+///
+/// The iteration count is doubled after every batch, so the timer overhead is
+/// negligible for the final batch which is the one that is reported.
+template <typename F>
+Measurement measure(F &&kernel, double min_seconds = 0.2) {
+    using clock = std::chrono::steady_clock;
+    kernel();
+    for (std::size_t iterations = 1;; iterations *= 2) {
+        auto *counters = active_perf_counters();
+        if (counters != nullptr) {
+            counters->start();
+        }
+        const auto start = clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            kernel();
+        }
+        const std::chrono::duration<double> elapsed = clock::now() - start;
+        const PerfSample events = counters != nullptr ? counters->stop() : PerfSample {};
+        if (elapsed.count() >= min_seconds) {
+            return { iterations, elapsed.count(), events };
+        }
+    }
+}
+
+struct Result {
+    std::string name;
+    Measurement measurement;
+    /// Derived metrics, e.g. `GFLOP/s`, keyed by their display name.
+    std::map<std::string, double> counters;
+    /// Operations performed by a single kernel call, e.g. the number of
+    /// vectors a batched kernel processes.
+    double items = 1.0;
+    /// Bytes read and written by a single kernel call, zero when unknown.
+    double bytes = 0.0;
+    /// Floating point operations of a single kernel call, zero when unknown.
+    double flops = 0.0;
+    /// Distinct bytes a single kernel call touches when it differs from
+    /// `bytes`, e.g. for updates in place, zero otherwise.
+    double working_set = 0.0;
+    /// `memory` or `compute` once the result was placed on a roofline.
+    std::string bound;
+
+    [[nodiscard]] double ops_per_second() const noexcept {
+        return measurement.seconds == 0.0 ? 0.0 : items * static_cast<double>(measurement.iterations) / measurement.seconds;
+    }
+
+    [[nodiscard]] double bytes_per_second() const noexcept {
+        return measurement.seconds == 0.0 ? 0.0 : bytes * static_cast<double>(measurement.iterations) / measurement.seconds;
+    }
+
+    [[nodiscard]] double flops_per_second() const noexcept {
+        return measurement.seconds == 0.0 ? 0.0 : flops * static_cast<double>(measurement.iterations) / measurement.seconds;
+    }
+};
+
+class Reporter {
+public:
+    /// @brief Stores `result`, adding GFLOP/s to its counters when it declares
+    /// its FLOP count and IPC and per item event counts when hardware events
+    /// were recorded.
+    void add(Result result) {
+        if (result.flops > 0.0) {
+            result.counters["GFLOP/s"] = result.flops_per_second() * 1e-9;
+        }
+        const auto &events = result.measurement.events;
+        const double items = result.items * static_cast<double>(result.measurement.iterations);
+        if (events[PerfEvent::cycles] and events[PerfEvent::instructions] and *events[PerfEvent::cycles] > 0.0) {
+            result.counters["IPC"] = *events[PerfEvent::instructions] / *events[PerfEvent::cycles];
+        }
+        for (const auto event : { PerfEvent::cycles, PerfEvent::l1d_misses, PerfEvent::llc_misses, PerfEvent::branch_misses }) {
+            if (events[event] and items > 0.0) {
+                result.counters[std::string(to_string(event)) + "/item"] = *events[event] / items;
+            }
+        }
+        results_.push_back(std::move(result));
+    }
+
+    [[nodiscard]] const std::vector<Result> &results() const noexcept {
+        return results_;
+    }
+
+    [[nodiscard]] std::vector<Result> &results() noexcept { return results_; }
+
+private:
+    std::vector<Result> results_;
+};
+
+struct Benchmark {
+    std::string name;
+    std::function<void(Reporter &)> run;
+};
+
+inline std::vector<Benchmark> &registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct Registration {
+    Registration(std::string name, std::function<void(Reporter &)> run) {
+        registry().push_back({ std::move(name), std::move(run) });
+    }
+};
+
+} // namespace dk::bench
+
+#define DK_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define DK_BENCHMARK_CONCAT(a, b) DK_BENCHMARK_CONCAT_IMPL(a, b)
+
+/// Defines and registers a benchmark function taking `Reporter &reporter`.
+#define DK_BENCHMARK(name)                                                                    \
+    static void DK_BENCHMARK_CONCAT(dk_benchmark_, __LINE__)(::dk::bench::Reporter &);        \
+    static const ::dk::bench::Registration DK_BENCHMARK_CONCAT(dk_registration_, __LINE__) { \
+        name, DK_BENCHMARK_CONCAT(dk_benchmark_, __LINE__)                                    \
+    };                                                                                        \
+    static void DK_BENCHMARK_CONCAT(dk_benchmark_, __LINE__)([[maybe_unused]] ::dk::bench::Reporter & reporter)
+
+#endif // DK_MATH_BENCHMARK_HPP
@@ -0,0 +1,152 @@
+#ifndef DK_MATH_PERF_COUNTERS_HPP
+#define DK_MATH_PERF_COUNTERS_HPP
+
+/// @file perf_counters.hpp
+///
+/// Hardware performance counters read through `perf_event_open`. Every event
+/// is opened on its own, so a machine which lacks e.g. LLC events still
+/// reports the remaining ones. Without kernel support, in most containers or
+/// with a strict `perf_event_paranoid`, no event opens and the harness reports
+/// timings only.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define DK_BENCH_HAS_PERF_EVENTS 1
+#else
+#define DK_BENCH_HAS_PERF_EVENTS 0
+#endif
+
+namespace dk::bench {
+
+enum class PerfEvent {
+    cycles = 0,
+    instructions,
+    l1d_misses,
+    llc_misses,
+    branch_misses,
+};
+
+inline constexpr std::size_t perf_event_count = 5;
+
+[[nodiscard]] constexpr std::string_view to_string(PerfEvent event) noexcept {
+    switch (event) {
+    case PerfEvent::cycles: return "cycles";
+    case PerfEvent::instructions: return "instructions";
+    case PerfEvent::l1d_misses: return "L1D-misses";
+    case PerfEvent::llc_misses: return "LLC-misses";
+    default: return "branch-misses";
+    }
+}
+
+/// Event totals of one measured batch, events which could not be opened are
+/// empty.
+struct PerfSample {
+    std::array<std::optional<double>, perf_event_count> values;
+
+    [[nodiscard]] const std::optional<double> &operator[](PerfEvent event) const noexcept {
+        return values[static_cast<std::size_t>(event)];
+    }
+};
+
+class PerfCounters {
+public:
+    PerfCounters() {
+#if DK_BENCH_HAS_PERF_EVENTS
+        constexpr auto cache_miss = [](std::uint64_t cache) {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        };
+        const std::array<std::pair<std::uint32_t, std::uint64_t>, perf_event_count> events { {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D) },
+            { PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL) },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        } };
+        for (std::size_t i = 0; i < perf_event_count; ++i) {
+            perf_event_attr attr {};
+            attr.size = sizeof(attr);
+            attr.type = events[i].first;
+            attr.config = events[i].second;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    ~PerfCounters() {
+#if DK_BENCH_HAS_PERF_EVENTS
+        for (const int fd : fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    /// @brief Returns true if at least one event could be opened.
+    [[nodiscard]] bool available() const noexcept {
+        for (const int fd : fds_) {
+            if (fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Resets and starts every opened event.
+    void start() noexcept {
+#if DK_BENCH_HAS_PERF_EVENTS
+        for (const int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /// @brief Stops every opened event and returns the totals since `start`,
+    /// scaled up when the kernel had to multiplex the events.
+    PerfSample stop() noexcept {
+        PerfSample sample;
+#if DK_BENCH_HAS_PERF_EVENTS
+        for (const int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (std::size_t i = 0; i < perf_event_count; ++i) {
+            // value, time enabled, time running
+            std::uint64_t data[3] {};
+            if (fds_[i] < 0 or read(fds_[i], data, sizeof(data)) != sizeof(data) or data[2] == 0) {
+                continue;
+            }
+            sample.values[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        }
+#endif
+        return sample;
+    }
+
+private:
+    std::array<int, perf_event_count> fds_ { -1, -1, -1, -1, -1 };
+};
+
+} // namespace dk::bench
+
+#endif // DK_MATH_PERF_COUNTERS_HPP
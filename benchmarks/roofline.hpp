@@ -0,0 +1,244 @@
+#ifndef DK_MATH_ROOFLINE_HPP
+#define DK_MATH_ROOFLINE_HPP
+
+/// @file roofline.hpp
+///
+/// Measured machine peaks for placing benchmarks on a roofline. A kernel with
+/// arithmetic intensity `I` (FLOP per byte) can at best reach
+///
+///     min(peak GFLOP/s, I * peak GB/s),
+///
+/// kernels left of the ridge point `peak GFLOP/s / peak GB/s` are memory
+/// bound, the others compute bound. Both peaks are measured on one core, as
+/// are all benchmarks except `parallel/*`, and the compute peak is the single
+/// precision one, double precision kernels top out at about half of it.
+///
+/// The bandwidth is measured once per cache level and once for the main
+/// memory, every level on a footprint of four times the level above. The
+/// repeated calls of a small benchmark run from the caches and would exceed
+/// the main memory roof many times over, so a benchmark is placed against
+/// the level with the largest footprint its working set reaches. A working
+/// set between two levels still hits the faster one in part and is placed
+/// against that one, the roof stays an upper bound.
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include <dklib/math/aligned_allocator.hpp>
+
+#include "benchmark.hpp"
+
+namespace dk::bench {
+
+/// Bandwidth of one level of the memory hierarchy.
+struct MemoryRoof {
+    std::string level;
+    /// Bytes the bandwidth was measured on.
+    std::size_t footprint = 0;
+    double gbytes_per_second = 0.0;
+};
+
+struct MachinePeak {
+    double gflops = 0.0;
+    /// Ordered by footprint, the main memory last.
+    std::vector<MemoryRoof> memory;
+
+    /// @brief Returns the level a kernel touching `working_set` bytes is
+    /// placed against, see the file comment.
+    [[nodiscard]] const MemoryRoof &roof(double working_set) const noexcept {
+        const auto *result = &memory.front();
+        for (const auto &level : memory) {
+            if (working_set >= static_cast<double>(level.footprint)) {
+                result = &level;
+            }
+        }
+        return *result;
+    }
+
+    /// @brief Returns the intensity in FLOP per byte above which kernels
+    /// streaming from `roof` are compute bound.
+    [[nodiscard]] double ridge(const MemoryRoof &roof) const noexcept { return gflops / roof.gbytes_per_second; }
+
+    /// @brief Returns the best GFLOP/s a kernel of `intensity` streaming from
+    /// `roof` can reach.
+    [[nodiscard]] double attainable_gflops(double intensity, const MemoryRoof &roof) const noexcept {
+        return std::min(gflops, intensity * roof.gbytes_per_second);
+    }
+};
+
+namespace detail {
+
+/// Native vector width of the benchmark build, which uses `-march=native`.
+#if defined(__AVX512F__)
+inline constexpr std::size_t peak_vector_bytes = 64;
+#elif defined(__AVX__)
+inline constexpr std::size_t peak_vector_bytes = 32;
+#else
+inline constexpr std::size_t peak_vector_bytes = 16;
+#endif
+
+/// Independent multiply-add chains, enough to hide the FMA latency on two
+/// ports while leaving registers for the two operands.
+inline constexpr std::size_t peak_chains = 12;
+inline constexpr std::size_t peak_steps = 4096;
+
+/// Every peak is the best of this many measurements, like STREAM reports the
+/// best of its repetitions: a roof is an upper bound.
+inline constexpr int peak_repetitions = 5;
+
+/// Cache sizes assumed where the system does not report them.
+inline constexpr std::size_t fallback_cache_sizes[] = { std::size_t { 32 } << 10, std::size_t { 1 } << 20, std::size_t { 32 } << 20 };
+
+/// Smallest footprint of the main memory probe.
+inline constexpr std::size_t min_stream_bytes = std::size_t { 192 } << 20;
+
+/// @brief Returns the shortest time per call of `kernel` in nanoseconds.
+template <typename F>
+double best_ns_per_op(F &&kernel) {
+    double best = measure(kernel, 0.05).ns_per_op();
+    for (int i = 1; i < peak_repetitions; ++i) {
+        best = std::min(best, measure(kernel, 0.05).ns_per_op());
+    }
+    return best;
+}
+
+/// @brief Measures single precision multiply-add throughput in GFLOP/s.
+///
+/// The chains and operands are locals of the timed kernel so that they stay
+/// in registers, only their sum escapes once the chains are done.
+inline double probe_gflops() {
+    using vector = float __attribute__((vector_size(peak_vector_bytes)));
+    constexpr std::size_t lanes = peak_vector_bytes / sizeof(float);
+    vector scale = vector {} + 0.999f;
+    vector offset = vector {} + 0.001f;
+    do_not_optimize(scale);
+    do_not_optimize(offset);
+    const double ns = best_ns_per_op([&] {
+        const vector s = scale;
+        const vector o = offset;
+        // Distinct start values, identical chains would be merged into one.
+        vector acc[peak_chains];
+        for (std::size_t i = 0; i < peak_chains; ++i) {
+            acc[i] = vector {} + (1.0f + static_cast<float>(i) / peak_chains);
+        }
+        for (std::size_t step = 0; step < peak_steps; ++step) {
+            for (auto &chain : acc) {
+                chain = chain * s + o;
+            }
+        }
+        vector sum {};
+        for (const auto &chain : acc) {
+            sum += chain;
+        }
+        do_not_optimize(sum);
+    });
+    return 2.0 * lanes * peak_chains * peak_steps / ns;
+}
+
+/// @brief Measures the bandwidth in GB/s on arrays of `bytes` in total, the
+/// better one of the STREAM triad and of updating the arrays in place. The
+/// triad stores to a third array and pays for reading it into the cache
+/// first, which kernels updating their data in place do not.
+inline double probe_gbytes_per_second(std::size_t bytes) {
+    const std::size_t size = std::max<std::size_t>(bytes / (3 * sizeof(double)), 64);
+    // Aligned to cache lines, unaligned vectors split lines on every access.
+    using buffer = std::vector<double, math::AlignedAllocator<double>>;
+    buffer a(size, 1.0);
+    buffer b(size, 2.0);
+    buffer c(size, 3.0);
+    const double triad = best_ns_per_op([&] {
+#pragma omp simd
+        for (std::size_t i = 0; i < size; ++i) {
+            a[i] = b[i] + 0.5 * c[i];
+        }
+        do_not_optimize(a);
+    });
+    const double update = best_ns_per_op([&] {
+        for (auto *array : { &a, &b, &c }) {
+            double *data = array->data();
+#pragma omp simd
+            for (std::size_t i = 0; i < size; ++i) {
+                data[i] = 0.5 * data[i] + 1.0;
+            }
+        }
+        do_not_optimize(a);
+        do_not_optimize(b);
+        do_not_optimize(c);
+    });
+    // Two loads and a store per element of the triad, a load and a store per
+    // element of every array for the update.
+    const double triad_bytes = 3.0 * sizeof(double) * size;
+    const double update_bytes = 2.0 * sizeof(double) * 3 * size;
+    return std::max(triad_bytes / triad, update_bytes / update);
+}
+
+/// @brief Returns the data cache sizes of the current core from the first
+/// level on, zero where unknown.
+inline std::vector<std::size_t> cache_sizes() {
+    std::vector<std::size_t> sizes(std::size(fallback_cache_sizes), 0);
+#if defined(__linux__) && defined(_SC_LEVEL1_DCACHE_SIZE)
+    const long reported[] = { sysconf(_SC_LEVEL1_DCACHE_SIZE), sysconf(_SC_LEVEL2_CACHE_SIZE), sysconf(_SC_LEVEL3_CACHE_SIZE) };
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        sizes[i] = reported[i] > 0 ? static_cast<std::size_t>(reported[i]) : 0;
+    }
+#endif
+    return sizes;
+}
+
+/// @brief Measures the bandwidth of every cache level and of the main memory.
+///
+/// Every level is probed on four times the size of the level above, at most
+/// half of its own: the last level is often shared and much smaller per
+/// core than reported.
+inline std::vector<MemoryRoof> probe_memory() {
+    std::vector<MemoryRoof> roofs;
+    auto sizes = cache_sizes();
+    if (std::ranges::all_of(sizes, [](std::size_t size) { return size == 0; })) {
+        sizes.assign(std::begin(fallback_cache_sizes), std::end(fallback_cache_sizes));
+    }
+    std::size_t last = 0;
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] <= last) {
+            continue;
+        }
+        const std::size_t footprint = last == 0 ? sizes[i] / 2 : std::min(4 * last, sizes[i] / 2);
+        last = sizes[i];
+        roofs.push_back({ "L" + std::to_string(i + 1), footprint, probe_gbytes_per_second(footprint) });
+    }
+    const std::size_t footprint = std::max(4 * last, min_stream_bytes);
+    roofs.push_back({ "DRAM", footprint, probe_gbytes_per_second(footprint) });
+    return roofs;
+}
+
+} // namespace detail
+
+/// @brief Measures the compute and memory peaks of the current core.
+inline MachinePeak measure_machine_peak() {
+    return { detail::probe_gflops(), detail::probe_memory() };
+}
+
+/// @brief Places `result` on the roofline of `peak` if it declares both its
+/// FLOP and byte counts.
+inline void annotate_roofline(Result &result, const MachinePeak &peak) {
+    if (result.flops <= 0.0 or result.bytes <= 0.0) {
+        return;
+    }
+    const auto &roof = peak.roof(result.working_set > 0.0 ? result.working_set : result.bytes);
+    const double intensity = result.flops / result.bytes;
+    const double achieved = result.flops_per_second() * 1e-9;
+    result.counters["FLOP/byte"] = intensity;
+    result.counters["roof GB/s"] = roof.gbytes_per_second;
+    result.counters["roofline %"] = 100.0 * achieved / peak.attainable_gflops(intensity, roof);
+    result.bound = intensity < peak.ridge(roof) ? "memory" : "compute";
+}
+
+} // namespace dk::bench
+
+#endif // DK_MATH_ROOFLINE_HPP
@@ -0,0 +1,110 @@
+#ifndef DK_MATH_ALIGNED_ALLOCATOR_HPP
+#define DK_MATH_ALIGNED_ALLOCATOR_HPP
+
+/// @file aligned_allocator.hpp
+///
+/// Standard allocators returning storage aligned to a cache line, so that
+/// containers of scalars can be streamed with aligned vector loads.
+/// `AlignedAllocator` always uses the global aligned `operator new`,
+/// `ResourceAllocator` draws from a `std::pmr::memory_resource`, which lets
+/// the dynamic types live in an `Arena` (see `workspace.hpp`).
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+namespace dk::math {
+
+/// Alignment of heap allocated lanes, one cache line, which also covers the
+/// widest vector registers (AVX-512).
+inline constexpr std::size_t cache_line_size = 64;
+
+template <typename T, std::size_t Alignment = cache_line_size>
+requires(Alignment >= alignof(T) and (Alignment & (Alignment - 1)) == 0)
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    static constexpr std::size_t alignment = Alignment;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept { }
+
+    [[nodiscard]] T *allocate(std::size_t count) {
+        if (count > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t { Alignment }));
+    }
+
+    void deallocate(T *pointer, std::size_t) noexcept {
+        ::operator delete(pointer, std::align_val_t { Alignment });
+    }
+
+    template <typename U>
+    friend constexpr bool operator==(const AlignedAllocator &, const AlignedAllocator<U, Alignment> &) noexcept {
+        return true;
+    }
+};
+
+/// Cache line aligned allocator over a `std::pmr::memory_resource`.
+///
+/// Like `std::pmr::polymorphic_allocator` it is implicitly constructible from
+/// a resource pointer and copies of a container go back to the default
+/// resource, so a copy never outlives the arena of its source. Moves keep
+/// the resource, which keeps move assignment a pointer swap.
+template <typename T>
+class ResourceAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    static constexpr std::size_t alignment = std::max(cache_line_size, alignof(T));
+
+    ResourceAllocator() noexcept
+        : resource_ { std::pmr::get_default_resource() } { }
+
+    ResourceAllocator(std::pmr::memory_resource *resource) noexcept
+        : resource_ { resource } { }
+
+    template <typename U>
+    ResourceAllocator(const ResourceAllocator<U> &other) noexcept
+        : resource_ { other.resource() } { }
+
+    [[nodiscard]] T *allocate(std::size_t count) {
+        if (count > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T *>(resource_->allocate(count * sizeof(T), alignment));
+    }
+
+    void deallocate(T *pointer, std::size_t count) noexcept {
+        resource_->deallocate(pointer, count * sizeof(T), alignment);
+    }
+
+    [[nodiscard]] ResourceAllocator select_on_container_copy_construction() const noexcept { return {}; }
+
+    [[nodiscard]] std::pmr::memory_resource *resource() const noexcept { return resource_; }
+
+    template <typename U>
+    friend bool operator==(const ResourceAllocator &lhs, const ResourceAllocator<U> &rhs) noexcept {
+        return *lhs.resource() == *rhs.resource();
+    }
+
+private:
+    std::pmr::memory_resource *resource_;
+};
+
+} // namespace dk::math
+
+#endif // DK_MATH_ALIGNED_ALLOCATOR_HPP
@@ -0,0 +1,47 @@
+#ifndef DK_MATH_BATCH_HPP
+#define DK_MATH_BATCH_HPP
+
+/// @file batch.hpp
+///
+/// Batched variants of the vector and quaternion operations, they work on
+/// whole spans at once and run on the kernels selected by `dispatch.hpp`.
+/// The structure-of-arrays variants are declared in `vector3_soa.hpp`.
+
+#include <cassert>
+#include <span>
+
+#include <dklib/math/dispatch.hpp>
+#include <dklib/math/quaternion.hpp>
+#include <dklib/math/vector3_soa.hpp>
+#include <dklib/math/vector3d.hpp>
+
+namespace dk::math::batch {
+
+// Kernels treat spans of vectors as packed arrays of floats.
+static_assert(sizeof(Vector3D) == 3 * sizeof(float));
+
+/// @brief Computes `out[i] = dot(lhs[i], rhs[i])` for every pair of vectors.
+inline void dot(std::span<const Vector3D> lhs, std::span<const Vector3D> rhs, std::span<float> out) noexcept {
+    assert(lhs.size() == rhs.size() and lhs.size() == out.size());
+    dispatch::kernels().dot3(lhs.size(), reinterpret_cast<const float *>(lhs.data()), reinterpret_cast<const float *>(rhs.data()), out.data());
+}
+
+/// @brief Normalizes every vector of the span in place.
+inline void normalize(std::span<Vector3D> vectors) noexcept {
+    dispatch::kernels().normalize3(vectors.size(), reinterpret_cast<float *>(vectors.data()));
+}
+
+/// @brief Rotates every vector of `in` by the unit quaternion `rotation`.
+///
+/// Unlike `Quaternion::rotate` the rotation is expected to be already in its
+/// unit form, e.g. from `Quaternion::unit_norm`. `in` and `out` may be the
+/// same span.
+inline void rotate(const Quaternion &rotation, std::span<const Vector3D> in, std::span<Vector3D> out) noexcept {
+    assert(in.size() == out.size());
+    const float quat[4] = { rotation.imag.get_x(), rotation.imag.get_y(), rotation.imag.get_z(), rotation.real };
+    dispatch::kernels().rotate3(in.size(), quat, reinterpret_cast<const float *>(in.data()), reinterpret_cast<float *>(out.data()));
+}
+
+} // namespace dk::math::batch
+
+#endif // DK_MATH_BATCH_HPP
@@ -0,0 +1,457 @@
+#ifndef DK_MATH_BATCH_DECOMPOSITION_HPP
+#define DK_MATH_BATCH_DECOMPOSITION_HPP
+
+/// @file batch_decomposition.hpp
+///
+/// Factorizations of many small independent matrices at once.
+///
+/// The kernels work on `MatrixSoA` containers and run one matrix per SIMD
+/// lane. Matrices are processed in tiles of `tile_size`: every step of the
+/// factorization runs over the whole tile before the next one starts, so
+/// the innermost loops are plain loops over the lanes and the tile stays in
+/// L1 between the steps. There is no branching on the data, a matrix that
+/// cannot be factored does not stop the others and ends up with NaN or
+/// infinite elements instead. The formulas are the ones of `cholesky.hpp`
+/// and `qr.hpp`, except that the Cholesky factorization multiplies with the
+/// reciprocal of the diagonal instead of dividing by it, so results may
+/// differ from `Cholesky` and `QR` in the last bits.
+///
+/// The 3x3 singular value, polar and symmetric eigendecompositions run the
+/// kernels of `svd3.hpp` and `eigen3.hpp` on one matrix per lane in a
+/// single loop instead, which keeps the whole decomposition in registers.
+/// `neighborhood_normals` fuses the covariance of point neighborhoods with
+/// their eigendecomposition.
+///
+///     std::vector<Matrix<float, 3, 3>> spd = ...;
+///     MatrixSoA<float, 3, 3> factors(spd);
+///     VectorSoA<float, 3> rhs(factors.size());
+///     batch::cholesky(factors);
+///     batch::cholesky_solve(factors, rhs);
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+#include <dklib/math/eigen3.hpp>
+#include <dklib/math/matrix_soa.hpp>
+#include <dklib/math/svd3.hpp>
+#include <dklib/math/vector3_soa.hpp>
+
+namespace dk::math::batch {
+
+/// Matrices factored together, see the file comment.
+inline constexpr std::size_t tile_size = 64;
+
+/// @brief Overwrites every matrix with the lower triangular factor `L` of
+/// its Cholesky factorization `L * Lᵀ`, only the lower triangles are read.
+/// @return The number of matrices that are not positive definite, their
+///         factors have a NaN on the diagonal.
+template <std::floating_point T, std::size_t N>
+std::size_t cholesky(MatrixSoA<T, N, N> &mats) noexcept {
+    std::size_t failures = 0;
+    T reciprocals[tile_size];
+    for (std::size_t begin = 0; begin < mats.size(); begin += tile_size) {
+        const std::size_t count = std::min(tile_size, mats.size() - begin);
+        for (std::size_t j = 0; j < N; ++j) {
+            T *diagonal = mats.lane(j, j) + begin;
+            for (std::size_t k = 0; k < j; ++k) {
+                const T *l = mats.lane(j, k) + begin;
+#pragma omp simd
+                for (std::size_t p = 0; p < count; ++p) {
+                    diagonal[p] -= l[p] * l[p];
+                }
+            }
+#pragma omp simd
+            for (std::size_t p = 0; p < count; ++p) {
+                const bool positive = diagonal[p] > T {};
+                diagonal[p] = std::sqrt(positive ? diagonal[p] : std::numeric_limits<T>::quiet_NaN());
+                reciprocals[p] = T { 1 } / diagonal[p];
+            }
+            for (std::size_t i = j + 1; i < N; ++i) {
+                T *target = mats.lane(i, j) + begin;
+                for (std::size_t k = 0; k < j; ++k) {
+                    const T *lhs = mats.lane(i, k) + begin;
+                    const T *rhs = mats.lane(j, k) + begin;
+#pragma omp simd
+                    for (std::size_t p = 0; p < count; ++p) {
+                        target[p] -= lhs[p] * rhs[p];
+                    }
+                }
+                T *upper = mats.lane(j, i) + begin;
+#pragma omp simd
+                for (std::size_t p = 0; p < count; ++p) {
+                    target[p] *= reciprocals[p];
+                    upper[p] = T {};
+                }
+            }
+        }
+        // A NaN pivot makes all the following ones NaN.
+        const T *last = mats.lane(N - 1, N - 1) + begin;
+#pragma omp simd reduction(+ : failures)
+        for (std::size_t p = 0; p < count; ++p) {
+            failures += last[p] == last[p] ? 0 : 1;
+        }
+    }
+    return failures;
+}
+
+/// @brief Overwrites every `rhs` with the solution of `mat * x = rhs`, the
+/// matrices being factored by `cholesky`.
+template <std::floating_point T, std::size_t N>
+void cholesky_solve(const MatrixSoA<T, N, N> &factors, VectorSoA<T, N> &rhs) noexcept {
+    assert(factors.size() == rhs.size());
+    for (std::size_t begin = 0; begin < rhs.size(); begin += tile_size) {
+        const std::size_t count = std::min(tile_size, rhs.size() - begin);
+        for (std::size_t i = 0; i < N; ++i) {
+            T *target = rhs.lane(i, 0) + begin;
+            for (std::size_t k = 0; k < i; ++k) {
+                const T *l = factors.lane(i, k) + begin;
+                const T *source = rhs.lane(k, 0) + begin;
+#pragma omp simd
+                for (std::size_t p = 0; p < count; ++p) {
+                    target[p] -= l[p] * source[p];
+                }
+            }
+            const T *diagonal = factors.lane(i, i) + begin;
+#pragma omp simd
+            for (std::size_t p = 0; p < count; ++p) {
+                target[p] /= diagonal[p];
+            }
+        }
+        for (std::size_t i = N; i-- > 0;) {
+            T *target = rhs.lane(i, 0) + begin;
+            for (std::size_t k = i + 1; k < N; ++k) {
+                const T *l = factors.lane(k, i) + begin;
+                const T *source = rhs.lane(k, 0) + begin;
+#pragma omp simd
+                for (std::size_t p = 0; p < count; ++p) {
+                    target[p] -= l[p] * source[p];
+                }
+            }
+            const T *diagonal = factors.lane(i, i) + begin;
+#pragma omp simd
+            for (std::size_t p = 0; p < count; ++p) {
+                target[p] /= diagonal[p];
+            }
+        }
+    }
+}
+
+namespace detail {
+
+    /// Applies reflector `j` of the `R x C` factorizations in `factors` to
+    /// the lanes `target[j]` to `target[R - 1]` of the tile at `begin`.
+    template <typename T, std::size_t R, std::size_t C>
+    void apply_reflectors(
+        const MatrixSoA<T, R, C> &factors, const T *tau, std::size_t j, T *const *target, std::size_t begin, std::size_t count
+    ) noexcept {
+        T sums[tile_size];
+        const T *pivot = target[j];
+#pragma omp simd
+        for (std::size_t p = 0; p < count; ++p) {
+            sums[p] = pivot[p];
+        }
+        for (std::size_t i = j + 1; i < R; ++i) {
+            const T *v = factors.lane(i, j) + begin;
+            const T *row = target[i];
+#pragma omp simd
+            for (std::size_t p = 0; p < count; ++p) {
+                sums[p] += v[p] * row[p];
+            }
+        }
+        T *first = target[j];
+#pragma omp simd
+        for (std::size_t p = 0; p < count; ++p) {
+            sums[p] *= tau[p];
+            first[p] -= sums[p];
+        }
+        for (std::size_t i = j + 1; i < R; ++i) {
+            const T *v = factors.lane(i, j) + begin;
+            T *row = target[i];
+#pragma omp simd
+            for (std::size_t p = 0; p < count; ++p) {
+                row[p] -= sums[p] * v[p];
+            }
+        }
+    }
+
+} // namespace detail
+
+/// @brief Overwrites every matrix with its Householder QR factorization,
+/// laid out as by `qr::factor`, and `tau` with the scalar factors of the
+/// reflectors.
+template <std::floating_point T, std::size_t R, std::size_t C>
+    requires(R >= C)
+void qr(MatrixSoA<T, R, C> &mats, VectorSoA<T, C> &tau) {
+    tau.resize(mats.size());
+    T scales[tile_size];
+    for (std::size_t begin = 0; begin < mats.size(); begin += tile_size) {
+        const std::size_t count = std::min(tile_size, mats.size() - begin);
+        for (std::size_t j = 0; j < C; ++j) {
+            T *t = tau.lane(j, 0) + begin;
+            T *diagonal = mats.lane(j, j) + begin;
+#pragma omp simd
+            for (std::size_t p = 0; p < count; ++p) {
+                scales[p] = T {};
+            }
+            for (std::size_t i = j + 1; i < R; ++i) {
+                const T *v = mats.lane(i, j) + begin;
+#pragma omp simd
+                for (std::size_t p = 0; p < count; ++p) {
+                    scales[p] += v[p] * v[p];
+                }
+            }
+#pragma omp simd
+            for (std::size_t p = 0; p < count; ++p) {
+                // Columns that are already zero below the diagonal are left
+                // alone, `tau = 0` making the reflector the identity.
+                const T tail = scales[p];
+                const bool reflect = tail != T {};
+                const T alpha = diagonal[p];
+                const T norm = std::sqrt(alpha * alpha + tail);
+                const T beta = reflect ? (alpha >= T {} ? -norm : norm) : alpha;
+                scales[p] = reflect ? T { 1 } / (alpha - beta) : T { 1 };
+                t[p] = reflect ? (beta - alpha) / beta : T {};
+                diagonal[p] = beta;
+            }
+            for (std::size_t i = j + 1; i < R; ++i) {
+                T *v = mats.lane(i, j) + begin;
+#pragma omp simd
+                for (std::size_t p = 0; p < count; ++p) {
+                    v[p] *= scales[p];
+                }
+            }
+            for (std::size_t c = j + 1; c < C; ++c) {
+                T *column[R];
+                for (std::size_t i = 0; i < R; ++i) {
+                    column[i] = mats.lane(i, c) + begin;
+                }
+                detail::apply_reflectors(mats, t, j, column, begin, count);
+            }
+        }
+    }
+}
+
+/// @brief Overwrites every `rhs` with `Qᵀ * rhs` and its first `C` rows
+/// with the least squares solution of `mat * x = rhs`, the matrices being
+/// factored by `qr`.
+template <std::floating_point T, std::size_t R, std::size_t C>
+    requires(R >= C)
+void qr_solve(const MatrixSoA<T, R, C> &factors, const VectorSoA<T, C> &tau, VectorSoA<T, R> &rhs) noexcept {
+    assert(factors.size() == rhs.size() and tau.size() == rhs.size());
+    for (std::size_t begin = 0; begin < rhs.size(); begin += tile_size) {
+        const std::size_t count = std::min(tile_size, rhs.size() - begin);
+        T *b[R];
+        for (std::size_t i = 0; i < R; ++i) {
+            b[i] = rhs.lane(i, 0) + begin;
+        }
+        for (std::size_t j = 0; j < C; ++j) {
+            detail::apply_reflectors(factors, tau.lane(j, 0) + begin, j, b, begin, count);
+        }
+        for (std::size_t i = C; i-- > 0;) {
+            for (std::size_t k = i + 1; k < C; ++k) {
+                const T *r = factors.lane(i, k) + begin;
+#pragma omp simd
+                for (std::size_t p = 0; p < count; ++p) {
+                    b[i][p] -= r[p] * b[k][p];
+                }
+            }
+            const T *diagonal = factors.lane(i, i) + begin;
+#pragma omp simd
+            for (std::size_t p = 0; p < count; ++p) {
+                b[i][p] /= diagonal[p];
+            }
+        }
+    }
+}
+
+/// @brief Computes the singular value decompositions
+/// `mat = U * diag(sigma) * Vᵀ` of 3x3 matrices by `svd3::decompose`, the
+/// outputs are resized to the number of matrices.
+template <std::floating_point T>
+void svd(const MatrixSoA<T, 3, 3> &mats, MatrixSoA<T, 3, 3> &u, VectorSoA<T, 3> &sigma, MatrixSoA<T, 3, 3> &v) {
+    const std::size_t count = mats.size();
+    u.resize(count);
+    sigma.resize(count);
+    v.resize(count);
+    const T *in[9];
+    T *left[9];
+    T *right[9];
+    T *values[3];
+    for (std::size_t k = 0; k < 9; ++k) {
+        in[k] = mats.lane(k / 3, k % 3);
+        left[k] = u.lane(k / 3, k % 3);
+        right[k] = v.lane(k / 3, k % 3);
+    }
+    for (std::size_t k = 0; k < 3; ++k) {
+        values[k] = sigma.lane(k, 0);
+    }
+#pragma omp simd
+    for (std::size_t p = 0; p < count; ++p) {
+        T a[9];
+        T lhs[9];
+        T s[3];
+        T rhs[9];
+        for (std::size_t k = 0; k < 9; ++k) {
+            a[k] = in[k][p];
+        }
+        svd3::decompose(a, lhs, s, rhs);
+        for (std::size_t k = 0; k < 9; ++k) {
+            left[k][p] = lhs[k];
+            right[k][p] = rhs[k];
+        }
+        for (std::size_t k = 0; k < 3; ++k) {
+            values[k][p] = s[k];
+        }
+    }
+}
+
+/// @brief Computes the polar decompositions `mat = R * S` of 3x3 matrices
+/// by `svd3::polar`, the outputs are resized to the number of matrices.
+template <std::floating_point T>
+void polar(const MatrixSoA<T, 3, 3> &mats, MatrixSoA<T, 3, 3> &rotation, MatrixSoA<T, 3, 3> &stretch) {
+    const std::size_t count = mats.size();
+    rotation.resize(count);
+    stretch.resize(count);
+    const T *in[9];
+    T *rotations[9];
+    T *stretches[9];
+    for (std::size_t k = 0; k < 9; ++k) {
+        in[k] = mats.lane(k / 3, k % 3);
+        rotations[k] = rotation.lane(k / 3, k % 3);
+        stretches[k] = stretch.lane(k / 3, k % 3);
+    }
+#pragma omp simd
+    for (std::size_t p = 0; p < count; ++p) {
+        T a[9];
+        T r[9];
+        T s[9];
+        for (std::size_t k = 0; k < 9; ++k) {
+            a[k] = in[k][p];
+        }
+        svd3::polar(a, r, s);
+        for (std::size_t k = 0; k < 9; ++k) {
+            rotations[k][p] = r[k];
+            stretches[k][p] = s[k];
+        }
+    }
+}
+
+/// @brief Computes the eigendecompositions of symmetric 3x3 matrices by
+/// `eigen3::decompose`, only their lower triangles are read. The outputs are
+/// resized to the number of matrices.
+template <std::floating_point T>
+void symmetric_eigen(const MatrixSoA<T, 3, 3> &mats, VectorSoA<T, 3> &values, MatrixSoA<T, 3, 3> &vectors) {
+    const std::size_t count = mats.size();
+    values.resize(count);
+    vectors.resize(count);
+    const T *in[9];
+    T *eigenvalues[3];
+    T *eigenvectors[9];
+    for (std::size_t k = 0; k < 9; ++k) {
+        in[k] = mats.lane(k / 3, k % 3);
+        eigenvectors[k] = vectors.lane(k / 3, k % 3);
+    }
+    for (std::size_t k = 0; k < 3; ++k) {
+        eigenvalues[k] = values.lane(k, 0);
+    }
+#pragma omp simd
+    for (std::size_t p = 0; p < count; ++p) {
+        T a[9];
+        T lambda[3];
+        T v[9];
+        for (std::size_t k = 0; k < 9; ++k) {
+            a[k] = in[k][p];
+        }
+        eigen3::decompose(a, lambda, v);
+        for (std::size_t k = 0; k < 3; ++k) {
+            eigenvalues[k][p] = lambda[k];
+        }
+        for (std::size_t k = 0; k < 9; ++k) {
+            eigenvectors[k][p] = v[k];
+        }
+    }
+}
+
+/// @brief Estimates the normal of every point as the eigenvector of the
+/// smallest eigenvalue of the covariance of its neighbors.
+///
+/// The neighbors of point `i` are `points[neighbors[k]]` for `k` from
+/// `offsets[i]` to `offsets[i + 1]`, so `offsets` holds one more element
+/// than `points`. The covariances of a tile of points are accumulated with
+/// their mean subtracted into a buffer on the stack and decomposed right
+/// away, one point per lane, they are never stored. The normals have unit
+/// length and an arbitrary sign, points with fewer than three neighbors get
+/// an arbitrary unit vector. `normals` is resized to the number of points.
+template <std::floating_point T>
+void neighborhood_normals(
+    const Vector3SoA<T> &points, std::span<const std::size_t> offsets, std::span<const std::size_t> neighbors, Vector3SoA<T> &normals
+) {
+    assert(offsets.size() == points.size() + 1);
+    const std::size_t count = points.size();
+    normals.resize(count);
+    const T *x = points.x(), *y = points.y(), *z = points.z();
+    T *nx = normals.x(), *ny = normals.y(), *nz = normals.z();
+    // Lower triangle of the covariances of the tile, row by row.
+    T covariance[6][tile_size];
+    for (std::size_t begin = 0; begin < count; begin += tile_size) {
+        const std::size_t tile = std::min(tile_size, count - begin);
+        for (std::size_t p = 0; p < tile; ++p) {
+            const std::size_t first = offsets[begin + p];
+            const std::size_t last = offsets[begin + p + 1];
+            T mx {}, my {}, mz {};
+            for (std::size_t k = first; k < last; ++k) {
+                const std::size_t n = neighbors[k];
+                mx += x[n];
+                my += y[n];
+                mz += z[n];
+            }
+            const T scale = last > first ? T { 1 } / static_cast<T>(last - first) : T {};
+            mx *= scale;
+            my *= scale;
+            mz *= scale;
+            T xx {}, yx {}, yy {}, zx {}, zy {}, zz {};
+            for (std::size_t k = first; k < last; ++k) {
+                const std::size_t n = neighbors[k];
+                const T dx = x[n] - mx;
+                const T dy = y[n] - my;
+                const T dz = z[n] - mz;
+                xx += dx * dx;
+                yx += dy * dx;
+                yy += dy * dy;
+                zx += dz * dx;
+                zy += dz * dy;
+                zz += dz * dz;
+            }
+            covariance[0][p] = xx * scale;
+            covariance[1][p] = yx * scale;
+            covariance[2][p] = yy * scale;
+            covariance[3][p] = zx * scale;
+            covariance[4][p] = zy * scale;
+            covariance[5][p] = zz * scale;
+        }
+        T *out_x = nx + begin, *out_y = ny + begin, *out_z = nz + begin;
+#pragma omp simd
+        for (std::size_t p = 0; p < tile; ++p) {
+            const T a[9] = {
+                covariance[0][p], T {}, T {},
+                covariance[1][p], covariance[2][p], T {},
+                covariance[3][p], covariance[4][p], covariance[5][p],
+            };
+            T lambda[3];
+            T v[9];
+            eigen3::decompose(a, lambda, v);
+            out_x[p] = v[0];
+            out_y[p] = v[3];
+            out_z[p] = v[6];
+        }
+    }
+}
+
+} // namespace dk::math::batch
+
+#endif // DK_MATH_BATCH_DECOMPOSITION_HPP
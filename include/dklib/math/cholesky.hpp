@@ -0,0 +1,191 @@
+#ifndef DK_MATH_CHOLESKY_HPP
+#define DK_MATH_CHOLESKY_HPP
+
+/// @file cholesky.hpp
+///
+/// Cholesky factorization `a = L * Lᵀ` of row-major symmetric positive
+/// definite matrices.
+///
+/// `factor` only reads the lower triangle of `a` and overwrites it with `L`.
+/// Small matrices are factored column by column, each element of `L` being
+/// a dot product of two rows. From `min_blocked_order` on the factorization
+/// is right-looking and blocked: the diagonal block of a panel of
+/// `block_size` columns is factored as above, the rows below it are
+/// obtained by a triangular solve, and the trailing matrix receives the
+/// rank `block_size` update `A22 -= L21 * L21ᵀ` from the blocked GEMM. The
+/// update runs on strips of `block_size` rows, each ending at the diagonal,
+/// so only the diagonal blocks of the strict upper triangle are
+/// overwritten.
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+#include <dklib/math/gemm.hpp>
+
+namespace dk::math::cholesky {
+
+/// Columns per panel of the blocked factorization.
+inline constexpr std::size_t block_size = 48;
+
+/// Smallest order factored by the blocked path.
+inline constexpr std::size_t min_blocked_order = 96;
+
+namespace detail {
+
+    /// Factors the `width x width` diagonal block at `k`, whose rows left of
+    /// `k` are already applied. Returns false if a pivot is not positive.
+    template <typename T>
+    constexpr bool factor_diagonal(T *a, std::size_t ld, std::size_t k, std::size_t width) noexcept {
+        const std::size_t end = k + width;
+        for (std::size_t j = k; j < end; ++j) {
+            const T *pivot_row = a + j * ld;
+            T diagonal = pivot_row[j];
+            for (std::size_t p = k; p < j; ++p) {
+                diagonal -= pivot_row[p] * pivot_row[p];
+            }
+            if (not(diagonal > T {})) {
+                return false;
+            }
+            diagonal = std::sqrt(diagonal);
+            a[j * ld + j] = diagonal;
+            for (std::size_t i = j + 1; i < end; ++i) {
+                T *row = a + i * ld;
+                T sum = row[j];
+#pragma omp simd reduction(- : sum)
+                for (std::size_t p = k; p < j; ++p) {
+                    sum -= row[p] * pivot_row[p];
+                }
+                row[j] = sum / diagonal;
+            }
+        }
+        return true;
+    }
+
+    /// Computes `L21 = A21 * L11⁻ᵀ` for the panel at `k`, row by row.
+    template <typename T>
+    void solve_panel_rows(T *a, std::size_t n, std::size_t ld, std::size_t k, std::size_t width) {
+        // `L11ᵀ`, so that the updates below run along rows.
+        std::vector<T> upper(width * width);
+        for (std::size_t i = 0; i < width; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                upper[j * width + i] = a[(k + i) * ld + k + j];
+            }
+        }
+        for (std::size_t r = k + width; r < n; ++r) {
+            T *row = a + r * ld + k;
+            for (std::size_t j = 0; j < width; ++j) {
+                const T element = row[j] / upper[j * width + j];
+                row[j] = element;
+                const T *source = upper.data() + j * width;
+#pragma omp simd
+                for (std::size_t c = j + 1; c < width; ++c) {
+                    row[c] -= element * source[c];
+                }
+            }
+        }
+    }
+
+    /// Applies `A22 -= L21 * L21ᵀ` to the lower triangle of the trailing
+    /// matrix of the panel at `k`.
+    template <typename T>
+    void update_trailing(T *a, std::size_t n, std::size_t ld, std::size_t k, std::size_t width) {
+        // GEMM only accumulates, its right operand is a negated copy of
+        // `L21ᵀ`, which also keeps it from aliasing the result.
+        const std::size_t rest = n - k - width;
+        const T *l21 = a + (k + width) * ld + k;
+        std::vector<T> negated(width * rest);
+        for (std::size_t i = 0; i < rest; ++i) {
+            for (std::size_t p = 0; p < width; ++p) {
+                negated[p * rest + i] = -l21[i * ld + p];
+            }
+        }
+        T *a22 = a + (k + width) * (ld + 1);
+        for (std::size_t begin = 0; begin < rest; begin += block_size) {
+            const std::size_t rows = std::min(block_size, rest - begin);
+            gemm::multiply<T>(rows, begin + rows, width, { l21 + begin * ld, ld, 1 }, { negated.data(), rest, 1 }, a22 + begin * ld, ld, true);
+        }
+    }
+
+} // namespace detail
+
+/// @brief Factors the `n x n` matrix at `a` in place, see the file comment.
+/// @param  [in] ld Distance between the rows of `a`, at least `n`.
+/// @param  [in] panel_width Columns per panel, `n` or more factors the
+///                          matrix unblocked. Zero is taken as one, and
+///                          constant evaluation is always unblocked.
+/// @return False if the matrix is not positive definite, `a` is then only
+///         partially factored.
+template <std::floating_point T>
+constexpr bool factor(T *a, std::size_t n, std::size_t ld, std::size_t panel_width) {
+    if consteval {
+        panel_width = n;
+    }
+    panel_width = std::max<std::size_t>(panel_width, 1);
+    for (std::size_t k = 0; k < n; k += panel_width) {
+        const std::size_t panel = std::min(panel_width, n - k);
+        if (not detail::factor_diagonal(a, ld, k, panel)) {
+            return false;
+        }
+        if (k + panel == n) {
+            continue;
+        }
+        if !consteval {
+            detail::solve_panel_rows(a, n, ld, k, panel);
+            detail::update_trailing(a, n, ld, k, panel);
+        }
+    }
+    return true;
+}
+
+/// @brief Same as above, blocked from `min_blocked_order` on. Constant
+/// evaluation is always unblocked.
+template <std::floating_point T>
+constexpr bool factor(T *a, std::size_t n, std::size_t ld) {
+    if !consteval {
+        if (n >= min_blocked_order) {
+            return factor(a, n, ld, block_size);
+        }
+    }
+    return factor(a, n, ld, n);
+}
+
+/// @brief Overwrites the `n x nrhs` matrix `b` with the solution of
+/// `a * x = b`, the lower triangle of `l` holding the factor of `a`.
+template <std::floating_point T>
+constexpr void solve(const T *l, std::size_t n, std::size_t ld, T *b, std::size_t nrhs, std::size_t ldb) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        T *row = b + i * ldb;
+        for (std::size_t p = 0; p < i; ++p) {
+            const T factor = l[i * ld + p];
+            const T *source = b + p * ldb;
+            for (std::size_t c = 0; c < nrhs; ++c) {
+                row[c] -= factor * source[c];
+            }
+        }
+        const T diagonal = l[i * ld + i];
+        for (std::size_t c = 0; c < nrhs; ++c) {
+            row[c] /= diagonal;
+        }
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        T *row = b + i * ldb;
+        for (std::size_t p = i + 1; p < n; ++p) {
+            const T factor = l[p * ld + i];
+            const T *source = b + p * ldb;
+            for (std::size_t c = 0; c < nrhs; ++c) {
+                row[c] -= factor * source[c];
+            }
+        }
+        const T diagonal = l[i * ld + i];
+        for (std::size_t c = 0; c < nrhs; ++c) {
+            row[c] /= diagonal;
+        }
+    }
+}
+
+} // namespace dk::math::cholesky
+
+#endif // DK_MATH_CHOLESKY_HPP
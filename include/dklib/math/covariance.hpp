@@ -0,0 +1,405 @@
+#ifndef DK_MATH_COVARIANCE_HPP
+#define DK_MATH_COVARIANCE_HPP
+
+/// @file covariance.hpp
+///
+/// Single pass mean and covariance of streams of points.
+///
+/// `CovarianceAccumulator` keeps the number of points, their mean and the
+/// scatter matrix `sum((x - mean) * (x - mean)ᵀ)`, never the raw sums whose
+/// difference would cancel catastrophically. Points added one at a time
+/// update it with Welford's method. Spans are consumed in chunks of
+/// `chunk_size` points that stay in L1: a first pass over the chunk
+/// computes its mean relative to its first point, a second one its scatter
+/// around that mean, and the summary of the chunk is merged with the
+/// pairwise formulas of Chan et al.
+/// Both passes are plain reductions over the points, which vectorize for
+/// packed `Vector` arrays as well as for the lanes of `Vector3SoA` and
+/// `VectorSoA`.
+///
+/// Accumulators of different threads or shards combine with `merge`, the
+/// parallel overloads of `add` split the points into blocks whose partial
+/// accumulators are merged pairwise in a fixed order, so the result does not
+/// depend on the scheduling. `serialize` writes the state into a fixed size,
+/// little endian byte array, which lets shards processed out of core, or on
+/// other machines, be merged later:
+///
+/// ```cpp
+/// CovarianceAccumulator<double, 3> shard;
+/// shard.add(execution::par, points);
+/// write(shard.serialize());
+/// ...
+/// total.merge(CovarianceAccumulator<double, 3>::deserialize(bytes));
+/// ```
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <dklib/math/execution.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/matrix_soa.hpp>
+#include <dklib/math/vector.hpp>
+#include <dklib/math/vector3_soa.hpp>
+
+namespace dk::math {
+
+namespace detail {
+
+    /// Writes `value` to `out` in little endian byte order.
+    template <typename U>
+    void store_le(std::byte *out, U value) noexcept {
+        using Bits = std::conditional_t<sizeof(U) == 4, std::uint32_t, std::uint64_t>;
+        auto bits = std::bit_cast<Bits>(value);
+        if constexpr (std::endian::native == std::endian::big) {
+            bits = std::byteswap(bits);
+        }
+        const auto bytes = std::bit_cast<std::array<std::byte, sizeof(U)>>(bits);
+        std::copy(bytes.begin(), bytes.end(), out);
+    }
+
+    /// Reads a value written by `store_le`.
+    template <typename U>
+    U load_le(const std::byte *in) noexcept {
+        using Bits = std::conditional_t<sizeof(U) == 4, std::uint32_t, std::uint64_t>;
+        std::array<std::byte, sizeof(U)> bytes;
+        std::copy(in, in + sizeof(U), bytes.begin());
+        auto bits = std::bit_cast<Bits>(bytes);
+        if constexpr (std::endian::native == std::endian::big) {
+            bits = std::byteswap(bits);
+        }
+        return std::bit_cast<U>(bits);
+    }
+
+} // namespace detail
+
+template <std::floating_point T, std::size_t D>
+requires(D > 0 and (sizeof(T) == 4 or sizeof(T) == 8))
+class CovarianceAccumulator {
+public:
+    using value_type = T;
+    using vector_type = Vector<T, D>;
+    using matrix_type = Matrix<T, D, D>;
+
+    /// Elements of the lower triangle of the scatter matrix.
+    static constexpr std::size_t packed_size = D * (D + 1) / 2;
+
+    /// Points summarized at once by the span overloads of `add`, about
+    /// 16 KiB of them.
+    static constexpr std::size_t chunk_size = std::max<std::size_t>(16 * 1024 / (D * sizeof(T)), 64);
+
+    /// Points summarized by one task of the parallel overloads of `add`.
+    static constexpr std::size_t parallel_block_size = 64 * chunk_size;
+
+    /// Everything the accumulator knows about the points added so far.
+    struct State {
+        std::uint64_t count = 0;
+        std::array<T, D> mean {};
+        /// Lower triangle of the scatter matrix, row by row.
+        std::array<T, packed_size> scatter {};
+    };
+
+    /// Bytes written by `serialize`: the dimension and the size of `T` as
+    /// 32 bit integers, the count as a 64 bit integer, then the mean and the
+    /// packed scatter matrix.
+    static constexpr std::size_t serialized_size = 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t) + (D + packed_size) * sizeof(T);
+
+    CovarianceAccumulator() = default;
+
+    /// @brief Restores an accumulator from its `state()`.
+    explicit CovarianceAccumulator(const State &state)
+        : state_(state) {}
+
+    [[nodiscard]] const State &state() const noexcept { return state_; }
+    [[nodiscard]] std::uint64_t count() const noexcept { return state_.count; }
+    [[nodiscard]] bool empty() const noexcept { return state_.count == 0; }
+
+    void clear() noexcept { state_ = {}; }
+
+    /// @brief Adds a single point with Welford's update.
+    void add(const vector_type &point) noexcept {
+        const T n = static_cast<T>(++state_.count);
+        T delta[D];
+        for (std::size_t i = 0; i < D; ++i) {
+            delta[i] = point[i] - state_.mean[i];
+            state_.mean[i] += delta[i] / n;
+        }
+        // `(x - old mean) * (x - new mean)ᵀ`, written symmetrically.
+        const T weight = (n - T { 1 }) / n;
+        std::size_t e = 0;
+        for (std::size_t i = 0; i < D; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                state_.scatter[e++] += weight * delta[i] * delta[j];
+            }
+        }
+    }
+
+    /// @brief Adds a contiguous range of packed points, e.g. a
+    /// `std::vector<Vector3D>` or a span of a larger array.
+    template <std::ranges::contiguous_range R>
+    requires std::derived_from<std::ranges::range_value_t<R>, vector_type>
+    void add(const R &points) noexcept {
+        static_assert(sizeof(std::ranges::range_value_t<R>) == D * sizeof(T));
+        const T *base = reinterpret_cast<const T *>(std::ranges::data(points));
+        const T *in[D];
+        for (std::size_t i = 0; i < D; ++i) {
+            in[i] = base + i;
+        }
+        add_chunks<D>(in, 0, std::ranges::size(points));
+    }
+
+    /// @brief Adds the points whose coordinate `i` is `lanes[i][k]`, all
+    /// lanes having the same size.
+    void add(const std::array<std::span<const T>, D> &lanes) {
+        const T *in[D];
+        const std::size_t count = lane_pointers(lanes, in);
+        add_chunks<1>(in, 0, count);
+    }
+
+    /// @brief Adds all vectors of `points`.
+    void add(const Vector3SoA<T> &points) noexcept
+    requires(D == 3)
+    {
+        const T *in[D] = { points.x(), points.y(), points.z() };
+        add_chunks<1>(in, 0, points.size());
+    }
+
+    /// @brief Adds all vectors of `points`.
+    void add(const VectorSoA<T, D> &points) noexcept {
+        const T *in[D];
+        for (std::size_t i = 0; i < D; ++i) {
+            in[i] = points.lane(i, 0);
+        }
+        add_chunks<1>(in, 0, points.size());
+    }
+
+    /// @brief Parallel variant of adding packed points, see the file comment.
+    template <std::ranges::contiguous_range R>
+    requires std::derived_from<std::ranges::range_value_t<R>, vector_type>
+    void add(const execution::parallel_policy &policy, const R &points) {
+        static_assert(sizeof(std::ranges::range_value_t<R>) == D * sizeof(T));
+        const T *base = reinterpret_cast<const T *>(std::ranges::data(points));
+        const T *in[D];
+        for (std::size_t i = 0; i < D; ++i) {
+            in[i] = base + i;
+        }
+        add_parallel<D>(policy, in, std::ranges::size(points));
+    }
+
+    /// @brief Parallel variant of adding lanes, see the file comment.
+    void add(const execution::parallel_policy &policy, const std::array<std::span<const T>, D> &lanes) {
+        const T *in[D];
+        const std::size_t count = lane_pointers(lanes, in);
+        add_parallel<1>(policy, in, count);
+    }
+
+    /// @brief Adds all points of `other`, as if they had been added to this
+    /// accumulator.
+    void merge(const CovarianceAccumulator &other) noexcept { merge(other.state_); }
+
+    /// @brief Mean of the points, zero while the accumulator is empty.
+    [[nodiscard]] vector_type mean() const noexcept {
+        vector_type result;
+        for (std::size_t i = 0; i < D; ++i) {
+            result[i] = state_.mean[i];
+        }
+        return result;
+    }
+
+    /// @brief Sum of the outer products of the deviations from the mean.
+    [[nodiscard]] matrix_type scatter() const noexcept { return unpack(T { 1 }); }
+
+    /// @brief Population covariance, the scatter matrix divided by the
+    /// number of points.
+    [[nodiscard]] matrix_type covariance() const {
+        if (state_.count == 0) {
+            throw std::runtime_error("Division by zero");
+        }
+        return unpack(T { 1 } / static_cast<T>(state_.count));
+    }
+
+    /// @brief Sample covariance, the scatter matrix divided by the number
+    /// of points minus one.
+    [[nodiscard]] matrix_type sample_covariance() const {
+        if (state_.count < 2) {
+            throw std::runtime_error("Division by zero");
+        }
+        return unpack(T { 1 } / static_cast<T>(state_.count - 1));
+    }
+
+    /// @brief Writes the state in the format described at `serialized_size`.
+    [[nodiscard]] std::array<std::byte, serialized_size> serialize() const noexcept {
+        using detail::store_le;
+        std::array<std::byte, serialized_size> bytes;
+        std::byte *out = bytes.data();
+        store_le(out, static_cast<std::uint32_t>(D));
+        store_le(out + 4, static_cast<std::uint32_t>(sizeof(T)));
+        store_le(out + 8, state_.count);
+        out += 16;
+        for (const T value : state_.mean) {
+            store_le(out, value);
+            out += sizeof(T);
+        }
+        for (const T value : state_.scatter) {
+            store_le(out, value);
+            out += sizeof(T);
+        }
+        return bytes;
+    }
+
+    /// @brief Restores an accumulator written by `serialize`.
+    /// @throws std::runtime_error if `bytes` is not `serialized_size` long,
+    ///         or was not written by an accumulator of the same dimension
+    ///         and scalar type.
+    [[nodiscard]] static CovarianceAccumulator deserialize(std::span<const std::byte> bytes) {
+        using detail::load_le;
+        if (bytes.size() != serialized_size) {
+            throw std::runtime_error("invalid serialized size");
+        }
+        if (load_le<std::uint32_t>(bytes.data()) != D or load_le<std::uint32_t>(bytes.data() + 4) != sizeof(T)) {
+            throw std::runtime_error("dimension mismatch");
+        }
+        State state;
+        state.count = load_le<std::uint64_t>(bytes.data() + 8);
+        const std::byte *in = bytes.data() + 16;
+        for (T &value : state.mean) {
+            value = load_le<T>(in);
+            in += sizeof(T);
+        }
+        for (T &value : state.scatter) {
+            value = load_le<T>(in);
+            in += sizeof(T);
+        }
+        return CovarianceAccumulator { state };
+    }
+
+private:
+    /// Combines the summaries of two sets of points (Chan et al.).
+    void merge(const State &other) noexcept {
+        if (other.count == 0) {
+            return;
+        }
+        if (state_.count == 0) {
+            state_ = other;
+            return;
+        }
+        const T n_a = static_cast<T>(state_.count);
+        const T n_b = static_cast<T>(other.count);
+        const T fraction = n_b / (n_a + n_b);
+        const T weight = n_a * fraction;
+        T delta[D];
+        for (std::size_t i = 0; i < D; ++i) {
+            delta[i] = other.mean[i] - state_.mean[i];
+            state_.mean[i] += delta[i] * fraction;
+        }
+        std::size_t e = 0;
+        for (std::size_t i = 0; i < D; ++i) {
+            for (std::size_t j = 0; j <= i; ++j, ++e) {
+                state_.scatter[e] += other.scatter[e] + weight * delta[i] * delta[j];
+            }
+        }
+        state_.count += other.count;
+    }
+
+    /// Summary of the `count <= chunk_size` points whose coordinate `i` is
+    /// `in[i][k * Stride]`, by two passes over them.
+    template <std::size_t Stride>
+    static State chunk_state(const T *const (&in)[D], std::size_t count) noexcept {
+        State chunk;
+        chunk.count = count;
+        const T reciprocal = T { 1 } / static_cast<T>(count);
+        // Summing the offsets from the first point keeps the rounding errors
+        // relative to the spread of the points instead of their distance
+        // from the origin.
+        for (std::size_t i = 0; i < D; ++i) {
+            const T *x = in[i];
+            const T shift = x[0];
+            T sum {};
+#pragma omp simd reduction(+ : sum)
+            for (std::size_t k = 0; k < count; ++k) {
+                sum += x[k * Stride] - shift;
+            }
+            chunk.mean[i] = shift + sum * reciprocal;
+        }
+        std::size_t e = 0;
+        for (std::size_t i = 0; i < D; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                const T *x = in[i];
+                const T *y = in[j];
+                const T mx = chunk.mean[i];
+                const T my = chunk.mean[j];
+                T sum {};
+#pragma omp simd reduction(+ : sum)
+                for (std::size_t k = 0; k < count; ++k) {
+                    sum += (x[k * Stride] - mx) * (y[k * Stride] - my);
+                }
+                chunk.scatter[e++] = sum;
+            }
+        }
+        return chunk;
+    }
+
+    /// Adds the points `[first, first + count)` chunk by chunk.
+    template <std::size_t Stride>
+    void add_chunks(const T *const (&in)[D], std::size_t first, std::size_t count) noexcept {
+        for (std::size_t begin = first; begin < first + count; begin += chunk_size) {
+            const T *chunk[D];
+            for (std::size_t i = 0; i < D; ++i) {
+                chunk[i] = in[i] + begin * Stride;
+            }
+            merge(chunk_state<Stride>(chunk, std::min(chunk_size, first + count - begin)));
+        }
+    }
+
+    template <std::size_t Stride>
+    void add_parallel(const execution::parallel_policy &policy, const T *const (&in)[D], std::size_t count) {
+        const std::size_t blocks = (count + parallel_block_size - 1) / parallel_block_size;
+        std::vector<CovarianceAccumulator> partials(blocks);
+        policy.get_pool().parallel_for(blocks, [&](std::size_t block) {
+            const std::size_t begin = block * parallel_block_size;
+            partials[block].template add_chunks<Stride>(in, begin, std::min(parallel_block_size, count - begin));
+        });
+        for (std::size_t stride = 1; stride < blocks; stride *= 2) {
+            for (std::size_t block = 0; block + stride < blocks; block += 2 * stride) {
+                partials[block].merge(partials[block + stride].state_);
+            }
+        }
+        if (blocks > 0) {
+            merge(partials[0].state_);
+        }
+    }
+
+    static std::size_t lane_pointers(const std::array<std::span<const T>, D> &lanes, const T *(&in)[D]) {
+        for (std::size_t i = 0; i < D; ++i) {
+            if (lanes[i].size() != lanes[0].size()) {
+                throw std::runtime_error("dimension mismatch");
+            }
+            in[i] = lanes[i].data();
+        }
+        return lanes[0].size();
+    }
+
+    matrix_type unpack(T scale) const noexcept {
+        matrix_type result;
+        std::size_t e = 0;
+        for (std::size_t i = 0; i < D; ++i) {
+            for (std::size_t j = 0; j <= i; ++j, ++e) {
+                result[i, j] = result[j, i] = state_.scatter[e] * scale;
+            }
+        }
+        return result;
+    }
+
+    State state_;
+};
+
+} // namespace dk::math
+
+#endif // DK_MATH_COVARIANCE_HPP
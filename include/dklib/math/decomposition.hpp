@@ -0,0 +1,731 @@
+#ifndef DK_MATH_DECOMPOSITION_HPP
+#define DK_MATH_DECOMPOSITION_HPP
+
+/// @file decomposition.hpp
+///
+/// Matrix factorizations and the linear solvers built on them.
+///
+/// A factorization is computed once and then reused, so that a system with
+/// many right-hand sides, or several systems sharing their matrix, pay for
+/// the O(n³) part only once:
+///
+///     const LU lu(a);
+///     const auto x = lu.solve(b);
+///     const auto y = lu.solve(c);
+///
+/// `LU` factors general square matrices, `Cholesky` symmetric positive
+/// definite ones at half the cost, and `QR` rectangular ones with at least
+/// as many rows as columns, whose `solve` returns the least squares
+/// solution. `SVD3` and `Polar3` decompose 3x3 matrices into rotations and
+/// scalings and `SymmetricEigen3` symmetric ones into their eigenvectors,
+/// for many matrices at once see `batch_decomposition.hpp`.
+///
+/// `solve` and `inverse` are also available as free functions. Orders two
+/// and three use closed forms there instead of a factorization, as does the
+/// inverse of order four, see `Matrix4::inverse`.
+///
+/// Integer matrices are factored in double precision, `decomposition_type`
+/// gives the element type of the factors and the solutions. Solving with a
+/// singular matrix throws `std::runtime_error`, as do solving with a
+/// matrix that is not positive definite by `Cholesky` and with a rank
+/// deficient one by `QR`.
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <dklib/math/cholesky.hpp>
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/dyn_matrix.hpp>
+#include <dklib/math/dyn_vector.hpp>
+#include <dklib/math/eigen3.hpp>
+#include <dklib/math/lu.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/matrix4d.hpp>
+#include <dklib/math/qr.hpp>
+#include <dklib/math/svd3.hpp>
+#include <dklib/math/vector.hpp>
+
+namespace dk::math {
+
+/// Element type of the factors of a matrix of `T`.
+template <Numeric T>
+using decomposition_type = std::conditional_t<std::floating_point<T>, T, double>;
+
+/// LU factorization with partial pivoting of a fixed size matrix.
+template <Numeric T, std::size_t N>
+class LU {
+public:
+    using value_type = decomposition_type<T>;
+    using matrix_type = Matrix<value_type, N, N>;
+    using vector_type = Vector<value_type, N>;
+
+    explicit constexpr LU(const Matrix<T, N, N> &mat) {
+        for (std::size_t i = 0; i < N * N; ++i) {
+            factors_[i] = static_cast<value_type>(mat[i]);
+        }
+        sign_ = lu::factor(factors_.data(), N, N, pivots_.data());
+    }
+
+    [[nodiscard]] constexpr bool is_singular() const noexcept { return sign_ == 0; }
+
+    [[nodiscard]] constexpr value_type determinant() const noexcept {
+        return is_singular() ? value_type {} : lu::determinant(factors_.data(), N, N, sign_);
+    }
+
+    /// @brief Returns `x` such that `mat * x = rhs`.
+    [[nodiscard]] constexpr vector_type solve(const vector_type &rhs) const {
+        check_regular();
+        vector_type result = rhs;
+        lu::solve(factors_.data(), N, N, pivots_.data(), result.data(), 1, 1);
+        return result;
+    }
+
+    /// @brief Solves for all columns of `rhs` at once.
+    template <std::size_t K>
+    [[nodiscard]] constexpr Matrix<value_type, N, K> solve(const Matrix<value_type, N, K> &rhs) const {
+        check_regular();
+        Matrix<value_type, N, K> result = rhs;
+        lu::solve(factors_.data(), N, N, pivots_.data(), result.data(), K, K);
+        return result;
+    }
+
+    [[nodiscard]] constexpr matrix_type inverse() const {
+        matrix_type identity { value_type {} };
+        for (std::size_t i = 0; i < N; ++i) {
+            identity[i, i] = value_type { 1 };
+        }
+        return solve(identity);
+    }
+
+    /// @brief `L` below the diagonal and `U` on and above it.
+    [[nodiscard]] constexpr const matrix_type &factors() const noexcept { return factors_; }
+
+    /// @brief Row exchanges, see `lu::factor`.
+    [[nodiscard]] constexpr const std::array<std::size_t, N> &pivots() const noexcept { return pivots_; }
+
+private:
+    constexpr void check_regular() const {
+        if (is_singular()) {
+            throw std::runtime_error("matrix is singular");
+        }
+    }
+
+    matrix_type factors_;
+    std::array<std::size_t, N> pivots_ {};
+    int sign_ = 0;
+};
+
+/// LU factorization with partial pivoting of a dynamic matrix.
+template <Numeric T>
+class DynLU {
+public:
+    using value_type = decomposition_type<T>;
+    using matrix_type = DynMatrix<value_type>;
+    using vector_type = DynVector<value_type>;
+
+    explicit DynLU(const DynMatrix<T> &mat)
+        : factors_(mat.rows(), mat.cols())
+        , pivots_(mat.rows()) {
+        if (mat.rows() != mat.cols()) {
+            throw std::runtime_error("matrix is not square");
+        }
+        for (std::size_t i = 0; i < mat.size(); ++i) {
+            factors_[i] = static_cast<value_type>(mat[i]);
+        }
+        sign_ = lu::factor(factors_.data(), size(), size(), pivots_.data());
+    }
+
+    /// @brief Order of the factored matrix.
+    [[nodiscard]] std::size_t size() const noexcept { return factors_.rows(); }
+
+    [[nodiscard]] bool is_singular() const noexcept { return sign_ == 0; }
+
+    [[nodiscard]] value_type determinant() const noexcept {
+        return is_singular() ? value_type {} : lu::determinant(factors_.data(), size(), size(), sign_);
+    }
+
+    /// @brief Returns `x` such that `mat * x = rhs`.
+    [[nodiscard]] vector_type solve(const vector_type &rhs) const {
+        check(rhs.size());
+        vector_type result = rhs;
+        lu::solve(factors_.data(), size(), size(), pivots_.data(), result.data(), 1, 1);
+        return result;
+    }
+
+    /// @brief Solves for all columns of `rhs` at once.
+    [[nodiscard]] matrix_type solve(const matrix_type &rhs) const {
+        check(rhs.rows());
+        matrix_type result = rhs;
+        lu::solve(factors_.data(), size(), size(), pivots_.data(), result.data(), rhs.cols(), rhs.cols());
+        return result;
+    }
+
+    [[nodiscard]] matrix_type inverse() const { return solve(matrix_type::identity(size())); }
+
+    /// @brief `L` below the diagonal and `U` on and above it.
+    [[nodiscard]] const matrix_type &factors() const noexcept { return factors_; }
+
+    /// @brief Row exchanges, see `lu::factor`.
+    [[nodiscard]] const std::vector<std::size_t> &pivots() const noexcept { return pivots_; }
+
+private:
+    void check(std::size_t rows) const {
+        if (rows != size()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+        if (is_singular()) {
+            throw std::runtime_error("matrix is singular");
+        }
+    }
+
+    matrix_type factors_;
+    std::vector<std::size_t> pivots_;
+    int sign_ = 0;
+};
+
+/// Cholesky factorization of a fixed size symmetric positive definite
+/// matrix, only its lower triangle is read.
+template <Numeric T, std::size_t N>
+class Cholesky {
+public:
+    using value_type = decomposition_type<T>;
+    using matrix_type = Matrix<value_type, N, N>;
+    using vector_type = Vector<value_type, N>;
+
+    explicit constexpr Cholesky(const Matrix<T, N, N> &mat) {
+        for (std::size_t i = 0; i < N * N; ++i) {
+            factor_[i] = static_cast<value_type>(mat[i]);
+        }
+        positive_ = cholesky::factor(factor_.data(), N, N);
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = i + 1; j < N; ++j) {
+                factor_[i, j] = value_type {};
+            }
+        }
+    }
+
+    [[nodiscard]] constexpr bool is_positive_definite() const noexcept { return positive_; }
+
+    /// @brief Returns the determinant, zero if the matrix is not positive definite.
+    [[nodiscard]] constexpr value_type determinant() const noexcept {
+        if (not positive_) {
+            return value_type {};
+        }
+        value_type result { 1 };
+        for (std::size_t i = 0; i < N; ++i) {
+            result *= factor_[i, i] * factor_[i, i];
+        }
+        return result;
+    }
+
+    /// @brief Returns `x` such that `mat * x = rhs`.
+    [[nodiscard]] constexpr vector_type solve(const vector_type &rhs) const {
+        check_positive();
+        vector_type result = rhs;
+        cholesky::solve(factor_.data(), N, N, result.data(), 1, 1);
+        return result;
+    }
+
+    /// @brief Solves for all columns of `rhs` at once.
+    template <std::size_t K>
+    [[nodiscard]] constexpr Matrix<value_type, N, K> solve(const Matrix<value_type, N, K> &rhs) const {
+        check_positive();
+        Matrix<value_type, N, K> result = rhs;
+        cholesky::solve(factor_.data(), N, N, result.data(), K, K);
+        return result;
+    }
+
+    [[nodiscard]] constexpr matrix_type inverse() const {
+        matrix_type identity { value_type {} };
+        for (std::size_t i = 0; i < N; ++i) {
+            identity[i, i] = value_type { 1 };
+        }
+        return solve(identity);
+    }
+
+    /// @brief Lower triangular `L` with `mat = L * Lᵀ`.
+    [[nodiscard]] constexpr const matrix_type &factor() const noexcept { return factor_; }
+
+private:
+    constexpr void check_positive() const {
+        if (not positive_) {
+            throw std::runtime_error("matrix is not positive definite");
+        }
+    }
+
+    matrix_type factor_;
+    bool positive_ = false;
+};
+
+/// Cholesky factorization of a dynamic symmetric positive definite matrix,
+/// only its lower triangle is read.
+template <Numeric T>
+class DynCholesky {
+public:
+    using value_type = decomposition_type<T>;
+    using matrix_type = DynMatrix<value_type>;
+    using vector_type = DynVector<value_type>;
+
+    explicit DynCholesky(const DynMatrix<T> &mat)
+        : factor_(mat.rows(), mat.cols()) {
+        if (mat.rows() != mat.cols()) {
+            throw std::runtime_error("matrix is not square");
+        }
+        for (std::size_t i = 0; i < mat.size(); ++i) {
+            factor_[i] = static_cast<value_type>(mat[i]);
+        }
+        positive_ = cholesky::factor(factor_.data(), size(), size());
+        for (std::size_t i = 0; i < size(); ++i) {
+            for (std::size_t j = i + 1; j < size(); ++j) {
+                factor_[i, j] = value_type {};
+            }
+        }
+    }
+
+    /// @brief Order of the factored matrix.
+    [[nodiscard]] std::size_t size() const noexcept { return factor_.rows(); }
+
+    [[nodiscard]] bool is_positive_definite() const noexcept { return positive_; }
+
+    /// @brief Returns the determinant, zero if the matrix is not positive definite.
+    [[nodiscard]] value_type determinant() const noexcept {
+        if (not positive_) {
+            return value_type {};
+        }
+        value_type result { 1 };
+        for (std::size_t i = 0; i < size(); ++i) {
+            result *= factor_[i, i] * factor_[i, i];
+        }
+        return result;
+    }
+
+    /// @brief Returns `x` such that `mat * x = rhs`.
+    [[nodiscard]] vector_type solve(const vector_type &rhs) const {
+        check(rhs.size());
+        vector_type result = rhs;
+        cholesky::solve(factor_.data(), size(), size(), result.data(), 1, 1);
+        return result;
+    }
+
+    /// @brief Solves for all columns of `rhs` at once.
+    [[nodiscard]] matrix_type solve(const matrix_type &rhs) const {
+        check(rhs.rows());
+        matrix_type result = rhs;
+        cholesky::solve(factor_.data(), size(), size(), result.data(), rhs.cols(), rhs.cols());
+        return result;
+    }
+
+    [[nodiscard]] matrix_type inverse() const { return solve(matrix_type::identity(size())); }
+
+    /// @brief Lower triangular `L` with `mat = L * Lᵀ`.
+    [[nodiscard]] const matrix_type &factor() const noexcept { return factor_; }
+
+private:
+    void check(std::size_t rows) const {
+        if (rows != size()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+        if (not positive_) {
+            throw std::runtime_error("matrix is not positive definite");
+        }
+    }
+
+    matrix_type factor_;
+    bool positive_ = false;
+};
+
+/// Householder QR factorization of a fixed size matrix with at least as
+/// many rows as columns.
+template <Numeric T, std::size_t R, std::size_t C>
+    requires(R >= C)
+class QR {
+public:
+    using value_type = decomposition_type<T>;
+    using matrix_type = Matrix<value_type, R, C>;
+
+    explicit constexpr QR(const Matrix<T, R, C> &mat) {
+        for (std::size_t i = 0; i < R * C; ++i) {
+            factors_[i] = static_cast<value_type>(mat[i]);
+        }
+        std::array<value_type, C> work {};
+        qr::factor(factors_.data(), R, C, C, tau_.data(), work.data());
+    }
+
+    /// @brief True if a diagonal element of `R` is zero.
+    [[nodiscard]] constexpr bool is_rank_deficient() const noexcept {
+        for (std::size_t i = 0; i < C; ++i) {
+            if (factors_[i, i] == value_type {}) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Returns the `x` minimizing `‖mat * x - rhs‖`, which solves
+    /// `mat * x = rhs` for square matrices.
+    [[nodiscard]] constexpr Vector<value_type, C> solve(const Vector<value_type, R> &rhs) const {
+        check_rank();
+        Vector<value_type, R> projected = rhs;
+        value_type work {};
+        qr::solve(factors_.data(), R, C, C, tau_.data(), projected.data(), 1, 1, &work);
+        Vector<value_type, C> result;
+        for (std::size_t i = 0; i < C; ++i) {
+            result[i] = projected[i];
+        }
+        return result;
+    }
+
+    /// @brief Solves for all columns of `rhs` at once.
+    template <std::size_t K>
+    [[nodiscard]] constexpr Matrix<value_type, C, K> solve(const Matrix<value_type, R, K> &rhs) const {
+        check_rank();
+        Matrix<value_type, R, K> projected = rhs;
+        std::array<value_type, K> work {};
+        qr::solve(factors_.data(), R, C, C, tau_.data(), projected.data(), K, K, work.data());
+        Matrix<value_type, C, K> result;
+        for (std::size_t i = 0; i < C * K; ++i) {
+            result[i] = projected[i];
+        }
+        return result;
+    }
+
+    /// @brief First `C` columns of the orthogonal factor.
+    [[nodiscard]] constexpr matrix_type q() const {
+        matrix_type result;
+        std::array<value_type, C> work {};
+        qr::form_q(factors_.data(), R, C, C, tau_.data(), result.data(), C, work.data());
+        return result;
+    }
+
+    /// @brief Upper triangular factor.
+    [[nodiscard]] constexpr Matrix<value_type, C, C> r() const {
+        Matrix<value_type, C, C> result { value_type {} };
+        for (std::size_t i = 0; i < C; ++i) {
+            for (std::size_t j = i; j < C; ++j) {
+                result[i, j] = factors_[i, j];
+            }
+        }
+        return result;
+    }
+
+    /// @brief `R` and the Householder vectors, see `qr::factor`.
+    [[nodiscard]] constexpr const matrix_type &factors() const noexcept { return factors_; }
+
+    [[nodiscard]] constexpr const std::array<value_type, C> &tau() const noexcept { return tau_; }
+
+private:
+    constexpr void check_rank() const {
+        if (is_rank_deficient()) {
+            throw std::runtime_error("matrix is rank deficient");
+        }
+    }
+
+    matrix_type factors_;
+    std::array<value_type, C> tau_ {};
+};
+
+/// Householder QR factorization of a dynamic matrix with at least as many
+/// rows as columns.
+template <Numeric T>
+class DynQR {
+public:
+    using value_type = decomposition_type<T>;
+    using matrix_type = DynMatrix<value_type>;
+    using vector_type = DynVector<value_type>;
+
+    explicit DynQR(const DynMatrix<T> &mat)
+        : factors_(mat.rows(), mat.cols())
+        , tau_(mat.cols()) {
+        if (mat.rows() < mat.cols()) {
+            throw std::runtime_error("matrix has fewer rows than columns");
+        }
+        for (std::size_t i = 0; i < mat.size(); ++i) {
+            factors_[i] = static_cast<value_type>(mat[i]);
+        }
+        std::vector<value_type> work(cols());
+        qr::factor(factors_.data(), rows(), cols(), cols(), tau_.data(), work.data());
+    }
+
+    [[nodiscard]] std::size_t rows() const noexcept { return factors_.rows(); }
+    [[nodiscard]] std::size_t cols() const noexcept { return factors_.cols(); }
+
+    /// @brief True if a diagonal element of `R` is zero.
+    [[nodiscard]] bool is_rank_deficient() const noexcept {
+        for (std::size_t i = 0; i < cols(); ++i) {
+            if (factors_[i, i] == value_type {}) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Returns the `x` minimizing `‖mat * x - rhs‖`.
+    [[nodiscard]] vector_type solve(const vector_type &rhs) const {
+        check(rhs.size());
+        vector_type projected = rhs;
+        value_type work {};
+        qr::solve(factors_.data(), rows(), cols(), cols(), tau_.data(), projected.data(), 1, 1, &work);
+        vector_type result(cols());
+        for (std::size_t i = 0; i < cols(); ++i) {
+            result[i] = projected[i];
+        }
+        return result;
+    }
+
+    /// @brief Solves for all columns of `rhs` at once.
+    [[nodiscard]] matrix_type solve(const matrix_type &rhs) const {
+        check(rhs.rows());
+        matrix_type projected = rhs;
+        std::vector<value_type> work(rhs.cols());
+        qr::solve(factors_.data(), rows(), cols(), cols(), tau_.data(), projected.data(), rhs.cols(), rhs.cols(), work.data());
+        matrix_type result(cols(), rhs.cols());
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = projected[i];
+        }
+        return result;
+    }
+
+    /// @brief First `cols()` columns of the orthogonal factor.
+    [[nodiscard]] matrix_type q() const {
+        matrix_type result(rows(), cols());
+        std::vector<value_type> work(cols());
+        qr::form_q(factors_.data(), rows(), cols(), cols(), tau_.data(), result.data(), cols(), work.data());
+        return result;
+    }
+
+    /// @brief Upper triangular factor.
+    [[nodiscard]] matrix_type r() const {
+        matrix_type result(cols(), cols());
+        for (std::size_t i = 0; i < cols(); ++i) {
+            for (std::size_t j = i; j < cols(); ++j) {
+                result[i, j] = factors_[i, j];
+            }
+        }
+        return result;
+    }
+
+    /// @brief `R` and the Householder vectors, see `qr::factor`.
+    [[nodiscard]] const matrix_type &factors() const noexcept { return factors_; }
+
+    [[nodiscard]] const std::vector<value_type> &tau() const noexcept { return tau_; }
+
+private:
+    void check(std::size_t rows) const {
+        if (rows != this->rows()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+        if (is_rank_deficient()) {
+            throw std::runtime_error("matrix is rank deficient");
+        }
+    }
+
+    matrix_type factors_;
+    std::vector<value_type> tau_;
+};
+
+/// Singular value decomposition `mat = U * diag(sigma) * Vᵀ` of a 3x3
+/// matrix by `svd3::decompose`. `U` and `V` are rotations, so the last
+/// singular value has the sign of the determinant.
+template <Numeric T>
+class SVD3 {
+public:
+    using value_type = decomposition_type<T>;
+    using matrix_type = Matrix<value_type, 3, 3>;
+    using vector_type = Vector<value_type, 3>;
+
+    explicit constexpr SVD3(const Matrix<T, 3, 3> &mat) {
+        value_type a[9];
+        for (std::size_t i = 0; i < 9; ++i) {
+            a[i] = static_cast<value_type>(mat[i]);
+        }
+        value_type u[9];
+        value_type sigma[3];
+        value_type v[9];
+        svd3::decompose(a, u, sigma, v);
+        for (std::size_t i = 0; i < 9; ++i) {
+            u_[i] = u[i];
+            v_[i] = v[i];
+        }
+        for (std::size_t i = 0; i < 3; ++i) {
+            sigma_[i] = sigma[i];
+        }
+    }
+
+    [[nodiscard]] constexpr const matrix_type &u() const noexcept { return u_; }
+
+    /// @brief Singular values, sorted by decreasing magnitude.
+    [[nodiscard]] constexpr const vector_type &singular_values() const noexcept { return sigma_; }
+
+    [[nodiscard]] constexpr const matrix_type &v() const noexcept { return v_; }
+
+private:
+    matrix_type u_;
+    vector_type sigma_;
+    matrix_type v_;
+};
+
+/// Polar decomposition `mat = R * S` of a 3x3 matrix by `svd3::polar`, with
+/// a rotation `R` and a symmetric `S` that is positive semidefinite unless
+/// the determinant is negative.
+template <Numeric T>
+class Polar3 {
+public:
+    using value_type = decomposition_type<T>;
+    using matrix_type = Matrix<value_type, 3, 3>;
+
+    explicit constexpr Polar3(const Matrix<T, 3, 3> &mat) {
+        value_type a[9];
+        for (std::size_t i = 0; i < 9; ++i) {
+            a[i] = static_cast<value_type>(mat[i]);
+        }
+        value_type r[9];
+        value_type s[9];
+        svd3::polar(a, r, s);
+        for (std::size_t i = 0; i < 9; ++i) {
+            rotation_[i] = r[i];
+            stretch_[i] = s[i];
+        }
+    }
+
+    [[nodiscard]] constexpr const matrix_type &rotation() const noexcept { return rotation_; }
+
+    [[nodiscard]] constexpr const matrix_type &stretch() const noexcept { return stretch_; }
+
+private:
+    matrix_type rotation_;
+    matrix_type stretch_;
+};
+
+/// Eigendecomposition `mat = V * diag(values) * Vᵀ` of a symmetric 3x3
+/// matrix by `eigen3::decompose`, only its lower triangle is read. The
+/// eigenvalues increase and `V` is a rotation whose columns are the
+/// eigenvectors.
+template <Numeric T>
+class SymmetricEigen3 {
+public:
+    using value_type = decomposition_type<T>;
+    using matrix_type = Matrix<value_type, 3, 3>;
+    using vector_type = Vector<value_type, 3>;
+
+    explicit constexpr SymmetricEigen3(const Matrix<T, 3, 3> &mat) {
+        value_type a[9];
+        for (std::size_t i = 0; i < 9; ++i) {
+            a[i] = static_cast<value_type>(mat[i]);
+        }
+        value_type values[3];
+        value_type vectors[9];
+        eigen3::decompose(a, values, vectors);
+        for (std::size_t i = 0; i < 3; ++i) {
+            values_[i] = values[i];
+        }
+        for (std::size_t i = 0; i < 9; ++i) {
+            vectors_[i] = vectors[i];
+        }
+    }
+
+    [[nodiscard]] constexpr const vector_type &eigenvalues() const noexcept { return values_; }
+
+    [[nodiscard]] constexpr const matrix_type &eigenvectors() const noexcept { return vectors_; }
+
+private:
+    vector_type values_;
+    matrix_type vectors_;
+};
+
+namespace detail {
+
+    /// Adjugate of an order two or three matrix, `inverse = adjugate / det`.
+    template <typename R, std::size_t N, typename T>
+    constexpr Matrix<R, N, N> adjugate(const Matrix<T, N, N> &mat) noexcept {
+        const auto at = [&](std::size_t x, std::size_t y) { return static_cast<R>(mat[x, y]); };
+        Matrix<R, N, N> result;
+        if constexpr (N == 2) {
+            result[0, 0] = at(1, 1);
+            result[0, 1] = -at(0, 1);
+            result[1, 0] = -at(1, 0);
+            result[1, 1] = at(0, 0);
+        } else {
+            for (std::size_t i = 0; i < 3; ++i) {
+                const std::size_t i1 = (i + 1) % 3;
+                const std::size_t i2 = (i + 2) % 3;
+                for (std::size_t j = 0; j < 3; ++j) {
+                    const std::size_t j1 = (j + 1) % 3;
+                    const std::size_t j2 = (j + 2) % 3;
+                    // Cyclic indices give the cofactor its sign.
+                    result[j, i] = at(i1, j1) * at(i2, j2) - at(i1, j2) * at(i2, j1);
+                }
+            }
+        }
+        return result;
+    }
+
+    template <typename R>
+    constexpr R checked_determinant(double det) {
+        if (det == 0.0) {
+            throw std::runtime_error("matrix is singular");
+        }
+        return static_cast<R>(det);
+    }
+
+} // namespace detail
+
+/// @brief Returns the inverse of `mat`.
+template <Numeric T, std::size_t N>
+[[nodiscard]] constexpr Matrix<decomposition_type<T>, N, N> inverse(const Matrix<T, N, N> &mat) {
+    using R = decomposition_type<T>;
+    if constexpr (N == 2 or N == 3) {
+        const R det = detail::checked_determinant<R>(mat.determinant());
+        auto result = detail::adjugate<R>(mat);
+        for (std::size_t i = 0; i < N * N; ++i) {
+            result[i] /= det;
+        }
+        return result;
+    } else if constexpr (N == 4) {
+        Matrix4<R> converted;
+        for (std::size_t i = 0; i < 16; ++i) {
+            converted[i] = static_cast<R>(mat[i]);
+        }
+        return converted.inverse();
+    } else {
+        return LU<T, N>(mat).inverse();
+    }
+}
+
+/// @brief Returns `x` such that `mat * x = rhs`.
+template <Numeric T, std::size_t N>
+[[nodiscard]] constexpr Vector<decomposition_type<T>, N> solve(const Matrix<T, N, N> &mat, const Vector<decomposition_type<T>, N> &rhs) {
+    using R = decomposition_type<T>;
+    if constexpr (N == 2 or N == 3) {
+        const R det = detail::checked_determinant<R>(mat.determinant());
+        const auto adjugate = detail::adjugate<R>(mat);
+        Vector<R, N> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            R sum {};
+            for (std::size_t j = 0; j < N; ++j) {
+                sum += adjugate[i, j] * rhs[j];
+            }
+            result[i] = sum / det;
+        }
+        return result;
+    } else {
+        return LU<T, N>(mat).solve(rhs);
+    }
+}
+
+template <Numeric T>
+[[nodiscard]] DynMatrix<decomposition_type<T>> inverse(const DynMatrix<T> &mat) {
+    return DynLU<T>(mat).inverse();
+}
+
+template <Numeric T>
+[[nodiscard]] DynVector<decomposition_type<T>> solve(const DynMatrix<T> &mat, const DynVector<decomposition_type<T>> &rhs) {
+    return DynLU<T>(mat).solve(rhs);
+}
+
+} // namespace dk::math
+
+#endif // DK_MATH_DECOMPOSITION_HPP
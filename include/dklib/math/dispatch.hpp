@@ -0,0 +1,374 @@
+#ifndef DK_MATH_DISPATCH_HPP
+#define DK_MATH_DISPATCH_HPP
+
+/// @file dispatch.hpp
+///
+/// Runtime selection of the hot single precision kernels.
+///
+/// Every kernel is compiled once per supported instruction set through
+/// function target attributes, so one binary carries SSE4.2, AVX2 and AVX-512
+/// code paths regardless of the `-march` it was built with. The best variant
+/// is picked on first use from `cpuid` and can be overridden by setting the
+/// `DK_MATH_ISA` environment variable to one of the `to_string(Isa)` names.
+///
+/// Variants are allowed to contract multiplications and additions into FMA
+/// instructions, so results may differ in the last bits between machines.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <string_view>
+
+#include <dklib/math/gemm.hpp>
+#include <dklib/math/types.hpp>
+
+#if (defined(__GNUC__) or defined(__clang__)) and (defined(__x86_64__) or defined(__i386__))
+#define DK_DISPATCH_X86 1
+#define DK_TARGET(isa) [[gnu::target(isa)]]
+#else
+#define DK_DISPATCH_X86 0
+#define DK_TARGET(isa)
+#endif
+
+namespace dk::math::dispatch {
+
+/// Instruction sets with a dedicated kernel variant, ordered by preference.
+enum class Isa {
+    scalar = 0,
+    sse42 = 1,
+    avx2 = 2,
+    avx512 = 3,
+};
+
+[[nodiscard]] constexpr std::string_view to_string(Isa isa) noexcept {
+    switch (isa) {
+    case Isa::sse42: return "sse4.2";
+    case Isa::avx2: return "avx2";
+    case Isa::avx512: return "avx512";
+    default: return "scalar";
+    }
+}
+
+/// Row-major `c = a * b` where `a` is `m x k`, `b` is `k x n` and `c` is `m x n`.
+using gemm_kernel = void (*)(std::size_t m, std::size_t n, std::size_t k, const float *a, const float *b, float *c) noexcept;
+
+/// `out[i] = dot(lhs[i], rhs[i])` over `count` packed xyz triplets.
+using dot3_kernel = void (*)(std::size_t count, const float *lhs, const float *rhs, float *out) noexcept;
+
+/// Normalizes `count` packed xyz triplets in place.
+using normalize3_kernel = void (*)(std::size_t count, float *xyz) noexcept;
+
+/// Rotates `count` packed xyz triplets by the unit quaternion `quat` stored
+/// as (x, y, z, w), `in` and `out` may be the same buffer.
+using rotate3_kernel = void (*)(std::size_t count, const float *quat, const float *in, float *out) noexcept;
+
+/// `out[i] = matrix * in[i]` over `count` packed xyzw quadruplets, `matrix`
+/// is a row-major 4x4 matrix, `in` and `out` may be the same buffer.
+using transform4_kernel = void (*)(std::size_t count, const float *matrix, const float *in, float *out) noexcept;
+
+/// Same as `transform4_kernel` for packed xyz triplets which are extended by
+/// `w`, 1 for points and 0 for directions, only xyz of the result is stored.
+using transform3_kernel = void (*)(std::size_t count, const float *matrix, float w, const float *in, float *out) noexcept;
+
+/// Same as `transform3_kernel` for vectors stored in separate x, y and z lanes.
+using transform3_soa_kernel = void (*)(
+    std::size_t count, const float *matrix, float w, const float *x, const float *y, const float *z, float *out_x, float *out_y,
+    float *out_z
+) noexcept;
+
+/// Same as `rotate3_kernel` for vectors stored in separate x, y and z lanes.
+using rotate3_soa_kernel = void (*)(
+    std::size_t count, const float *quat, const float *x, const float *y, const float *z, float *out_x, float *out_y, float *out_z
+) noexcept;
+
+struct KernelTable {
+    Isa isa;
+    gemm_kernel gemm;
+    dot3_kernel dot3;
+    normalize3_kernel normalize3;
+    rotate3_kernel rotate3;
+    transform4_kernel transform4;
+    transform3_kernel transform3;
+    transform3_soa_kernel transform3_soa;
+    rotate3_soa_kernel rotate3_soa;
+};
+
+namespace detail {
+
+    /// Kernel bodies, they are force-inlined into every per-ISA entry point
+    /// below, so that each copy is compiled for the instruction set of its
+    /// caller.
+
+    DK_ALWAYS_INLINE void gemm(std::size_t m, std::size_t n, std::size_t k, const float *a, const float *b, float *c) noexcept {
+        gemm::multiply<float>(m, n, k, { a, k, 1 }, { b, n, 1 }, c, n);
+    }
+
+    DK_ALWAYS_INLINE void dot3(std::size_t count, const float *lhs, const float *rhs, float *out) noexcept {
+#pragma omp simd
+        for (std::size_t i = 0; i < count; ++i) {
+            const float *l = lhs + 3 * i;
+            const float *r = rhs + 3 * i;
+            out[i] = l[0] * r[0] + l[1] * r[1] + l[2] * r[2];
+        }
+    }
+
+    DK_ALWAYS_INLINE void normalize3(std::size_t count, float *xyz) noexcept {
+#pragma omp simd
+        for (std::size_t i = 0; i < count; ++i) {
+            float *v = xyz + 3 * i;
+            const float factor = 1.0f / std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+            v[0] *= factor;
+            v[1] *= factor;
+            v[2] *= factor;
+        }
+    }
+
+    /// Uses `v' = v + w * t + q x t` with `t = 2 * (q x v)`, which is the
+    /// expanded form of the `q * v * q^-1` sandwich product for unit `q`.
+    DK_ALWAYS_INLINE void rotate3(std::size_t count, const float *quat, const float *in, float *out) noexcept {
+        const float qx = quat[0];
+        const float qy = quat[1];
+        const float qz = quat[2];
+        const float qw = quat[3];
+#pragma omp simd
+        for (std::size_t i = 0; i < count; ++i) {
+            const float vx = in[3 * i + 0];
+            const float vy = in[3 * i + 1];
+            const float vz = in[3 * i + 2];
+            const float tx = 2.0f * (qy * vz - qz * vy);
+            const float ty = 2.0f * (qz * vx - qx * vz);
+            const float tz = 2.0f * (qx * vy - qy * vx);
+            out[3 * i + 0] = vx + qw * tx + (qy * tz - qz * ty);
+            out[3 * i + 1] = vy + qw * ty + (qz * tx - qx * tz);
+            out[3 * i + 2] = vz + qw * tz + (qx * ty - qy * tx);
+        }
+    }
+
+    DK_ALWAYS_INLINE void rotate3_soa(
+        std::size_t count, const float *quat, const float *x, const float *y, const float *z, float *out_x, float *out_y, float *out_z
+    ) noexcept {
+        const float qx = quat[0];
+        const float qy = quat[1];
+        const float qz = quat[2];
+        const float qw = quat[3];
+#pragma omp simd
+        for (std::size_t i = 0; i < count; ++i) {
+            const float vx = x[i];
+            const float vy = y[i];
+            const float vz = z[i];
+            const float tx = 2.0f * (qy * vz - qz * vy);
+            const float ty = 2.0f * (qz * vx - qx * vz);
+            const float tz = 2.0f * (qx * vy - qy * vx);
+            out_x[i] = vx + qw * tx + (qy * tz - qz * ty);
+            out_y[i] = vy + qw * ty + (qz * tx - qx * tz);
+            out_z[i] = vz + qw * tz + (qx * ty - qy * tx);
+        }
+    }
+
+    /// The matrix entries are loaded once and stay in registers for the whole
+    /// batch, the loop is vectorized across vertices.
+    DK_ALWAYS_INLINE void transform4(std::size_t count, const float *matrix, const float *in, float *out) noexcept {
+        const float m00 = matrix[0], m01 = matrix[1], m02 = matrix[2], m03 = matrix[3];
+        const float m10 = matrix[4], m11 = matrix[5], m12 = matrix[6], m13 = matrix[7];
+        const float m20 = matrix[8], m21 = matrix[9], m22 = matrix[10], m23 = matrix[11];
+        const float m30 = matrix[12], m31 = matrix[13], m32 = matrix[14], m33 = matrix[15];
+#pragma omp simd
+        for (std::size_t i = 0; i < count; ++i) {
+            const float x = in[4 * i + 0];
+            const float y = in[4 * i + 1];
+            const float z = in[4 * i + 2];
+            const float w = in[4 * i + 3];
+            out[4 * i + 0] = m00 * x + m01 * y + m02 * z + m03 * w;
+            out[4 * i + 1] = m10 * x + m11 * y + m12 * z + m13 * w;
+            out[4 * i + 2] = m20 * x + m21 * y + m22 * z + m23 * w;
+            out[4 * i + 3] = m30 * x + m31 * y + m32 * z + m33 * w;
+        }
+    }
+
+    DK_ALWAYS_INLINE void transform3(std::size_t count, const float *matrix, float w, const float *in, float *out) noexcept {
+        const float m00 = matrix[0], m01 = matrix[1], m02 = matrix[2], m03 = matrix[3] * w;
+        const float m10 = matrix[4], m11 = matrix[5], m12 = matrix[6], m13 = matrix[7] * w;
+        const float m20 = matrix[8], m21 = matrix[9], m22 = matrix[10], m23 = matrix[11] * w;
+#pragma omp simd
+        for (std::size_t i = 0; i < count; ++i) {
+            const float x = in[3 * i + 0];
+            const float y = in[3 * i + 1];
+            const float z = in[3 * i + 2];
+            out[3 * i + 0] = m00 * x + m01 * y + m02 * z + m03;
+            out[3 * i + 1] = m10 * x + m11 * y + m12 * z + m13;
+            out[3 * i + 2] = m20 * x + m21 * y + m22 * z + m23;
+        }
+    }
+
+    DK_ALWAYS_INLINE void transform3_soa(
+        std::size_t count, const float *matrix, float w, const float *x, const float *y, const float *z, float *out_x, float *out_y,
+        float *out_z
+    ) noexcept {
+        const float m00 = matrix[0], m01 = matrix[1], m02 = matrix[2], m03 = matrix[3] * w;
+        const float m10 = matrix[4], m11 = matrix[5], m12 = matrix[6], m13 = matrix[7] * w;
+        const float m20 = matrix[8], m21 = matrix[9], m22 = matrix[10], m23 = matrix[11] * w;
+#pragma omp simd
+        for (std::size_t i = 0; i < count; ++i) {
+            const float vx = x[i];
+            const float vy = y[i];
+            const float vz = z[i];
+            out_x[i] = m00 * vx + m01 * vy + m02 * vz + m03;
+            out_y[i] = m10 * vx + m11 * vy + m12 * vz + m13;
+            out_z[i] = m20 * vx + m21 * vy + m22 * vz + m23;
+        }
+    }
+
+#define DK_DISPATCH_VARIANT(suffix, target)                                                                                          \
+    DK_TARGET(target)                                                                                                                \
+    inline void gemm_##suffix(std::size_t m, std::size_t n, std::size_t k, const float *a, const float *b, float *c) noexcept { \
+        gemm(m, n, k, a, b, c);                                                                                                      \
+    }                                                                                                                                \
+    DK_TARGET(target)                                                                                                                \
+    inline void dot3_##suffix(std::size_t count, const float *lhs, const float *rhs, float *out) noexcept {                        \
+        dot3(count, lhs, rhs, out);                                                                                                  \
+    }                                                                                                                                \
+    DK_TARGET(target)                                                                                                                \
+    inline void normalize3_##suffix(std::size_t count, float *xyz) noexcept {                                                     \
+        normalize3(count, xyz);                                                                                                      \
+    }                                                                                                                                \
+    DK_TARGET(target)                                                                                                                \
+    inline void rotate3_##suffix(std::size_t count, const float *quat, const float *in, float *out) noexcept {                    \
+        rotate3(count, quat, in, out);                                                                                               \
+    }                                                                                                                                \
+    DK_TARGET(target)                                                                                                                \
+    inline void transform4_##suffix(std::size_t count, const float *matrix, const float *in, float *out) noexcept {               \
+        transform4(count, matrix, in, out);                                                                                          \
+    }                                                                                                                                \
+    DK_TARGET(target)                                                                                                                \
+    inline void transform3_##suffix(std::size_t count, const float *matrix, float w, const float *in, float *out) noexcept {      \
+        transform3(count, matrix, w, in, out);                                                                                       \
+    }                                                                                                                                \
+    DK_TARGET(target)                                                                                                                \
+    inline void transform3_soa_##suffix(                                                                                             \
+        std::size_t count, const float *matrix, float w, const float *x, const float *y, const float *z, float *out_x,             \
+        float *out_y, float *out_z                                                                                                   \
+    ) noexcept {                                                                                                                     \
+        transform3_soa(count, matrix, w, x, y, z, out_x, out_y, out_z);                                                              \
+    }                                                                                                                                \
+    DK_TARGET(target)                                                                                                                \
+    inline void rotate3_soa_##suffix(                                                                                                \
+        std::size_t count, const float *quat, const float *x, const float *y, const float *z, float *out_x, float *out_y,          \
+        float *out_z                                                                                                                 \
+    ) noexcept {                                                                                                                     \
+        rotate3_soa(count, quat, x, y, z, out_x, out_y, out_z);                                                                      \
+    }
+
+    inline void gemm_scalar(std::size_t m, std::size_t n, std::size_t k, const float *a, const float *b, float *c) noexcept {
+        gemm(m, n, k, a, b, c);
+    }
+    inline void dot3_scalar(std::size_t count, const float *lhs, const float *rhs, float *out) noexcept {
+        dot3(count, lhs, rhs, out);
+    }
+    inline void normalize3_scalar(std::size_t count, float *xyz) noexcept {
+        normalize3(count, xyz);
+    }
+    inline void rotate3_scalar(std::size_t count, const float *quat, const float *in, float *out) noexcept {
+        rotate3(count, quat, in, out);
+    }
+    inline void transform4_scalar(std::size_t count, const float *matrix, const float *in, float *out) noexcept {
+        transform4(count, matrix, in, out);
+    }
+    inline void transform3_scalar(std::size_t count, const float *matrix, float w, const float *in, float *out) noexcept {
+        transform3(count, matrix, w, in, out);
+    }
+    inline void transform3_soa_scalar(
+        std::size_t count, const float *matrix, float w, const float *x, const float *y, const float *z, float *out_x, float *out_y,
+        float *out_z
+    ) noexcept {
+        transform3_soa(count, matrix, w, x, y, z, out_x, out_y, out_z);
+    }
+    inline void rotate3_soa_scalar(
+        std::size_t count, const float *quat, const float *x, const float *y, const float *z, float *out_x, float *out_y, float *out_z
+    ) noexcept {
+        rotate3_soa(count, quat, x, y, z, out_x, out_y, out_z);
+    }
+
+#if DK_DISPATCH_X86
+    DK_DISPATCH_VARIANT(sse42, "sse4.2")
+    DK_DISPATCH_VARIANT(avx2, "avx2,fma")
+    DK_DISPATCH_VARIANT(avx512, "avx512f,avx512vl,avx512dq,avx2,fma")
+#endif
+
+#undef DK_DISPATCH_VARIANT
+
+    inline Isa isa_from_environment(Isa detected) noexcept {
+        const char *value = std::getenv("DK_MATH_ISA");
+        if (value == nullptr) {
+            return detected;
+        }
+        for (auto isa : { Isa::scalar, Isa::sse42, Isa::avx2, Isa::avx512 }) {
+            // Requests for an unsupported instruction set are ignored.
+            if (to_string(isa) == value and isa <= detected) {
+                return isa;
+            }
+        }
+        return detected;
+    }
+
+} // namespace detail
+
+/// @brief Returns the best instruction set supported by the running CPU.
+[[nodiscard]] inline Isa detect_isa() noexcept {
+#if DK_DISPATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512vl")
+        and __builtin_cpu_supports("avx512dq")) {
+        return Isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma")) {
+        return Isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return Isa::sse42;
+    }
+#endif
+    return Isa::scalar;
+}
+
+/// @brief Returns the kernels compiled for the given instruction set.
+///
+/// It does not check whether the CPU supports it, which makes it possible to
+/// compare the variants with each other.
+[[nodiscard]] constexpr KernelTable kernels_for(Isa isa) noexcept {
+    switch (isa) {
+#if DK_DISPATCH_X86
+    case Isa::avx512:
+        return { isa, detail::gemm_avx512, detail::dot3_avx512, detail::normalize3_avx512, detail::rotate3_avx512,
+                 detail::transform4_avx512, detail::transform3_avx512, detail::transform3_soa_avx512,
+                 detail::rotate3_soa_avx512 };
+    case Isa::avx2:
+        return { isa, detail::gemm_avx2, detail::dot3_avx2, detail::normalize3_avx2, detail::rotate3_avx2,
+                 detail::transform4_avx2, detail::transform3_avx2, detail::transform3_soa_avx2,
+                 detail::rotate3_soa_avx2 };
+    case Isa::sse42:
+        return { isa, detail::gemm_sse42, detail::dot3_sse42, detail::normalize3_sse42, detail::rotate3_sse42,
+                 detail::transform4_sse42, detail::transform3_sse42, detail::transform3_soa_sse42,
+                 detail::rotate3_soa_sse42 };
+#endif
+    default:
+        return { Isa::scalar, detail::gemm_scalar, detail::dot3_scalar, detail::normalize3_scalar, detail::rotate3_scalar,
+                 detail::transform4_scalar, detail::transform3_scalar, detail::transform3_soa_scalar,
+                 detail::rotate3_soa_scalar };
+    }
+}
+
+/// @brief Returns the kernel table selected for this process.
+///
+/// The selection happens once, on the first call.
+[[nodiscard]] inline const KernelTable &kernels() noexcept {
+    static const KernelTable table = kernels_for(detail::isa_from_environment(detect_isa()));
+    return table;
+}
+
+/// @brief Returns the instruction set the kernels were selected for, this is
+/// mostly meant for logging.
+[[nodiscard]] inline Isa active_isa() noexcept { return kernels().isa; }
+
+} // namespace dk::math::dispatch
+
+#endif // DK_MATH_DISPATCH_HPP
@@ -0,0 +1,471 @@
+#ifndef DK_MATH_DYN_MATRIX_HPP
+#define DK_MATH_DYN_MATRIX_HPP
+
+/// @file dyn_matrix.hpp
+///
+/// Row-major matrix whose extents are only known at runtime.
+///
+/// `DynMatrix` is the heap allocated counterpart of `Matrix`: the storage is
+/// cache line aligned and taken from a `std::pmr::memory_resource`,
+/// element-wise operators run the loops from `elementwise.hpp` and products
+/// the blocked GEMM from `gemm.hpp`, with the same size heuristic as the fixed
+/// size `operator*`. Operands of mismatching shape throw. Binary operators
+/// reuse the storage of an rvalue operand and `multiply_into` writes into an
+/// existing matrix, so products in a loop only allocate on the first
+/// iteration.
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <dklib/math/aligned_allocator.hpp>
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/dyn_vector.hpp>
+#include <dklib/math/elementwise.hpp>
+#include <dklib/math/execution.hpp>
+#include <dklib/math/gemm.hpp>
+#include <dklib/math/lu.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/matrix_concepts.hpp>
+#include <dklib/math/transpose.hpp>
+#include <dklib/math/types.hpp>
+#include <dklib/math/view.hpp>
+#include <dklib/math/workspace.hpp>
+
+namespace dk::math {
+
+template <Numeric T = real>
+class DynMatrix {
+public:
+    using value_type = T;
+    using vector_type = DynVector<T>;
+    using allocator_type = ResourceAllocator<T>;
+    using storage_type = std::vector<T, allocator_type>;
+
+    DynMatrix() = default;
+
+    explicit DynMatrix(const allocator_type &alloc) noexcept
+        : elems_(alloc) { }
+
+    /// @brief Creates a `rows x cols` matrix with every element set to `value`.
+    DynMatrix(std::size_t rows, std::size_t cols, T value = T {}, const allocator_type &alloc = {})
+        : rows_ { rows }
+        , cols_ { cols }
+        , elems_(rows * cols, value, alloc) { }
+
+    /// @brief Creates a matrix from its rows, which must have the same length.
+    DynMatrix(std::initializer_list<std::initializer_list<T>> rows, const allocator_type &alloc = {})
+        : rows_ { rows.size() }
+        , cols_ { rows.size() == 0 ? 0 : rows.begin()->size() }
+        , elems_(alloc) {
+        elems_.reserve(rows_ * cols_);
+        for (const auto &row : rows) {
+            if (row.size() != cols_) {
+                throw std::runtime_error("dimension mismatch");
+            }
+            elems_.insert(elems_.end(), row.begin(), row.end());
+        }
+    }
+
+    template <std::size_t Rows, std::size_t Cols>
+    explicit DynMatrix(const Matrix<T, Rows, Cols> &mat, const allocator_type &alloc = {})
+        : rows_ { Rows }
+        , cols_ { Cols }
+        , elems_(mat.data(), mat.data() + Rows * Cols, alloc) { }
+
+    /// @brief Copies the elements of a possibly strided view.
+    explicit DynMatrix(MatrixView<const T> source, const allocator_type &alloc = {})
+        : DynMatrix(source.rows(), source.cols(), T {}, alloc) {
+        assign(MatrixView<T> { data(), rows_, cols_ }, source);
+    }
+
+    DynMatrix(const DynMatrix &) = default;
+    DynMatrix &operator=(const DynMatrix &) = default;
+
+    /// @brief Copies `other` into storage taken from `alloc`.
+    DynMatrix(const DynMatrix &other, const allocator_type &alloc)
+        : rows_ { other.rows_ }
+        , cols_ { other.cols_ }
+        , elems_(other.elems_, alloc) { }
+
+    /// Moves leave an empty `0 x 0` matrix behind.
+    DynMatrix(DynMatrix &&other) noexcept
+        : rows_ { std::exchange(other.rows_, 0) }
+        , cols_ { std::exchange(other.cols_, 0) }
+        , elems_ { std::move(other.elems_) } { }
+
+    DynMatrix &operator=(DynMatrix &&other) noexcept {
+        rows_ = std::exchange(other.rows_, 0);
+        cols_ = std::exchange(other.cols_, 0);
+        elems_ = std::move(other.elems_);
+        return *this;
+    }
+
+    [[nodiscard]] static DynMatrix zero(std::size_t rows, std::size_t cols) { return DynMatrix(rows, cols); }
+
+    [[nodiscard]] static DynMatrix identity(std::size_t size) { return diagonal(vector_type(size, T { 1 })); }
+
+    [[nodiscard]] static DynMatrix diagonal(const vector_type &values) {
+        DynMatrix result(values.size(), values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            result[i, i] = values[i];
+        }
+        return result;
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return elems_.get_allocator(); }
+
+    [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+    [[nodiscard]] std::size_t cols() const noexcept { return cols_; }
+    [[nodiscard]] std::size_t size() const noexcept { return elems_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return elems_.empty(); }
+
+    /// @brief Changes the extents, the elements are unspecified afterwards.
+    /// Storage is kept when shrinking, so going back to a previous size does
+    /// not allocate.
+    void resize(std::size_t rows, std::size_t cols) {
+        rows_ = rows;
+        cols_ = cols;
+        elems_.resize(rows * cols);
+    }
+
+    [[nodiscard]] T &operator[](std::size_t idx) noexcept { return elems_[idx]; }
+    [[nodiscard]] T operator[](std::size_t idx) const noexcept { return elems_[idx]; }
+
+    [[nodiscard]] T &operator[](std::size_t x, std::size_t y) noexcept { return elems_[x * cols_ + y]; }
+    [[nodiscard]] T operator[](std::size_t x, std::size_t y) const noexcept { return elems_[x * cols_ + y]; }
+
+    [[nodiscard]] T &at(std::size_t x, std::size_t y) {
+        if (x >= rows_ or y >= cols_) {
+            throw std::runtime_error("index is out of bounds");
+        }
+        return elems_[x * cols_ + y];
+    }
+
+    [[nodiscard]] T at(std::size_t x, std::size_t y) const {
+        if (x >= rows_ or y >= cols_) {
+            throw std::runtime_error("index is out of bounds");
+        }
+        return elems_[x * cols_ + y];
+    }
+
+    [[nodiscard]] T *data() noexcept { return elems_.data(); }
+    [[nodiscard]] const T *data() const noexcept { return elems_.data(); }
+
+    [[nodiscard]] std::span<T> row(std::size_t x) noexcept { return { data() + x * cols_, cols_ }; }
+    [[nodiscard]] std::span<const T> row(std::size_t x) const noexcept { return { data() + x * cols_, cols_ }; }
+
+    [[nodiscard]] DynMatrix transpose() const {
+        DynMatrix result(cols_, rows_);
+        transposition::transpose_into(data(), rows_, cols_, cols_, result.data(), rows_);
+        return result;
+    }
+
+    /// @brief Transposes a square matrix without a second copy of it.
+    DynMatrix &transpose_inplace() {
+        if (rows_ != cols_) {
+            throw std::runtime_error("matrix is not square");
+        }
+        transposition::transpose_square(data(), rows_, cols_);
+        return *this;
+    }
+
+    /// @brief Returns the determinant, evaluated in double precision by an
+    /// LU factorization of a copy.
+    [[nodiscard]] double determinant() const {
+        if (rows_ != cols_) {
+            throw std::runtime_error("matrix is not square");
+        }
+        std::vector<double> factored(elems_.begin(), elems_.end());
+        std::vector<std::size_t> pivots(rows_);
+        const int sign = lu::factor(factored.data(), rows_, cols_, pivots.data());
+        return sign == 0 ? 0.0 : lu::determinant(factored.data(), rows_, cols_, sign);
+    }
+
+    DynMatrix &operator-() noexcept {
+        std::ranges::transform(elems_, elems_.begin(), std::negate<T>());
+        return *this;
+    }
+
+    DynMatrix &operator+=(const DynMatrix &other) {
+        check_shape(other);
+        detail::elementwise(size(), data(), data(), other.data(), std::plus<T>());
+        return *this;
+    }
+
+    DynMatrix &operator-=(const DynMatrix &other) {
+        check_shape(other);
+        detail::elementwise(size(), data(), data(), other.data(), std::minus<T>());
+        return *this;
+    }
+
+    /// @brief Replaces the matrix by the product `*this * other`.
+    DynMatrix &operator*=(const DynMatrix &other);
+
+    template <std::convertible_to<T> T1>
+    DynMatrix &operator*=(T1 value) noexcept {
+        detail::elementwise_scalar(size(), data(), data(), value, std::multiplies<>());
+        return *this;
+    }
+
+    template <std::convertible_to<T> T1>
+    DynMatrix &operator/=(T1 value) {
+        if (value == 0) {
+            throw std::runtime_error("Division by zero");
+        }
+        detail::elementwise_scalar(size(), data(), data(), value, std::divides<>());
+        return *this;
+    }
+
+    friend bool operator==(const DynMatrix &lhs, const DynMatrix &rhs) noexcept {
+        return lhs.rows_ == rhs.rows_ and lhs.cols_ == rhs.cols_ and lhs.elems_ == rhs.elems_;
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const DynMatrix &mat) {
+        os << '(';
+        for (std::size_t i = 0; i < mat.rows(); ++i) {
+            os << (i == 0 ? "(" : ", (");
+            for (std::size_t j = 0; j < mat.cols(); ++j) {
+                os << (j == 0 ? "" : ", ") << mat[i, j];
+            }
+            os << ')';
+        }
+        return os << ')';
+    }
+
+private:
+    void check_shape(const DynMatrix &other) const {
+        if (rows_ != other.rows_ or cols_ != other.cols_) {
+            throw std::runtime_error("dimension mismatch");
+        }
+    }
+
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    storage_type elems_;
+};
+
+namespace detail {
+
+    template <Numeric T>
+    void check_product(const DynMatrix<T> &lhs, const DynMatrix<T> &rhs, const DynMatrix<T> &result) {
+        if (lhs.cols() != rhs.rows()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+        if (&result == &lhs or &result == &rhs) {
+            throw std::runtime_error("product must not alias its operands");
+        }
+    }
+
+} // namespace detail
+
+/// @brief Computes `result = lhs * rhs`, resizing `result` as needed, which
+/// must not be one of the operands.
+///
+/// Products with every extent of at least `gemm::min_blocked_dimension` use
+/// the blocked GEMM, smaller ones the plain triple loop, like `operator*` of
+/// the fixed size matrices.
+template <Numeric T>
+void multiply_into(const DynMatrix<T> &lhs, const DynMatrix<T> &rhs, DynMatrix<T> &result) {
+    detail::check_product(lhs, rhs, result);
+    const std::size_t m = lhs.rows();
+    const std::size_t n = rhs.cols();
+    const std::size_t k = lhs.cols();
+    result.resize(m, n);
+    if (std::min({ m, n, k }) >= gemm::min_blocked_dimension) {
+        gemm::multiply<T>(m, n, k, { lhs.data(), k, 1 }, { rhs.data(), n, 1 }, result.data(), n);
+        return;
+    }
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            T sum {};
+            for (std::size_t p = 0; p < k; ++p) {
+                sum += lhs[i, p] * rhs[p, j];
+            }
+            result[i, j] = sum;
+        }
+    }
+}
+
+/// @brief Same as `multiply_into` with tiles of the result computed in
+/// parallel, small products run on the calling thread.
+template <Numeric T>
+void multiply_into(const execution::parallel_policy &policy, const DynMatrix<T> &lhs, const DynMatrix<T> &rhs, DynMatrix<T> &result) {
+    detail::check_product(lhs, rhs, result);
+    const std::size_t m = lhs.rows();
+    const std::size_t n = rhs.cols();
+    const std::size_t k = lhs.cols();
+    if (std::min({ m, n, k }) < gemm::min_blocked_dimension) {
+        multiply_into(lhs, rhs, result);
+        return;
+    }
+    result.resize(m, n);
+    gemm::multiply<T>(policy, m, n, k, { lhs.data(), k, 1 }, { rhs.data(), n, 1 }, result.data(), n);
+}
+
+/// @brief Same as `multiply_into` with the GEMM packing buffers borrowed from
+/// `workspace` rather than the per-thread ones.
+template <Numeric T>
+void multiply_into(Workspace &workspace, const DynMatrix<T> &lhs, const DynMatrix<T> &rhs, DynMatrix<T> &result) {
+    detail::check_product(lhs, rhs, result);
+    const std::size_t m = lhs.rows();
+    const std::size_t n = rhs.cols();
+    const std::size_t k = lhs.cols();
+    if (std::min({ m, n, k }) < gemm::min_blocked_dimension) {
+        multiply_into(lhs, rhs, result);
+        return;
+    }
+    result.resize(m, n);
+    gemm::multiply<T>(workspace, m, n, k, { lhs.data(), k, 1 }, { rhs.data(), n, 1 }, result.data(), n);
+}
+
+template <Numeric T>
+DynMatrix<T> operator*(const DynMatrix<T> &lhs, const DynMatrix<T> &rhs) {
+    DynMatrix<T> result;
+    multiply_into(lhs, rhs, result);
+    return result;
+}
+
+template <Numeric T>
+DynMatrix<T> multiply(execution::sequenced_policy, const DynMatrix<T> &lhs, const DynMatrix<T> &rhs) {
+    return lhs * rhs;
+}
+
+template <Numeric T>
+DynMatrix<T> multiply(const execution::parallel_policy &policy, const DynMatrix<T> &lhs, const DynMatrix<T> &rhs) {
+    DynMatrix<T> result;
+    multiply_into(policy, lhs, rhs, result);
+    return result;
+}
+
+template <Numeric T>
+DynMatrix<T> &DynMatrix<T>::operator*=(const DynMatrix &other) {
+    return *this = *this * other;
+}
+
+/// @brief Matrix-vector product, `result[r]` is the dot product of row `r`
+/// with `vec`.
+template <Numeric T>
+DynVector<T> operator*(const DynMatrix<T> &mat, const DynVector<T> &vec) {
+    if (mat.cols() != vec.size()) {
+        throw std::runtime_error("dimension mismatch");
+    }
+    DynVector<T> result(mat.rows());
+    for (std::size_t i = 0; i < mat.rows(); ++i) {
+        const T *row = mat.data() + i * mat.cols();
+        T sum {};
+        for (std::size_t p = 0; p < mat.cols(); ++p) {
+            sum += row[p] * vec[p];
+        }
+        result[i] = sum;
+    }
+    return result;
+}
+
+template <Numeric T>
+DynMatrix<T> operator+(DynMatrix<T> lhs, const DynMatrix<T> &rhs) {
+    return std::move(lhs += rhs);
+}
+
+template <Numeric T>
+DynMatrix<T> operator+(const DynMatrix<T> &lhs, DynMatrix<T> &&rhs) {
+    return std::move(rhs += lhs);
+}
+
+template <Numeric T>
+DynMatrix<T> operator-(DynMatrix<T> lhs, const DynMatrix<T> &rhs) {
+    return std::move(lhs -= rhs);
+}
+
+template <Numeric T, std::convertible_to<double> F>
+DynMatrix<T> operator*(DynMatrix<T> mat, F value) noexcept {
+    return std::move(mat *= value);
+}
+
+template <Numeric T, std::convertible_to<double> F>
+DynMatrix<T> operator*(F value, DynMatrix<T> mat) noexcept {
+    return std::move(mat *= value);
+}
+
+template <Numeric T, std::floating_point F>
+DynMatrix<T> operator/(DynMatrix<T> mat, F value) {
+    return std::move(mat /= value);
+}
+
+template <Numeric T>
+[[nodiscard]] MatrixView<T> view(DynMatrix<T> &mat) noexcept {
+    return { mat.data(), mat.rows(), mat.cols() };
+}
+
+template <Numeric T>
+[[nodiscard]] MatrixView<const T> view(const DynMatrix<T> &mat) noexcept {
+    return { mat.data(), mat.rows(), mat.cols() };
+}
+
+template <Numeric T>
+void view(const DynMatrix<T> &&) = delete;
+
+template <Numeric T>
+[[nodiscard]] Transposed<DynMatrix<T>> transposed(const DynMatrix<T> &mat) noexcept {
+    return Transposed<DynMatrix<T>> { mat };
+}
+
+template <Numeric T>
+void transposed(const DynMatrix<T> &&) = delete;
+
+namespace detail {
+
+    template <Numeric T>
+    DynMatrix<T> multiply_views(MatrixView<const T> lhs, MatrixView<const T> rhs) {
+        DynMatrix<T> result(lhs.rows(), rhs.cols());
+        multiply_into(lhs, rhs, view(result));
+        return result;
+    }
+
+} // namespace detail
+
+/// @brief `lhsᵀ * rhs` without building `lhsᵀ`, see `multiply_into` of the
+/// views for the kernels.
+template <Numeric T>
+DynMatrix<T> operator*(const Transposed<DynMatrix<T>> &lhs, const DynMatrix<T> &rhs) {
+    return detail::multiply_views<T>(view(lhs.base()).transpose(), view(rhs));
+}
+
+template <Numeric T>
+DynMatrix<T> operator*(const DynMatrix<T> &lhs, const Transposed<DynMatrix<T>> &rhs) {
+    return detail::multiply_views<T>(view(lhs), view(rhs.base()).transpose());
+}
+
+template <Numeric T>
+DynMatrix<T> operator*(const Transposed<DynMatrix<T>> &lhs, const Transposed<DynMatrix<T>> &rhs) {
+    return detail::multiply_views<T>(view(lhs.base()).transpose(), view(rhs.base()).transpose());
+}
+
+/// @brief `matᵀ * vec`, the sum of the rows of `mat` scaled by the elements
+/// of `vec`.
+template <Numeric T>
+DynVector<T> operator*(const Transposed<DynMatrix<T>> &mat, const DynVector<T> &vec) {
+    const auto &a = mat.base();
+    if (a.rows() != vec.size()) {
+        throw std::runtime_error("dimension mismatch");
+    }
+    DynVector<T> result(a.cols());
+    for (std::size_t p = 0; p < a.rows(); ++p) {
+        const T scale = vec[p];
+        const T *row = a.data() + p * a.cols();
+        for (std::size_t i = 0; i < a.cols(); ++i) {
+            result[i] += scale * row[i];
+        }
+    }
+    return result;
+}
+
+} // namespace dk::math
+
+#endif // DK_MATH_DYN_MATRIX_HPP
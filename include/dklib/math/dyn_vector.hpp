@@ -0,0 +1,267 @@
+#ifndef DK_MATH_DYN_VECTOR_HPP
+#define DK_MATH_DYN_VECTOR_HPP
+
+/// @file dyn_vector.hpp
+///
+/// Vector whose size is only known at runtime.
+///
+/// `DynVector` keeps its elements in cache line aligned heap storage, taken
+/// from a `std::pmr::memory_resource` (the default one unless a constructor
+/// is given another, such as `Workspace::resource()`), and offers the
+/// operators of the fixed size `Vector`, computed by the same loops from
+/// `elementwise.hpp`. Operands of mismatching size throw. Binary operators
+/// reuse the storage of an rvalue operand, so chains such as `a + b - c`
+/// allocate only once:
+///
+///     DynVector<float> v(count);
+///     auto w = v * 2.0f + v; // one allocation for `v * 2.0f`, reused by `+`
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <numeric>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <dklib/math/aligned_allocator.hpp>
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/elementwise.hpp>
+#include <dklib/math/types.hpp>
+#include <dklib/math/vector.hpp>
+#include <dklib/math/vector_concepts.hpp>
+#include <dklib/math/view.hpp>
+
+namespace dk::math {
+
+template <Numeric T = real>
+class DynVector {
+public:
+    using value_type = T;
+    using allocator_type = ResourceAllocator<T>;
+    using storage_type = std::vector<T, allocator_type>;
+
+    DynVector() = default;
+
+    explicit DynVector(const allocator_type &alloc) noexcept
+        : elems_(alloc) { }
+
+    /// @brief Creates `size` elements set to `value`.
+    explicit DynVector(std::size_t size, T value = T {}, const allocator_type &alloc = {})
+        : elems_(size, value, alloc) { }
+
+    DynVector(std::initializer_list<T> values, const allocator_type &alloc = {})
+        : elems_(values, alloc) { }
+
+    explicit DynVector(std::span<const T> values, const allocator_type &alloc = {})
+        : elems_(values.begin(), values.end(), alloc) { }
+
+    template <std::size_t Dims>
+    explicit DynVector(const Vector<T, Dims> &vec, const allocator_type &alloc = {})
+        : elems_(vec.data(), vec.data() + Dims, alloc) { }
+
+    /// @brief Copies the elements of a possibly strided view.
+    explicit DynVector(VectorView<const T> source, const allocator_type &alloc = {})
+        : elems_(source.size(), T {}, alloc) {
+        assign(VectorView<T> { data(), size() }, source);
+    }
+
+    DynVector(const DynVector &) = default;
+    DynVector(DynVector &&) noexcept = default;
+    DynVector &operator=(const DynVector &) = default;
+    DynVector &operator=(DynVector &&) noexcept = default;
+
+    /// @brief Copies `other` into storage taken from `alloc`.
+    DynVector(const DynVector &other, const allocator_type &alloc)
+        : elems_(other.elems_, alloc) { }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return elems_.get_allocator(); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return elems_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return elems_.empty(); }
+
+    /// @brief Changes the size, new elements are zero. Shrinking keeps the
+    /// storage, so growing back to the old size does not allocate.
+    void resize(std::size_t size) { elems_.resize(size); }
+
+    [[nodiscard]] T &operator[](std::size_t idx) noexcept { return elems_[idx]; }
+    [[nodiscard]] T operator[](std::size_t idx) const noexcept { return elems_[idx]; }
+
+    [[nodiscard]] T &at(std::size_t idx) {
+        if (idx >= size()) {
+            throw std::runtime_error("index out of bounds");
+        }
+        return elems_[idx];
+    }
+
+    [[nodiscard]] T at(std::size_t idx) const {
+        if (idx >= size()) {
+            throw std::runtime_error("index out of bounds");
+        }
+        return elems_[idx];
+    }
+
+    [[nodiscard]] T *data() noexcept { return elems_.data(); }
+    [[nodiscard]] const T *data() const noexcept { return elems_.data(); }
+
+    [[nodiscard]] auto begin() noexcept { return elems_.begin(); }
+    [[nodiscard]] auto begin() const noexcept { return elems_.begin(); }
+    [[nodiscard]] auto end() noexcept { return elems_.end(); }
+    [[nodiscard]] auto end() const noexcept { return elems_.end(); }
+
+    [[nodiscard]] double magnitude() const noexcept { return std::sqrt(magnitude_squared()); }
+
+    [[nodiscard]] double magnitude_squared() const noexcept {
+        double result = 0;
+        for (const auto v : elems_) {
+            result += static_cast<double>(v * v);
+        }
+        return result;
+    }
+
+    [[nodiscard]] double norm() const noexcept { return magnitude(); }
+
+    [[nodiscard]] double dot(const DynVector &other) const {
+        check_size(other);
+        return static_cast<double>(std::inner_product(elems_.begin(), elems_.end(), other.elems_.begin(), T {}));
+    }
+
+    DynVector &normalize() noexcept { return *this *= T { 1 } / norm(); }
+
+    [[nodiscard]] DynVector normalized() const & { return DynVector { *this }.normalize(); }
+    [[nodiscard]] DynVector normalized() && noexcept { return std::move(normalize()); }
+
+    DynVector &operator-() noexcept {
+        std::ranges::transform(elems_, elems_.begin(), std::negate<T>());
+        return *this;
+    }
+
+    DynVector &operator+=(const DynVector &other) {
+        check_size(other);
+        detail::elementwise(size(), data(), data(), other.data(), std::plus<T>());
+        return *this;
+    }
+
+    DynVector &operator-=(const DynVector &other) {
+        check_size(other);
+        detail::elementwise(size(), data(), data(), other.data(), std::minus<T>());
+        return *this;
+    }
+
+    DynVector &operator*=(const DynVector &other) {
+        check_size(other);
+        detail::elementwise(size(), data(), data(), other.data(), std::multiplies<T>());
+        return *this;
+    }
+
+    DynVector &operator/=(const DynVector &other) {
+        check_size(other);
+        if (detail::any_zero(other.size(), other.data())) {
+            throw std::runtime_error("Division by zero");
+        }
+        detail::elementwise(size(), data(), data(), other.data(), std::divides<T>());
+        return *this;
+    }
+
+    template <std::convertible_to<T> T1>
+    DynVector &operator*=(T1 value) noexcept {
+        detail::elementwise_scalar(size(), data(), data(), value, std::multiplies<>());
+        return *this;
+    }
+
+    template <std::convertible_to<T> T1>
+    DynVector &operator/=(T1 value) {
+        if (value == 0) {
+            throw std::runtime_error("Division by zero");
+        }
+        detail::elementwise_scalar(size(), data(), data(), value, std::divides<>());
+        return *this;
+    }
+
+    friend bool operator==(const DynVector &lhs, const DynVector &rhs) noexcept {
+        return lhs.elems_ == rhs.elems_;
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const DynVector &vec) {
+        os << '(';
+        for (std::size_t i = 0; i < vec.size(); ++i) {
+            os << (i == 0 ? "" : ", ") << vec[i];
+        }
+        return os << ')';
+    }
+
+private:
+    void check_size(const DynVector &other) const {
+        if (size() != other.size()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+    }
+
+    storage_type elems_;
+};
+
+template <Numeric T>
+DynVector<T> operator+(DynVector<T> lhs, const DynVector<T> &rhs) {
+    return std::move(lhs += rhs);
+}
+
+template <Numeric T>
+DynVector<T> operator+(const DynVector<T> &lhs, DynVector<T> &&rhs) {
+    return std::move(rhs += lhs);
+}
+
+template <Numeric T>
+DynVector<T> operator-(DynVector<T> lhs, const DynVector<T> &rhs) {
+    return std::move(lhs -= rhs);
+}
+
+template <Numeric T>
+DynVector<T> operator*(DynVector<T> lhs, const DynVector<T> &rhs) {
+    return std::move(lhs *= rhs);
+}
+
+template <Numeric T>
+DynVector<T> operator*(const DynVector<T> &lhs, DynVector<T> &&rhs) {
+    return std::move(rhs *= lhs);
+}
+
+template <Numeric T>
+DynVector<T> operator/(DynVector<T> lhs, const DynVector<T> &rhs) {
+    return std::move(lhs /= rhs);
+}
+
+template <Numeric T, std::convertible_to<double> F>
+DynVector<T> operator*(DynVector<T> vec, F value) noexcept {
+    return std::move(vec *= value);
+}
+
+template <Numeric T, std::convertible_to<double> F>
+DynVector<T> operator*(F value, DynVector<T> vec) noexcept {
+    return std::move(vec *= value);
+}
+
+template <Numeric T, std::floating_point F>
+DynVector<T> operator/(DynVector<T> vec, F value) {
+    return std::move(vec /= value);
+}
+
+template <Numeric T>
+[[nodiscard]] VectorView<T> view(DynVector<T> &vec) noexcept {
+    return { vec.data(), vec.size() };
+}
+
+template <Numeric T>
+[[nodiscard]] VectorView<const T> view(const DynVector<T> &vec) noexcept {
+    return { vec.data(), vec.size() };
+}
+
+template <Numeric T>
+void view(const DynVector<T> &&) = delete;
+
+} // namespace dk::math
+
+#endif // DK_MATH_DYN_VECTOR_HPP
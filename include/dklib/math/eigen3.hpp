@@ -0,0 +1,140 @@
+#ifndef DK_MATH_EIGEN3_HPP
+#define DK_MATH_EIGEN3_HPP
+
+/// @file eigen3.hpp
+///
+/// Eigendecomposition of row-major symmetric 3x3 matrices.
+///
+/// `decompose` computes `a = V * diag(values) * Vᵀ` with the cyclic Jacobi
+/// method: a fixed number of sweeps of rotations annihilate the
+/// off-diagonal elements in turn, accumulating them into `V`, whose columns
+/// are the eigenvectors. The eigenvalues are sorted in increasing order, so
+/// the first column is the normal of a point neighborhood whose covariance
+/// is decomposed, and `V` is always a rotation.
+///
+/// Like the kernels of `svd3.hpp`, which build on these rotations, there is
+/// no branching on the data and the number of sweeps is a template
+/// parameter, so the kernels vectorize across matrices, see
+/// `batch::symmetric_eigen` and `batch::neighborhood_normals`.
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+
+#include <dklib/math/types.hpp>
+
+namespace dk::math::eigen3 {
+
+/// Jacobi sweeps of `decompose`, enough to reach working precision in
+/// single and double precision, a third sweep is still short of it in
+/// single precision.
+inline constexpr std::size_t sweeps = 4;
+
+namespace detail {
+
+    /// Rotates columns `P` and `Q` of `m` by the angle with cosine `c` and
+    /// sine `s`.
+    template <std::size_t P, std::size_t Q, typename T>
+    DK_ALWAYS_INLINE constexpr void rotate_columns(T (&m)[3][3], T c, T s) noexcept {
+        for (std::size_t i = 0; i < 3; ++i) {
+            const T mp = m[i][P];
+            const T mq = m[i][Q];
+            m[i][P] = c * mp + s * mq;
+            m[i][Q] = c * mq - s * mp;
+        }
+    }
+
+    /// Annihilates `sym[P][Q]` of the symmetric `sym` by a Jacobi rotation,
+    /// which is accumulated into `v`.
+    template <std::size_t P, std::size_t Q, typename T>
+    DK_ALWAYS_INLINE constexpr void jacobi_rotation(T (&sym)[3][3], T (&v)[3][3]) noexcept {
+        constexpr std::size_t R = 3 - P - Q;
+        const T off = sym[P][Q];
+        // Elements negligible next to both diagonal elements are only
+        // zeroed: rotating them would create denormals in the following
+        // sweeps, which are very slow on most processors.
+        const T threshold = std::numeric_limits<T>::epsilon() * std::min(std::abs(sym[P][P]), std::abs(sym[Q][Q]));
+        const bool rotate = std::abs(off) > threshold;
+        // `t` is the smaller root of `t² + 2 * theta * t - 1 = 0`, the
+        // tangent of the angle. The selects only pick operands, so that no
+        // arithmetic is conditional and the compiler keeps the code free of
+        // branches.
+        const T theta = (sym[P][P] - sym[Q][Q]) / (T { 2 } * (rotate ? off : T { 1 }));
+        const T root = std::sqrt(T { 1 } + theta * theta);
+        const T t = (rotate ? T { 1 } : T {}) / (theta + std::copysign(root, theta));
+        const T c = T { 1 } / std::sqrt(T { 1 } + t * t);
+        const T s = t * c;
+
+        const T pr = sym[P][R];
+        const T qr = sym[Q][R];
+        sym[P][P] += t * off;
+        sym[Q][Q] -= t * off;
+        sym[P][Q] = sym[Q][P] = T {};
+        sym[P][R] = sym[R][P] = c * pr + s * qr;
+        sym[Q][R] = sym[R][Q] = c * qr - s * pr;
+        rotate_columns<P, Q>(v, c, s);
+    }
+
+    /// Cyclic sweeps over the off-diagonal elements, unrolled so that no
+    /// loop is left in the kernels.
+    template <std::size_t Sweeps, typename T>
+    DK_ALWAYS_INLINE constexpr void jacobi_sweeps(T (&sym)[3][3], T (&v)[3][3]) noexcept {
+        if constexpr (Sweeps > 0) {
+            jacobi_rotation<0, 1>(sym, v);
+            jacobi_rotation<0, 2>(sym, v);
+            jacobi_rotation<1, 2>(sym, v);
+            jacobi_sweeps<Sweeps - 1>(sym, v);
+        }
+    }
+
+    /// Swaps eigenvalues `P` and `Q` and the matching columns of `v` if
+    /// they are out of order, negating one column to keep `v` a rotation.
+    template <std::size_t P, std::size_t Q, typename T>
+    DK_ALWAYS_INLINE constexpr void sort_pair(T (&values)[3], T (&v)[3][3]) noexcept {
+        const bool swap = values[P] > values[Q];
+        for (std::size_t i = 0; i < 3; ++i) {
+            const T vp = v[i][P];
+            v[i][P] = swap ? v[i][Q] : vp;
+            v[i][Q] = swap ? -vp : v[i][Q];
+        }
+        const T first = values[P];
+        values[P] = swap ? values[Q] : first;
+        values[Q] = swap ? first : values[Q];
+    }
+
+} // namespace detail
+
+/// @brief Computes the eigendecomposition of the symmetric 3x3 matrix `a`,
+/// only its lower triangle is read, see the file comment.
+/// @param  [out] values  Eigenvalues in increasing order.
+/// @param  [out] vectors Row-major rotation whose columns are the
+///                       eigenvectors.
+template <std::floating_point T, std::size_t Sweeps = sweeps>
+DK_ALWAYS_INLINE constexpr void decompose(const T (&a)[9], T (&values)[3], T (&vectors)[9]) noexcept {
+    T sym[3][3];
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            sym[i][j] = i >= j ? a[3 * i + j] : a[3 * j + i];
+        }
+    }
+    T rot[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    detail::jacobi_sweeps<Sweeps>(sym, rot);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        values[i] = sym[i][i];
+    }
+    detail::sort_pair<0, 1>(values, rot);
+    detail::sort_pair<0, 2>(values, rot);
+    detail::sort_pair<1, 2>(values, rot);
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            vectors[3 * i + j] = rot[i][j];
+        }
+    }
+}
+
+} // namespace dk::math::eigen3
+
+#endif // DK_MATH_EIGEN3_HPP
@@ -0,0 +1,48 @@
+#ifndef DK_MATH_ELEMENTWISE_HPP
+#define DK_MATH_ELEMENTWISE_HPP
+
+/// @file elementwise.hpp
+///
+/// Element-wise loops over contiguous storage shared by the fixed size types
+/// and the dynamic ones in `dyn_vector.hpp` and `dyn_matrix.hpp`, so that both
+/// get the same vectorized code. They are `constexpr` and the `omp simd`
+/// hints are ignored during constant evaluation.
+
+#include <cstddef>
+
+#include <dklib/math/types.hpp>
+
+namespace dk::math::detail {
+
+/// @brief `out[i] = op(lhs[i], rhs[i])`, `out` may be `lhs` or `rhs`.
+template <typename T, typename Op>
+DK_ALWAYS_INLINE constexpr void elementwise(std::size_t count, T *out, const T *lhs, const T *rhs, Op op) noexcept {
+#pragma omp simd
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<T>(op(lhs[i], rhs[i]));
+    }
+}
+
+/// @brief `out[i] = op(in[i], value)` computed in the common type of the
+/// element and `value`, like a compound assignment, `out` may be `in`.
+template <typename T, typename F, typename Op>
+DK_ALWAYS_INLINE constexpr void elementwise_scalar(std::size_t count, T *out, const T *in, F value, Op op) noexcept {
+#pragma omp simd
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<T>(op(in[i], value));
+    }
+}
+
+/// @brief Returns true if any of the `count` elements is zero.
+template <typename T>
+[[nodiscard]] constexpr bool any_zero(std::size_t count, const T *values) noexcept {
+    bool zero = false;
+    for (std::size_t i = 0; i < count; ++i) {
+        zero |= values[i] == 0;
+    }
+    return zero;
+}
+
+} // namespace dk::math::detail
+
+#endif // DK_MATH_ELEMENTWISE_HPP
@@ -0,0 +1,108 @@
+#ifndef DK_MATH_EXECUTION_HPP
+#define DK_MATH_EXECUTION_HPP
+
+/// @file execution.hpp
+///
+/// Execution policies for the kernels that can use more than one core.
+///
+/// `execution::par` runs on the library owned `ThreadPool::global()`,
+/// `execution::on(pool)` on a specific pool and `execution::seq` on the
+/// calling thread only:
+///
+/// ```cpp
+/// auto c = multiply(execution::par, a, b);
+/// ```
+
+#include <algorithm>
+#include <cstddef>
+
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/gemm.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/thread_pool.hpp>
+
+namespace dk::math {
+
+namespace execution {
+
+    struct sequenced_policy { };
+
+    struct parallel_policy {
+        ThreadPool *pool = nullptr;
+
+        [[nodiscard]] ThreadPool &get_pool() const {
+            return pool != nullptr ? *pool : ThreadPool::global();
+        }
+    };
+
+    inline constexpr sequenced_policy seq {};
+    inline constexpr parallel_policy par {};
+
+    /// @brief Returns a parallel policy running on the given pool.
+    [[nodiscard]] constexpr parallel_policy on(ThreadPool &pool) noexcept {
+        return { &pool };
+    }
+
+} // namespace execution
+
+namespace gemm {
+
+    /// Tile of `C` computed by one task of the parallel GEMM, every task packs
+    /// its own panels into the per-thread buffers of the worker running it.
+    template <typename T>
+    inline constexpr std::size_t parallel_tile_rows = BlockSizes<T>::mc / 2;
+
+    template <typename T>
+    inline constexpr std::size_t parallel_tile_cols = 16 * BlockSizes<T>::nr;
+
+    /// @brief Parallel variant of `gemm::multiply`, `C` is split into tiles
+    /// which are distributed over the threads of the policy's pool.
+    template <Numeric T>
+    void multiply(
+        const execution::parallel_policy &policy, std::size_t m, std::size_t n, std::size_t k, Operand<T> a, Operand<T> b, T *c,
+        std::size_t ldc, bool accumulate = false
+    ) {
+        constexpr std::size_t tile_rows = parallel_tile_rows<T>;
+        constexpr std::size_t tile_cols = parallel_tile_cols<T>;
+        const std::size_t row_tiles = (m + tile_rows - 1) / tile_rows;
+        const std::size_t col_tiles = (n + tile_cols - 1) / tile_cols;
+        policy.get_pool().parallel_for(row_tiles * col_tiles, [&](std::size_t tile) {
+            const std::size_t row = tile / col_tiles * tile_rows;
+            const std::size_t col = tile % col_tiles * tile_cols;
+            const Operand<T> a_rows { a.data + row * a.row_stride, a.row_stride, a.col_stride };
+            const Operand<T> b_cols { b.data + col * b.col_stride, b.row_stride, b.col_stride };
+            multiply<T>(
+                std::min(tile_rows, m - row), std::min(tile_cols, n - col), k, a_rows, b_cols, c + row * ldc + col, ldc, accumulate
+            );
+        });
+    }
+
+} // namespace gemm
+
+/// @brief Matrix product on the calling thread, same as `operator*`.
+template <Numeric T, std::size_t Rows1, std::size_t Cols1, std::size_t Rows2, std::size_t Cols2>
+requires(Cols1 == Rows2)
+constexpr Matrix<T, Rows1, Cols2>
+multiply(execution::sequenced_policy, const Matrix<T, Rows1, Cols1> &lhs, const Matrix<T, Rows2, Cols2> &rhs) noexcept {
+    return lhs * rhs;
+}
+
+/// @brief Matrix product with tiles of the result computed in parallel.
+///
+/// Products too small for the blocked GEMM fall back to `operator*`.
+template <Numeric T, std::size_t Rows1, std::size_t Cols1, std::size_t Rows2, std::size_t Cols2>
+requires(Cols1 == Rows2)
+Matrix<T, Rows1, Cols2>
+multiply(const execution::parallel_policy &policy, const Matrix<T, Rows1, Cols1> &lhs, const Matrix<T, Rows2, Cols2> &rhs) {
+    if constexpr (gemm::use_blocked<Rows1, Cols2, Cols1>) {
+        Matrix<T, Rows1, Cols2> result_matrix;
+        gemm::multiply<T>(policy, Rows1, Cols2, Cols1, { lhs.data(), Cols1, 1 }, { rhs.data(), Cols2, 1 }, result_matrix.data(), Cols2);
+        return result_matrix;
+    } else {
+        return lhs * rhs;
+    }
+}
+
+} // namespace dk::math
+
+#endif // DK_MATH_EXECUTION_HPP
@@ -0,0 +1,237 @@
+#ifndef DK_MATH_GEMM_HPP
+#define DK_MATH_GEMM_HPP
+
+/// @file gemm.hpp
+///
+/// Cache blocked general matrix multiplication.
+///
+/// The implementation follows the usual Goto/BLIS structure: `B` is packed
+/// into `kc x nc` panels that stay in L2/L3, `A` into `mc x kc` blocks that
+/// stay in L2, and a register tiled `mr x nr` micro-kernel streams through
+/// both packed buffers. Every element of `C` still receives its partial
+/// products in increasing `k` order starting from zero, so integer results are
+/// exact and floating point results match the naive triple loop.
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/types.hpp>
+#include <dklib/math/workspace.hpp>
+
+namespace dk::math::gemm {
+
+/// Read-only strided access to a row-major (or transposed) matrix operand.
+template <typename T>
+struct Operand {
+    const T *data;
+    std::size_t row_stride;
+    std::size_t col_stride;
+
+    [[nodiscard]] constexpr T operator()(std::size_t row, std::size_t col) const noexcept {
+        return data[row * row_stride + col * col_stride];
+    }
+};
+
+/// Blocking parameters for element type `T`.
+///
+/// The micro tile is four rows by one cache line of columns, the remaining
+/// sizes keep a packed `A` block in L2 and a packed `B` panel in L3.
+template <typename T>
+struct BlockSizes {
+    static constexpr std::size_t mr = 4;
+    static constexpr std::size_t nr = std::max<std::size_t>(64 / sizeof(T), 2);
+    static constexpr std::size_t kc = 256;
+    static constexpr std::size_t mc = 128;
+    static constexpr std::size_t nc = 2048;
+};
+
+/// Smallest dimension for which packing pays off over the plain loop.
+inline constexpr std::size_t min_blocked_dimension = 16;
+
+template <std::size_t M, std::size_t N, std::size_t K>
+inline constexpr bool use_blocked = M >= min_blocked_dimension and N >= min_blocked_dimension and K >= min_blocked_dimension;
+
+namespace detail {
+
+    /// Per-thread packing buffers, they only ever grow, so steady state
+    /// multiplications do not allocate.
+    template <typename T>
+    struct PackBuffers {
+        std::vector<T> a;
+        std::vector<T> b;
+    };
+
+    template <typename T>
+    PackBuffers<T> &pack_buffers(std::size_t a_size, std::size_t b_size) {
+        thread_local PackBuffers<T> buffers;
+        if (buffers.a.size() < a_size) {
+            buffers.a.resize(a_size);
+        }
+        if (buffers.b.size() < b_size) {
+            buffers.b.resize(b_size);
+        }
+        return buffers;
+    }
+
+    /// Packs `rows x depth` elements of `a` starting at (`row`, `col`) into
+    /// slivers of `mr` rows, the last sliver is padded with zeros.
+    template <typename T>
+    DK_ALWAYS_INLINE void pack_a(Operand<T> a, std::size_t row, std::size_t col, std::size_t rows, std::size_t depth, T *out) noexcept {
+        constexpr std::size_t mr = BlockSizes<T>::mr;
+        for (std::size_t i = 0; i < rows; i += mr) {
+            const std::size_t height = std::min(mr, rows - i);
+            for (std::size_t p = 0; p < depth; ++p) {
+                for (std::size_t ii = 0; ii < mr; ++ii) {
+                    out[p * mr + ii] = ii < height ? a(row + i + ii, col + p) : T {};
+                }
+            }
+            out += depth * mr;
+        }
+    }
+
+    /// Packs `depth x cols` elements of `b` starting at (`row`, `col`) into
+    /// slivers of `nr` columns, the last sliver is padded with zeros.
+    template <typename T>
+    DK_ALWAYS_INLINE void pack_b(Operand<T> b, std::size_t row, std::size_t col, std::size_t depth, std::size_t cols, T *out) noexcept {
+        constexpr std::size_t nr = BlockSizes<T>::nr;
+        for (std::size_t j = 0; j < cols; j += nr) {
+            const std::size_t width = std::min(nr, cols - j);
+            for (std::size_t p = 0; p < depth; ++p) {
+                for (std::size_t jj = 0; jj < nr; ++jj) {
+                    out[p * nr + jj] = jj < width ? b(row + p, col + j + jj) : T {};
+                }
+            }
+            out += depth * nr;
+        }
+    }
+
+    /// Multiplies one packed sliver of `A` with one packed sliver of `B` and
+    /// stores the top-left `rows x cols` part of the tile to `c`.
+    ///
+    /// The accumulator tile has compile-time extents, so the compiler keeps it
+    /// in vector registers for the whole `depth` loop.
+    template <typename T>
+    DK_ALWAYS_INLINE void micro_kernel(std::size_t depth, const T *a, const T *b, T *c, std::size_t ldc, std::size_t rows, std::size_t cols, bool load) noexcept {
+        constexpr std::size_t mr = BlockSizes<T>::mr;
+        constexpr std::size_t nr = BlockSizes<T>::nr;
+        T acc[mr][nr] = {};
+        if (load) {
+            for (std::size_t i = 0; i < rows; ++i) {
+                for (std::size_t j = 0; j < cols; ++j) {
+                    acc[i][j] = c[i * ldc + j];
+                }
+            }
+        }
+        for (std::size_t p = 0; p < depth; ++p) {
+            for (std::size_t i = 0; i < mr; ++i) {
+                const T scale = a[p * mr + i];
+#pragma omp simd
+                for (std::size_t j = 0; j < nr; ++j) {
+                    acc[i][j] += scale * b[p * nr + j];
+                }
+            }
+        }
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t j = 0; j < cols; ++j) {
+                c[i * ldc + j] = acc[i][j];
+            }
+        }
+    }
+
+    /// Sizes of the packed `A` block and `B` panel for an `m x n x k` product.
+    template <typename T>
+    [[nodiscard]] constexpr std::pair<std::size_t, std::size_t> pack_sizes(std::size_t m, std::size_t n, std::size_t k) noexcept {
+        using Blocks = BlockSizes<T>;
+        const std::size_t kc_max = std::min(Blocks::kc, k);
+        const std::size_t mc_max = std::min(Blocks::mc, (m + Blocks::mr - 1) / Blocks::mr * Blocks::mr);
+        const std::size_t nc_max = std::min(Blocks::nc, (n + Blocks::nr - 1) / Blocks::nr * Blocks::nr);
+        return { mc_max * kc_max, kc_max * nc_max };
+    }
+
+    /// Blocked product using the given packing buffers, which hold at least
+    /// `pack_sizes<T>(m, n, k)` elements.
+    template <typename T>
+    DK_ALWAYS_INLINE void multiply_packed(
+        std::size_t m, std::size_t n, std::size_t k, Operand<T> a, Operand<T> b, T *c, std::size_t ldc, bool accumulate,
+        T *packed_a, T *packed_b
+    ) {
+        using Blocks = BlockSizes<T>;
+        constexpr std::size_t mr = Blocks::mr;
+        constexpr std::size_t nr = Blocks::nr;
+
+        if (k == 0) {
+            if (not accumulate) {
+                for (std::size_t i = 0; i < m; ++i) {
+                    std::fill_n(c + i * ldc, n, T {});
+                }
+            }
+            return;
+        }
+
+        for (std::size_t jc = 0; jc < n; jc += Blocks::nc) {
+            const std::size_t nc = std::min(Blocks::nc, n - jc);
+            for (std::size_t pc = 0; pc < k; pc += Blocks::kc) {
+                const std::size_t kc = std::min(Blocks::kc, k - pc);
+                const bool load = accumulate or pc != 0;
+                pack_b(b, pc, jc, kc, nc, packed_b);
+                for (std::size_t ic = 0; ic < m; ic += Blocks::mc) {
+                    const std::size_t mc = std::min(Blocks::mc, m - ic);
+                    pack_a(a, ic, pc, mc, kc, packed_a);
+                    for (std::size_t jr = 0; jr < nc; jr += nr) {
+                        for (std::size_t ir = 0; ir < mc; ir += mr) {
+                            micro_kernel(
+                                kc, packed_a + ir * kc, packed_b + jr * kc, c + (ic + ir) * ldc + jc + jr, ldc,
+                                std::min(mr, mc - ir), std::min(nr, nc - jr), load
+                            );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace detail
+
+/// @brief Computes `c = a * b`, or `c += a * b` when `accumulate` is set.
+///
+/// @param  [in] m,n,k Dimensions of the product, `a` is `m x k`, `b` is `k x n`.
+/// @param  [in] a,b Strided operands, transposed operands are expressed by
+///                  swapping their strides.
+/// @param  [out] c Row-major result with leading dimension `ldc`, it must not
+///                 alias any of the operands.
+template <Numeric T>
+DK_ALWAYS_INLINE void multiply(std::size_t m, std::size_t n, std::size_t k, Operand<T> a, Operand<T> b, T *c, std::size_t ldc, bool accumulate = false) {
+    const auto [a_size, b_size] = detail::pack_sizes<T>(m, n, k);
+    auto &buffers = detail::pack_buffers<T>(a_size, b_size);
+    detail::multiply_packed(m, n, k, a, b, c, ldc, accumulate, buffers.a.data(), buffers.b.data());
+}
+
+/// @brief Same as above with the packing buffers borrowed from `workspace`
+/// instead of the per-thread ones, they are given back on return.
+template <Numeric T>
+void multiply(
+    Workspace &workspace, std::size_t m, std::size_t n, std::size_t k, Operand<T> a, Operand<T> b, T *c, std::size_t ldc,
+    bool accumulate = false
+) {
+    const auto scope = workspace.scope();
+    const auto [a_size, b_size] = detail::pack_sizes<T>(m, n, k);
+    const auto packed_a = workspace.borrow<T>(a_size);
+    const auto packed_b = workspace.borrow<T>(b_size);
+    detail::multiply_packed(m, n, k, a, b, c, ldc, accumulate, packed_a.data(), packed_b.data());
+}
+
+/// @brief Fixed size variant for contiguous row-major matrices.
+///
+/// All extents are compile-time constants, which lets the compiler drop the
+/// edge handling of dimensions that are multiples of the tile sizes.
+template <Numeric T, std::size_t M, std::size_t N, std::size_t K>
+DK_ALWAYS_INLINE void multiply(const T *a, const T *b, T *c) {
+    multiply<T>(M, N, K, { a, K, 1 }, { b, N, 1 }, c, N);
+}
+
+} // namespace dk::math::gemm
+
+#endif // DK_MATH_GEMM_HPP
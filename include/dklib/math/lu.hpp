@@ -0,0 +1,214 @@
+#ifndef DK_MATH_LU_HPP
+#define DK_MATH_LU_HPP
+
+/// @file lu.hpp
+///
+/// LU factorization with partial pivoting of row-major square matrices.
+///
+/// `factor` overwrites `a` with `L` below the diagonal, whose unit diagonal
+/// is implied, and `U` on and above it, such that `P * a = L * U`. The row
+/// permutation is recorded LAPACK style: row `j` was exchanged with row
+/// `pivots[j]` at step `j`.
+///
+/// Small matrices are factored column by column. From `min_blocked_order`
+/// on the factorization is right-looking and blocked: a panel of
+/// `block_size` columns is factored as above, the matching rows of `U` are
+/// obtained by a triangular solve, and the trailing matrix receives the
+/// rank `block_size` update `A22 -= L21 * U12` from the blocked GEMM, which
+/// is where nearly all the flops are spent.
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+#include <dklib/math/gemm.hpp>
+
+namespace dk::math::lu {
+
+/// Columns per panel of the blocked factorization.
+inline constexpr std::size_t block_size = 48;
+
+/// Smallest order factored by the blocked path.
+inline constexpr std::size_t min_blocked_order = 96;
+
+namespace detail {
+
+    template <typename T>
+    constexpr T magnitude(T value) noexcept {
+        return value < T {} ? -value : value;
+    }
+
+    /// Factors columns `k` to `k + width` of rows `k` to `n`, exchanging
+    /// whole rows, and applies the panel to its own columns only. Returns
+    /// false if one of the columns had no non-zero pivot.
+    template <typename T>
+    constexpr bool factor_panel(T *a, std::size_t n, std::size_t ld, std::size_t k, std::size_t width, std::size_t *pivots) noexcept {
+        bool regular = true;
+        const std::size_t end = k + width;
+        for (std::size_t j = k; j < end; ++j) {
+            std::size_t pivot = j;
+            T largest = magnitude(a[j * ld + j]);
+            for (std::size_t i = j + 1; i < n; ++i) {
+                const T candidate = magnitude(a[i * ld + j]);
+                if (candidate > largest) {
+                    largest = candidate;
+                    pivot = i;
+                }
+            }
+            pivots[j] = pivot;
+            if (pivot != j) {
+                std::swap_ranges(a + j * ld, a + j * ld + n, a + pivot * ld);
+            }
+            if (largest == T {}) {
+                regular = false;
+                continue;
+            }
+            const T diagonal = a[j * ld + j];
+            const T *pivot_row = a + j * ld;
+            for (std::size_t i = j + 1; i < n; ++i) {
+                T *row = a + i * ld;
+                const T factor = row[j] /= diagonal;
+#pragma omp simd
+                for (std::size_t c = j + 1; c < end; ++c) {
+                    row[c] -= factor * pivot_row[c];
+                }
+            }
+        }
+        return regular;
+    }
+
+    /// Computes `U12 = L11⁻¹ * A12` for the panel at `k`.
+    template <typename T>
+    void solve_panel_rows(T *a, std::size_t n, std::size_t ld, std::size_t k, std::size_t width) noexcept {
+        const std::size_t end = k + width;
+        for (std::size_t r = k + 1; r < end; ++r) {
+            T *row = a + r * ld;
+            for (std::size_t i = k; i < r; ++i) {
+                const T factor = row[i];
+                const T *source = a + i * ld;
+#pragma omp simd
+                for (std::size_t c = end; c < n; ++c) {
+                    row[c] -= factor * source[c];
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void negate_block(T *a, std::size_t rows, std::size_t cols, std::size_t ld) noexcept {
+        for (std::size_t i = 0; i < rows; ++i) {
+#pragma omp simd
+            for (std::size_t j = 0; j < cols; ++j) {
+                a[i * ld + j] = -a[i * ld + j];
+            }
+        }
+    }
+
+} // namespace detail
+
+/// @brief Factors the `n x n` matrix at `a` in place, see the file comment.
+/// @param  [in] ld Distance between the rows of `a`, at least `n`.
+/// @param  [out] pivots Row exchanges, `n` elements.
+/// @param  [in] panel_width Columns per panel, `n` or more factors the
+///                          matrix unblocked. Zero is taken as one, and
+///                          constant evaluation is always unblocked.
+/// @return The sign of the permutation, or zero if the matrix is singular.
+template <std::floating_point T>
+constexpr int factor(T *a, std::size_t n, std::size_t ld, std::size_t *pivots, std::size_t panel_width) {
+    if consteval {
+        panel_width = n;
+    }
+    panel_width = std::max<std::size_t>(panel_width, 1);
+    bool regular = true;
+    for (std::size_t k = 0; k < n; k += panel_width) {
+        const std::size_t panel = std::min(panel_width, n - k);
+        regular = detail::factor_panel(a, n, ld, k, panel, pivots) and regular;
+        const std::size_t rest = n - k - panel;
+        if (rest == 0) {
+            continue;
+        }
+        if !consteval {
+            // GEMM only accumulates, the update adds `L21 * -U12` and `U12`
+            // is negated back afterwards, which is exact.
+            T *u12 = a + k * ld + k + panel;
+            detail::solve_panel_rows(a, n, ld, k, panel);
+            detail::negate_block(u12, panel, rest, ld);
+            gemm::multiply<T>(
+                rest, rest, panel, { a + (k + panel) * ld + k, ld, 1 }, { u12, ld, 1 }, a + (k + panel) * ld + k + panel, ld, true
+            );
+            detail::negate_block(u12, panel, rest, ld);
+        }
+    }
+    if (not regular) {
+        return 0;
+    }
+    int sign = 1;
+    for (std::size_t j = 0; j < n; ++j) {
+        if (pivots[j] != j) {
+            sign = -sign;
+        }
+    }
+    return sign;
+}
+
+/// @brief Same as above, blocked from `min_blocked_order` on. Constant
+/// evaluation is always unblocked.
+template <std::floating_point T>
+constexpr int factor(T *a, std::size_t n, std::size_t ld, std::size_t *pivots) {
+    if !consteval {
+        if (n >= min_blocked_order) {
+            return factor(a, n, ld, pivots, block_size);
+        }
+    }
+    return factor(a, n, ld, pivots, n);
+}
+
+/// @brief Determinant of a matrix factored by `factor`.
+template <std::floating_point T>
+constexpr T determinant(const T *lu, std::size_t n, std::size_t ld, int sign) noexcept {
+    T result = static_cast<T>(sign);
+    for (std::size_t i = 0; i < n; ++i) {
+        result *= lu[i * ld + i];
+    }
+    return result;
+}
+
+/// @brief Overwrites the `n x nrhs` matrix `b` with the solution of
+/// `a * x = b`, `a` being factored by `factor` and regular.
+template <std::floating_point T>
+constexpr void solve(const T *lu, std::size_t n, std::size_t ld, const std::size_t *pivots, T *b, std::size_t nrhs, std::size_t ldb) noexcept {
+    for (std::size_t j = 0; j < n; ++j) {
+        if (pivots[j] != j) {
+            std::swap_ranges(b + j * ldb, b + j * ldb + nrhs, b + pivots[j] * ldb);
+        }
+    }
+    for (std::size_t i = 1; i < n; ++i) {
+        T *row = b + i * ldb;
+        for (std::size_t p = 0; p < i; ++p) {
+            const T factor = lu[i * ld + p];
+            const T *source = b + p * ldb;
+            for (std::size_t c = 0; c < nrhs; ++c) {
+                row[c] -= factor * source[c];
+            }
+        }
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        T *row = b + i * ldb;
+        for (std::size_t p = i + 1; p < n; ++p) {
+            const T factor = lu[i * ld + p];
+            const T *source = b + p * ldb;
+            for (std::size_t c = 0; c < nrhs; ++c) {
+                row[c] -= factor * source[c];
+            }
+        }
+        const T diagonal = lu[i * ld + i];
+        for (std::size_t c = 0; c < nrhs; ++c) {
+            row[c] /= diagonal;
+        }
+    }
+}
+
+} // namespace dk::math::lu
+
+#endif // DK_MATH_LU_HPP
@@ -2,13 +2,21 @@
 #define DK_MATH_MATRIX_HPP
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <iostream>
 #include <ostream>
+#include <utility>
 
 #include <dklib/math/concepts.hpp>
+#include <dklib/math/elementwise.hpp>
+#include <dklib/math/gemm.hpp>
+#include <dklib/math/lu.hpp>
 #include <dklib/math/matrix_concepts.hpp>
+#include <dklib/math/simd.hpp>
+#include <dklib/math/strassen.hpp>
 #include <dklib/math/tensor.hpp>
+#include <dklib/math/transpose.hpp>
 #include <dklib/math/types.hpp>
 #include <dklib/math/vector.hpp>
 
@@ -63,9 +71,48 @@ public:
         return {};
     }
 
-    [[nodiscard]] constexpr double determinant() const noexcept;
+    /// @brief Returns the determinant, evaluated in double precision.
+    ///
+    /// Orders up to four use the cofactor expansion, larger ones an LU
+    /// factorization of a copy, see `lu.hpp`.
+    [[nodiscard]] constexpr double determinant() const noexcept
+    requires(Rows == Cols)
+    {
+        const auto at = [this](std::size_t x, std::size_t y) { return static_cast<double>((*this)[x, y]); };
+        if constexpr (Rows == 1) {
+            return at(0, 0);
+        } else if constexpr (Rows == 2) {
+            return at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0);
+        } else if constexpr (Rows == 3) {
+            return at(0, 0) * (at(1, 1) * at(2, 2) - at(1, 2) * at(2, 1)) - at(0, 1) * (at(1, 0) * at(2, 2) - at(1, 2) * at(2, 0))
+                + at(0, 2) * (at(1, 0) * at(2, 1) - at(1, 1) * at(2, 0));
+        } else if constexpr (Rows == 4) {
+            // Products of the 2x2 minors of the top and bottom row pairs.
+            const double s0 = at(0, 0) * at(1, 1) - at(1, 0) * at(0, 1);
+            const double s1 = at(0, 0) * at(1, 2) - at(1, 0) * at(0, 2);
+            const double s2 = at(0, 0) * at(1, 3) - at(1, 0) * at(0, 3);
+            const double s3 = at(0, 1) * at(1, 2) - at(1, 1) * at(0, 2);
+            const double s4 = at(0, 1) * at(1, 3) - at(1, 1) * at(0, 3);
+            const double s5 = at(0, 2) * at(1, 3) - at(1, 2) * at(0, 3);
+            const double c5 = at(2, 2) * at(3, 3) - at(3, 2) * at(2, 3);
+            const double c4 = at(2, 1) * at(3, 3) - at(3, 1) * at(2, 3);
+            const double c3 = at(2, 1) * at(3, 2) - at(3, 1) * at(2, 2);
+            const double c2 = at(2, 0) * at(3, 3) - at(3, 0) * at(2, 3);
+            const double c1 = at(2, 0) * at(3, 2) - at(3, 0) * at(2, 2);
+            const double c0 = at(2, 0) * at(3, 1) - at(3, 0) * at(2, 1);
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        } else {
+            Matrix<double, Rows, Cols> factored;
+            std::copy(this->data(), this->data() + Rows * Cols, factored.data());
+            std::array<std::size_t, Rows> pivots {};
+            const int sign = lu::factor(factored.data(), Rows, Cols, pivots.data());
+            return sign == 0 ? 0.0 : lu::determinant(factored.data(), Rows, Cols, sign);
+        }
+    }
 
-    friend constexpr double determinant(const Matrix &mat) noexcept {
+    friend constexpr double determinant(const Matrix &mat) noexcept
+    requires(Rows == Cols)
+    {
         return mat.determinant();
     }
 
@@ -120,30 +167,46 @@ public:
         return *this;
     }
 
+    /// @brief Evaluates a fused element-wise expression in place.
+    template <TensorExpressionType E>
+    requires std::same_as<typename E::result_type, Matrix>
+    constexpr Matrix &operator=(const E &expression) noexcept {
+        expression.evaluate_into(*this);
+        return *this;
+    }
+
     constexpr Matrix &operator+=(const Matrix &other) noexcept {
-        std::ranges::transform(this->elems_, other.elems_, this->elems_.begin(), std::plus<T>());
+        detail::elementwise(Rows * Cols, this->data(), this->data(), other.data(), std::plus<T>());
         return *this;
     }
 
     constexpr Matrix &operator-=(const Matrix &other) noexcept {
-        std::ranges::transform(this->elems_, other.elems_, this->elems_.begin(), std::minus<T>());
+        detail::elementwise(Rows * Cols, this->data(), this->data(), other.data(), std::minus<T>());
         return *this;
     }
 
     template <std::convertible_to<T> T1>
     constexpr Matrix &operator*=(T1 value) noexcept {
-        std::ranges::for_each(this->elems_, [value](auto &v) { v *= value; });
+        detail::elementwise_scalar(Rows * Cols, this->data(), this->data(), value, std::multiplies<>());
         return *this;
     }
 
     template <std::convertible_to<T> T1>
-    constexpr Matrix &operator/=(T value) noexcept {
-        std::ranges::for_each(this->elems_, [value](auto &v) { v /= value; });
+    constexpr Matrix &operator/=(T1 value) noexcept {
+        detail::elementwise_scalar(Rows * Cols, this->data(), this->data(), value, std::divides<>());
         return *this;
     }
 
-    constexpr Matrix<T, Cols, Rows> transpose() noexcept {
+    /// @brief Returns the transpose, large matrices go through the
+    /// cache-oblivious kernel of `transpose.hpp`.
+    [[nodiscard]] constexpr Matrix<T, Cols, Rows> transpose() const noexcept {
         Matrix<T, Cols, Rows> return_matrix;
+        if !consteval {
+            if constexpr (transposition::use_blocked<Rows, Cols>) {
+                transposition::transpose_into(this->data(), Rows, Cols, Cols, return_matrix.data(), Rows);
+                return return_matrix;
+            }
+        }
         for (std::size_t i = 0; i < return_matrix.rows(); ++i) {
             for (std::size_t j = 0; j < return_matrix.cols(); ++j) {
                 return_matrix[i, j] = (*this)[j, i];
@@ -152,6 +215,24 @@ public:
         return return_matrix;
     }
 
+    /// @brief Transposes a square matrix without a second copy of it.
+    constexpr Matrix &transpose_inplace() noexcept
+    requires(Rows == Cols)
+    {
+        if !consteval {
+            if constexpr (transposition::use_blocked<Rows, Cols>) {
+                transposition::transpose_square(this->data(), Rows, Cols);
+                return *this;
+            }
+        }
+        for (std::size_t i = 0; i < Rows; ++i) {
+            for (std::size_t j = i + 1; j < Cols; ++j) {
+                std::swap((*this)[i, j], (*this)[j, i]);
+            }
+        }
+        return *this;
+    }
+
     [[nodiscard]] constexpr std::size_t rows() const noexcept { return Rows; }
     [[nodiscard]] constexpr std::size_t cols() const noexcept { return Cols; }
 
@@ -169,11 +250,28 @@ public:
     }
 };
 
-// TODO: use implementation which is not O(n^3)
+/// Constant evaluation and small products use the plain triple loop, 4x4
+/// products use the SIMD kernels, large double precision square products use
+/// Strassen-Winograd and everything else the blocked GEMM.
 template <Numeric T, std::size_t Rows1, std::size_t Cols1, std::size_t Rows2, std::size_t Cols2>
 requires(Cols1 == Rows2)
 constexpr Matrix<T, Rows1, Cols2>
 operator*(const Matrix<T, Rows1, Cols1> &lhs, const Matrix<T, Rows2, Cols2> &rhs) noexcept {
+    if !consteval {
+        if constexpr (Rows1 == 4 and Cols1 == 4 and Cols2 == 4 and simd::accelerated<T, 16>) {
+            Matrix<T, Rows1, Cols2> result_matrix;
+            simd::mat4_mul(result_matrix.data(), lhs.data(), rhs.data());
+            return result_matrix;
+        } else if constexpr (Rows1 == Cols1 and Cols1 == Cols2 and strassen::use_strassen<T, Rows1>) {
+            Matrix<T, Rows1, Cols2> result_matrix;
+            strassen::multiply<T>(Rows1, lhs.data(), rhs.data(), result_matrix.data());
+            return result_matrix;
+        } else if constexpr (gemm::use_blocked<Rows1, Cols2, Cols1>) {
+            Matrix<T, Rows1, Cols2> result_matrix;
+            gemm::multiply<T, Rows1, Cols2, Cols1>(lhs.data(), rhs.data(), result_matrix.data());
+            return result_matrix;
+        }
+    }
     Matrix<T, Rows1, Cols2> result_matrix { 0 };
     for (std::size_t i = 0; i < lhs.rows(); ++i) {
         for (std::size_t j = 0; j < rhs.cols(); ++j) {
@@ -185,6 +283,142 @@ operator*(const Matrix<T, Rows1, Cols1> &lhs, const Matrix<T, Rows2, Cols2> &rhs
     return result_matrix;
 }
 
+/// Element-wise expressions are evaluated once before they take part in a
+/// matrix product, which reads every operand element many times.
+template <typename L, typename R>
+requires(TensorExpressionType<L> or TensorExpressionType<R>)
+    and MatrixLike<expression_result_t<L>> and MatrixLike<expression_result_t<R>>
+constexpr auto operator*(const L &lhs, const R &rhs) noexcept {
+    return evaluate(lhs) * evaluate(rhs);
+}
+
+/// Transpose of a matrix that is never materialized, made by `transposed`.
+///
+/// It only refers to the matrix, products with it read the original storage
+/// with swapped strides:
+///
+///     const auto normal = transposed(a) * a; // aᵀa without building aᵀ
+template <typename M>
+class Transposed {
+public:
+    using matrix_type = M;
+    using value_type = typename M::value_type;
+
+    explicit constexpr Transposed(const M &mat) noexcept
+        : mat_ { mat } { }
+
+    /// @brief The matrix whose transpose this is.
+    [[nodiscard]] constexpr const M &base() const noexcept { return mat_; }
+
+    [[nodiscard]] constexpr std::size_t rows() const noexcept { return mat_.cols(); }
+    [[nodiscard]] constexpr std::size_t cols() const noexcept { return mat_.rows(); }
+
+    [[nodiscard]] constexpr value_type operator[](std::size_t x, std::size_t y) const noexcept { return mat_[y, x]; }
+
+private:
+    const M &mat_;
+};
+
+template <Numeric T, std::size_t Rows, std::size_t Cols>
+[[nodiscard]] constexpr Transposed<Matrix<T, Rows, Cols>> transposed(const Matrix<T, Rows, Cols> &mat) noexcept {
+    return Transposed<Matrix<T, Rows, Cols>> { mat };
+}
+
+template <Numeric T, std::size_t Rows, std::size_t Cols>
+void transposed(const Matrix<T, Rows, Cols> &&) = delete;
+
+namespace detail {
+
+    /// Small product kernel: every row of the result is accumulated in a
+    /// local array from the rows of `rhs` scaled by `lhs(i, p)`, in
+    /// increasing `p` order like the triple loop. Reading `lhs` through an
+    /// accessor lets transposed operands use it without a copy.
+    template <typename T, std::size_t M, std::size_t N, std::size_t K, typename A>
+    constexpr Matrix<T, M, N> accumulate_rows(A lhs, const Matrix<T, K, N> &rhs) noexcept {
+        Matrix<T, M, N> result_matrix;
+        for (std::size_t i = 0; i < M; ++i) {
+            T acc[N] = {};
+            for (std::size_t p = 0; p < K; ++p) {
+                const T scale = lhs(i, p);
+                for (std::size_t j = 0; j < N; ++j) {
+                    acc[j] += scale * rhs[p, j];
+                }
+            }
+            for (std::size_t j = 0; j < N; ++j) {
+                result_matrix[i, j] = acc[j];
+            }
+        }
+        return result_matrix;
+    }
+
+} // namespace detail
+
+/// @brief `lhsᵀ * rhs` without building `lhsᵀ`.
+///
+/// Small products accumulate scaled rows of `rhs`, reading `lhs` down its
+/// columns, large ones run the blocked GEMM with the strides of `lhs`
+/// swapped.
+template <Numeric T, std::size_t K, std::size_t M, std::size_t N>
+constexpr Matrix<T, M, N> operator*(const Transposed<Matrix<T, K, M>> &lhs, const Matrix<T, K, N> &rhs) noexcept {
+    const auto &a = lhs.base();
+    if !consteval {
+        if constexpr (gemm::use_blocked<M, N, K>) {
+            Matrix<T, M, N> result_matrix;
+            gemm::multiply<T>(M, N, K, { a.data(), 1, M }, { rhs.data(), N, 1 }, result_matrix.data(), N);
+            return result_matrix;
+        }
+    }
+    return detail::accumulate_rows<T, M, N, K>([&](std::size_t i, std::size_t p) { return a[p, i]; }, rhs);
+}
+
+/// @brief `lhs * rhsᵀ` without building `rhsᵀ` for large products.
+///
+/// Large products run the blocked GEMM with the strides of `rhs` swapped.
+/// Small ones pack `rhs` into row-major order first, like the GEMM packs its
+/// panels, which measured faster than any loop order on the original layout.
+template <Numeric T, std::size_t M, std::size_t K, std::size_t N>
+constexpr Matrix<T, M, N> operator*(const Matrix<T, M, K> &lhs, const Transposed<Matrix<T, N, K>> &rhs) noexcept {
+    const auto &b = rhs.base();
+    if !consteval {
+        if constexpr (gemm::use_blocked<M, N, K>) {
+            Matrix<T, M, N> result_matrix;
+            gemm::multiply<T>(M, N, K, { lhs.data(), K, 1 }, { b.data(), 1, K }, result_matrix.data(), N);
+            return result_matrix;
+        }
+    }
+    return lhs * b.transpose();
+}
+
+/// @brief `lhsᵀ * rhsᵀ`, with `rhs` packed for small products as above.
+template <Numeric T, std::size_t K, std::size_t M, std::size_t N>
+constexpr Matrix<T, M, N> operator*(const Transposed<Matrix<T, K, M>> &lhs, const Transposed<Matrix<T, N, K>> &rhs) noexcept {
+    const auto &a = lhs.base();
+    const auto &b = rhs.base();
+    if !consteval {
+        if constexpr (gemm::use_blocked<M, N, K>) {
+            Matrix<T, M, N> result_matrix;
+            gemm::multiply<T>(M, N, K, { a.data(), 1, M }, { b.data(), 1, K }, result_matrix.data(), N);
+            return result_matrix;
+        }
+    }
+    return lhs * b.transpose();
+}
+
+/// @brief `matᵀ * vec`, the sum of the rows of `mat` scaled by the elements
+/// of `vec`, as in the normal equations `aᵀb`.
+template <Numeric T, std::size_t K, std::size_t M>
+constexpr Vector<T, M> operator*(const Transposed<Matrix<T, K, M>> &mat, const Vector<T, K> &vec) noexcept {
+    const auto &a = mat.base();
+    Vector<T, M> result { 0 };
+    for (std::size_t p = 0; p < K; ++p) {
+        const T scale = vec[p];
+        for (std::size_t i = 0; i < M; ++i) {
+            result[i] += scale * a[p, i];
+        }
+    }
+    return result;
+}
+
 using Matrix2x3 = Matrix<real, 2, 3>;
 using Matrix3x2 = Matrix<real, 3, 2>;
 using Matrix4x3 = Matrix<real, 4, 3>;
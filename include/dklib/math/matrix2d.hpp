@@ -50,8 +50,6 @@ public:
         return {};
     }
 
-    [[nodiscard]] constexpr double determinant() const noexcept;
-
     friend constexpr double determinant(const Matrix2 &mat) noexcept {
         return mat.determinant();
     }
@@ -69,7 +67,7 @@ public:
     template <std::convertible_to<T> T1>
     constexpr Matrix2 &operator/=(T value) noexcept;
 
-    constexpr Matrix2 transpose() noexcept {
+    [[nodiscard]] constexpr Matrix2 transpose() const noexcept {
         const auto &self = *this;
         return {
             { self[0], self[2] },
@@ -85,8 +85,6 @@ public:
 
     DK_INIT_METHOD Matrix3 retract() noexcept { return {}; }
 
-    [[nodiscard]] constexpr double determinant() const noexcept;
-
     friend constexpr double determinant(const Matrix3 &mat) noexcept {
         return mat.determinant();
     }
@@ -120,7 +118,7 @@ public:
     template <std::convertible_to<T> T1>
     constexpr Matrix3 &operator/=(T value) noexcept;
 
-    constexpr Matrix3 transpose() noexcept {
+    [[nodiscard]] constexpr Matrix3 transpose() const noexcept {
         const auto &self = *this;
         return {
             { self[0], self[3], self[6] },
@@ -2,19 +2,24 @@
 #define DK_MATH_MATRIX_4D_HPP
 
 #include <algorithm>
+#include <concepts>
 #include <functional>
 #include <iostream>
 #include <ostream>
+#include <stdexcept>
 
 #include <dklib/math/concepts.hpp>
+#include <dklib/math/matrix.hpp>
 #include <dklib/math/matrix_concepts.hpp>
+#include <dklib/math/simd.hpp>
 #include <dklib/math/types.hpp>
 #include <dklib/math/vector.hpp>
+#include <dklib/math/vector4d.hpp>
 
 namespace dk::math {
 
 template <Numeric T = real>
-class Matrix4 : public Matrix<T, 4, 4> {
+class alignas(simd::alignment<T, 16>) Matrix4 : public Matrix<T, 4, 4> {
 public:
     using Base = Matrix<T, 4, 4>;
     using arr_type = std::array<T, 4>;
@@ -45,11 +50,11 @@ public:
     }
 
     DK_INIT_METHOD Matrix4 diagonal(T value) noexcept {
-        return diagonal({ value, value, value });
+        return diagonal({ value, value, value, value });
     }
 
     DK_INIT_METHOD Matrix4 diagonal(const Base::vector_type &vec) noexcept {
-        return diagonal({ vec[0], vec[1], vec[2] });
+        return diagonal({ vec[0], vec[1], vec[2], vec[3] });
     }
 
     DK_INIT_METHOD Matrix4
@@ -91,8 +96,6 @@ public:
 
     DK_INIT_METHOD Matrix4 retract() noexcept { return {}; }
 
-    [[nodiscard]] constexpr double determinant() const noexcept;
-
     friend constexpr double determinant(const Matrix4 &mat) noexcept {
         return mat.determinant();
     }
@@ -100,17 +103,42 @@ public:
     constexpr Matrix4 &operator-() noexcept;
 
     constexpr Matrix4 &operator+=(const Matrix4 &other) noexcept {
+        if !consteval {
+            if constexpr (simd::accelerated<T, 16>) {
+                for (std::size_t row = 0; row < 4; ++row) {
+                    simd::add4(this->data() + 4 * row, other.data() + 4 * row);
+                }
+                return *this;
+            }
+        }
         std::ranges::transform(this->elems_, other.elems_, this->elems_.begin(), std::plus<T>());
         return *this;
     }
 
-    constexpr Matrix4 &operator-=(const Matrix4 &other) noexcept;
+    constexpr Matrix4 &operator-=(const Matrix4 &other) noexcept {
+        if !consteval {
+            if constexpr (simd::accelerated<T, 16>) {
+                for (std::size_t row = 0; row < 4; ++row) {
+                    simd::sub4(this->data() + 4 * row, other.data() + 4 * row);
+                }
+                return *this;
+            }
+        }
+        std::ranges::transform(this->elems_, other.elems_, this->elems_.begin(), std::minus<T>());
+        return *this;
+    }
 
     constexpr Matrix4 &operator*=(const Matrix4 &other) noexcept {
+        if !consteval {
+            if constexpr (simd::accelerated<T, 16>) {
+                simd::mat4_mul(this->data(), this->data(), other.data());
+                return *this;
+            }
+        }
         Matrix4 result_matrix { 0 };
-        for (std::size_t i = 0; i < 3; ++i) {
-            for (std::size_t j = 0; j < 3; ++j) {
-                for (std::size_t k = 0; k < 3; ++k) {
+        for (std::size_t i = 0; i < 4; ++i) {
+            for (std::size_t j = 0; j < 4; ++j) {
+                for (std::size_t k = 0; k < 4; ++k) {
                     result_matrix[i, j] += (*this)[i, k] * other[k, j];
                 }
             }
@@ -127,9 +155,62 @@ public:
     template <std::convertible_to<T> T1>
     constexpr Matrix4 &operator/=(T value) noexcept;
 
-    constexpr Matrix4 transpose() noexcept {
+    [[nodiscard]] constexpr Matrix4 transpose() const noexcept {
         const auto &self = *this;
-        return {};
+        return {
+            { self[0], self[4], self[8], self[12] },
+            { self[1], self[5], self[9], self[13] },
+            { self[2], self[6], self[10], self[14] },
+            { self[3], self[7], self[11], self[15] },
+        };
+    }
+
+    /// @brief General inverse by cofactor expansion, throws if the matrix is
+    /// singular.
+    [[nodiscard]] constexpr Matrix4 inverse() const
+        requires std::floating_point<T>
+    {
+        Matrix4 result;
+        T det;
+        if consteval {
+            det = simd::mat4_inverse<T>(result.data(), this->data());
+        } else {
+            det = simd::mat4_inverse(result.data(), this->data());
+        }
+        check_invertible(det);
+        return result;
+    }
+
+    /// @brief Inverse of an affine transformation, whose last row is
+    /// `(0, 0, 0, 1)`: the 3x3 part is inverted and applied to the negated
+    /// translation. Throws if the 3x3 part is singular.
+    [[nodiscard]] constexpr Matrix4 inverse_affine() const
+        requires std::floating_point<T>
+    {
+        Matrix4 result;
+        T det;
+        if consteval {
+            det = simd::mat4_inverse_affine<T>(result.data(), this->data());
+        } else {
+            det = simd::mat4_inverse_affine(result.data(), this->data());
+        }
+        check_invertible(det);
+        return result;
+    }
+
+    /// @brief Inverse of a rigid transformation, an affine transformation
+    /// whose 3x3 part is a rotation: the rotation is transposed. Other
+    /// matrices give meaningless results.
+    [[nodiscard]] constexpr Matrix4 inverse_rigid() const noexcept
+        requires std::floating_point<T>
+    {
+        Matrix4 result;
+        if consteval {
+            simd::mat4_inverse_rigid<T>(result.data(), this->data());
+        } else {
+            simd::mat4_inverse_rigid(result.data(), this->data());
+        }
+        return result;
     }
 
     friend constexpr bool operator==(const Matrix4 &lhs, const Matrix4 &rhs) noexcept {
@@ -149,8 +230,27 @@ public:
         os << ")";
         return os;
     }
+
+private:
+    static constexpr void check_invertible(T det) {
+        if (det == T {}) {
+            throw std::runtime_error("matrix is singular");
+        }
+    }
 };
 
+/// @brief Transforms the column vector `vec`, i.e. `result[r]` is the dot
+/// product of row `r` with `vec`. Batches of vectors are transformed by the
+/// kernels in `transform.hpp`.
+template <Numeric T>
+constexpr Vector4<T> operator*(const Matrix4<T> &mat, const Vector4<T> &vec) noexcept {
+    Vector4<T> result;
+    for (std::size_t r = 0; r < 4; ++r) {
+        result[r] = mat[r, 0] * vec[0] + mat[r, 1] * vec[1] + mat[r, 2] * vec[2] + mat[r, 3] * vec[3];
+    }
+    return result;
+}
+
 using Matrix4D = Matrix4<real>;
 
 } // namespace dk::math
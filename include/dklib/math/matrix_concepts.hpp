@@ -24,6 +24,30 @@ inline constexpr bool is_matrix_type_v = is_matrix_type<T>::value;
 template <typename T>
 concept MatrixType = is_matrix_type_v<T>;
 
+/// Matches `Matrix` and the classes derived from it, e.g. `Matrix3`.
+template <typename T>
+concept MatrixLike = MatrixType<T> or MatrixType<typename T::Base>;
+
+template <Numeric T>
+class DynMatrix;
+
+template <typename T>
+struct is_dynamic_matrix_type : std::false_type { };
+
+template <typename T>
+struct is_dynamic_matrix_type<DynMatrix<T>> : std::true_type { };
+
+template <typename T>
+inline constexpr bool is_dynamic_matrix_type_v = is_dynamic_matrix_type<T>::value;
+
+/// Matrices whose extents are only known at runtime, see `dyn_matrix.hpp`.
+template <typename T>
+concept DynamicMatrixType = is_dynamic_matrix_type_v<T>;
+
+/// Fixed size as well as dynamic matrices.
+template <typename T>
+concept AnyMatrixType = MatrixLike<T> or DynamicMatrixType<T>;
+
 template <std::size_t Cols, std::size_t Rows>
 concept SymmetricMatrix = (Cols == Rows);
 
@@ -0,0 +1,165 @@
+#ifndef DK_MATH_MATRIX_SOA_HPP
+#define DK_MATH_MATRIX_SOA_HPP
+
+/// @file matrix_soa.hpp
+///
+/// Structure-of-arrays storage for large numbers of small fixed size
+/// matrices.
+///
+/// `MatrixSoA` keeps every element position in its own lane, element
+/// `(i, j)` of all matrices being contiguous, so the batched kernels of
+/// `batch_decomposition.hpp` run one matrix per SIMD lane, like the
+/// `Vector3SoA` kernels do for vectors. Lanes start on a cache line and are
+/// padded to a whole number of cache lines, the padding starts out zero.
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <dklib/math/aligned_allocator.hpp>
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/matrix.hpp>
+
+namespace dk::math {
+
+template <Numeric T, std::size_t Rows, std::size_t Cols>
+class MatrixSoA {
+public:
+    using value_type = T;
+    using matrix_type = Matrix<T, Rows, Cols>;
+    using lane_type = std::vector<T, AlignedAllocator<T>>;
+
+    /// Lanes are padded to a multiple of this many elements.
+    static constexpr std::size_t lane_width = cache_line_size / sizeof(T);
+
+    MatrixSoA() = default;
+
+    /// @brief Creates `count` zero matrices.
+    explicit MatrixSoA(std::size_t count) { resize(count); }
+
+    /// @brief Creates the container from `Matrix` values.
+    explicit MatrixSoA(std::span<const matrix_type> matrices) { gather(matrices); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Number of elements of every lane, including the padding.
+    [[nodiscard]] std::size_t padded_size() const noexcept { return lanes_[0].size(); }
+
+    [[nodiscard]] static constexpr std::size_t padded_size(std::size_t count) noexcept {
+        return (count + lane_width - 1) / lane_width * lane_width;
+    }
+
+    void reserve(std::size_t count) {
+        for (auto &lane : lanes_) {
+            lane.reserve(padded_size(count));
+        }
+    }
+
+    /// @brief Changes the number of matrices, new matrices are zero.
+    void resize(std::size_t count) {
+        const std::size_t old_size = size_;
+        resize_lanes(count);
+        if (count > old_size) {
+            for (auto &lane : lanes_) {
+                std::fill(lane.begin() + old_size, lane.begin() + count, T {});
+            }
+        }
+    }
+
+    void clear() noexcept { resize_lanes(0); }
+
+    void push_back(const matrix_type &mat) {
+        resize_lanes(size_ + 1);
+        set(size_ - 1, mat);
+    }
+
+    [[nodiscard]] matrix_type operator[](std::size_t idx) const noexcept {
+        matrix_type result;
+        for (std::size_t k = 0; k < Rows * Cols; ++k) {
+            result[k] = lanes_[k][idx];
+        }
+        return result;
+    }
+
+    [[nodiscard]] matrix_type at(std::size_t idx) const {
+        if (idx >= size()) {
+            throw std::runtime_error("index out of bounds");
+        }
+        return (*this)[idx];
+    }
+
+    void set(std::size_t idx, const matrix_type &mat) noexcept {
+        for (std::size_t k = 0; k < Rows * Cols; ++k) {
+            lanes_[k][idx] = mat[k];
+        }
+    }
+
+    /// Lane of element (`row`, `col`), aligned to `cache_line_size` and
+    /// valid for `padded_size()` elements.
+    [[nodiscard]] T *lane(std::size_t row, std::size_t col) noexcept {
+        return std::assume_aligned<cache_line_size>(lanes_[row * Cols + col].data());
+    }
+
+    [[nodiscard]] const T *lane(std::size_t row, std::size_t col) const noexcept {
+        return std::assume_aligned<cache_line_size>(lanes_[row * Cols + col].data());
+    }
+
+    /// @brief Replaces the contents by the matrices of `matrices`.
+    void gather(std::span<const matrix_type> matrices) {
+        resize_lanes(matrices.size());
+        for (std::size_t k = 0; k < Rows * Cols; ++k) {
+            T *out = lane(k / Cols, k % Cols);
+            for (std::size_t i = 0; i < size_; ++i) {
+                out[i] = matrices[i][k];
+            }
+        }
+    }
+
+    /// @brief Writes all matrices to `matrices`, which has to hold `size()` of them.
+    void scatter(std::span<matrix_type> matrices) const noexcept {
+        assert(matrices.size() == size_);
+        for (std::size_t k = 0; k < Rows * Cols; ++k) {
+            const T *in = lane(k / Cols, k % Cols);
+            for (std::size_t i = 0; i < size_; ++i) {
+                matrices[i][k] = in[i];
+            }
+        }
+    }
+
+    [[nodiscard]] std::vector<matrix_type> to_vector() const {
+        std::vector<matrix_type> matrices(size_);
+        scatter(matrices);
+        return matrices;
+    }
+
+private:
+    /// Resizes the lanes, new elements are value-initialized to zero and
+    /// removed elements that stay in the padding are zeroed as well.
+    void resize_lanes(std::size_t count) {
+        const std::size_t padded = padded_size(count);
+        for (auto &lane : lanes_) {
+            lane.resize(padded);
+            if (count < size_) {
+                std::fill(lane.begin() + count, lane.begin() + std::min(size_, padded), T {});
+            }
+        }
+        size_ = count;
+    }
+
+    std::array<lane_type, Rows * Cols> lanes_;
+    std::size_t size_ = 0;
+};
+
+/// Right-hand sides and solutions of batched systems.
+template <Numeric T, std::size_t N>
+using VectorSoA = MatrixSoA<T, N, 1>;
+
+} // namespace dk::math
+
+#endif // DK_MATH_MATRIX_SOA_HPP
@@ -0,0 +1,313 @@
+#ifndef DK_MATH_QR_HPP
+#define DK_MATH_QR_HPP
+
+/// @file qr.hpp
+///
+/// Householder QR factorization of row-major `m x n` matrices with `m ≥ n`.
+///
+/// `factor` overwrites `a` with `R` on and above the diagonal and the
+/// Householder vectors below it, LAPACK style: `Q = H(0) * ... * H(n - 1)`
+/// with `H(j) = I - tau[j] * v * vᵀ`, where `v` has a unit element `j`,
+/// which is implied, zeros above it and rows `j + 1` to `m` of column `j`
+/// below it.
+///
+/// Small matrices are factored column by column, every reflector being
+/// applied to the remaining columns right away. From `min_blocked_columns`
+/// on the factorization is blocked: a panel of `block_size` columns is
+/// copied out transposed, so that its columns are contiguous, and factored
+/// there as above. Its reflectors are accumulated into the compact WY form
+/// `I - V * T * Vᵀ`, and the trailing matrix receives
+/// `A2 -= V * (Tᵀ * (Vᵀ * A2))`, the two large products running on the
+/// blocked GEMM.
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+#include <dklib/math/gemm.hpp>
+
+namespace dk::math::qr {
+
+/// Columns per panel of the blocked factorization.
+inline constexpr std::size_t block_size = 32;
+
+/// Smallest number of columns factored by the blocked path.
+inline constexpr std::size_t min_blocked_columns = 64;
+
+namespace detail {
+
+    /// Turns rows `j` to `m` of column `j` into a Householder vector and
+    /// returns its `tau`. A column that is already zero below the diagonal
+    /// gives `tau = 0`, `H(j)` is then the identity.
+    template <typename T>
+    constexpr T make_reflector(T *a, std::size_t m, std::size_t ld, std::size_t j) noexcept {
+        T tail {};
+        for (std::size_t i = j + 1; i < m; ++i) {
+            tail += a[i * ld + j] * a[i * ld + j];
+        }
+        if (tail == T {}) {
+            return T {};
+        }
+        const T alpha = a[j * ld + j];
+        const T norm = std::sqrt(alpha * alpha + tail);
+        const T beta = alpha >= T {} ? -norm : norm;
+        const T scale = T { 1 } / (alpha - beta);
+        for (std::size_t i = j + 1; i < m; ++i) {
+            a[i * ld + j] *= scale;
+        }
+        a[j * ld + j] = beta;
+        return (beta - alpha) / beta;
+    }
+
+    /// Applies `H(j)`, stored in column `j` of `v`, to columns `begin` to
+    /// `end` of `b`. `work` holds `end - begin` elements.
+    template <typename T>
+    constexpr void apply_reflector(
+        const T *v, std::size_t m, std::size_t ld, std::size_t j, T tau, T *b, std::size_t ldb, std::size_t begin, std::size_t end,
+        T *work
+    ) noexcept {
+        if (tau == T {}) {
+            return;
+        }
+        const std::size_t width = end - begin;
+        const T *pivot_row = b + j * ldb + begin;
+        for (std::size_t c = 0; c < width; ++c) {
+            work[c] = pivot_row[c];
+        }
+        for (std::size_t i = j + 1; i < m; ++i) {
+            const T factor = v[i * ld + j];
+            const T *row = b + i * ldb + begin;
+#pragma omp simd
+            for (std::size_t c = 0; c < width; ++c) {
+                work[c] += factor * row[c];
+            }
+        }
+        for (std::size_t c = 0; c < width; ++c) {
+            work[c] *= tau;
+        }
+        T *target = b + j * ldb + begin;
+        for (std::size_t c = 0; c < width; ++c) {
+            target[c] -= work[c];
+        }
+        for (std::size_t i = j + 1; i < m; ++i) {
+            const T factor = v[i * ld + j];
+            T *row = b + i * ldb + begin;
+#pragma omp simd
+            for (std::size_t c = 0; c < width; ++c) {
+                row[c] -= factor * work[c];
+            }
+        }
+    }
+
+    /// Factors the `width x rows` transposed panel `vt` in place, as
+    /// `make_reflector` and `apply_reflector` do on columns.
+    template <typename T>
+    void factor_transposed(T *vt, std::size_t rows, std::size_t width, T *tau) noexcept {
+        for (std::size_t j = 0; j < width; ++j) {
+            T *column = vt + j * rows;
+            T tail {};
+#pragma omp simd reduction(+ : tail)
+            for (std::size_t i = j + 1; i < rows; ++i) {
+                tail += column[i] * column[i];
+            }
+            if (tail == T {}) {
+                tau[j] = T {};
+                continue;
+            }
+            const T alpha = column[j];
+            const T norm = std::sqrt(alpha * alpha + tail);
+            const T beta = alpha >= T {} ? -norm : norm;
+            const T scale = T { 1 } / (alpha - beta);
+#pragma omp simd
+            for (std::size_t i = j + 1; i < rows; ++i) {
+                column[i] *= scale;
+            }
+            column[j] = beta;
+            tau[j] = (beta - alpha) / beta;
+
+            for (std::size_t c = j + 1; c < width; ++c) {
+                T *other = vt + c * rows;
+                T sum = other[j];
+#pragma omp simd reduction(+ : sum)
+                for (std::size_t i = j + 1; i < rows; ++i) {
+                    sum += column[i] * other[i];
+                }
+                sum *= tau[j];
+                other[j] -= sum;
+#pragma omp simd
+                for (std::size_t i = j + 1; i < rows; ++i) {
+                    other[i] -= sum * column[i];
+                }
+            }
+        }
+    }
+
+    /// Factors the panel of `width` columns at `k` and applies its
+    /// reflectors to the columns right of it through their compact WY form.
+    template <typename T>
+    void factor_blocked(T *a, std::size_t m, std::size_t n, std::size_t ld, std::size_t k, std::size_t width, T *tau) {
+        const std::size_t rows = m - k;
+        const std::size_t rest = n - k - width;
+
+        // `Vᵀ`, factored in place, then given its implied unit diagonal and
+        // zeros once `R` is copied back.
+        std::vector<T> vt(width * rows);
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t p = 0; p < width; ++p) {
+                vt[p * rows + i] = a[(k + i) * ld + k + p];
+            }
+        }
+        factor_transposed(vt.data(), rows, width, tau + k);
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t p = 0; p < width; ++p) {
+                a[(k + i) * ld + k + p] = vt[p * rows + i];
+            }
+        }
+        for (std::size_t p = 0; p < width; ++p) {
+            std::fill(vt.begin() + p * rows, vt.begin() + p * rows + p, T {});
+            vt[p * rows + p] = T { 1 };
+        }
+
+        // Upper triangular `T`, column `p` is `-tau[p] * T * Vᵀ * v[p]`.
+        std::vector<T> t(width * width, T {});
+        for (std::size_t p = 0; p < width; ++p) {
+            const T *column = vt.data() + p * rows;
+            for (std::size_t q = 0; q < p; ++q) {
+                const T *other = vt.data() + q * rows;
+                T dot {};
+#pragma omp simd reduction(+ : dot)
+                for (std::size_t i = p; i < rows; ++i) {
+                    dot += other[i] * column[i];
+                }
+                t[q * width + p] = dot;
+            }
+            for (std::size_t q = 0; q < p; ++q) {
+                T sum {};
+                for (std::size_t r = q; r < p; ++r) {
+                    sum += t[q * width + r] * t[r * width + p];
+                }
+                t[q * width + p] = sum;
+            }
+            for (std::size_t q = 0; q < p; ++q) {
+                t[q * width + p] *= -tau[k + p];
+            }
+            t[p * width + p] = tau[k + p];
+        }
+
+        // `W = Vᵀ * A2`, then `W = -Tᵀ * W` in place from the last row up.
+        T *a2 = a + k * ld + k + width;
+        std::vector<T> w(width * rest);
+        gemm::multiply<T>(width, rest, rows, { vt.data(), rows, 1 }, { a2, ld, 1 }, w.data(), rest);
+        for (std::size_t p = width; p-- > 0;) {
+            T *row = w.data() + p * rest;
+            const T diagonal = -t[p * width + p];
+#pragma omp simd
+            for (std::size_t c = 0; c < rest; ++c) {
+                row[c] *= diagonal;
+            }
+            for (std::size_t q = 0; q < p; ++q) {
+                const T factor = -t[q * width + p];
+                const T *source = w.data() + q * rest;
+#pragma omp simd
+                for (std::size_t c = 0; c < rest; ++c) {
+                    row[c] += factor * source[c];
+                }
+            }
+        }
+        gemm::multiply<T>(rows, rest, width, { vt.data(), 1, rows }, { w.data(), rest, 1 }, a2, ld, true);
+    }
+
+} // namespace detail
+
+/// @brief Factors the `m x n` matrix at `a` in place, see the file comment.
+/// @param  [in] ld Distance between the rows of `a`, at least `n`.
+/// @param  [out] tau Scalar factors of the reflectors, `n` elements.
+/// @param  [out] work Scratch space, `n` elements.
+/// @param  [in] panel_width Columns per panel, `n` or more factors the
+///                          matrix unblocked. Zero is taken as one, and
+///                          constant evaluation is always unblocked.
+template <std::floating_point T>
+constexpr void factor(T *a, std::size_t m, std::size_t n, std::size_t ld, T *tau, T *work, std::size_t panel_width) {
+    if consteval {
+        panel_width = n;
+    }
+    panel_width = std::max<std::size_t>(panel_width, 1);
+    for (std::size_t k = 0; k < n; k += panel_width) {
+        const std::size_t panel = std::min(panel_width, n - k);
+        if !consteval {
+            if (k + panel < n) {
+                detail::factor_blocked(a, m, n, ld, k, panel, tau);
+                continue;
+            }
+        }
+        for (std::size_t j = k; j < k + panel; ++j) {
+            tau[j] = detail::make_reflector(a, m, ld, j);
+            detail::apply_reflector(a, m, ld, j, tau[j], a, ld, j + 1, n, work);
+        }
+    }
+}
+
+/// @brief Same as above, blocked from `min_blocked_columns` on. Constant
+/// evaluation is always unblocked.
+template <std::floating_point T>
+constexpr void factor(T *a, std::size_t m, std::size_t n, std::size_t ld, T *tau, T *work) {
+    if !consteval {
+        if (n >= min_blocked_columns) {
+            return factor(a, m, n, ld, tau, work, block_size);
+        }
+    }
+    factor(a, m, n, ld, tau, work, n);
+}
+
+/// @brief Overwrites the `m x nrhs` matrix `b` with `Qᵀ * b`.
+/// @param  [out] work Scratch space, `nrhs` elements.
+template <std::floating_point T>
+constexpr void apply_qt(const T *qr, std::size_t m, std::size_t n, std::size_t ld, const T *tau, T *b, std::size_t nrhs, std::size_t ldb, T *work) noexcept {
+    for (std::size_t j = 0; j < n; ++j) {
+        detail::apply_reflector(qr, m, ld, j, tau[j], b, ldb, 0, nrhs, work);
+    }
+}
+
+/// @brief Writes the first `n` columns of `Q` to the `m x n` matrix `q`.
+/// @param  [out] work Scratch space, `n` elements.
+template <std::floating_point T>
+constexpr void form_q(const T *qr, std::size_t m, std::size_t n, std::size_t ld, const T *tau, T *q, std::size_t ldq, T *work) noexcept {
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            q[i * ldq + j] = i == j ? T { 1 } : T {};
+        }
+    }
+    // `H(j)` leaves the rows and columns before `j` of the partial product alone.
+    for (std::size_t j = n; j-- > 0;) {
+        detail::apply_reflector(qr, m, ld, j, tau[j], q, ldq, j, n, work);
+    }
+}
+
+/// @brief Overwrites the `m x nrhs` matrix `b` with `Qᵀ * b` and its first
+/// `n` rows with the least squares solution of `a * x = b`. `R` has to be
+/// regular.
+/// @param  [out] work Scratch space, `nrhs` elements.
+template <std::floating_point T>
+constexpr void solve(const T *qr, std::size_t m, std::size_t n, std::size_t ld, const T *tau, T *b, std::size_t nrhs, std::size_t ldb, T *work) noexcept {
+    apply_qt(qr, m, n, ld, tau, b, nrhs, ldb, work);
+    for (std::size_t i = n; i-- > 0;) {
+        T *row = b + i * ldb;
+        for (std::size_t p = i + 1; p < n; ++p) {
+            const T factor = qr[i * ld + p];
+            const T *source = b + p * ldb;
+            for (std::size_t c = 0; c < nrhs; ++c) {
+                row[c] -= factor * source[c];
+            }
+        }
+        const T diagonal = qr[i * ld + i];
+        for (std::size_t c = 0; c < nrhs; ++c) {
+            row[c] /= diagonal;
+        }
+    }
+}
+
+} // namespace dk::math::qr
+
+#endif // DK_MATH_QR_HPP
@@ -79,6 +79,9 @@ public:
     ///                   it can be any arbitrary axis.
     ///
     /// @return Rotated copy (which is created as copy of the original vector).
+    ///
+    /// Rotating many vectors by the same rotation is cheaper with `Rotation`,
+    /// which prepares the quaternion only once.
     constexpr static Vector3D rotate(const Vector3D &vec, Angle angle, const Vector3D &axis);
 
     /// @brief Returns the norm of quaternion.
@@ -150,13 +153,12 @@ constexpr Quaternion::Quaternion(const Vector3D &vec, Angle angle)
 constexpr Vector3D Quaternion::vector_part() const { return imag; }
 
 constexpr Vector3D Quaternion::rotate(const Vector3D &vec, Angle angle, const Vector3D &axis) {
-    const Quaternion pure_quat = { vec, 0.0f };
     const Vector3D rotation_axis = axis.normalized();
     const Quaternion rotation_quat = Quaternion(rotation_axis, angle).to_unit_norm();
-    const Quaternion rotation_quat_inverse = rotation_quat.inverse();
-    const Quaternion rotated = rotation_quat * pure_quat * rotation_quat_inverse;
 
-    return rotated.imag;
+    // Expanded form of the `q * v * q^-1` sandwich product for unit `q`.
+    const Vector3D t = cross(rotation_quat.imag, vec) * 2.0f;
+    return vec + t * rotation_quat.real + cross(rotation_quat.imag, t);
 }
 
 constexpr bool operator==(const Quaternion &lhs, const Quaternion &rhs) {
@@ -0,0 +1,84 @@
+#ifndef DK_MATH_ROTATION_HPP
+#define DK_MATH_ROTATION_HPP
+
+/// @file rotation.hpp
+///
+/// Prepared rotation by a fixed axis and angle.
+///
+/// `Quaternion::rotate` normalizes the axis, evaluates `cos` and `sin`, builds
+/// the inverse and multiplies three quaternions on every call. `Rotation` does
+/// the setup once and rotates every vector by the expanded sandwich product
+///
+///     v' = v + 2w (q x v) + 2 q x (q x v),
+///
+/// which it evaluates as `v + w t + q x t` with `t = 2 (q x v)`, two cross
+/// products per vector. Spans and SoA lanes run on the kernels selected by
+/// `dispatch.hpp`.
+
+#include <cassert>
+#include <span>
+
+#include <dklib/math/angle.hpp>
+#include <dklib/math/dispatch.hpp>
+#include <dklib/math/quaternion.hpp>
+#include <dklib/math/vector3_soa.hpp>
+#include <dklib/math/vector3d.hpp>
+
+namespace dk::math {
+
+class Rotation {
+public:
+    /// @brief Prepares the rotation by `angle` around `axis`, which does not
+    /// need to be normalized.
+    constexpr Rotation(Angle angle, const Vector3D &axis)
+        : Rotation(Quaternion(axis.normalized(), angle).to_unit_norm()) { }
+
+    /// @brief Prepares the rotation by a unit quaternion, e.g. one returned by
+    /// `Quaternion::unit_norm`.
+    explicit constexpr Rotation(const Quaternion &unit) noexcept
+        : quat_ { unit.imag.get_x(), unit.imag.get_y(), unit.imag.get_z(), unit.real } { }
+
+    /// @brief Returns the unit quaternion of the rotation.
+    [[nodiscard]] constexpr Quaternion quaternion() const noexcept {
+        return { quat_[0], quat_[1], quat_[2], quat_[3] };
+    }
+
+    /// @brief Rotates a single vector.
+    [[nodiscard]] constexpr Vector3D operator()(const Vector3D &vec) const noexcept {
+        const float qx = quat_[0];
+        const float qy = quat_[1];
+        const float qz = quat_[2];
+        const float qw = quat_[3];
+        const float tx = 2.0f * (qy * vec.get_z() - qz * vec.get_y());
+        const float ty = 2.0f * (qz * vec.get_x() - qx * vec.get_z());
+        const float tz = 2.0f * (qx * vec.get_y() - qy * vec.get_x());
+        return {
+            vec.get_x() + qw * tx + (qy * tz - qz * ty),
+            vec.get_y() + qw * ty + (qz * tx - qx * tz),
+            vec.get_z() + qw * tz + (qx * ty - qy * tx),
+        };
+    }
+
+    /// @brief Rotates every vector of `in` into `out`, they may be the same span.
+    void operator()(std::span<const Vector3D> in, std::span<Vector3D> out) const noexcept {
+        assert(in.size() == out.size());
+        dispatch::kernels().rotate3(
+            in.size(), quat_, reinterpret_cast<const float *>(in.data()), reinterpret_cast<float *>(out.data())
+        );
+    }
+
+    /// @brief Rotates every vector of `in` into `out`, which is resized to the
+    /// size of `in` and may be `in` itself.
+    void operator()(const Vector3SoA<float> &in, Vector3SoA<float> &out) const {
+        out.resize(in.size());
+        dispatch::kernels().rotate3_soa(in.padded_size(), quat_, in.x(), in.y(), in.z(), out.x(), out.y(), out.z());
+    }
+
+private:
+    /// Unit quaternion as (x, y, z, w), the layout the kernels expect.
+    float quat_[4];
+};
+
+} // namespace dk::math
+
+#endif // DK_MATH_ROTATION_HPP
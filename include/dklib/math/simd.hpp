@@ -0,0 +1,714 @@
+#ifndef DK_MATH_SIMD_HPP
+#define DK_MATH_SIMD_HPP
+
+/// @file simd.hpp
+///
+/// Opt-in SIMD storage and kernel layer for the fixed size 4D types.
+///
+/// The layer is selected at compile time. It is enabled by defining
+/// `DK_USE_SIMD` (the `DK_ENABLE_SIMD` CMake option does that) and it picks
+/// the widest instruction set that the compiler is allowed to target:
+///
+///   - SSE2 maps `Vector4<float>` onto one `__m128` and `Matrix4<float>` onto
+///     four of them,
+///   - AVX maps `Vector4<double>` onto one `__m256d` and `Matrix4<double>` onto
+///     four of them.
+///
+/// The layer also provides the square tile kernels of the blocked transpose,
+/// 4x4 with SSE (float) and AVX (double) and 8x8 float with AVX, and the
+/// branch-free 4x4 inverses of `Matrix4`.
+///
+/// Kernels only use plain multiplications and additions in the same order as
+/// the scalar code paths, so the results are bit-for-bit identical to them.
+
+#include <cstddef>
+
+#if DK_USE_SIMD and (defined(__SSE2__) or defined(_M_X64))
+#include <immintrin.h>
+#define DK_SIMD_SSE 1
+#if defined(__AVX__)
+#define DK_SIMD_AVX 1
+#endif
+#endif
+
+#ifndef DK_SIMD_SSE
+#define DK_SIMD_SSE 0
+#endif
+
+#ifndef DK_SIMD_AVX
+#define DK_SIMD_AVX 0
+#endif
+
+namespace dk::math::simd {
+
+/// Whether a tensor with `N` elements of type `T` is backed by SIMD kernels.
+template <typename T, std::size_t N>
+inline constexpr bool accelerated = false;
+
+#if DK_SIMD_SSE
+template <>
+inline constexpr bool accelerated<float, 4> = true;
+template <>
+inline constexpr bool accelerated<float, 16> = true;
+#endif
+
+#if DK_SIMD_AVX
+template <>
+inline constexpr bool accelerated<double, 4> = true;
+template <>
+inline constexpr bool accelerated<double, 16> = true;
+#endif
+
+/// Alignment of the storage of a tensor with `N` elements of type `T`.
+///
+/// Accelerated types are aligned to the width of one register, so that rows
+/// never straddle a cache line, other types keep their natural alignment.
+template <typename T, std::size_t N>
+inline constexpr std::size_t alignment = accelerated<T, N> ? 4 * sizeof(T) : alignof(T);
+
+/// Portable kernels, these are the only candidates when the matching
+/// instruction set is not enabled, so that callers can name the kernels
+/// unconditionally and guard them with `accelerated` only.
+template <typename T>
+constexpr void add4(T *lhs, const T *rhs) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+        lhs[i] += rhs[i];
+    }
+}
+
+template <typename T>
+constexpr void sub4(T *lhs, const T *rhs) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+        lhs[i] -= rhs[i];
+    }
+}
+
+template <typename T>
+constexpr void mul4(T *lhs, const T *rhs) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+        lhs[i] *= rhs[i];
+    }
+}
+
+template <typename T>
+constexpr void div4(T *lhs, const T *rhs) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+        lhs[i] /= rhs[i];
+    }
+}
+
+template <typename T>
+constexpr void scale4(T *lhs, T value) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+        lhs[i] *= value;
+    }
+}
+
+template <typename T>
+constexpr void divide4(T *lhs, T value) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+        lhs[i] /= value;
+    }
+}
+
+template <typename T>
+constexpr void negate4(T *lhs) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+        lhs[i] = -lhs[i];
+    }
+}
+
+template <typename T>
+constexpr void mat4_mul(T *out, const T *lhs, const T *rhs) noexcept {
+    T result[16] {};
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                result[i * 4 + j] += lhs[i * 4 + k] * rhs[k * 4 + j];
+            }
+        }
+    }
+    for (std::size_t i = 0; i < 16; ++i) {
+        out[i] = result[i];
+    }
+}
+
+/// `mat4_mul` for affine `lhs` and `rhs`, whose last row is `(0, 0, 0, 1)`.
+/// Only the first three rows are accumulated, the last one is copied, which
+/// gives the same result as the full product.
+template <typename T>
+constexpr void mat4_mul_affine(T *out, const T *lhs, const T *rhs) noexcept {
+    T result[12] {};
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                result[i * 4 + j] += lhs[i * 4 + k] * rhs[k * 4 + j];
+            }
+        }
+    }
+    for (std::size_t i = 0; i < 12; ++i) {
+        out[i] = result[i];
+    }
+    for (std::size_t j = 0; j < 4; ++j) {
+        out[12 + j] = rhs[12 + j];
+    }
+}
+
+/// Row-major 4x4 inverse by cofactor expansion, returns the determinant.
+///
+/// The lanes of every vector below hold one row of the result. `pairs[k]`
+/// is column `k` of `in` with its rows exchanged in pairs, and `minors(p, q)`
+/// holds the 2x2 minors of columns `p` and `q`, `(c, -c, s, -s)` with `c`
+/// taken from rows two and three and `s` from rows zero and one, which
+/// builds the signs of the cofactors into the products. Lane `r` of the
+/// adjugate times `in` is the determinant on the diagonal, which is cheaper
+/// to sum vertically than across the lanes. The adjugate is scaled by its
+/// reciprocal without checking it, a singular `in` leaves non-finite values
+/// in `out`. The accelerated overloads evaluate the same expressions in
+/// registers.
+template <typename T>
+constexpr T mat4_inverse(T *out, const T *in) noexcept {
+    T cols[4][4] {};
+    T pairs[4][4] {};
+    for (std::size_t k = 0; k < 4; ++k) {
+        for (std::size_t r = 0; r < 4; ++r) {
+            cols[k][r] = in[r * 4 + k];
+            pairs[k][r] = in[(r ^ 1) * 4 + k];
+        }
+    }
+    const auto minors = [&](std::size_t p, std::size_t q, T *result) {
+        T products[4] {};
+        for (std::size_t r = 0; r < 4; ++r) {
+            products[r] = cols[p][r] * pairs[q][r];
+        }
+        for (std::size_t r = 0; r < 4; ++r) {
+            result[r] = products[r ^ 2] - products[r ^ 3];
+        }
+    };
+    T z[6][4] {};
+    minors(0, 1, z[0]);
+    minors(0, 2, z[1]);
+    minors(0, 3, z[2]);
+    minors(1, 2, z[3]);
+    minors(1, 3, z[4]);
+    minors(2, 3, z[5]);
+
+    T rows[4][4] {};
+    T det[4] {};
+    for (std::size_t r = 0; r < 4; ++r) {
+        rows[0][r] = (pairs[1][r] * z[5][r] - pairs[2][r] * z[4][r]) + pairs[3][r] * z[3][r];
+        rows[1][r] = (pairs[2][r] * z[2][r] - pairs[0][r] * z[5][r]) - pairs[3][r] * z[1][r];
+        rows[2][r] = (pairs[0][r] * z[4][r] - pairs[1][r] * z[2][r]) + pairs[3][r] * z[0][r];
+        rows[3][r] = (pairs[1][r] * z[1][r] - pairs[0][r] * z[3][r]) - pairs[2][r] * z[0][r];
+        det[r] = (rows[0][r] * cols[0][r] + rows[1][r] * cols[1][r]) + (rows[2][r] * cols[2][r] + rows[3][r] * cols[3][r]);
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t r = 0; r < 4; ++r) {
+            out[i * 4 + r] = rows[i][r] * (T(1) / det[r]);
+        }
+    }
+    return det[0];
+}
+
+/// Inverse of a row-major affine transformation, whose last row is
+/// `(0, 0, 0, 1)`, returns the determinant of its 3x3 part `A`.
+///
+/// The columns of `A⁻¹` are the cross products of the rows of `A` divided by
+/// the determinant, which is again summed vertically, the translation `t`
+/// becomes `-A⁻¹ * t`. Singular parts leave non-finite values in `out`, as
+/// for `mat4_inverse`.
+template <typename T>
+constexpr T mat4_inverse_affine(T *out, const T *in) noexcept {
+    // yzx(v) = (v[1], v[2], v[0], v[3]), cross(a, b) = yzx(a * yzx(b) - yzx(a) * b).
+    const auto cross = [&](std::size_t a, std::size_t b, T *result) {
+        constexpr std::size_t yzx[4] { 1, 2, 0, 3 };
+        T lanes[4] {};
+        for (std::size_t r = 0; r < 4; ++r) {
+            lanes[r] = in[a * 4 + r] * in[b * 4 + yzx[r]] - in[a * 4 + yzx[r]] * in[b * 4 + r];
+        }
+        for (std::size_t r = 0; r < 4; ++r) {
+            result[r] = lanes[yzx[r]];
+        }
+    };
+    T x[3][4] {};
+    cross(1, 2, x[0]);
+    cross(2, 0, x[1]);
+    cross(0, 1, x[2]);
+    // The last lane only feeds the last row of the result, which is known.
+    T det[3] {};
+    for (std::size_t r = 0; r < 3; ++r) {
+        det[r] = (in[r] * x[0][r] + in[4 + r] * x[1][r]) + in[8 + r] * x[2][r];
+    }
+    for (std::size_t j = 0; j < 3; ++j) {
+        for (std::size_t r = 0; r < 3; ++r) {
+            x[j][r] *= T(1) / det[r];
+        }
+    }
+    for (std::size_t r = 0; r < 3; ++r) {
+        out[r * 4 + 0] = x[0][r];
+        out[r * 4 + 1] = x[1][r];
+        out[r * 4 + 2] = x[2][r];
+        out[r * 4 + 3] = -((x[0][r] * in[3] + x[1][r] * in[7]) + x[2][r] * in[11]);
+    }
+    out[12] = out[13] = out[14] = T {};
+    out[15] = T(1);
+    return det[0];
+}
+
+/// Inverse of a row-major rigid transformation, an orthonormal 3x3 part `R`
+/// and a translation `t`: `Rᵀ` and `-Rᵀ * t`.
+template <typename T>
+constexpr void mat4_inverse_rigid(T *out, const T *in) noexcept {
+    T translation[3] {};
+    for (std::size_t r = 0; r < 3; ++r) {
+        translation[r] = -((in[r] * in[3] + in[4 + r] * in[7]) + in[8 + r] * in[11]);
+    }
+    for (std::size_t r = 0; r < 3; ++r) {
+        out[r * 4 + 0] = in[r];
+        out[r * 4 + 1] = in[4 + r];
+        out[r * 4 + 2] = in[8 + r];
+        out[r * 4 + 3] = translation[r];
+    }
+    out[12] = out[13] = out[14] = T {};
+    out[15] = T(1);
+}
+
+/// Side of the square tiles `transpose_tile_kernel` handles for `T`.
+template <typename T>
+inline constexpr std::size_t transpose_tile = 4;
+
+/// Whether `transpose_tile_kernel` transposes tiles of `T` in registers.
+template <typename T>
+inline constexpr bool accelerated_transpose = false;
+
+#if DK_SIMD_SSE
+template <>
+inline constexpr bool accelerated_transpose<float> = true;
+#endif
+
+#if DK_SIMD_AVX
+template <>
+inline constexpr std::size_t transpose_tile<float> = 8;
+template <>
+inline constexpr bool accelerated_transpose<double> = true;
+#endif
+
+/// Writes the transpose of the `transpose_tile<T>` square tile at `src` to
+/// `dst`, both row-major with leading dimensions `lds` and `ldd`. The tiles
+/// must not overlap.
+template <typename T>
+constexpr void transpose_tile_kernel(T *dst, std::size_t ldd, const T *src, std::size_t lds) noexcept {
+    constexpr std::size_t tile = transpose_tile<T>;
+    for (std::size_t j = 0; j < tile; ++j) {
+        for (std::size_t i = 0; i < tile; ++i) {
+            dst[j * ldd + i] = src[i * lds + j];
+        }
+    }
+}
+
+#if DK_SIMD_SSE
+
+inline void add4(float *lhs, const float *rhs) noexcept {
+    _mm_storeu_ps(lhs, _mm_add_ps(_mm_loadu_ps(lhs), _mm_loadu_ps(rhs)));
+}
+
+inline void sub4(float *lhs, const float *rhs) noexcept {
+    _mm_storeu_ps(lhs, _mm_sub_ps(_mm_loadu_ps(lhs), _mm_loadu_ps(rhs)));
+}
+
+inline void mul4(float *lhs, const float *rhs) noexcept {
+    _mm_storeu_ps(lhs, _mm_mul_ps(_mm_loadu_ps(lhs), _mm_loadu_ps(rhs)));
+}
+
+inline void div4(float *lhs, const float *rhs) noexcept {
+    _mm_storeu_ps(lhs, _mm_div_ps(_mm_loadu_ps(lhs), _mm_loadu_ps(rhs)));
+}
+
+inline void scale4(float *lhs, float value) noexcept {
+    _mm_storeu_ps(lhs, _mm_mul_ps(_mm_loadu_ps(lhs), _mm_set1_ps(value)));
+}
+
+inline void divide4(float *lhs, float value) noexcept {
+    _mm_storeu_ps(lhs, _mm_div_ps(_mm_loadu_ps(lhs), _mm_set1_ps(value)));
+}
+
+inline void negate4(float *lhs) noexcept {
+    _mm_storeu_ps(lhs, _mm_xor_ps(_mm_loadu_ps(lhs), _mm_set1_ps(-0.0f)));
+}
+
+/// Row-major 4x4 product `out = lhs * rhs`, `out` may alias `lhs` or `rhs`.
+///
+/// Every row of the result is accumulated from zero as a sum of the rows of
+/// `rhs` scaled by the matching element of `lhs`, which is exactly the order in
+/// which the scalar triple loop adds the partial products.
+inline void mat4_mul(float *out, const float *lhs, const float *rhs) noexcept {
+    const __m128 r0 = _mm_loadu_ps(rhs + 0);
+    const __m128 r1 = _mm_loadu_ps(rhs + 4);
+    const __m128 r2 = _mm_loadu_ps(rhs + 8);
+    const __m128 r3 = _mm_loadu_ps(rhs + 12);
+    __m128 rows[4];
+    for (std::size_t i = 0; i < 4; ++i) {
+        const float *row = lhs + 4 * i;
+        __m128 acc = _mm_setzero_ps();
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(row[0]), r0));
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(row[1]), r1));
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(row[2]), r2));
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(row[3]), r3));
+        rows[i] = acc;
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        _mm_storeu_ps(out + 4 * i, rows[i]);
+    }
+}
+
+inline void mat4_mul_affine(float *out, const float *lhs, const float *rhs) noexcept {
+    const __m128 r0 = _mm_loadu_ps(rhs + 0);
+    const __m128 r1 = _mm_loadu_ps(rhs + 4);
+    const __m128 r2 = _mm_loadu_ps(rhs + 8);
+    const __m128 r3 = _mm_loadu_ps(rhs + 12);
+    __m128 rows[3];
+    for (std::size_t i = 0; i < 3; ++i) {
+        const float *row = lhs + 4 * i;
+        __m128 acc = _mm_setzero_ps();
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(row[0]), r0));
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(row[1]), r1));
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(row[2]), r2));
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(row[3]), r3));
+        rows[i] = acc;
+    }
+    for (std::size_t i = 0; i < 3; ++i) {
+        _mm_storeu_ps(out + 4 * i, rows[i]);
+    }
+    _mm_storeu_ps(out + 12, r3);
+}
+
+namespace detail {
+
+    inline __m128 swap_pairs(__m128 v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+    inline __m128 swap_halves(__m128 v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)); }
+
+    inline __m128 yzx(__m128 v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1)); }
+
+    /// `minors(p, q)` of `mat4_inverse`, `lhs * swap_pairs(rhs)` minus its
+    /// own pair swap, with the halves exchanged.
+    inline __m128 minors(__m128 lhs, __m128 lhs_pairs, __m128 rhs, __m128 rhs_pairs) noexcept {
+        return swap_halves(_mm_sub_ps(_mm_mul_ps(lhs, rhs_pairs), _mm_mul_ps(lhs_pairs, rhs)));
+    }
+
+    inline __m128 cross(__m128 a, __m128 b) noexcept {
+        return yzx(_mm_sub_ps(_mm_mul_ps(a, yzx(b)), _mm_mul_ps(yzx(a), b)));
+    }
+
+    /// Transposes the rotation and translation in `r0` to `r3` and stores
+    /// them above the row `(0, 0, 0, 1)`.
+    inline void store_affine(float *out, __m128 r0, __m128 r1, __m128 r2, __m128 r3) noexcept {
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(out, r0);
+        _mm_storeu_ps(out + 4, r1);
+        _mm_storeu_ps(out + 8, r2);
+        _mm_storeu_ps(out + 12, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+} // namespace detail
+
+/// Branch-free `mat4_inverse`, one `__m128` per column of `in` and per row
+/// of the result.
+inline float mat4_inverse(float *out, const float *in) noexcept {
+    __m128 c0 = _mm_loadu_ps(in + 0);
+    __m128 c1 = _mm_loadu_ps(in + 4);
+    __m128 c2 = _mm_loadu_ps(in + 8);
+    __m128 c3 = _mm_loadu_ps(in + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    const __m128 p0 = detail::swap_pairs(c0);
+    const __m128 p1 = detail::swap_pairs(c1);
+    const __m128 p2 = detail::swap_pairs(c2);
+    const __m128 p3 = detail::swap_pairs(c3);
+    const __m128 z0 = detail::minors(c0, p0, c1, p1);
+    const __m128 z1 = detail::minors(c0, p0, c2, p2);
+    const __m128 z2 = detail::minors(c0, p0, c3, p3);
+    const __m128 z3 = detail::minors(c1, p1, c2, p2);
+    const __m128 z4 = detail::minors(c1, p1, c3, p3);
+    const __m128 z5 = detail::minors(c2, p2, c3, p3);
+
+    const __m128 r0 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(p1, z5), _mm_mul_ps(p2, z4)), _mm_mul_ps(p3, z3));
+    const __m128 r1 = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(p2, z2), _mm_mul_ps(p0, z5)), _mm_mul_ps(p3, z1));
+    const __m128 r2 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(p0, z4), _mm_mul_ps(p1, z2)), _mm_mul_ps(p3, z0));
+    const __m128 r3 = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(p1, z1), _mm_mul_ps(p0, z3)), _mm_mul_ps(p2, z0));
+    const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, c0), _mm_mul_ps(r1, c1)), _mm_add_ps(_mm_mul_ps(r2, c2), _mm_mul_ps(r3, c3)));
+    const __m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), det);
+    _mm_storeu_ps(out + 0, _mm_mul_ps(r0, scale));
+    _mm_storeu_ps(out + 4, _mm_mul_ps(r1, scale));
+    _mm_storeu_ps(out + 8, _mm_mul_ps(r2, scale));
+    _mm_storeu_ps(out + 12, _mm_mul_ps(r3, scale));
+    return _mm_cvtss_f32(det);
+}
+
+inline float mat4_inverse_affine(float *out, const float *in) noexcept {
+    const __m128 r0 = _mm_loadu_ps(in + 0);
+    const __m128 r1 = _mm_loadu_ps(in + 4);
+    const __m128 r2 = _mm_loadu_ps(in + 8);
+    const __m128 a0 = detail::cross(r1, r2);
+    const __m128 a1 = detail::cross(r2, r0);
+    const __m128 a2 = detail::cross(r0, r1);
+    const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, a0), _mm_mul_ps(r1, a1)), _mm_mul_ps(r2, a2));
+    const __m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), det);
+    const __m128 x0 = _mm_mul_ps(a0, scale);
+    const __m128 x1 = _mm_mul_ps(a1, scale);
+    const __m128 x2 = _mm_mul_ps(a2, scale);
+    const __m128 sum = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(x0, _mm_set1_ps(in[3])), _mm_mul_ps(x1, _mm_set1_ps(in[7]))), _mm_mul_ps(x2, _mm_set1_ps(in[11]))
+    );
+    detail::store_affine(out, x0, x1, x2, _mm_xor_ps(sum, _mm_set1_ps(-0.0f)));
+    return _mm_cvtss_f32(det);
+}
+
+inline void mat4_inverse_rigid(float *out, const float *in) noexcept {
+    const __m128 r0 = _mm_loadu_ps(in + 0);
+    const __m128 r1 = _mm_loadu_ps(in + 4);
+    const __m128 r2 = _mm_loadu_ps(in + 8);
+    const __m128 sum = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(r0, _mm_set1_ps(in[3])), _mm_mul_ps(r1, _mm_set1_ps(in[7]))), _mm_mul_ps(r2, _mm_set1_ps(in[11]))
+    );
+    detail::store_affine(out, r0, r1, r2, _mm_xor_ps(sum, _mm_set1_ps(-0.0f)));
+}
+
+#if not DK_SIMD_AVX
+/// 4x4 float tile in four registers, `_MM_TRANSPOSE4_PS` does the shuffles.
+inline void transpose_tile_kernel(float *dst, std::size_t ldd, const float *src, std::size_t lds) noexcept {
+    __m128 r0 = _mm_loadu_ps(src);
+    __m128 r1 = _mm_loadu_ps(src + lds);
+    __m128 r2 = _mm_loadu_ps(src + 2 * lds);
+    __m128 r3 = _mm_loadu_ps(src + 3 * lds);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(dst, r0);
+    _mm_storeu_ps(dst + ldd, r1);
+    _mm_storeu_ps(dst + 2 * ldd, r2);
+    _mm_storeu_ps(dst + 3 * ldd, r3);
+}
+#endif
+
+#endif // DK_SIMD_SSE
+
+#if DK_SIMD_AVX
+
+inline void add4(double *lhs, const double *rhs) noexcept {
+    _mm256_storeu_pd(lhs, _mm256_add_pd(_mm256_loadu_pd(lhs), _mm256_loadu_pd(rhs)));
+}
+
+inline void sub4(double *lhs, const double *rhs) noexcept {
+    _mm256_storeu_pd(lhs, _mm256_sub_pd(_mm256_loadu_pd(lhs), _mm256_loadu_pd(rhs)));
+}
+
+inline void mul4(double *lhs, const double *rhs) noexcept {
+    _mm256_storeu_pd(lhs, _mm256_mul_pd(_mm256_loadu_pd(lhs), _mm256_loadu_pd(rhs)));
+}
+
+inline void div4(double *lhs, const double *rhs) noexcept {
+    _mm256_storeu_pd(lhs, _mm256_div_pd(_mm256_loadu_pd(lhs), _mm256_loadu_pd(rhs)));
+}
+
+inline void scale4(double *lhs, double value) noexcept {
+    _mm256_storeu_pd(lhs, _mm256_mul_pd(_mm256_loadu_pd(lhs), _mm256_set1_pd(value)));
+}
+
+inline void divide4(double *lhs, double value) noexcept {
+    _mm256_storeu_pd(lhs, _mm256_div_pd(_mm256_loadu_pd(lhs), _mm256_set1_pd(value)));
+}
+
+inline void negate4(double *lhs) noexcept {
+    _mm256_storeu_pd(lhs, _mm256_xor_pd(_mm256_loadu_pd(lhs), _mm256_set1_pd(-0.0)));
+}
+
+/// Double precision variant of `mat4_mul`, one `__m256d` per row.
+inline void mat4_mul(double *out, const double *lhs, const double *rhs) noexcept {
+    const __m256d r0 = _mm256_loadu_pd(rhs + 0);
+    const __m256d r1 = _mm256_loadu_pd(rhs + 4);
+    const __m256d r2 = _mm256_loadu_pd(rhs + 8);
+    const __m256d r3 = _mm256_loadu_pd(rhs + 12);
+    __m256d rows[4];
+    for (std::size_t i = 0; i < 4; ++i) {
+        const double *row = lhs + 4 * i;
+        __m256d acc = _mm256_setzero_pd();
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(row[0]), r0));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(row[1]), r1));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(row[2]), r2));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(row[3]), r3));
+        rows[i] = acc;
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        _mm256_storeu_pd(out + 4 * i, rows[i]);
+    }
+}
+
+inline void mat4_mul_affine(double *out, const double *lhs, const double *rhs) noexcept {
+    const __m256d r0 = _mm256_loadu_pd(rhs + 0);
+    const __m256d r1 = _mm256_loadu_pd(rhs + 4);
+    const __m256d r2 = _mm256_loadu_pd(rhs + 8);
+    const __m256d r3 = _mm256_loadu_pd(rhs + 12);
+    __m256d rows[3];
+    for (std::size_t i = 0; i < 3; ++i) {
+        const double *row = lhs + 4 * i;
+        __m256d acc = _mm256_setzero_pd();
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(row[0]), r0));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(row[1]), r1));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(row[2]), r2));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(row[3]), r3));
+        rows[i] = acc;
+    }
+    for (std::size_t i = 0; i < 3; ++i) {
+        _mm256_storeu_pd(out + 4 * i, rows[i]);
+    }
+    _mm256_storeu_pd(out + 12, r3);
+}
+
+namespace detail {
+
+    inline __m256d swap_pairs(__m256d v) noexcept { return _mm256_permute_pd(v, 0b0101); }
+
+    inline __m256d swap_halves(__m256d v) noexcept { return _mm256_permute2f128_pd(v, v, 1); }
+
+    /// `(v[1], v[2], v[0], v[3])`, one cross-lane permute with AVX2 and three
+    /// permutes and a blend without.
+    inline __m256d yzx(__m256d v) noexcept {
+#if defined(__AVX2__)
+        return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 0, 2, 1));
+#else
+        return _mm256_blend_pd(_mm256_permute_pd(v, 0b1001), _mm256_permute_pd(swap_halves(v), 0), 0b0110);
+#endif
+    }
+
+    inline __m256d minors(__m256d lhs, __m256d lhs_pairs, __m256d rhs, __m256d rhs_pairs) noexcept {
+        return swap_halves(_mm256_sub_pd(_mm256_mul_pd(lhs, rhs_pairs), _mm256_mul_pd(lhs_pairs, rhs)));
+    }
+
+    inline __m256d cross(__m256d a, __m256d b) noexcept {
+        return yzx(_mm256_sub_pd(_mm256_mul_pd(a, yzx(b)), _mm256_mul_pd(yzx(a), b)));
+    }
+
+    inline void transpose4(__m256d &r0, __m256d &r1, __m256d &r2, __m256d &r3) noexcept {
+        const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+        const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+        const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+        const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+        r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+        r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+        r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+        r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+    }
+
+    inline void store_affine(double *out, __m256d r0, __m256d r1, __m256d r2, __m256d r3) noexcept {
+        transpose4(r0, r1, r2, r3);
+        _mm256_storeu_pd(out, r0);
+        _mm256_storeu_pd(out + 4, r1);
+        _mm256_storeu_pd(out + 8, r2);
+        _mm256_storeu_pd(out + 12, _mm256_setr_pd(0.0, 0.0, 0.0, 1.0));
+    }
+
+} // namespace detail
+
+/// Double precision variant of `mat4_inverse`, one `__m256d` per column of
+/// `in` and per row of the result.
+inline double mat4_inverse(double *out, const double *in) noexcept {
+    __m256d c0 = _mm256_loadu_pd(in + 0);
+    __m256d c1 = _mm256_loadu_pd(in + 4);
+    __m256d c2 = _mm256_loadu_pd(in + 8);
+    __m256d c3 = _mm256_loadu_pd(in + 12);
+    detail::transpose4(c0, c1, c2, c3);
+    const __m256d p0 = detail::swap_pairs(c0);
+    const __m256d p1 = detail::swap_pairs(c1);
+    const __m256d p2 = detail::swap_pairs(c2);
+    const __m256d p3 = detail::swap_pairs(c3);
+    const __m256d z0 = detail::minors(c0, p0, c1, p1);
+    const __m256d z1 = detail::minors(c0, p0, c2, p2);
+    const __m256d z2 = detail::minors(c0, p0, c3, p3);
+    const __m256d z3 = detail::minors(c1, p1, c2, p2);
+    const __m256d z4 = detail::minors(c1, p1, c3, p3);
+    const __m256d z5 = detail::minors(c2, p2, c3, p3);
+
+    const __m256d r0 = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(p1, z5), _mm256_mul_pd(p2, z4)), _mm256_mul_pd(p3, z3));
+    const __m256d r1 = _mm256_sub_pd(_mm256_sub_pd(_mm256_mul_pd(p2, z2), _mm256_mul_pd(p0, z5)), _mm256_mul_pd(p3, z1));
+    const __m256d r2 = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(p0, z4), _mm256_mul_pd(p1, z2)), _mm256_mul_pd(p3, z0));
+    const __m256d r3 = _mm256_sub_pd(_mm256_sub_pd(_mm256_mul_pd(p1, z1), _mm256_mul_pd(p0, z3)), _mm256_mul_pd(p2, z0));
+    const __m256d det = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r0, c0), _mm256_mul_pd(r1, c1)), _mm256_add_pd(_mm256_mul_pd(r2, c2), _mm256_mul_pd(r3, c3)));
+    const __m256d scale = _mm256_div_pd(_mm256_set1_pd(1.0), det);
+    _mm256_storeu_pd(out + 0, _mm256_mul_pd(r0, scale));
+    _mm256_storeu_pd(out + 4, _mm256_mul_pd(r1, scale));
+    _mm256_storeu_pd(out + 8, _mm256_mul_pd(r2, scale));
+    _mm256_storeu_pd(out + 12, _mm256_mul_pd(r3, scale));
+    return _mm256_cvtsd_f64(det);
+}
+
+inline double mat4_inverse_affine(double *out, const double *in) noexcept {
+    const __m256d r0 = _mm256_loadu_pd(in + 0);
+    const __m256d r1 = _mm256_loadu_pd(in + 4);
+    const __m256d r2 = _mm256_loadu_pd(in + 8);
+    const __m256d a0 = detail::cross(r1, r2);
+    const __m256d a1 = detail::cross(r2, r0);
+    const __m256d a2 = detail::cross(r0, r1);
+    const __m256d det = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r0, a0), _mm256_mul_pd(r1, a1)), _mm256_mul_pd(r2, a2));
+    const __m256d scale = _mm256_div_pd(_mm256_set1_pd(1.0), det);
+    const __m256d x0 = _mm256_mul_pd(a0, scale);
+    const __m256d x1 = _mm256_mul_pd(a1, scale);
+    const __m256d x2 = _mm256_mul_pd(a2, scale);
+    const __m256d sum = _mm256_add_pd(
+        _mm256_add_pd(_mm256_mul_pd(x0, _mm256_set1_pd(in[3])), _mm256_mul_pd(x1, _mm256_set1_pd(in[7]))),
+        _mm256_mul_pd(x2, _mm256_set1_pd(in[11]))
+    );
+    detail::store_affine(out, x0, x1, x2, _mm256_xor_pd(sum, _mm256_set1_pd(-0.0)));
+    return _mm256_cvtsd_f64(det);
+}
+
+inline void mat4_inverse_rigid(double *out, const double *in) noexcept {
+    const __m256d r0 = _mm256_loadu_pd(in + 0);
+    const __m256d r1 = _mm256_loadu_pd(in + 4);
+    const __m256d r2 = _mm256_loadu_pd(in + 8);
+    const __m256d sum = _mm256_add_pd(
+        _mm256_add_pd(_mm256_mul_pd(r0, _mm256_set1_pd(in[3])), _mm256_mul_pd(r1, _mm256_set1_pd(in[7]))),
+        _mm256_mul_pd(r2, _mm256_set1_pd(in[11]))
+    );
+    detail::store_affine(out, r0, r1, r2, _mm256_xor_pd(sum, _mm256_set1_pd(-0.0)));
+}
+
+/// 4x4 double tile: pairs of rows are interleaved within the 128-bit lanes,
+/// then the lanes are exchanged.
+inline void transpose_tile_kernel(double *dst, std::size_t ldd, const double *src, std::size_t lds) noexcept {
+    __m256d r0 = _mm256_loadu_pd(src);
+    __m256d r1 = _mm256_loadu_pd(src + lds);
+    __m256d r2 = _mm256_loadu_pd(src + 2 * lds);
+    __m256d r3 = _mm256_loadu_pd(src + 3 * lds);
+    detail::transpose4(r0, r1, r2, r3);
+    _mm256_storeu_pd(dst, r0);
+    _mm256_storeu_pd(dst + ldd, r1);
+    _mm256_storeu_pd(dst + 2 * ldd, r2);
+    _mm256_storeu_pd(dst + 3 * ldd, r3);
+}
+
+/// 8x8 float tile: interleave, shuffle within the lanes, exchange the lanes.
+inline void transpose_tile_kernel(float *dst, std::size_t ldd, const float *src, std::size_t lds) noexcept {
+    __m256 r[8];
+    for (std::size_t i = 0; i < 8; ++i) {
+        r[i] = _mm256_loadu_ps(src + i * lds);
+    }
+    __m256 t[8];
+    for (std::size_t i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+    }
+    for (std::size_t i = 0; i < 8; i += 4) {
+        r[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+        r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+        r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+        r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        _mm256_storeu_ps(dst + i * ldd, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+        _mm256_storeu_ps(dst + (i + 4) * ldd, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+    }
+}
+
+#endif // DK_SIMD_AVX
+
+} // namespace dk::math::simd
+
+#endif // DK_MATH_SIMD_HPP
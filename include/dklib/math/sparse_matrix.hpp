@@ -0,0 +1,705 @@
+#ifndef DK_MATH_SPARSE_MATRIX_HPP
+#define DK_MATH_SPARSE_MATRIX_HPP
+
+/// @file sparse_matrix.hpp
+///
+/// Compressed sparse row (CSR) and column (CSC) matrices.
+///
+/// `CompressedMatrix` stores the nonzero elements of every row (`CsrMatrix`)
+/// or column (`CscMatrix`) contiguously, with their column or row indices
+/// sorted and unique, and an offset per row or column into those arrays.
+/// Indices are 32 bit, which keeps the index stream of the products at half
+/// the bandwidth of `std::size_t` ones. Matrices are assembled from
+/// `(row, col, value)` triplets by a `TripletBuilder`, where duplicate
+/// triplets add up like finite element contributions do:
+///
+///     TripletBuilder<double> builder(n, n);
+///     builder.add(i, j, w);
+///     const auto laplacian = builder.to_csr();
+///     multiply_into(execution::par, laplacian, x, y); // y = L * x
+///
+/// Products walk the compressed lines in order. A line whose result element
+/// is a dot product with gathered elements of `x` (the rows of a CSR
+/// matrix, the columns of a CSC matrix for its transpose) is independent of
+/// the other lines, so the parallel overloads split the lines into blocks of
+/// about `parallel_block_nonzeros` elements each. The other products
+/// scatter scaled lines into the result and run on the calling thread, e.g.
+/// `transposed(a) * x` for a CSR `a` needs no transpose of `a`, but converting
+/// it with `to_csc()` once is worth it when the transposed product is
+/// repeated in parallel.
+///
+/// Products with dense matrices (SpMM) take views, so `DynMatrix`, `Matrix`
+/// and blocks of them are all accepted, and accumulate scaled rows of the
+/// dense operand with unit strides. Up to four columns, e.g. vertex
+/// positions, the rows of the result are accumulated in registers, and one
+/// pass over the sparse matrix is cheaper than one SpMV per column.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/dyn_matrix.hpp>
+#include <dklib/math/dyn_vector.hpp>
+#include <dklib/math/execution.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/view.hpp>
+
+namespace dk::math {
+
+/// Which lines of a `CompressedMatrix` are stored contiguously.
+enum class SparseLayout {
+    csr,
+    csc,
+};
+
+template <Numeric T, SparseLayout Layout>
+class CompressedMatrix;
+
+template <Numeric T = real>
+using CsrMatrix = CompressedMatrix<T, SparseLayout::csr>;
+
+template <Numeric T = real>
+using CscMatrix = CompressedMatrix<T, SparseLayout::csc>;
+
+namespace sparse {
+
+    using index_type = std::uint32_t;
+
+    /// Nonzero elements per task of the parallel products.
+    inline constexpr std::size_t parallel_block_nonzeros = std::size_t { 1 } << 15;
+
+    [[nodiscard]] constexpr SparseLayout other(SparseLayout layout) noexcept {
+        return layout == SparseLayout::csr ? SparseLayout::csc : SparseLayout::csr;
+    }
+
+    /// Compressed lines, the `lines` outer dimension selects a line and the
+    /// `width` inner dimension an element within it.
+    template <typename T>
+    struct Compressed {
+        std::vector<std::size_t> offsets;
+        std::vector<index_type> indices;
+        std::vector<T> values;
+    };
+
+    /// Compresses `count` triplets given by their outer and inner indices,
+    /// sorting them by two stable counting sorts and adding up duplicates.
+    template <typename T>
+    Compressed<T> compress(
+        std::size_t lines, std::size_t width, const index_type *outer, const index_type *inner, const T *values, std::size_t count
+    ) {
+        // Sorting by inner index first leaves every line sorted after the
+        // stable sort by outer index.
+        std::vector<std::size_t> by_inner(width + 1, 0);
+        for (std::size_t k = 0; k < count; ++k) {
+            ++by_inner[inner[k] + 1];
+        }
+        for (std::size_t i = 0; i < width; ++i) {
+            by_inner[i + 1] += by_inner[i];
+        }
+        std::vector<std::size_t> order(count);
+        for (std::size_t k = 0; k < count; ++k) {
+            order[by_inner[inner[k]]++] = k;
+        }
+
+        Compressed<T> result;
+        result.offsets.assign(lines + 1, 0);
+        for (std::size_t k = 0; k < count; ++k) {
+            ++result.offsets[outer[k] + 1];
+        }
+        for (std::size_t o = 0; o < lines; ++o) {
+            result.offsets[o + 1] += result.offsets[o];
+        }
+        std::vector<std::size_t> next(result.offsets.begin(), result.offsets.end() - 1);
+        result.indices.resize(count);
+        result.values.resize(count);
+        for (const std::size_t k : order) {
+            const std::size_t p = next[outer[k]]++;
+            result.indices[p] = inner[k];
+            result.values[p] = values[k];
+        }
+
+        std::size_t end = 0;
+        std::size_t begin = 0;
+        for (std::size_t o = 0; o < lines; ++o) {
+            const std::size_t line_end = result.offsets[o + 1];
+            const std::size_t line_begin = end;
+            for (std::size_t p = begin; p < line_end; ++p) {
+                if (end > line_begin and result.indices[end - 1] == result.indices[p]) {
+                    result.values[end - 1] += result.values[p];
+                } else {
+                    result.indices[end] = result.indices[p];
+                    result.values[end] = result.values[p];
+                    ++end;
+                }
+            }
+            begin = line_end;
+            result.offsets[o + 1] = end;
+        }
+        result.indices.resize(end);
+        result.values.resize(end);
+        return result;
+    }
+
+    /// Compressed lines of the transpose, i.e. the same matrix in the other
+    /// layout, by one counting sort over the inner indices.
+    template <typename T>
+    Compressed<T> transpose(std::size_t lines, std::size_t width, const Compressed<T> &source) {
+        const std::size_t count = source.indices.size();
+        Compressed<T> result;
+        result.offsets.assign(width + 1, 0);
+        for (const index_type i : source.indices) {
+            ++result.offsets[i + 1];
+        }
+        for (std::size_t i = 0; i < width; ++i) {
+            result.offsets[i + 1] += result.offsets[i];
+        }
+        std::vector<std::size_t> next(result.offsets.begin(), result.offsets.end() - 1);
+        result.indices.resize(count);
+        result.values.resize(count);
+        for (std::size_t o = 0; o < lines; ++o) {
+            for (std::size_t p = source.offsets[o]; p < source.offsets[o + 1]; ++p) {
+                const std::size_t q = next[source.indices[p]]++;
+                result.indices[q] = static_cast<index_type>(o);
+                result.values[q] = source.values[p];
+            }
+        }
+        return result;
+    }
+
+    /// `y[o] = sum(values[p] * x[indices[p]])` over the elements of every
+    /// line `o` in `[first, last)`.
+    template <typename T>
+    void gather_lines(const Compressed<T> &a, const T *x, T *y, std::size_t first, std::size_t last) noexcept {
+        const std::size_t *offsets = a.offsets.data();
+        const index_type *indices = a.indices.data();
+        const T *values = a.values.data();
+        for (std::size_t o = first; o < last; ++o) {
+            T sum {};
+            for (std::size_t p = offsets[o]; p < offsets[o + 1]; ++p) {
+                sum += values[p] * x[indices[p]];
+            }
+            y[o] = sum;
+        }
+    }
+
+    /// `y[indices[p]] += values[p] * x[o]` over the elements of every line.
+    template <typename T>
+    void scatter_lines(const Compressed<T> &a, std::size_t lines, const T *x, T *y) noexcept {
+        const std::size_t *offsets = a.offsets.data();
+        const index_type *indices = a.indices.data();
+        const T *values = a.values.data();
+        for (std::size_t o = 0; o < lines; ++o) {
+            const T scale = x[o];
+            // Indices are unique within a line, iterations never conflict.
+#pragma omp simd
+            for (std::size_t p = offsets[o]; p < offsets[o + 1]; ++p) {
+                y[indices[p]] += values[p] * scale;
+            }
+        }
+    }
+
+    /// First line of block `block` out of `blocks` blocks of about the same
+    /// number of elements.
+    inline std::size_t block_boundary(std::span<const std::size_t> offsets, std::size_t block, std::size_t blocks) noexcept {
+        const std::size_t lines = offsets.size() - 1;
+        if (block == blocks) {
+            return lines;
+        }
+        const std::size_t target = offsets[lines] * block / blocks;
+        return static_cast<std::size_t>(std::ranges::lower_bound(offsets.first(lines), target) - offsets.begin());
+    }
+
+    /// Calls `body(first, last)` for blocks of lines in parallel, see
+    /// `parallel_block_nonzeros`.
+    template <typename F>
+    void for_line_blocks(const execution::parallel_policy &policy, std::span<const std::size_t> offsets, F &&body) {
+        const std::size_t lines = offsets.size() - 1;
+        const std::size_t blocks = std::min(lines, std::max<std::size_t>(1, offsets[lines] / parallel_block_nonzeros));
+        policy.get_pool().parallel_for(blocks, [&](std::size_t block) {
+            body(block_boundary(offsets, block, blocks), block_boundary(offsets, block + 1, blocks));
+        });
+    }
+
+    /// Rows of `c` with `Width` unit stride columns accumulated in
+    /// registers, for the narrow dense operands such as vertex positions.
+    template <std::size_t Width, typename T>
+    void gather_rows_narrow(
+        const Compressed<T> &a, const T *b, std::size_t ldb, T *c, std::size_t ldc, std::size_t first, std::size_t last
+    ) noexcept {
+        const std::size_t *offsets = a.offsets.data();
+        const index_type *indices = a.indices.data();
+        const T *values = a.values.data();
+        for (std::size_t o = first; o < last; ++o) {
+            T acc[Width] = {};
+            for (std::size_t p = offsets[o]; p < offsets[o + 1]; ++p) {
+                const T scale = values[p];
+                const T *src = b + indices[p] * ldb;
+                for (std::size_t j = 0; j < Width; ++j) {
+                    acc[j] += scale * src[j];
+                }
+            }
+            std::copy_n(acc, Width, c + o * ldc);
+        }
+    }
+
+    /// `c[o, :] = sum(values[p] * b[indices[p], :])` for every line `o` in
+    /// `[first, last)`.
+    template <typename T>
+    void gather_rows(const Compressed<T> &a, MatrixView<const T> b, MatrixView<T> c, std::size_t first, std::size_t last) noexcept {
+        const std::size_t n = b.cols();
+        if (b.stride(1) == 1 and c.stride(1) == 1) {
+            const T *src = b.data();
+            T *dst = c.data();
+            const std::size_t ldb = b.stride(0);
+            const std::size_t ldc = c.stride(0);
+            switch (n) {
+            case 1:
+                return gather_rows_narrow<1>(a, src, ldb, dst, ldc, first, last);
+            case 2:
+                return gather_rows_narrow<2>(a, src, ldb, dst, ldc, first, last);
+            case 3:
+                return gather_rows_narrow<3>(a, src, ldb, dst, ldc, first, last);
+            case 4:
+                return gather_rows_narrow<4>(a, src, ldb, dst, ldc, first, last);
+            default:
+                break;
+            }
+            // Wider rows of the result are accumulated in strips held
+            // locally, like the small dense products of `view.hpp`.
+            constexpr std::size_t strip = 64;
+            for (std::size_t o = first; o < last; ++o) {
+                for (std::size_t j0 = 0; j0 < n; j0 += strip) {
+                    const std::size_t width = std::min(strip, n - j0);
+                    T acc[strip] = {};
+                    for (std::size_t p = a.offsets[o]; p < a.offsets[o + 1]; ++p) {
+                        const T scale = a.values[p];
+                        const T *row = src + a.indices[p] * ldb + j0;
+                        for (std::size_t j = 0; j < width; ++j) {
+                            acc[j] += scale * row[j];
+                        }
+                    }
+                    std::copy_n(acc, width, dst + o * ldc + j0);
+                }
+            }
+            return;
+        }
+        for (std::size_t o = first; o < last; ++o) {
+            for (std::size_t j = 0; j < n; ++j) {
+                T sum {};
+                for (std::size_t p = a.offsets[o]; p < a.offsets[o + 1]; ++p) {
+                    sum += a.values[p] * b[a.indices[p], j];
+                }
+                c[o, j] = sum;
+            }
+        }
+    }
+
+    /// `c[indices[p], :] += values[p] * b[o, :]` over the elements of every
+    /// line `o`.
+    template <typename T>
+    void scatter_rows(const Compressed<T> &a, std::size_t lines, MatrixView<const T> b, MatrixView<T> c) noexcept {
+        const std::size_t n = b.cols();
+        for (std::size_t o = 0; o < lines; ++o) {
+            for (std::size_t p = a.offsets[o]; p < a.offsets[o + 1]; ++p) {
+                const T scale = a.values[p];
+                for (std::size_t j = 0; j < n; ++j) {
+                    c[a.indices[p], j] += scale * b[o, j];
+                }
+            }
+        }
+    }
+
+} // namespace sparse
+
+/// Sparse matrix in compressed row or column form, see the file comment.
+///
+/// The sparsity pattern is fixed once the matrix is built, the values of the
+/// stored elements can be changed in place.
+template <Numeric T, SparseLayout Layout>
+class CompressedMatrix {
+public:
+    using value_type = T;
+    using index_type = sparse::index_type;
+
+    static constexpr SparseLayout layout = Layout;
+
+    CompressedMatrix() = default;
+
+    /// @brief Creates a `rows x cols` matrix without stored elements.
+    CompressedMatrix(std::size_t rows, std::size_t cols)
+        : CompressedMatrix(rows, cols, std::vector<std::size_t>(outer_extent(rows, cols) + 1, 0), {}, {}) { }
+
+    /// @brief Takes over compressed arrays: the elements of line `o` (a row
+    /// for CSR, a column for CSC) are `values[p]` at `indices[p]` for `p` in
+    /// `[offsets[o], offsets[o + 1])`, with increasing indices in every line.
+    /// @throws std::runtime_error if the arrays do not describe such a
+    ///         matrix.
+    CompressedMatrix(
+        std::size_t rows, std::size_t cols, std::vector<std::size_t> offsets, std::vector<index_type> indices, std::vector<T> values
+    )
+        : rows_ { rows }
+        , cols_ { cols }
+        , data_ { std::move(offsets), std::move(indices), std::move(values) } {
+        check_extents(rows, cols);
+        const std::size_t lines = outer_size();
+        if (data_.offsets.size() != lines + 1 or data_.offsets[0] != 0 or data_.offsets[lines] != data_.indices.size()
+            or data_.values.size() != data_.indices.size()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+        // All offsets first, the lines below must stay within `indices`.
+        for (std::size_t o = 0; o < lines; ++o) {
+            if (data_.offsets[o + 1] < data_.offsets[o]) {
+                throw std::runtime_error("dimension mismatch");
+            }
+        }
+        for (std::size_t o = 0; o < lines; ++o) {
+            for (std::size_t p = data_.offsets[o]; p < data_.offsets[o + 1]; ++p) {
+                if (data_.indices[p] >= inner_size() or (p > data_.offsets[o] and data_.indices[p] <= data_.indices[p - 1])) {
+                    throw std::runtime_error("index out of bounds");
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+    [[nodiscard]] std::size_t cols() const noexcept { return cols_; }
+
+    /// @brief Number of stored elements, including explicit zeros.
+    [[nodiscard]] std::size_t nonzeros() const noexcept { return data_.values.size(); }
+
+    /// @brief Number of compressed lines, rows for CSR and columns for CSC.
+    [[nodiscard]] std::size_t outer_size() const noexcept { return outer_extent(rows_, cols_); }
+
+    /// @brief Extent of the lines, columns for CSR and rows for CSC.
+    [[nodiscard]] std::size_t inner_size() const noexcept { return Layout == SparseLayout::csr ? cols_ : rows_; }
+
+    [[nodiscard]] std::span<const std::size_t> offsets() const noexcept { return data_.offsets; }
+    [[nodiscard]] std::span<const index_type> indices() const noexcept { return data_.indices; }
+    [[nodiscard]] std::span<const T> values() const noexcept { return data_.values; }
+    [[nodiscard]] std::span<T> values() noexcept { return data_.values; }
+
+    /// @brief Element `(x, y)`, zero if it is not stored, found by a binary
+    /// search of its line.
+    [[nodiscard]] T operator[](std::size_t x, std::size_t y) const noexcept {
+        const std::size_t line = Layout == SparseLayout::csr ? x : y;
+        const std::size_t index = Layout == SparseLayout::csr ? y : x;
+        const auto first = data_.indices.begin() + static_cast<std::ptrdiff_t>(data_.offsets[line]);
+        const auto last = data_.indices.begin() + static_cast<std::ptrdiff_t>(data_.offsets[line + 1]);
+        const auto it = std::lower_bound(first, last, index);
+        return it != last and *it == index ? data_.values[static_cast<std::size_t>(it - data_.indices.begin())] : T {};
+    }
+
+    [[nodiscard]] T at(std::size_t x, std::size_t y) const {
+        if (x >= rows_ or y >= cols_) {
+            throw std::runtime_error("index out of bounds");
+        }
+        return (*this)[x, y];
+    }
+
+    /// @brief The same matrix in CSR form.
+    [[nodiscard]] CsrMatrix<T> to_csr() const { return convert<SparseLayout::csr>(); }
+
+    /// @brief The same matrix in CSC form.
+    [[nodiscard]] CscMatrix<T> to_csc() const { return convert<SparseLayout::csc>(); }
+
+    /// @brief The transpose in the other layout, which shares the compressed
+    /// arrays, so only copies them.
+    [[nodiscard]] CompressedMatrix<T, sparse::other(Layout)> transpose() const & {
+        return CompressedMatrix<T, sparse::other(Layout)> { cols_, rows_, sparse::Compressed<T> { data_ } };
+    }
+
+    [[nodiscard]] CompressedMatrix<T, sparse::other(Layout)> transpose() && {
+        return CompressedMatrix<T, sparse::other(Layout)> { cols_, rows_, std::move(data_) };
+    }
+
+    [[nodiscard]] DynMatrix<T> to_dense() const {
+        DynMatrix<T> result(rows_, cols_);
+        for (std::size_t o = 0; o < outer_size(); ++o) {
+            for (std::size_t p = data_.offsets[o]; p < data_.offsets[o + 1]; ++p) {
+                if constexpr (Layout == SparseLayout::csr) {
+                    result[o, data_.indices[p]] = data_.values[p];
+                } else {
+                    result[data_.indices[p], o] = data_.values[p];
+                }
+            }
+        }
+        return result;
+    }
+
+    /// @brief The compressed arrays, for the product kernels.
+    [[nodiscard]] const sparse::Compressed<T> &compressed() const noexcept { return data_; }
+
+private:
+    template <Numeric, SparseLayout>
+    friend class CompressedMatrix;
+
+    template <Numeric>
+    friend class TripletBuilder;
+
+    /// Takes over arrays that are known to be valid.
+    CompressedMatrix(std::size_t rows, std::size_t cols, sparse::Compressed<T> data) noexcept
+        : rows_ { rows }
+        , cols_ { cols }
+        , data_ { std::move(data) } { }
+
+    [[nodiscard]] static constexpr std::size_t outer_extent(std::size_t rows, std::size_t cols) noexcept {
+        return Layout == SparseLayout::csr ? rows : cols;
+    }
+
+    static void check_extents(std::size_t rows, std::size_t cols) {
+        if (std::max(rows, cols) > std::numeric_limits<index_type>::max()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+    }
+
+    template <SparseLayout To>
+    CompressedMatrix<T, To> convert() const {
+        if constexpr (To == Layout) {
+            return *this;
+        } else {
+            return CompressedMatrix<T, To> { rows_, cols_, sparse::transpose(outer_size(), inner_size(), data_) };
+        }
+    }
+
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    sparse::Compressed<T> data_ { { 0 }, {}, {} };
+};
+
+/// Collects `(row, col, value)` triplets in any order and compresses them
+/// into a `CsrMatrix` or `CscMatrix`, duplicates adding up.
+template <Numeric T = real>
+class TripletBuilder {
+public:
+    using value_type = T;
+    using index_type = sparse::index_type;
+
+    /// @brief Starts a `rows x cols` matrix without elements.
+    TripletBuilder(std::size_t rows, std::size_t cols)
+        : rows_ { rows }
+        , cols_ { cols } {
+        if (std::max(rows, cols) > std::numeric_limits<index_type>::max()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+    }
+
+    [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+    [[nodiscard]] std::size_t cols() const noexcept { return cols_; }
+
+    /// @brief Number of triplets added, duplicates included.
+    [[nodiscard]] std::size_t size() const noexcept { return values_.size(); }
+
+    void reserve(std::size_t count) {
+        row_indices_.reserve(count);
+        col_indices_.reserve(count);
+        values_.reserve(count);
+    }
+
+    void clear() noexcept {
+        row_indices_.clear();
+        col_indices_.clear();
+        values_.clear();
+    }
+
+    /// @brief Adds `value` to element `(row, col)`.
+    void add(std::size_t row, std::size_t col, T value) {
+        if (row >= rows_ or col >= cols_) {
+            throw std::runtime_error("index out of bounds");
+        }
+        row_indices_.push_back(static_cast<index_type>(row));
+        col_indices_.push_back(static_cast<index_type>(col));
+        values_.push_back(value);
+    }
+
+    [[nodiscard]] CsrMatrix<T> to_csr() const {
+        return { rows_, cols_, sparse::compress(rows_, cols_, row_indices_.data(), col_indices_.data(), values_.data(), size()) };
+    }
+
+    [[nodiscard]] CscMatrix<T> to_csc() const {
+        return { rows_, cols_, sparse::compress(cols_, rows_, col_indices_.data(), row_indices_.data(), values_.data(), size()) };
+    }
+
+private:
+    std::size_t rows_;
+    std::size_t cols_;
+    std::vector<index_type> row_indices_;
+    std::vector<index_type> col_indices_;
+    std::vector<T> values_;
+};
+
+namespace detail {
+
+    template <typename T>
+    void check_sparse_product(std::size_t cols, std::size_t rows, std::span<const T> x, std::span<T> y) {
+        if (x.size() != cols or y.size() != rows) {
+            throw std::runtime_error("dimension mismatch");
+        }
+        if (x.data() == y.data() and not x.empty()) {
+            throw std::runtime_error("product must not alias its operands");
+        }
+    }
+
+    template <typename T>
+    void check_sparse_product(std::size_t rows, std::size_t cols, MatrixView<const T> b, MatrixView<T> c) {
+        if (b.rows() != cols or c.rows() != rows or c.cols() != b.cols()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+        if (b.data() == c.data() and not b.empty()) {
+            throw std::runtime_error("product must not alias its operands");
+        }
+    }
+
+} // namespace detail
+
+/// @brief Computes `y = a * x` (SpMV), `y` must not overlap `x`.
+template <Numeric T, SparseLayout Layout>
+void multiply_into(const CompressedMatrix<T, Layout> &a, std::type_identity_t<std::span<const T>> x, std::type_identity_t<std::span<T>> y) {
+    detail::check_sparse_product(a.cols(), a.rows(), x, y);
+    if constexpr (Layout == SparseLayout::csr) {
+        sparse::gather_lines(a.compressed(), x.data(), y.data(), 0, a.rows());
+    } else {
+        std::ranges::fill(y, T {});
+        sparse::scatter_lines(a.compressed(), a.cols(), x.data(), y.data());
+    }
+}
+
+/// @brief Same as `multiply_into` with blocks of rows computed in parallel,
+/// CSC matrices run on the calling thread.
+template <Numeric T, SparseLayout Layout>
+void multiply_into(
+    const execution::parallel_policy &policy, const CompressedMatrix<T, Layout> &a, std::type_identity_t<std::span<const T>> x,
+    std::type_identity_t<std::span<T>> y
+) {
+    if constexpr (Layout == SparseLayout::csr) {
+        detail::check_sparse_product(a.cols(), a.rows(), x, y);
+        sparse::for_line_blocks(policy, a.offsets(), [&](std::size_t first, std::size_t last) {
+            sparse::gather_lines(a.compressed(), x.data(), y.data(), first, last);
+        });
+    } else {
+        multiply_into(a, x, y);
+    }
+}
+
+/// @brief Computes `y = aᵀ * x` without building `aᵀ`, `y` must not overlap
+/// `x`.
+template <Numeric T, SparseLayout Layout>
+void multiply_into(
+    const Transposed<CompressedMatrix<T, Layout>> &at, std::type_identity_t<std::span<const T>> x, std::type_identity_t<std::span<T>> y
+) {
+    const auto &a = at.base();
+    detail::check_sparse_product(a.rows(), a.cols(), x, y);
+    if constexpr (Layout == SparseLayout::csc) {
+        sparse::gather_lines(a.compressed(), x.data(), y.data(), 0, a.cols());
+    } else {
+        std::ranges::fill(y, T {});
+        sparse::scatter_lines(a.compressed(), a.rows(), x.data(), y.data());
+    }
+}
+
+/// @brief Same as the transposed `multiply_into` with blocks of columns
+/// computed in parallel, CSR matrices run on the calling thread.
+template <Numeric T, SparseLayout Layout>
+void multiply_into(
+    const execution::parallel_policy &policy, const Transposed<CompressedMatrix<T, Layout>> &at,
+    std::type_identity_t<std::span<const T>> x, std::type_identity_t<std::span<T>> y
+) {
+    const auto &a = at.base();
+    if constexpr (Layout == SparseLayout::csc) {
+        detail::check_sparse_product(a.rows(), a.cols(), x, y);
+        sparse::for_line_blocks(policy, a.offsets(), [&](std::size_t first, std::size_t last) {
+            sparse::gather_lines(a.compressed(), x.data(), y.data(), first, last);
+        });
+    } else {
+        multiply_into(at, x, y);
+    }
+}
+
+/// @brief Computes `c = a * b` (SpMM) for a dense `b`, `c` must not overlap
+/// `b`.
+template <Numeric T, SparseLayout Layout>
+void multiply_into(
+    const CompressedMatrix<T, Layout> &a, std::type_identity_t<MatrixView<const T>> b, std::type_identity_t<MatrixView<T>> c
+) {
+    detail::check_sparse_product(a.rows(), a.cols(), b, c);
+    if constexpr (Layout == SparseLayout::csr) {
+        sparse::gather_rows(a.compressed(), b, c, 0, a.rows());
+    } else {
+        for (std::size_t i = 0; i < c.rows(); ++i) {
+            for (std::size_t j = 0; j < c.cols(); ++j) {
+                c[i, j] = T {};
+            }
+        }
+        sparse::scatter_rows(a.compressed(), a.cols(), b, c);
+    }
+}
+
+/// @brief Same as the SpMM `multiply_into` with blocks of rows computed in
+/// parallel, CSC matrices run on the calling thread.
+template <Numeric T, SparseLayout Layout>
+void multiply_into(
+    const execution::parallel_policy &policy, const CompressedMatrix<T, Layout> &a, std::type_identity_t<MatrixView<const T>> b,
+    std::type_identity_t<MatrixView<T>> c
+) {
+    if constexpr (Layout == SparseLayout::csr) {
+        detail::check_sparse_product(a.rows(), a.cols(), b, c);
+        sparse::for_line_blocks(policy, a.offsets(), [&](std::size_t first, std::size_t last) {
+            sparse::gather_rows(a.compressed(), b, c, first, last);
+        });
+    } else {
+        multiply_into(a, b, c);
+    }
+}
+
+template <Numeric T, SparseLayout Layout>
+DynVector<T> operator*(const CompressedMatrix<T, Layout> &a, const DynVector<T> &x) {
+    DynVector<T> y(a.rows());
+    multiply_into(a, x, y);
+    return y;
+}
+
+template <Numeric T, SparseLayout Layout>
+DynVector<T> operator*(const Transposed<CompressedMatrix<T, Layout>> &at, const DynVector<T> &x) {
+    DynVector<T> y(at.rows());
+    multiply_into(at, x, y);
+    return y;
+}
+
+template <Numeric T, SparseLayout Layout>
+DynMatrix<T> operator*(const CompressedMatrix<T, Layout> &a, const DynMatrix<T> &b) {
+    DynMatrix<T> c(a.rows(), b.cols());
+    multiply_into(a, view(b), view(c));
+    return c;
+}
+
+template <Numeric T, SparseLayout Layout>
+DynVector<T> multiply(const execution::parallel_policy &policy, const CompressedMatrix<T, Layout> &a, const DynVector<T> &x) {
+    DynVector<T> y(a.rows());
+    multiply_into(policy, a, x, y);
+    return y;
+}
+
+template <Numeric T, SparseLayout Layout>
+DynMatrix<T> multiply(const execution::parallel_policy &policy, const CompressedMatrix<T, Layout> &a, const DynMatrix<T> &b) {
+    DynMatrix<T> c(a.rows(), b.cols());
+    multiply_into(policy, a, view(b), view(c));
+    return c;
+}
+
+template <Numeric T, SparseLayout Layout>
+[[nodiscard]] Transposed<CompressedMatrix<T, Layout>> transposed(const CompressedMatrix<T, Layout> &mat) noexcept {
+    return Transposed<CompressedMatrix<T, Layout>> { mat };
+}
+
+template <Numeric T, SparseLayout Layout>
+void transposed(const CompressedMatrix<T, Layout> &&) = delete;
+
+} // namespace dk::math
+
+#endif // DK_MATH_SPARSE_MATRIX_HPP
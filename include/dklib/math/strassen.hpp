@@ -0,0 +1,179 @@
+#ifndef DK_MATH_STRASSEN_HPP
+#define DK_MATH_STRASSEN_HPP
+
+/// @file strassen.hpp
+///
+/// Strassen-Winograd multiplication of large square matrices.
+///
+/// Every level of recursion replaces eight half-size products by seven and
+/// fifteen additions, until the blocks are no larger than the crossover size
+/// and the blocked GEMM takes over. The crossover is a compile-time constant,
+/// `DK_STRASSEN_CROSSOVER`, and can also be passed explicitly.
+///
+/// The recursion never places blocks on the stack. All temporaries live in
+/// one caller provided scratch buffer of `scratch_size(n)` elements, which the
+/// convenience overload takes from a per-thread buffer that only ever grows.
+///
+/// Strassen-like algorithms have a weaker error bound than the classic one,
+/// the error grows roughly by a constant factor per level of recursion, the
+/// tests and `bench_dklib` report it against the blocked GEMM.
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/gemm.hpp>
+
+#ifndef DK_STRASSEN_CROSSOVER
+#define DK_STRASSEN_CROSSOVER 256
+#endif
+
+namespace dk::math::strassen {
+
+/// Blocks of at most this size are multiplied by the blocked GEMM.
+inline constexpr std::size_t default_crossover = DK_STRASSEN_CROSSOVER;
+
+/// Whether `operator*` of `Matrix<T, N, N>` goes through Strassen-Winograd,
+/// it needs at least one level of recursion to pay off and is limited to
+/// double precision, where the additional error is negligible.
+template <typename T, std::size_t N>
+inline constexpr bool use_strassen = std::same_as<T, double> and N > default_crossover;
+
+/// @brief Returns the number of scratch elements needed to multiply two
+/// `n x n` matrices.
+[[nodiscard]] constexpr std::size_t scratch_size(std::size_t n, std::size_t crossover = default_crossover) noexcept {
+    std::size_t size = 0;
+    while (n > crossover and n > 1) {
+        // Odd sizes recurse on the even leading part.
+        const std::size_t half = n / 2;
+        size += 2 * half * half;
+        n = half;
+    }
+    return size;
+}
+
+namespace detail {
+
+    /// `out = lhs + sign * rhs` over `n x n` strided blocks.
+    template <typename T>
+    void combine(std::size_t n, const T *lhs, std::size_t ldl, const T *rhs, std::size_t ldr, T *out, std::size_t ldo, bool subtract) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            const T *l = lhs + i * ldl;
+            const T *r = rhs + i * ldr;
+            T *o = out + i * ldo;
+            if (subtract) {
+#pragma omp simd
+                for (std::size_t j = 0; j < n; ++j) {
+                    o[j] = l[j] - r[j];
+                }
+            } else {
+#pragma omp simd
+                for (std::size_t j = 0; j < n; ++j) {
+                    o[j] = l[j] + r[j];
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void add(std::size_t n, const T *lhs, std::size_t ldl, const T *rhs, std::size_t ldr, T *out, std::size_t ldo) noexcept {
+        combine(n, lhs, ldl, rhs, ldr, out, ldo, false);
+    }
+
+    template <typename T>
+    void sub(std::size_t n, const T *lhs, std::size_t ldl, const T *rhs, std::size_t ldr, T *out, std::size_t ldo) noexcept {
+        combine(n, lhs, ldl, rhs, ldr, out, ldo, true);
+    }
+
+    template <typename T>
+    void multiply(std::size_t n, const T *a, std::size_t lda, const T *b, std::size_t ldb, T *c, std::size_t ldc, T *scratch, std::size_t crossover) {
+        if (n <= crossover or n < 2) {
+            gemm::multiply<T>(n, n, n, { a, lda, 1 }, { b, ldb, 1 }, c, ldc);
+            return;
+        }
+
+        if (n % 2 == 1) {
+            // Dynamic peeling, the even leading block recurses and the last
+            // row and column are fixed up by rank-1 and panel products.
+            const std::size_t e = n - 1;
+            multiply(e, a, lda, b, ldb, c, ldc, scratch, crossover);
+            gemm::multiply<T>(e, e, 1, { a + e, lda, 1 }, { b + e * ldb, ldb, 1 }, c, ldc, true);
+            gemm::multiply<T>(e, 1, n, { a, lda, 1 }, { b + e, ldb, 1 }, c + e, ldc);
+            gemm::multiply<T>(1, n, n, { a + e * lda, lda, 1 }, { b, ldb, 1 }, c + e * ldc, ldc);
+            return;
+        }
+
+        const std::size_t h = n / 2;
+        const T *a11 = a;
+        const T *a12 = a + h;
+        const T *a21 = a + h * lda;
+        const T *a22 = a + h * lda + h;
+        const T *b11 = b;
+        const T *b12 = b + h;
+        const T *b21 = b + h * ldb;
+        const T *b22 = b + h * ldb + h;
+        T *c11 = c;
+        T *c12 = c + h;
+        T *c21 = c + h * ldc;
+        T *c22 = c + h * ldc + h;
+        T *x = scratch;
+        T *y = scratch + h * h;
+        T *rest = scratch + 2 * h * h;
+
+        // Schedule with two temporaries from Boyer, Dumas, Pernet and Zhou,
+        // "Memory efficient scheduling of Strassen-Winograd's matrix
+        // multiplication algorithm", the products land directly in `c`.
+        sub(h, a11, lda, a21, lda, x, h);                    // S3 = A11 - A21
+        sub(h, b22, ldb, b12, ldb, y, h);                    // T3 = B22 - B12
+        multiply(h, x, h, y, h, c21, ldc, rest, crossover);  // P7 = S3 T3
+        add(h, a21, lda, a22, lda, x, h);                    // S1 = A21 + A22
+        sub(h, b12, ldb, b11, ldb, y, h);                    // T1 = B12 - B11
+        multiply(h, x, h, y, h, c22, ldc, rest, crossover);  // P5 = S1 T1
+        sub(h, x, h, a11, lda, x, h);                        // S2 = S1 - A11
+        sub(h, b22, ldb, y, h, y, h);                        // T2 = B22 - T1
+        multiply(h, x, h, y, h, c12, ldc, rest, crossover);  // P6 = S2 T2
+        sub(h, a12, lda, x, h, x, h);                        // S4 = A12 - S2
+        multiply(h, x, h, b22, ldb, c11, ldc, rest, crossover); // P3 = S4 B22
+        multiply(h, a11, lda, b11, ldb, x, h, rest, crossover); // P1 = A11 B11
+        add(h, x, h, c12, ldc, c12, ldc);                    // U2 = P1 + P6
+        add(h, c12, ldc, c21, ldc, c21, ldc);                // U3 = U2 + P7
+        add(h, c12, ldc, c22, ldc, c12, ldc);                // U4 = U2 + P5
+        add(h, c21, ldc, c22, ldc, c22, ldc);                // U7 = U3 + P5
+        add(h, c12, ldc, c11, ldc, c12, ldc);                // U5 = U4 + P3
+        sub(h, y, h, b21, ldb, y, h);                        // T4 = T2 - B21
+        multiply(h, a22, lda, y, h, c11, ldc, rest, crossover); // P4 = A22 T4
+        sub(h, c21, ldc, c11, ldc, c21, ldc);                // U6 = U3 - P4
+        multiply(h, a12, lda, b21, ldb, c11, ldc, rest, crossover); // P2 = A12 B21
+        add(h, x, h, c11, ldc, c11, ldc);                    // U1 = P1 + P2
+    }
+
+} // namespace detail
+
+/// @brief Computes `c = a * b` for `n x n` row-major matrices.
+///
+/// @param  [in] scratch Buffer of at least `scratch_size(n, crossover)`
+///                      elements, its contents are overwritten.
+/// @param  [out] c Result, it must not alias `a`, `b` or `scratch`.
+template <Numeric T>
+void multiply(
+    std::size_t n, const T *a, std::size_t lda, const T *b, std::size_t ldb, T *c, std::size_t ldc, std::span<T> scratch,
+    std::size_t crossover = default_crossover
+) {
+    detail::multiply(n, a, lda, b, ldb, c, ldc, scratch.data(), crossover);
+}
+
+/// @brief Convenience variant using a per-thread scratch buffer.
+template <Numeric T>
+void multiply(std::size_t n, const T *a, const T *b, T *c, std::size_t crossover = default_crossover) {
+    thread_local std::vector<T> scratch;
+    const std::size_t size = scratch_size(n, crossover);
+    if (scratch.size() < size) {
+        scratch.resize(size);
+    }
+    detail::multiply(n, a, n, b, n, c, n, scratch.data(), crossover);
+}
+
+} // namespace dk::math::strassen
+
+#endif // DK_MATH_STRASSEN_HPP
@@ -0,0 +1,418 @@
+#ifndef DK_MATH_STRUCTURED_MATRIX_HPP
+#define DK_MATH_STRUCTURED_MATRIX_HPP
+
+/// @file structured_matrix.hpp
+///
+/// Square matrices whose structure is part of their type.
+///
+/// `Matrix4::identity()` or `Matrix3::diagonal()` return dense matrices, and
+/// every product with them then pays for all of their zeros. The types below
+/// only store what their structure leaves free, and overload resolution picks
+/// the matching formula for their products, inverses and determinants:
+///
+///   - `IdentityMatrix<T, N>` stores nothing,
+///   - `DiagonalMatrix<T, N>` stores its diagonal, products with it scale
+///     rows or columns in O(N²),
+///   - `RotationMatrix3<T>` is orthonormal with determinant one, its inverse
+///     is its transpose,
+///   - `AffineMatrix4<T>` has the last row `(0, 0, 0, 1)`, products skip it
+///     and its inverse only inverts the 3x3 part, see
+///     `Matrix4::inverse_affine`.
+///
+/// Products of two operands of the same structure keep it. Products with
+/// dense matrices and vectors return dense results, and `to_dense()`
+/// converts explicitly. Default constructed structured matrices are the
+/// identity.
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+
+#include <dklib/math/angle.hpp>
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/matrix4d.hpp>
+#include <dklib/math/simd.hpp>
+#include <dklib/math/types.hpp>
+#include <dklib/math/vector.hpp>
+#include <dklib/math/vector4d.hpp>
+
+namespace dk::math {
+
+template <Numeric T, std::size_t N>
+class IdentityMatrix {
+public:
+    using value_type = T;
+
+    [[nodiscard]] constexpr T operator[](std::size_t x, std::size_t y) const noexcept { return x == y ? T(1) : T(0); }
+
+    [[nodiscard]] constexpr double determinant() const noexcept { return 1.0; }
+
+    [[nodiscard]] constexpr IdentityMatrix inverse() const noexcept { return {}; }
+
+    [[nodiscard]] constexpr IdentityMatrix transpose() const noexcept { return {}; }
+
+    [[nodiscard]] constexpr Matrix<T, N, N> to_dense() const noexcept {
+        Matrix<T, N, N> result { 0 };
+        for (std::size_t i = 0; i < N; ++i) {
+            result[i, i] = T(1);
+        }
+        return result;
+    }
+
+    friend constexpr bool operator==(const IdentityMatrix &, const IdentityMatrix &) noexcept = default;
+};
+
+template <Numeric T, std::size_t N>
+class DiagonalMatrix {
+public:
+    using value_type = T;
+
+    constexpr DiagonalMatrix() noexcept
+        : diagonal_ { T(1) } { }
+
+    explicit constexpr DiagonalMatrix(const Vector<T, N> &diagonal) noexcept
+        : diagonal_ { diagonal } { }
+
+    explicit constexpr DiagonalMatrix(const std::array<T, N> &diagonal) noexcept
+        : diagonal_ { diagonal } { }
+
+    DK_INIT_METHOD DiagonalMatrix identity() noexcept { return {}; }
+
+    /// @brief Uniform scaling by `value`.
+    DK_INIT_METHOD DiagonalMatrix scaling(T value) noexcept { return DiagonalMatrix { Vector<T, N> { value } }; }
+
+    [[nodiscard]] constexpr const Vector<T, N> &diagonal() const noexcept { return diagonal_; }
+
+    [[nodiscard]] constexpr T operator[](std::size_t x, std::size_t y) const noexcept { return x == y ? diagonal_[x] : T(0); }
+
+    /// @brief Returns the determinant, evaluated in double precision.
+    [[nodiscard]] constexpr double determinant() const noexcept {
+        double result = 1.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            result *= static_cast<double>(diagonal_[i]);
+        }
+        return result;
+    }
+
+    /// @brief Reciprocal of every diagonal element, throws if one is zero.
+    [[nodiscard]] constexpr DiagonalMatrix inverse() const
+        requires std::floating_point<T>
+    {
+        DiagonalMatrix result;
+        for (std::size_t i = 0; i < N; ++i) {
+            if (diagonal_[i] == T {}) {
+                throw std::runtime_error("matrix is singular");
+            }
+            result.diagonal_[i] = T(1) / diagonal_[i];
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr DiagonalMatrix transpose() const noexcept { return *this; }
+
+    [[nodiscard]] constexpr Matrix<T, N, N> to_dense() const noexcept {
+        Matrix<T, N, N> result { 0 };
+        for (std::size_t i = 0; i < N; ++i) {
+            result[i, i] = diagonal_[i];
+        }
+        return result;
+    }
+
+    friend constexpr bool operator==(const DiagonalMatrix &lhs, const DiagonalMatrix &rhs) noexcept {
+        return lhs.diagonal_ == rhs.diagonal_;
+    }
+
+private:
+    Vector<T, N> diagonal_;
+};
+
+/// Orthonormal 3x3 matrix with determinant one.
+///
+/// The constructors trust their arguments, a matrix that is not a rotation
+/// gives wrong inverses and determinants.
+template <std::floating_point T>
+class RotationMatrix3 {
+public:
+    using value_type = T;
+
+    constexpr RotationMatrix3() noexcept
+        : RotationMatrix3(IdentityMatrix<T, 3> {}.to_dense()) { }
+
+    explicit constexpr RotationMatrix3(const Matrix<T, 3, 3> &mat) noexcept
+        : mat_ { mat } { }
+
+    DK_INIT_METHOD RotationMatrix3 identity() noexcept { return {}; }
+
+    /// @brief Rotation by `angle` around `axis`, which does not need to be
+    /// normalized, by the Rodrigues formula.
+    [[nodiscard]] static RotationMatrix3 about(const Vector<T, 3> &axis, Angle angle) noexcept {
+        const T length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        const T x = axis[0] / length, y = axis[1] / length, z = axis[2] / length;
+        const T c = static_cast<T>(std::cos(static_cast<double>(angle)));
+        const T s = static_cast<T>(std::sin(static_cast<double>(angle)));
+        const T t = T(1) - c;
+        return RotationMatrix3 { Matrix<T, 3, 3> { typename Matrix<T, 3, 3>::storage_type_2d { {
+            { t * x * x + c, t * x * y - s * z, t * x * z + s * y },
+            { t * x * y + s * z, t * y * y + c, t * y * z - s * x },
+            { t * x * z - s * y, t * y * z + s * x, t * z * z + c },
+        } } } };
+    }
+
+    [[nodiscard]] constexpr T operator[](std::size_t x, std::size_t y) const noexcept { return mat_[x, y]; }
+
+    [[nodiscard]] constexpr double determinant() const noexcept { return 1.0; }
+
+    [[nodiscard]] constexpr RotationMatrix3 inverse() const noexcept { return transpose(); }
+
+    [[nodiscard]] constexpr RotationMatrix3 transpose() const noexcept { return RotationMatrix3 { mat_.transpose() }; }
+
+    [[nodiscard]] constexpr const Matrix<T, 3, 3> &to_dense() const noexcept { return mat_; }
+
+    friend constexpr bool operator==(const RotationMatrix3 &lhs, const RotationMatrix3 &rhs) noexcept {
+        return lhs.mat_ == rhs.mat_;
+    }
+
+private:
+    Matrix<T, 3, 3> mat_;
+};
+
+/// 4x4 matrix with the last row `(0, 0, 0, 1)`: a linear 3x3 part and a
+/// translation in the last column, as `Matrix4` applies it to column vectors.
+///
+/// The matrix is stored densely, so that it converts to `Matrix4` for free
+/// and runs on its kernels.
+template <std::floating_point T>
+class AffineMatrix4 {
+public:
+    using value_type = T;
+
+    constexpr AffineMatrix4() noexcept
+        : mat_ { Matrix4<T>::identity() } { }
+
+    /// @brief Takes the first three rows of `mat`, its last row is ignored.
+    explicit constexpr AffineMatrix4(const Matrix4<T> &mat) noexcept
+        : mat_ { mat } {
+        for (std::size_t j = 0; j < 4; ++j) {
+            mat_[3, j] = j == 3 ? T(1) : T(0);
+        }
+    }
+
+    constexpr AffineMatrix4(const Matrix<T, 3, 3> &linear, const Vector<T, 3> &translation) noexcept
+        : AffineMatrix4() {
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                mat_[i, j] = linear[i, j];
+            }
+            mat_[i, 3] = translation[i];
+        }
+    }
+
+    constexpr AffineMatrix4(const RotationMatrix3<T> &rotation, const Vector<T, 3> &translation) noexcept
+        : AffineMatrix4(rotation.to_dense(), translation) { }
+
+    constexpr AffineMatrix4(const DiagonalMatrix<T, 3> &scale, const Vector<T, 3> &translation) noexcept
+        : AffineMatrix4(scale.to_dense(), translation) { }
+
+    DK_INIT_METHOD AffineMatrix4 identity() noexcept { return {}; }
+
+    DK_INIT_METHOD AffineMatrix4 translate(const Vector<T, 3> &translation) noexcept {
+        return { IdentityMatrix<T, 3> {}.to_dense(), translation };
+    }
+
+    [[nodiscard]] constexpr T operator[](std::size_t x, std::size_t y) const noexcept { return mat_[x, y]; }
+
+    [[nodiscard]] constexpr Matrix<T, 3, 3> linear() const noexcept {
+        Matrix<T, 3, 3> result;
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                result[i, j] = mat_[i, j];
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr Vector<T, 3> translation() const noexcept {
+        return std::array<T, 3> { mat_[0, 3], mat_[1, 3], mat_[2, 3] };
+    }
+
+    /// @brief Determinant of the linear part, which is that of the matrix.
+    [[nodiscard]] constexpr double determinant() const noexcept { return linear().determinant(); }
+
+    /// @brief Throws if the linear part is singular.
+    [[nodiscard]] constexpr AffineMatrix4 inverse() const { return AffineMatrix4 { mat_.inverse_affine() }; }
+
+    [[nodiscard]] constexpr const Matrix4<T> &to_dense() const noexcept { return mat_; }
+
+    /// @brief Applies the linear part and the translation, `w = 1`.
+    [[nodiscard]] constexpr Vector<T, 3> transform_point(const Vector<T, 3> &point) const noexcept {
+        Vector<T, 3> result;
+        for (std::size_t i = 0; i < 3; ++i) {
+            result[i] = mat_[i, 0] * point[0] + mat_[i, 1] * point[1] + mat_[i, 2] * point[2] + mat_[i, 3];
+        }
+        return result;
+    }
+
+    /// @brief Applies the linear part only, `w = 0`.
+    [[nodiscard]] constexpr Vector<T, 3> transform_direction(const Vector<T, 3> &direction) const noexcept {
+        Vector<T, 3> result;
+        for (std::size_t i = 0; i < 3; ++i) {
+            result[i] = mat_[i, 0] * direction[0] + mat_[i, 1] * direction[1] + mat_[i, 2] * direction[2];
+        }
+        return result;
+    }
+
+    friend constexpr bool operator==(const AffineMatrix4 &lhs, const AffineMatrix4 &rhs) noexcept {
+        return lhs.mat_ == rhs.mat_;
+    }
+
+private:
+    Matrix4<T> mat_;
+};
+
+template <Numeric T, std::size_t N>
+constexpr IdentityMatrix<T, N> operator*(IdentityMatrix<T, N>, IdentityMatrix<T, N>) noexcept {
+    return {};
+}
+
+template <Numeric T, std::size_t N, std::size_t Cols>
+constexpr Matrix<T, N, Cols> operator*(IdentityMatrix<T, N>, const Matrix<T, N, Cols> &rhs) noexcept {
+    return rhs;
+}
+
+template <Numeric T, std::size_t Rows, std::size_t N>
+constexpr Matrix<T, Rows, N> operator*(const Matrix<T, Rows, N> &lhs, IdentityMatrix<T, N>) noexcept {
+    return lhs;
+}
+
+template <Numeric T, std::size_t N>
+constexpr Vector<T, N> operator*(IdentityMatrix<T, N>, const Vector<T, N> &vec) noexcept {
+    return vec;
+}
+
+template <Numeric T, std::size_t N>
+constexpr DiagonalMatrix<T, N> operator*(const DiagonalMatrix<T, N> &lhs, const DiagonalMatrix<T, N> &rhs) noexcept {
+    Vector<T, N> result;
+    for (std::size_t i = 0; i < N; ++i) {
+        result[i] = lhs.diagonal()[i] * rhs.diagonal()[i];
+    }
+    return DiagonalMatrix<T, N> { result };
+}
+
+/// @brief Scales the rows of `rhs`.
+template <Numeric T, std::size_t N, std::size_t Cols>
+constexpr Matrix<T, N, Cols> operator*(const DiagonalMatrix<T, N> &lhs, const Matrix<T, N, Cols> &rhs) noexcept {
+    Matrix<T, N, Cols> result;
+    for (std::size_t i = 0; i < N; ++i) {
+        const T scale = lhs.diagonal()[i];
+        for (std::size_t j = 0; j < Cols; ++j) {
+            result[i, j] = scale * rhs[i, j];
+        }
+    }
+    return result;
+}
+
+/// @brief Scales the columns of `lhs`.
+template <Numeric T, std::size_t Rows, std::size_t N>
+constexpr Matrix<T, Rows, N> operator*(const Matrix<T, Rows, N> &lhs, const DiagonalMatrix<T, N> &rhs) noexcept {
+    Matrix<T, Rows, N> result;
+    for (std::size_t i = 0; i < Rows; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            result[i, j] = lhs[i, j] * rhs.diagonal()[j];
+        }
+    }
+    return result;
+}
+
+template <Numeric T, std::size_t N>
+constexpr Vector<T, N> operator*(const DiagonalMatrix<T, N> &mat, const Vector<T, N> &vec) noexcept {
+    Vector<T, N> result;
+    for (std::size_t i = 0; i < N; ++i) {
+        result[i] = mat.diagonal()[i] * vec[i];
+    }
+    return result;
+}
+
+template <std::floating_point T>
+constexpr RotationMatrix3<T> operator*(const RotationMatrix3<T> &lhs, const RotationMatrix3<T> &rhs) noexcept {
+    return RotationMatrix3<T> { lhs.to_dense() * rhs.to_dense() };
+}
+
+template <std::floating_point T, std::size_t Cols>
+constexpr Matrix<T, 3, Cols> operator*(const RotationMatrix3<T> &lhs, const Matrix<T, 3, Cols> &rhs) noexcept {
+    return lhs.to_dense() * rhs;
+}
+
+template <std::floating_point T, std::size_t Rows>
+constexpr Matrix<T, Rows, 3> operator*(const Matrix<T, Rows, 3> &lhs, const RotationMatrix3<T> &rhs) noexcept {
+    return lhs * rhs.to_dense();
+}
+
+template <std::floating_point T>
+constexpr Vector<T, 3> operator*(const RotationMatrix3<T> &mat, const Vector<T, 3> &vec) noexcept {
+    Vector<T, 3> result;
+    for (std::size_t i = 0; i < 3; ++i) {
+        result[i] = mat[i, 0] * vec[0] + mat[i, 1] * vec[1] + mat[i, 2] * vec[2];
+    }
+    return result;
+}
+
+/// @brief Composition of affine transformations, the last row of the result
+/// is known and not accumulated.
+template <std::floating_point T>
+constexpr AffineMatrix4<T> operator*(const AffineMatrix4<T> &lhs, const AffineMatrix4<T> &rhs) noexcept {
+    Matrix4<T> result;
+    if consteval {
+        simd::mat4_mul_affine<T>(result.data(), lhs.to_dense().data(), rhs.to_dense().data());
+    } else {
+        simd::mat4_mul_affine(result.data(), lhs.to_dense().data(), rhs.to_dense().data());
+    }
+    return AffineMatrix4<T> { result };
+}
+
+/// @brief Product with a dense matrix, whose last row is copied.
+template <std::floating_point T, std::size_t Cols>
+constexpr Matrix<T, 4, Cols> operator*(const AffineMatrix4<T> &lhs, const Matrix<T, 4, Cols> &rhs) noexcept {
+    const auto &a = lhs.to_dense();
+    Matrix<T, 4, Cols> result;
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < Cols; ++j) {
+            result[i, j] = a[i, 0] * rhs[0, j] + a[i, 1] * rhs[1, j] + a[i, 2] * rhs[2, j] + a[i, 3] * rhs[3, j];
+        }
+    }
+    for (std::size_t j = 0; j < Cols; ++j) {
+        result[3, j] = rhs[3, j];
+    }
+    return result;
+}
+
+/// @brief Product of a dense matrix with an affine one, the zeros of its
+/// last row are skipped.
+template <std::floating_point T, std::size_t Rows>
+constexpr Matrix<T, Rows, 4> operator*(const Matrix<T, Rows, 4> &lhs, const AffineMatrix4<T> &rhs) noexcept {
+    const auto &b = rhs.to_dense();
+    Matrix<T, Rows, 4> result;
+    for (std::size_t i = 0; i < Rows; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            result[i, j] = lhs[i, 0] * b[0, j] + lhs[i, 1] * b[1, j] + lhs[i, 2] * b[2, j];
+        }
+        result[i, 3] += lhs[i, 3];
+    }
+    return result;
+}
+
+template <std::floating_point T>
+constexpr Vector4<T> operator*(const AffineMatrix4<T> &mat, const Vector4<T> &vec) noexcept {
+    Vector4<T> result;
+    for (std::size_t i = 0; i < 3; ++i) {
+        result[i] = mat[i, 0] * vec[0] + mat[i, 1] * vec[1] + mat[i, 2] * vec[2] + mat[i, 3] * vec[3];
+    }
+    result[3] = vec[3];
+    return result;
+}
+
+} // namespace dk::math
+
+#endif // DK_MATH_STRUCTURED_MATRIX_HPP
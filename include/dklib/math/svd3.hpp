@@ -0,0 +1,149 @@
+#ifndef DK_MATH_SVD3_HPP
+#define DK_MATH_SVD3_HPP
+
+/// @file svd3.hpp
+///
+/// Singular value and polar decompositions of row-major 3x3 matrices.
+///
+/// `decompose` computes `a = U * diag(sigma) * Vᵀ` with the Jacobi
+/// eigenvalue method of `eigen3.hpp`: a fixed number of cyclic sweeps of
+/// rotations diagonalize `aᵀ * a`, accumulating them into `V`. The columns
+/// of `a * V` are then sorted by decreasing norm, and Givens rotations
+/// reduce them to upper triangular form, whose diagonal holds the singular
+/// values, the rotations accumulating into `U`.
+///
+/// `U` and `V` are always rotations, so the last singular value carries the
+/// sign of the determinant of `a`: `sigma[0] >= sigma[1] >= |sigma[2]|`.
+/// `polar` builds `a = R * S` from it, with the rotation `R = U * Vᵀ` and
+/// the symmetric `S = V * diag(sigma) * Vᵀ`, which is what corotational
+/// elements and point cloud registration need even for reflections.
+///
+/// There is no branching on the data and no early exit: the rotations use
+/// selects where an element is already negligible, and the number of sweeps
+/// is a template parameter, so all matrices take the same time and the
+/// kernels vectorize across matrices, see `batch::svd`. The matrices are
+/// passed as arrays, which lets the compiler keep them in registers when
+/// the kernels are inlined into a `#pragma omp simd` loop.
+///
+/// As the singular values come from `aᵀ * a`, the ones much smaller than
+/// `sigma[0]` are only accurate to working precision relative to `sigma[0]`.
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+
+#include <dklib/math/eigen3.hpp>
+#include <dklib/math/types.hpp>
+
+namespace dk::math::svd3 {
+
+/// Jacobi sweeps of `decompose`, see `eigen3::sweeps`.
+inline constexpr std::size_t sweeps = eigen3::sweeps;
+
+namespace detail {
+
+    /// Swaps columns `P` and `Q` of `b` and `v` if column `Q` of `b` is
+    /// longer, negating one of them to keep `v` a rotation.
+    template <std::size_t P, std::size_t Q, typename T>
+    DK_ALWAYS_INLINE constexpr void sort_columns(T (&b)[3][3], T (&v)[3][3], T (&norms)[3]) noexcept {
+        const bool swap = norms[Q] > norms[P];
+        for (std::size_t i = 0; i < 3; ++i) {
+            const T bp = b[i][P];
+            const T vp = v[i][P];
+            b[i][P] = swap ? b[i][Q] : bp;
+            b[i][Q] = swap ? -bp : b[i][Q];
+            v[i][P] = swap ? v[i][Q] : vp;
+            v[i][Q] = swap ? -vp : v[i][Q];
+        }
+        const T np = norms[P];
+        norms[P] = swap ? norms[Q] : np;
+        norms[Q] = swap ? np : norms[Q];
+    }
+
+    /// Annihilates `b[Q][Col]` by a Givens rotation of rows `P` and `Q`,
+    /// whose transpose is accumulated into `u`.
+    template <std::size_t P, std::size_t Q, std::size_t Col, typename T>
+    DK_ALWAYS_INLINE constexpr void givens_rotation(T (&b)[3][3], T (&u)[3][3]) noexcept {
+        const T x = b[P][Col];
+        const T y = b[Q][Col];
+        const T norm = std::sqrt(x * x + y * y);
+        const bool rotate = norm != T {};
+        const T scale = T { 1 } / (rotate ? norm : T { 1 });
+        const T c = (rotate ? x : T { 1 }) * scale;
+        const T s = y * scale;
+        for (std::size_t j = 0; j < 3; ++j) {
+            const T bp = b[P][j];
+            const T bq = b[Q][j];
+            b[P][j] = c * bp + s * bq;
+            b[Q][j] = c * bq - s * bp;
+        }
+        eigen3::detail::rotate_columns<P, Q>(u, c, s);
+    }
+
+} // namespace detail
+
+/// @brief Computes the singular value decomposition of the 3x3 matrix `a`,
+/// see the file comment.
+/// @param  [out] u     Row-major left rotation.
+/// @param  [out] sigma Singular values, sorted by decreasing magnitude.
+/// @param  [out] v     Row-major right rotation.
+template <std::floating_point T, std::size_t Sweeps = sweeps>
+DK_ALWAYS_INLINE constexpr void decompose(const T (&a)[9], T (&u)[9], T (&sigma)[3], T (&v)[9]) noexcept {
+    T sym[3][3];
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            sym[i][j] = a[i] * a[j] + a[3 + i] * a[3 + j] + a[6 + i] * a[6 + j];
+        }
+    }
+    T rot[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    eigen3::detail::jacobi_sweeps<Sweeps>(sym, rot);
+
+    // `b = a * V` has orthogonal columns, whose norms are the singular values.
+    T b[3][3];
+    T norms[3];
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            b[i][j] = a[3 * i] * rot[0][j] + a[3 * i + 1] * rot[1][j] + a[3 * i + 2] * rot[2][j];
+        }
+    }
+    for (std::size_t j = 0; j < 3; ++j) {
+        norms[j] = b[0][j] * b[0][j] + b[1][j] * b[1][j] + b[2][j] * b[2][j];
+    }
+    detail::sort_columns<0, 1>(b, rot, norms);
+    detail::sort_columns<0, 2>(b, rot, norms);
+    detail::sort_columns<1, 2>(b, rot, norms);
+
+    T left[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    detail::givens_rotation<0, 1, 0>(b, left);
+    detail::givens_rotation<0, 2, 0>(b, left);
+    detail::givens_rotation<1, 2, 1>(b, left);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        sigma[i] = b[i][i];
+        for (std::size_t j = 0; j < 3; ++j) {
+            u[3 * i + j] = left[i][j];
+            v[3 * i + j] = rot[i][j];
+        }
+    }
+}
+
+/// @brief Computes the polar decomposition `a = r * s` of the 3x3 matrix
+/// `a`, `r` being a rotation and `s` symmetric, see the file comment.
+template <std::floating_point T, std::size_t Sweeps = sweeps>
+DK_ALWAYS_INLINE constexpr void polar(const T (&a)[9], T (&r)[9], T (&s)[9]) noexcept {
+    T u[9];
+    T sigma[3];
+    T v[9];
+    decompose<T, Sweeps>(a, u, sigma, v);
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            r[3 * i + j] = u[3 * i] * v[3 * j] + u[3 * i + 1] * v[3 * j + 1] + u[3 * i + 2] * v[3 * j + 2];
+            // Multiplying the elements of `V` first makes `s` exactly symmetric.
+            s[3 * i + j] = sigma[0] * (v[3 * i] * v[3 * j]) + sigma[1] * (v[3 * i + 1] * v[3 * j + 1]) + sigma[2] * (v[3 * i + 2] * v[3 * j + 2]);
+        }
+    }
+}
+
+} // namespace dk::math::svd3
+
+#endif // DK_MATH_SVD3_HPP
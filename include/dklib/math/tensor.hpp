@@ -7,7 +7,9 @@
 #include <vector>
 
 #include <dklib/math/concepts.hpp>
+#include <dklib/math/matrix_concepts.hpp>
 #include <dklib/math/tensor_concepts.hpp>
+#include <dklib/math/tensor_expression.hpp>
 #include <dklib/math/types.hpp>
 
 #include <iostream>
@@ -30,9 +32,13 @@ public:
         return std::vector<std::size_t> { Dims... };
     }
 
+    /// @brief Copies the elements into a tensor of another shape with the
+    /// same size, `view(tensor).reshape(...)` does the same without copying.
     template <std::size_t... Dims1>
     requires((... * Dims) == (... * Dims1))
-    Tensor<T, Dims1...> reshape() const {};
+    [[nodiscard]] constexpr Tensor<T, Dims1...> reshape() const noexcept {
+        return Tensor<T, Dims1...> { elems_ };
+    }
 
     [[nodiscard]] constexpr std::size_t size() const noexcept {
         return elems_.size();
@@ -78,37 +84,46 @@ constexpr T operator&(const T &lhs, const T &rhs) {
     return T { lhs } += rhs;
 }
 
+// Large tensors build lazy expressions instead, see tensor_expression.hpp.
 template <TensorType T>
+requires(not LazyTensorType<T>)
 constexpr T operator+(const T &lhs, const T &rhs) {
     return T { lhs } += rhs;
 }
 
 template <TensorType T>
+requires(not LazyTensorType<T>)
 constexpr T operator-(const T &lhs, const T &rhs) {
     return T { lhs } -= rhs;
 }
 
+// Matrices use these operators for the matrix product instead.
 template <TensorType T>
+requires(not MatrixLike<T> and not LazyTensorType<T>)
 constexpr T operator*(const T &lhs, const T &rhs) {
     return T { lhs } *= rhs;
 }
 
 template <TensorType T>
+requires(not MatrixLike<T> and not LazyTensorType<T>)
 constexpr T operator/(const T &lhs, const T &rhs) {
     return T { lhs } /= rhs;
 }
 
 template <TensorType T, std::convertible_to<double> F>
+requires(not LazyTensorType<T>)
 constexpr T operator*(const T &other, F value) {
     return T { other } *= value;
 }
 
 template <TensorType T, std::convertible_to<double> F>
+requires(not LazyTensorType<T>)
 constexpr T operator*(F value, const T &other) {
     return T { other } *= value;
 }
 
 template <TensorType T, std::floating_point F>
+requires(not LazyTensorType<T>)
 constexpr T operator/(const T &other, F value) {
     return T { other } /= value;
 }
@@ -3,6 +3,9 @@
 
 #include <dklib/math/concepts.hpp>
 
+#include <array>
+#include <cstddef>
+#include <tuple>
 #include <type_traits>
 
 namespace dk::math {
@@ -14,7 +17,10 @@ class Tensor;
 template <typename T>
 struct is_tensor_type : std::false_type { };
 
+// Only candidates with valid `Tensor` arguments, wrappers of other types such
+// as `Transposed<Matrix<...>>` must not instantiate `Tensor<Matrix<...>>`.
 template <template <typename, std::size_t...> typename C, typename T, std::size_t... Dims>
+requires(Numeric<T> and ((Dims > 0) and ...))
 struct is_tensor_type<C<T, Dims...>>
     : std::is_base_of<Tensor<T, Dims...>, C<T, Dims...>> { };
 
@@ -24,6 +30,51 @@ inline constexpr bool is_tensor_type_v = is_tensor_type<T>::value;
 template <typename T>
 concept TensorType = is_tensor_type_v<T> or is_tensor_type_v<typename T::Base>;
 
+/// Number of elements stored by a tensor type.
+template <TensorType T>
+inline constexpr std::size_t tensor_size_v = std::tuple_size_v<typename T::storage_type>;
+
+#ifndef DK_LAZY_EVALUATION_THRESHOLD
+#define DK_LAZY_EVALUATION_THRESHOLD 16
+#endif
+
+/// Tensors larger than the threshold build lazy expressions from their
+/// element-wise operators, smaller ones (e.g. `Vector3`, `Matrix4`) are cheaper
+/// to compute eagerly and keep returning their own type.
+template <typename T>
+concept LazyTensorType = TensorType<T> and (tensor_size_v<T> > DK_LAZY_EVALUATION_THRESHOLD);
+
+template <typename T>
+struct is_tensor_expression : std::false_type { };
+
+template <typename T>
+inline constexpr bool is_tensor_expression_v = is_tensor_expression<T>::value;
+
+template <typename T>
+concept TensorExpressionType = is_tensor_expression_v<T>;
+
+/// Tensor type an operand evaluates to, i.e. the type itself for tensors.
+template <typename T>
+struct expression_result {
+    using type = T;
+};
+
+template <TensorExpressionType E>
+struct expression_result<E> {
+    using type = typename E::result_type;
+};
+
+template <typename T>
+using expression_result_t = typename expression_result<T>::type;
+
+template <typename T>
+concept LazyOperand = LazyTensorType<T> or TensorExpressionType<T>;
+
+/// Operands of a fused element-wise operation, both have to evaluate to the
+/// same tensor type, which rejects mismatched shapes at compile time.
+template <typename L, typename R>
+concept ElementwiseOperands = LazyOperand<L> and LazyOperand<R> and std::same_as<expression_result_t<L>, expression_result_t<R>>;
+
 } // namespace dk::math
 
 #endif // DK_MATH_TENSOR_CONCEPTS_HPP
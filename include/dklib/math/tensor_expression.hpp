@@ -0,0 +1,174 @@
+#ifndef DK_MATH_TENSOR_EXPRESSION_HPP
+#define DK_MATH_TENSOR_EXPRESSION_HPP
+
+/// @file tensor_expression.hpp
+///
+/// Lazy element-wise expressions over large tensors.
+///
+/// For tensors larger than `DK_LAZY_EVALUATION_THRESHOLD` elements the free
+/// operators `+`, `-`, `*` and `/` do not compute anything, they return a
+/// `TensorExpression` node that refers to its operands. Nodes nest, so
+/// `a + b * 2.0f - c` is a small tree, which is evaluated in one loop without
+/// temporaries once it is converted or assigned to a tensor:
+///
+///     Vector<float, 1024> result = a + b * 2.0f - c;
+///     result = result - a; // in place, every element only reads its own index
+///
+/// Nodes keep references to tensor operands, so they should be evaluated in
+/// the full expression that creates them, a node stored with `auto` may refer
+/// to destroyed temporaries. Operands have to evaluate to the same tensor
+/// type, mismatched shapes do not have a matching operator. Matrix operands
+/// only support the element-wise sum and difference, `*` stays the matrix
+/// product.
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/matrix_concepts.hpp>
+#include <dklib/math/tensor_concepts.hpp>
+#include <dklib/math/types.hpp>
+
+namespace dk::math {
+
+/// Scalar broadcast to every element of an expression.
+template <Numeric F>
+struct ScalarOperand {
+    F value;
+
+    [[nodiscard]] constexpr F operator[](std::size_t) const noexcept { return value; }
+};
+
+template <typename T>
+struct is_scalar_operand : std::false_type { };
+
+template <typename F>
+struct is_scalar_operand<ScalarOperand<F>> : std::true_type { };
+
+template <typename Op, typename L, typename R>
+class TensorExpression {
+    /// The tensor type is taken from the non-scalar operand.
+    using tensor_operand = std::conditional_t<is_scalar_operand<L>::value, R, L>;
+
+    /// Nested nodes and scalars are small and stored by value, tensors by reference.
+    template <typename X>
+    using storage_t = std::conditional_t<TensorExpressionType<X> or is_scalar_operand<X>::value, X, const X &>;
+
+public:
+    using result_type = expression_result_t<tensor_operand>;
+    using value_type = typename result_type::value_type;
+
+    constexpr TensorExpression(const L &lhs, const R &rhs) noexcept
+        : lhs_ { lhs }
+        , rhs_ { rhs } { }
+
+    [[nodiscard]] static constexpr std::size_t size() noexcept { return tensor_size_v<result_type>; }
+
+    /// @brief Computes a single element, every operand is read at the same index.
+    [[nodiscard]] DK_ALWAYS_INLINE constexpr value_type operator[](std::size_t idx) const noexcept {
+        return static_cast<value_type>(Op {}(lhs_[idx], rhs_[idx]));
+    }
+
+    /// @brief Writes the whole expression into `target` in one pass.
+    ///
+    /// `target` may be one of the operands, as elements only depend on the
+    /// operand elements at the same index.
+    constexpr void evaluate_into(result_type &target) const noexcept {
+#pragma omp simd
+        for (std::size_t i = 0; i < size(); ++i) {
+            target[i] = (*this)[i];
+        }
+    }
+
+    [[nodiscard]] constexpr result_type evaluate() const noexcept {
+        result_type result;
+        evaluate_into(result);
+        return result;
+    }
+
+    constexpr operator result_type() const noexcept { return evaluate(); }
+
+private:
+    storage_t<L> lhs_;
+    storage_t<R> rhs_;
+};
+
+template <typename Op, typename L, typename R>
+struct is_tensor_expression<TensorExpression<Op, L, R>> : std::true_type { };
+
+template <TensorType T>
+[[nodiscard]] constexpr const T &evaluate(const T &tensor) noexcept {
+    return tensor;
+}
+
+template <TensorExpressionType E>
+[[nodiscard]] constexpr typename E::result_type evaluate(const E &expression) noexcept {
+    return expression.evaluate();
+}
+
+namespace detail {
+
+    /// Division by zero throws like the compound operators of the small
+    /// types. The divisor is checked before anything is evaluated, which
+    /// costs one extra read of it instead of a branch in the fused loop.
+    template <typename R>
+    constexpr void check_divisor(const R &divisor) {
+        for (std::size_t i = 0; i < tensor_size_v<expression_result_t<R>>; ++i) {
+            if (divisor[i] == 0) {
+                throw std::runtime_error("Division by zero");
+            }
+        }
+    }
+
+} // namespace detail
+
+template <typename L, typename R>
+requires ElementwiseOperands<L, R>
+[[nodiscard]] constexpr auto operator+(const L &lhs, const R &rhs) noexcept {
+    return TensorExpression<std::plus<>, L, R>(lhs, rhs);
+}
+
+template <typename L, typename R>
+requires ElementwiseOperands<L, R>
+[[nodiscard]] constexpr auto operator-(const L &lhs, const R &rhs) noexcept {
+    return TensorExpression<std::minus<>, L, R>(lhs, rhs);
+}
+
+// Matrices use these operators for the matrix product instead.
+template <typename L, typename R>
+requires ElementwiseOperands<L, R> and (not MatrixLike<expression_result_t<L>>)
+[[nodiscard]] constexpr auto operator*(const L &lhs, const R &rhs) noexcept {
+    return TensorExpression<std::multiplies<>, L, R>(lhs, rhs);
+}
+
+template <typename L, typename R>
+requires ElementwiseOperands<L, R> and (not MatrixLike<expression_result_t<L>>)
+[[nodiscard]] constexpr auto operator/(const L &lhs, const R &rhs) {
+    detail::check_divisor(rhs);
+    return TensorExpression<std::divides<>, L, R>(lhs, rhs);
+}
+
+template <LazyOperand L, Numeric F>
+[[nodiscard]] constexpr auto operator*(const L &lhs, F value) noexcept {
+    return TensorExpression<std::multiplies<>, L, ScalarOperand<F>>(lhs, { value });
+}
+
+template <LazyOperand R, Numeric F>
+[[nodiscard]] constexpr auto operator*(F value, const R &rhs) noexcept {
+    // Keeps the `element * value` order of the eager operators.
+    return TensorExpression<std::multiplies<>, R, ScalarOperand<F>>(rhs, { value });
+}
+
+template <LazyOperand L, std::floating_point F>
+[[nodiscard]] constexpr auto operator/(const L &lhs, F value) {
+    if (value == 0) {
+        throw std::runtime_error("Division by zero");
+    }
+    return TensorExpression<std::divides<>, L, ScalarOperand<F>>(lhs, { value });
+}
+
+} // namespace dk::math
+
+#endif // DK_MATH_TENSOR_EXPRESSION_HPP
@@ -0,0 +1,295 @@
+#ifndef DK_MATH_THREAD_POOL_HPP
+#define DK_MATH_THREAD_POOL_HPP
+
+/// @file thread_pool.hpp
+///
+/// Small work-stealing thread pool owned by the library.
+///
+/// The pool only runs index spaces, `parallel_for(count, body)` calls
+/// `body(i)` for every `i < count`. The index space is split evenly into one
+/// contiguous range per participant (the calling thread included), every
+/// participant takes indices from the front of its own range and, once it runs
+/// dry, steals the back half of the fullest looking range of another one.
+///
+/// Ranges are packed into a single atomic word per participant and the body is
+/// passed as a function pointer with a context pointer, so submitting and
+/// running work never allocates. Both bounds of a range take 32 bits, larger
+/// index spaces are run as several consecutive jobs.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dk::math {
+
+class ThreadPool {
+public:
+    /// @brief Creates a pool where `threads` participants run every job, the
+    /// thread calling `parallel_for` is one of them.
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency())
+        : slots_(std::max<std::size_t>(threads, 1)) {
+        workers_.reserve(slots_.size() - 1);
+        for (std::size_t i = 1; i < slots_.size(); ++i) {
+            workers_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock { mutex_ };
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /// @brief Number of participants, including the calling thread.
+    [[nodiscard]] std::size_t size() const noexcept { return slots_.size(); }
+
+    /// @brief Calls `body(i)` for every `i` in `[0, count)` and waits for all
+    /// of them to finish.
+    ///
+    /// Calls from inside a running job are executed sequentially by the
+    /// calling thread, concurrent calls from different threads are serialized.
+    ///
+    /// If a call of `body` throws, the indices no participant has started yet
+    /// are skipped and the first exception is rethrown on the calling thread
+    /// once the running calls have returned, as on the sequential path.
+    template <typename F>
+    void parallel_for(std::size_t count, F &&body) {
+        if (count == 0) {
+            return;
+        }
+        if (inside_job() or size() == 1 or count == 1) {
+            for (std::size_t i = 0; i < count; ++i) {
+                body(i);
+            }
+            return;
+        }
+
+        using Body = std::remove_reference_t<F>;
+        std::lock_guard submit { submit_mutex_ };
+        void (*call)(void *, std::size_t) = [](void *context, std::size_t index) { (*static_cast<Body *>(context))(index); };
+        auto *context = const_cast<void *>(static_cast<const void *>(std::addressof(body)));
+        std::size_t offset = 0;
+        while (count - offset > max_job_count) {
+            run_job({ call, context, offset }, max_job_count);
+            offset += max_job_count;
+        }
+        run_job({ call, context, offset }, count - offset);
+    }
+
+    /// @brief Returns the pool shared by the library.
+    ///
+    /// It has one participant per hardware thread unless the `DK_MATH_THREADS`
+    /// environment variable asks for a different count.
+    static ThreadPool &global() {
+        static ThreadPool pool { threads_from_environment() };
+        return pool;
+    }
+
+private:
+    struct Job {
+        void (*call)(void *, std::size_t);
+        void *context;
+        /// Added to every index of the job's range before calling the body.
+        std::size_t offset;
+    };
+
+    struct alignas(64) Slot {
+        /// Remaining half-open index range, `begin` in the low and `end` in
+        /// the high 32 bits.
+        std::atomic<std::uint64_t> range { 0 };
+    };
+
+    /// Largest index range a single job can pack.
+    static constexpr std::size_t max_job_count = 0xffffffffu;
+
+    /// Splits `[0, count)` over the participants, runs it with them and
+    /// rethrows the first exception of a call.
+    void run_job(const Job &job, std::size_t count) {
+        const std::size_t participants = std::min(size(), count);
+        for (std::size_t i = 0; i < size(); ++i) {
+            const std::size_t begin = count * i / participants;
+            const std::size_t end = i < participants ? count * (i + 1) / participants : begin;
+            slots_[i].range.store(pack(i < participants ? begin : 0, i < participants ? end : 0), std::memory_order_relaxed);
+        }
+        remaining_.store(count, std::memory_order_relaxed);
+        {
+            std::lock_guard lock { mutex_ };
+            job_ = job;
+            open_ = true;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        run(0, job);
+        while (remaining_.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+
+        {
+            // Late workers must not join the job once it is closed, the ones
+            // that already did are waited for, so the slots can be reused.
+            std::lock_guard lock { mutex_ };
+            open_ = false;
+        }
+        while (active_.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+
+        if (failed_.load(std::memory_order_acquire)) {
+            failed_.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    static constexpr std::uint64_t pack(std::uint64_t begin, std::uint64_t end) noexcept {
+        return begin | (end << 32);
+    }
+
+    static constexpr std::uint64_t begin_of(std::uint64_t range) noexcept { return range & 0xffffffffu; }
+    static constexpr std::uint64_t end_of(std::uint64_t range) noexcept { return range >> 32; }
+
+    static bool &inside_job() noexcept {
+        thread_local bool inside = false;
+        return inside;
+    }
+
+    static std::size_t threads_from_environment() noexcept {
+        if (const char *value = std::getenv("DK_MATH_THREADS")) {
+            if (const long threads = std::strtol(value, nullptr, 10); threads > 0) {
+                return static_cast<std::size_t>(threads);
+            }
+        }
+        return std::thread::hardware_concurrency();
+    }
+
+    /// Takes the next index from the front of the own range.
+    bool pop(std::size_t slot, std::size_t &index) noexcept {
+        auto &range = slots_[slot].range;
+        auto current = range.load(std::memory_order_acquire);
+        while (begin_of(current) < end_of(current)) {
+            if (range.compare_exchange_weak(current, pack(begin_of(current) + 1, end_of(current)), std::memory_order_acq_rel)) {
+                index = begin_of(current);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Moves the back half of the largest other range into the own one and
+    /// takes its first index.
+    bool steal(std::size_t slot, std::size_t &index) noexcept {
+        while (remaining_.load(std::memory_order_acquire) != 0) {
+            std::size_t victim = slot;
+            std::uint64_t largest = 0;
+            for (std::size_t i = 0; i < size(); ++i) {
+                const auto range = slots_[i].range.load(std::memory_order_relaxed);
+                const auto available = end_of(range) - std::min(begin_of(range), end_of(range));
+                if (i != slot and available > largest) {
+                    largest = available;
+                    victim = i;
+                }
+            }
+            if (victim == slot) {
+                return false;
+            }
+            auto &range = slots_[victim].range;
+            auto current = range.load(std::memory_order_acquire);
+            const auto begin = begin_of(current);
+            const auto end = end_of(current);
+            if (begin >= end) {
+                continue;
+            }
+            const auto middle = begin + (end - begin) / 2;
+            if (range.compare_exchange_strong(current, pack(begin, middle), std::memory_order_acq_rel)) {
+                slots_[slot].range.store(pack(middle + 1, end), std::memory_order_release);
+                index = middle;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(std::size_t slot, const Job &job) noexcept {
+        inside_job() = true;
+        std::size_t index = 0;
+        while (pop(slot, index) or steal(slot, index)) {
+            if (not failed_.load(std::memory_order_relaxed)) {
+                try {
+                    job.call(job.context, job.offset + index);
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+            }
+            remaining_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        inside_job() = false;
+    }
+
+    /// Keeps the first exception of the running job for the calling thread.
+    void fail(std::exception_ptr error) noexcept {
+        std::lock_guard lock { mutex_ };
+        if (not error_) {
+            error_ = std::move(error);
+        }
+        failed_.store(true, std::memory_order_release);
+    }
+
+    void worker_loop(std::size_t slot) {
+        std::uint64_t seen = 0;
+        while (true) {
+            Job job;
+            {
+                std::unique_lock lock { mutex_ };
+                wake_.wait(lock, [&] { return stopping_ or generation_ != seen; });
+                if (stopping_) {
+                    return;
+                }
+                seen = generation_;
+                if (not open_) {
+                    continue;
+                }
+                job = job_;
+                active_.fetch_add(1, std::memory_order_acq_rel);
+            }
+            run(slot, job);
+            active_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<std::thread> workers_;
+
+    std::mutex submit_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    Job job_ {};
+    std::uint64_t generation_ = 0;
+    bool open_ = false;
+    bool stopping_ = false;
+    std::exception_ptr error_;
+    std::atomic<bool> failed_ { false };
+    std::atomic<std::size_t> remaining_ { 0 };
+    std::atomic<std::size_t> active_ { 0 };
+};
+
+} // namespace dk::math
+
+#endif // DK_MATH_THREAD_POOL_HPP
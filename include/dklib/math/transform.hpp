@@ -0,0 +1,72 @@
+#ifndef DK_MATH_TRANSFORM_HPP
+#define DK_MATH_TRANSFORM_HPP
+
+/// @file transform.hpp
+///
+/// Batched transformation of vertex streams by one `Matrix4<float>`.
+///
+/// Points are extended by `w = 1` and directions by `w = 0`, the result is not
+/// divided by its `w` component, projective transformations need the
+/// `Vector4` variant. All variants accept the same buffer as input and output
+/// and run on the kernels selected by `dispatch.hpp`, which keep the matrix in
+/// registers for the whole batch.
+
+#include <cassert>
+#include <span>
+
+#include <dklib/math/dispatch.hpp>
+#include <dklib/math/matrix4d.hpp>
+#include <dklib/math/vector3_soa.hpp>
+#include <dklib/math/vector3d.hpp>
+#include <dklib/math/vector4d.hpp>
+
+namespace dk::math::batch {
+
+// Kernels treat spans of vectors as packed arrays of floats.
+static_assert(sizeof(Vector4<float>) == 4 * sizeof(float));
+static_assert(sizeof(Matrix4<float>) == 16 * sizeof(float));
+
+/// @brief Computes `out[i] = matrix * in[i]` for every vector.
+inline void transform(const Matrix4<float> &matrix, std::span<const Vector4<float>> in, std::span<Vector4<float>> out) noexcept {
+    assert(in.size() == out.size());
+    dispatch::kernels().transform4(in.size(), matrix.data(), reinterpret_cast<const float *>(in.data()), reinterpret_cast<float *>(out.data()));
+}
+
+/// @brief Transforms every point of `in` by `matrix`, including its translation.
+inline void transform_points(const Matrix4<float> &matrix, std::span<const Vector3D> in, std::span<Vector3D> out) noexcept {
+    assert(in.size() == out.size());
+    dispatch::kernels().transform3(in.size(), matrix.data(), 1.0f, reinterpret_cast<const float *>(in.data()), reinterpret_cast<float *>(out.data()));
+}
+
+/// @brief Transforms every direction of `in` by `matrix`, ignoring its translation.
+inline void transform_directions(const Matrix4<float> &matrix, std::span<const Vector3D> in, std::span<Vector3D> out) noexcept {
+    assert(in.size() == out.size());
+    dispatch::kernels().transform3(in.size(), matrix.data(), 0.0f, reinterpret_cast<const float *>(in.data()), reinterpret_cast<float *>(out.data()));
+}
+
+namespace detail {
+
+    inline void transform_lanes(const Matrix4<float> &matrix, float w, const Vector3SoA<float> &in, Vector3SoA<float> &out) {
+        out.resize(in.size());
+        dispatch::kernels().transform3_soa(
+            in.padded_size(), matrix.data(), w, in.x(), in.y(), in.z(), out.x(), out.y(), out.z()
+        );
+    }
+
+} // namespace detail
+
+/// @brief Structure-of-arrays variant of `transform_points`, `out` is resized
+/// to the size of `in`.
+inline void transform_points(const Matrix4<float> &matrix, const Vector3SoA<float> &in, Vector3SoA<float> &out) {
+    detail::transform_lanes(matrix, 1.0f, in, out);
+}
+
+/// @brief Structure-of-arrays variant of `transform_directions`, `out` is
+/// resized to the size of `in`.
+inline void transform_directions(const Matrix4<float> &matrix, const Vector3SoA<float> &in, Vector3SoA<float> &out) {
+    detail::transform_lanes(matrix, 0.0f, in, out);
+}
+
+} // namespace dk::math::batch
+
+#endif // DK_MATH_TRANSFORM_HPP
@@ -9,6 +9,14 @@
 
 #define DK_INIT_METHOD [[nodiscard]] inline static constexpr
 
+/// Kernels that are instantiated once per instruction set have to be inlined
+/// into their callers to be compiled for the caller's target.
+#if defined(__GNUC__) or defined(__clang__)
+#define DK_ALWAYS_INLINE [[gnu::always_inline]] inline
+#else
+#define DK_ALWAYS_INLINE inline
+#endif
+
 namespace dk {
 using real = float;
 } // namespace dk
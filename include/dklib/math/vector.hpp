@@ -4,11 +4,14 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <functional>
 #include <numeric>
 #include <ostream>
+#include <stdexcept>
 #include <type_traits>
 
 #include <dklib/math/concepts.hpp>
+#include <dklib/math/elementwise.hpp>
 #include <dklib/math/tensor.hpp>
 #include <dklib/math/types.hpp>
 #include <dklib/math/vector_concepts.hpp>
@@ -156,18 +159,56 @@ public:
         return self.normalize();
     }
 
-    constexpr Vector &operator-() noexcept { }
+    constexpr Vector &operator-() noexcept {
+        std::ranges::transform(this->elems_, this->elems_.begin(), std::negate<T>());
+        return *this;
+    }
+
+    /// @brief Evaluates a fused element-wise expression in place.
+    template <TensorExpressionType E>
+    requires std::same_as<typename E::result_type, Vector>
+    constexpr Vector &operator=(const E &expression) noexcept {
+        expression.evaluate_into(*this);
+        return *this;
+    }
+
+    constexpr Vector &operator+=(const Vector &other) noexcept {
+        detail::elementwise(Dims, this->data(), this->data(), other.data(), std::plus<T>());
+        return *this;
+    }
+
+    constexpr Vector &operator-=(const Vector &other) noexcept {
+        detail::elementwise(Dims, this->data(), this->data(), other.data(), std::minus<T>());
+        return *this;
+    }
 
-    constexpr Vector &operator+=(const Vector &other) noexcept;
-    constexpr Vector &operator-=(const Vector &other) noexcept;
-    constexpr Vector &operator*=(const Vector &other) noexcept;
-    constexpr Vector &operator/=(const Vector &other) noexcept;
+    constexpr Vector &operator*=(const Vector &other) noexcept {
+        detail::elementwise(Dims, this->data(), this->data(), other.data(), std::multiplies<T>());
+        return *this;
+    }
+
+    constexpr Vector &operator/=(const Vector &other) {
+        if (detail::any_zero(Dims, other.data())) {
+            throw std::runtime_error("Division by zero");
+        }
+        detail::elementwise(Dims, this->data(), this->data(), other.data(), std::divides<T>());
+        return *this;
+    }
 
     template <std::convertible_to<T> T1>
-    constexpr Vector &operator*=(T1 value) noexcept;
+    constexpr Vector &operator*=(T1 value) noexcept {
+        detail::elementwise_scalar(Dims, this->data(), this->data(), value, std::multiplies<>());
+        return *this;
+    }
 
     template <std::convertible_to<T> T1>
-    constexpr Vector &operator/=(T value) noexcept;
+    constexpr Vector &operator/=(T1 value) {
+        if (value == 0) {
+            throw std::runtime_error("Division by zero");
+        }
+        detail::elementwise_scalar(Dims, this->data(), this->data(), value, std::divides<>());
+        return *this;
+    }
 
     friend constexpr bool operator==(const Vector &lhs, const Vector &rhs) noexcept {
         return lhs.elems_ == rhs.elems_;
@@ -183,22 +224,22 @@ public:
     }
 };
 
-template <VectorType V>
+template <AnyVectorType V>
 constexpr double dot(const V &lhs, const V &rhs) {
     return lhs.dot(rhs);
 }
 
-template <VectorType V>
+template <AnyVectorType V>
 constexpr double magnitude(const V &vec) {
     return vec.magnitude();
 }
 
-template <VectorType V>
+template <AnyVectorType V>
 constexpr double magnitude_squared(const V &vec) {
     return vec.magnitude_squared();
 }
 
-template <VectorType V>
+template <AnyVectorType V>
 constexpr double norm(const V &vec) {
     return vec.norm();
 }
@@ -0,0 +1,284 @@
+#ifndef DK_MATH_VECTOR_3_SOA_HPP
+#define DK_MATH_VECTOR_3_SOA_HPP
+
+/// @file vector3_soa.hpp
+///
+/// Structure-of-arrays storage for large numbers of 3D vectors.
+///
+/// `Vector3SoA` keeps the x, y and z components in three separate lanes, so
+/// the batched kernels below process one vector per SIMD lane instead of
+/// shuffling packed xyz triplets. Lanes start on a cache line and are padded
+/// to a whole number of cache lines, element-wise kernels run over the padding
+/// as well and never need a scalar tail. Padding starts out zero, but floating
+/// point kernels may leave other values in it.
+///
+/// The kernels follow the semantics of the matching `Vector3` operations, e.g.
+/// `magnitude` accumulates in double precision and `cross` never produces
+/// negative zeros.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <dklib/math/aligned_allocator.hpp>
+#include <dklib/math/concepts.hpp>
+#include <dklib/math/types.hpp>
+#include <dklib/math/vector3d.hpp>
+
+namespace dk::math {
+
+template <Numeric T = real>
+class Vector3SoA {
+public:
+    using value_type = T;
+    using vector_type = Vector3<T>;
+    using lane_type = std::vector<T, AlignedAllocator<T>>;
+
+    /// Lanes are padded to a multiple of this many elements.
+    static constexpr std::size_t lane_width = cache_line_size / sizeof(T);
+
+    Vector3SoA() = default;
+
+    /// @brief Creates `count` zero vectors.
+    explicit Vector3SoA(std::size_t count) { resize(count); }
+
+    /// @brief Creates the container from packed `Vector3` values.
+    explicit Vector3SoA(std::span<const vector_type> vectors) { gather(vectors); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Number of elements of every lane, including the padding.
+    [[nodiscard]] std::size_t padded_size() const noexcept { return x_.size(); }
+
+    [[nodiscard]] static constexpr std::size_t padded_size(std::size_t count) noexcept {
+        return (count + lane_width - 1) / lane_width * lane_width;
+    }
+
+    void reserve(std::size_t count) {
+        x_.reserve(padded_size(count));
+        y_.reserve(padded_size(count));
+        z_.reserve(padded_size(count));
+    }
+
+    /// @brief Changes the number of vectors, new vectors are zero.
+    void resize(std::size_t count) {
+        const std::size_t old_size = size_;
+        resize_lanes(count);
+        if (count > old_size) {
+            std::fill(x_.begin() + old_size, x_.begin() + count, T {});
+            std::fill(y_.begin() + old_size, y_.begin() + count, T {});
+            std::fill(z_.begin() + old_size, z_.begin() + count, T {});
+        }
+    }
+
+    void clear() noexcept { resize_lanes(0); }
+
+    void push_back(const vector_type &vec) {
+        resize_lanes(size_ + 1);
+        set(size_ - 1, vec);
+    }
+
+    [[nodiscard]] vector_type operator[](std::size_t idx) const noexcept {
+        return { x_[idx], y_[idx], z_[idx] };
+    }
+
+    [[nodiscard]] vector_type at(std::size_t idx) const {
+        if (idx >= size()) {
+            throw std::runtime_error("index out of bounds");
+        }
+        return (*this)[idx];
+    }
+
+    void set(std::size_t idx, const vector_type &vec) noexcept {
+        x_[idx] = vec.get_x();
+        y_[idx] = vec.get_y();
+        z_[idx] = vec.get_z();
+    }
+
+    /// Lane pointers are aligned to `cache_line_size` and valid for
+    /// `padded_size()` elements.
+    [[nodiscard]] T *x() noexcept { return std::assume_aligned<cache_line_size>(x_.data()); }
+    [[nodiscard]] T *y() noexcept { return std::assume_aligned<cache_line_size>(y_.data()); }
+    [[nodiscard]] T *z() noexcept { return std::assume_aligned<cache_line_size>(z_.data()); }
+    [[nodiscard]] const T *x() const noexcept { return std::assume_aligned<cache_line_size>(x_.data()); }
+    [[nodiscard]] const T *y() const noexcept { return std::assume_aligned<cache_line_size>(y_.data()); }
+    [[nodiscard]] const T *z() const noexcept { return std::assume_aligned<cache_line_size>(z_.data()); }
+
+    /// @brief Replaces the contents by the packed vectors of `vectors`.
+    void gather(std::span<const vector_type> vectors) {
+        resize_lanes(vectors.size());
+        const T *in = reinterpret_cast<const T *>(vectors.data());
+        T *x = this->x();
+        T *y = this->y();
+        T *z = this->z();
+#pragma omp simd
+        for (std::size_t i = 0; i < size_; ++i) {
+            x[i] = in[3 * i + 0];
+            y[i] = in[3 * i + 1];
+            z[i] = in[3 * i + 2];
+        }
+    }
+
+    /// @brief Writes all vectors to `vectors`, which has to hold `size()` of them.
+    void scatter(std::span<vector_type> vectors) const noexcept {
+        assert(vectors.size() == size_);
+        T *out = reinterpret_cast<T *>(vectors.data());
+        const T *x = this->x();
+        const T *y = this->y();
+        const T *z = this->z();
+#pragma omp simd
+        for (std::size_t i = 0; i < size_; ++i) {
+            out[3 * i + 0] = x[i];
+            out[3 * i + 1] = y[i];
+            out[3 * i + 2] = z[i];
+        }
+    }
+
+    [[nodiscard]] std::vector<vector_type> to_vector() const {
+        std::vector<vector_type> vectors(size_);
+        scatter(vectors);
+        return vectors;
+    }
+
+private:
+    // `gather` and `scatter` treat spans of vectors as packed arrays.
+    static_assert(sizeof(vector_type) == 3 * sizeof(T));
+
+    /// Resizes the lanes, new elements are value-initialized to zero.
+    ///
+    /// Removed elements that stay in the padding are zeroed as well, so
+    /// integer kernels running over the padding never overflow.
+    void resize_lanes(std::size_t count) {
+        const std::size_t padded = padded_size(count);
+        x_.resize(padded);
+        y_.resize(padded);
+        z_.resize(padded);
+        if (count < size_) {
+            const std::size_t end = std::min(size_, padded);
+            std::fill(x_.begin() + count, x_.begin() + end, T {});
+            std::fill(y_.begin() + count, y_.begin() + end, T {});
+            std::fill(z_.begin() + count, z_.begin() + end, T {});
+        }
+        size_ = count;
+    }
+
+    lane_type x_;
+    lane_type y_;
+    lane_type z_;
+    std::size_t size_ = 0;
+};
+
+using Vector3Stream = Vector3SoA<real>;
+
+namespace batch {
+
+    /// @brief Computes `out[i] = dot(lhs[i], rhs[i])` for every pair of vectors.
+    template <Numeric T>
+    void dot(const Vector3SoA<T> &lhs, const Vector3SoA<T> &rhs, std::span<T> out) noexcept {
+        assert(lhs.size() == rhs.size() and lhs.size() == out.size());
+        const T *lx = lhs.x(), *ly = lhs.y(), *lz = lhs.z();
+        const T *rx = rhs.x(), *ry = rhs.y(), *rz = rhs.z();
+        T *o = out.data();
+#pragma omp simd
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            o[i] = T {} + lx[i] * rx[i] + ly[i] * ry[i] + lz[i] * rz[i];
+        }
+    }
+
+    /// @brief Computes `out[i] = cross(lhs[i], rhs[i])`, `out` may be one of
+    /// the operands.
+    template <Numeric T>
+    void cross(const Vector3SoA<T> &lhs, const Vector3SoA<T> &rhs, Vector3SoA<T> &out) {
+        assert(lhs.size() == rhs.size());
+        out.resize(lhs.size());
+        const T *lx = lhs.x(), *ly = lhs.y(), *lz = lhs.z();
+        const T *rx = rhs.x(), *ry = rhs.y(), *rz = rhs.z();
+        T *ox = out.x(), *oy = out.y(), *oz = out.z();
+#pragma omp simd
+        for (std::size_t i = 0; i < out.padded_size(); ++i) {
+            // Adding zero turns negative zeros into positive ones.
+            const T x = ly[i] * rz[i] - lz[i] * ry[i] + T {};
+            const T y = lz[i] * rx[i] - lx[i] * rz[i] + T {};
+            const T z = lx[i] * ry[i] - ly[i] * rx[i] + T {};
+            ox[i] = x;
+            oy[i] = y;
+            oz[i] = z;
+        }
+    }
+
+    /// @brief Computes `out[i] = magnitude(vectors[i])`, the sum of squares is
+    /// accumulated in double precision.
+    template <std::floating_point T>
+    void magnitude(const Vector3SoA<T> &vectors, std::span<T> out) noexcept {
+        assert(vectors.size() == out.size());
+        const T *x = vectors.x(), *y = vectors.y(), *z = vectors.z();
+        T *o = out.data();
+#pragma omp simd
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            const double sum = static_cast<double>(x[i] * x[i]) + static_cast<double>(y[i] * y[i])
+                + static_cast<double>(z[i] * z[i]);
+            o[i] = static_cast<T>(std::sqrt(sum));
+        }
+    }
+
+    /// @brief Normalizes every vector in place, zero vectors become NaN as
+    /// with `Vector3::normalize`.
+    ///
+    /// Unlike the other kernels it skips the padding, which would raise
+    /// floating point exceptions for the zero vectors stored there.
+    template <std::floating_point T>
+    void normalize(Vector3SoA<T> &vectors) noexcept {
+        T *x = vectors.x(), *y = vectors.y(), *z = vectors.z();
+#pragma omp simd
+        for (std::size_t i = 0; i < vectors.size(); ++i) {
+            const double sum = static_cast<double>(x[i] * x[i]) + static_cast<double>(y[i] * y[i])
+                + static_cast<double>(z[i] * z[i]);
+            const double factor = T { 1 } / std::sqrt(sum);
+            x[i] = static_cast<T>(x[i] * factor);
+            y[i] = static_cast<T>(y[i] * factor);
+            z[i] = static_cast<T>(z[i] * factor);
+        }
+    }
+
+    /// @brief Computes `out[i] = lhs[i] + rhs[i]`, `out` may be one of the operands.
+    template <Numeric T>
+    void add(const Vector3SoA<T> &lhs, const Vector3SoA<T> &rhs, Vector3SoA<T> &out) {
+        assert(lhs.size() == rhs.size());
+        out.resize(lhs.size());
+        const T *lx = lhs.x(), *ly = lhs.y(), *lz = lhs.z();
+        const T *rx = rhs.x(), *ry = rhs.y(), *rz = rhs.z();
+        T *ox = out.x(), *oy = out.y(), *oz = out.z();
+#pragma omp simd
+        for (std::size_t i = 0; i < out.padded_size(); ++i) {
+            ox[i] = lx[i] + rx[i];
+            oy[i] = ly[i] + ry[i];
+            oz[i] = lz[i] + rz[i];
+        }
+    }
+
+    /// @brief Computes `out[i] = vectors[i] * factor`, `out` may be `vectors`.
+    template <Numeric T, std::convertible_to<T> F>
+    void scale(const Vector3SoA<T> &vectors, F factor, Vector3SoA<T> &out) {
+        out.resize(vectors.size());
+        const T *x = vectors.x(), *y = vectors.y(), *z = vectors.z();
+        T *ox = out.x(), *oy = out.y(), *oz = out.z();
+#pragma omp simd
+        for (std::size_t i = 0; i < out.padded_size(); ++i) {
+            ox[i] = static_cast<T>(x[i] * factor);
+            oy[i] = static_cast<T>(y[i] * factor);
+            oz[i] = static_cast<T>(z[i] * factor);
+        }
+    }
+
+} // namespace batch
+
+} // namespace dk::math
+
+#endif // DK_MATH_VECTOR_3_SOA_HPP
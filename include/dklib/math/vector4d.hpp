@@ -5,13 +5,14 @@
 #include <ostream>
 
 #include <dklib/math/concepts.hpp>
+#include <dklib/math/simd.hpp>
 #include <dklib/math/types.hpp>
 #include <dklib/math/vector.hpp>
 
 namespace dk::math {
 
 template <Numeric T = real>
-class Vector4 : public Vector<T, 4> {
+class alignas(simd::alignment<T, 4>) Vector4 : public Vector<T, 4> {
 public:
     using Base = Vector<T, 4>;
 
@@ -44,6 +45,12 @@ public:
     constexpr void set_w(T value) noexcept { (*this)[3] = value; }
 
     constexpr Vector4 &operator-() noexcept {
+        if !consteval {
+            if constexpr (simd::accelerated<T, 4>) {
+                simd::negate4(this->data());
+                return *this;
+            }
+        }
         (*this)[0] = -(*this)[0];
         (*this)[1] = -(*this)[1];
         (*this)[2] = -(*this)[2];
@@ -52,6 +59,12 @@ public:
     };
 
     constexpr Vector4 &operator+=(const Vector4 &other) noexcept {
+        if !consteval {
+            if constexpr (simd::accelerated<T, 4>) {
+                simd::add4(this->data(), other.data());
+                return *this;
+            }
+        }
         this->get_x() += other.get_x();
         this->get_y() += other.get_y();
         this->get_z() += other.get_z();
@@ -59,6 +72,12 @@ public:
         return *this;
     };
     constexpr Vector4 &operator-=(const Vector4 &other) noexcept {
+        if !consteval {
+            if constexpr (simd::accelerated<T, 4>) {
+                simd::sub4(this->data(), other.data());
+                return *this;
+            }
+        }
         (*this)[0] -= other.get_x();
         (*this)[1] -= other.get_y();
         (*this)[2] -= other.get_z();
@@ -66,6 +85,12 @@ public:
         return *this;
     }
     constexpr Vector4 &operator*=(const Vector4 &other) noexcept {
+        if !consteval {
+            if constexpr (simd::accelerated<T, 4>) {
+                simd::mul4(this->data(), other.data());
+                return *this;
+            }
+        }
         (*this)[0] *= other.get_x();
         (*this)[1] *= other.get_y();
         (*this)[2] *= other.get_z();
@@ -76,6 +101,12 @@ public:
         if (std::any_of(other.elems_.cbegin(), other.elems_.cend(), [](auto v) { return v == 0; })) {
             throw std::runtime_error("Division by zero");
         }
+        if !consteval {
+            if constexpr (simd::accelerated<T, 4>) {
+                simd::div4(this->data(), other.data());
+                return *this;
+            }
+        }
         (*this)[0] /= other.get_x();
         (*this)[1] /= other.get_y();
         (*this)[2] /= other.get_z();
@@ -85,6 +116,14 @@ public:
 
     template <std::convertible_to<T> T1>
     constexpr Vector4 &operator*=(T1 value) noexcept {
+        if !consteval {
+            // Mixed precision operands are computed in the wider type by the
+            // scalar path, so only the exact element type is vectorized.
+            if constexpr (simd::accelerated<T, 4> and std::same_as<T1, T>) {
+                simd::scale4(this->data(), value);
+                return *this;
+            }
+        }
         (*this)[0] *= value;
         (*this)[1] *= value;
         (*this)[2] *= value;
@@ -97,6 +136,12 @@ public:
         if (value == 0) {
             throw std::runtime_error("Division by zero");
         }
+        if !consteval {
+            if constexpr (simd::accelerated<T, 4> and std::same_as<T1, T>) {
+                simd::divide4(this->data(), value);
+                return *this;
+            }
+        }
         (*this)[0] /= value;
         (*this)[1] /= value;
         (*this)[2] /= value;
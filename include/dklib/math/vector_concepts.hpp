@@ -23,6 +23,26 @@ inline constexpr bool is_vector_type_v = is_vector_type<T>::value;
 template <typename T>
 concept VectorType = is_vector_type_v<T>;
 
+template <Numeric T>
+class DynVector;
+
+template <typename T>
+struct is_dynamic_vector_type : std::false_type { };
+
+template <typename T>
+struct is_dynamic_vector_type<DynVector<T>> : std::true_type { };
+
+template <typename T>
+inline constexpr bool is_dynamic_vector_type_v = is_dynamic_vector_type<T>::value;
+
+/// Vectors whose size is only known at runtime, see `dyn_vector.hpp`.
+template <typename T>
+concept DynamicVectorType = is_dynamic_vector_type_v<T>;
+
+/// Fixed size as well as dynamic vectors.
+template <typename T>
+concept AnyVectorType = VectorType<T> or DynamicVectorType<T>;
+
 } // namespace dk::math
 
 #endif // DK_MATH_VECTOR_CONCEPTS_HPP
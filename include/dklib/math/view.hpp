@@ -0,0 +1,530 @@
+#ifndef DK_MATH_VIEW_HPP
+#define DK_MATH_VIEW_HPP
+
+/// @file view.hpp
+///
+/// Non-owning strided views, in the spirit of `std::mdspan` with
+/// `layout_stride`.
+///
+/// A `TensorView<T, Rank>` is a pointer with an extent and an element stride
+/// per dimension, `T` is `const` qualified for read-only views. Views are
+/// made with `view()` from `Tensor`, `Matrix`, `Vector`, the dynamic types or
+/// a raw buffer, and `reshape`, `slice`, `subview`, `row`, `col`, `block`
+/// and `transpose` only compute new extents and strides, they never copy:
+///
+///     Matrix<float, 8, 8> mat;
+///     auto block = view(mat).block(2, 2, 4, 4);
+///     block *= 2.0f;                      // scales the 4x4 block of `mat`
+///     multiply_into(block.transpose(), view(other), view(result));
+///
+/// Element-wise operators run the contiguous loops from `elementwise.hpp` on
+/// every line with unit stride, and products hand the strides to the
+/// blocked GEMM. Shape mismatches throw. The destination of an element-wise
+/// operator must either be identical to its source or not overlap it at
+/// all, the result of a product must not overlap its operands and throws if
+/// it starts at the same element as one of them.
+///
+/// With a standard library providing `<mdspan>`, views convert from and to
+/// `std::mdspan`.
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <version>
+
+#ifdef __cpp_lib_mdspan
+#include <mdspan>
+#endif
+
+#include <dklib/math/elementwise.hpp>
+#include <dklib/math/gemm.hpp>
+#include <dklib/math/tensor.hpp>
+#include <dklib/math/types.hpp>
+
+namespace dk::math {
+
+template <typename T, std::size_t Rank>
+requires(Rank > 0 and Numeric<std::remove_const_t<T>>)
+class TensorView;
+
+namespace detail {
+
+    /// Calls `line(index)` for the first element of every innermost line of
+    /// a view with the given extents, in row-major order.
+    template <std::size_t Rank, typename F>
+    constexpr void for_each_line(const std::array<std::size_t, Rank> &extents, F &&line) {
+        if (std::ranges::find(extents, std::size_t { 0 }) != extents.end()) {
+            return;
+        }
+        std::array<std::size_t, Rank> index {};
+        while (true) {
+            line(index);
+            std::size_t dim = Rank - 1;
+            while (true) {
+                if (dim == 0) {
+                    return;
+                }
+                --dim;
+                if (++index[dim] < extents[dim]) {
+                    break;
+                }
+                index[dim] = 0;
+            }
+        }
+    }
+
+    template <typename T, std::size_t Rank>
+    void check_extents(const TensorView<T, Rank> &lhs, const auto &rhs) {
+        if (lhs.extents() != rhs.extents()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+    }
+
+    /// `out = op(out, in)` element-wise, lines with unit strides use the
+    /// vectorized loops.
+    template <typename T, std::size_t Rank, typename Op>
+    void view_elementwise(const TensorView<T, Rank> &out, const TensorView<const T, Rank> &in, Op op) {
+        check_extents(out, in);
+        if (out.is_contiguous() and in.is_contiguous()) {
+            elementwise(out.size(), out.data(), out.data(), in.data(), op);
+            return;
+        }
+        const std::size_t count = out.extent(Rank - 1);
+        const std::size_t out_stride = out.stride(Rank - 1);
+        const std::size_t in_stride = in.stride(Rank - 1);
+        for_each_line(out.extents(), [&](const auto &index) {
+            T *dst = out.data() + out.offset(index);
+            const T *src = in.data() + in.offset(index);
+            if (out_stride == 1 and in_stride == 1) {
+                elementwise(count, dst, dst, src, op);
+            } else {
+                for (std::size_t i = 0; i < count; ++i) {
+                    dst[i * out_stride] = static_cast<T>(op(dst[i * out_stride], src[i * in_stride]));
+                }
+            }
+        });
+    }
+
+    template <typename T, std::size_t Rank, typename F, typename Op>
+    void view_elementwise_scalar(const TensorView<T, Rank> &out, F value, Op op) {
+        if (out.is_contiguous()) {
+            elementwise_scalar(out.size(), out.data(), out.data(), value, op);
+            return;
+        }
+        const std::size_t count = out.extent(Rank - 1);
+        const std::size_t stride = out.stride(Rank - 1);
+        for_each_line(out.extents(), [&](const auto &index) {
+            T *dst = out.data() + out.offset(index);
+            if (stride == 1) {
+                elementwise_scalar(count, dst, dst, value, op);
+            } else {
+                for (std::size_t i = 0; i < count; ++i) {
+                    dst[i * stride] = static_cast<T>(op(dst[i * stride], value));
+                }
+            }
+        });
+    }
+
+} // namespace detail
+
+template <typename T, std::size_t Rank>
+requires(Rank > 0 and Numeric<std::remove_const_t<T>>)
+class TensorView {
+public:
+    using element_type = T;
+    using value_type = std::remove_const_t<T>;
+    using extents_type = std::array<std::size_t, Rank>;
+
+    constexpr TensorView() noexcept = default;
+
+    /// @brief Views `data` as a row-major array with the given extents.
+    constexpr TensorView(T *data, const extents_type &extents) noexcept
+        : data_ { data }
+        , extents_ { extents } {
+        std::size_t stride = 1;
+        for (std::size_t r = Rank; r-- > 0;) {
+            strides_[r] = stride;
+            stride *= extents_[r];
+        }
+    }
+
+    template <std::convertible_to<std::size_t>... E>
+    requires(sizeof...(E) == Rank)
+    constexpr TensorView(T *data, E... extents) noexcept
+        : TensorView(data, extents_type { static_cast<std::size_t>(extents)... }) { }
+
+    /// @brief Views `data` with explicit element strides.
+    constexpr TensorView(T *data, const extents_type &extents, const extents_type &strides) noexcept
+        : data_ { data }
+        , extents_ { extents }
+        , strides_ { strides } { }
+
+    /// Mutable views convert to read-only ones.
+    template <typename U>
+    requires(std::is_const_v<T> and std::same_as<U, std::remove_const_t<T>>)
+    constexpr TensorView(const TensorView<U, Rank> &other) noexcept
+        : TensorView(other.data(), other.extents(), other.strides()) { }
+
+#ifdef __cpp_lib_mdspan
+    template <typename Extents, typename Layout, typename Accessor>
+    requires(Extents::rank() == Rank and std::same_as<typename Accessor::data_handle_type, T *>)
+    explicit constexpr TensorView(const std::mdspan<T, Extents, Layout, Accessor> &span)
+        : data_ { span.data_handle() } {
+        for (std::size_t r = 0; r < Rank; ++r) {
+            extents_[r] = span.extent(r);
+            strides_[r] = span.stride(r);
+        }
+    }
+
+    [[nodiscard]] constexpr auto to_mdspan() const noexcept {
+        using Extents = std::dextents<std::size_t, Rank>;
+        return std::mdspan<T, Extents, std::layout_stride>(data_, std::layout_stride::mapping<Extents>(Extents(extents_), strides_));
+    }
+#endif
+
+    [[nodiscard]] static constexpr std::size_t rank() noexcept { return Rank; }
+
+    [[nodiscard]] constexpr T *data() const noexcept { return data_; }
+    [[nodiscard]] constexpr const extents_type &extents() const noexcept { return extents_; }
+    [[nodiscard]] constexpr const extents_type &strides() const noexcept { return strides_; }
+    [[nodiscard]] constexpr std::size_t extent(std::size_t dim) const noexcept { return extents_[dim]; }
+    [[nodiscard]] constexpr std::size_t stride(std::size_t dim) const noexcept { return strides_[dim]; }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+        std::size_t size = 1;
+        for (const auto extent : extents_) {
+            size *= extent;
+        }
+        return size;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+    /// @brief Returns true if the elements are densely packed in row-major
+    /// order, which allows treating the view as a flat array.
+    [[nodiscard]] constexpr bool is_contiguous() const noexcept {
+        std::size_t stride = 1;
+        for (std::size_t r = Rank; r-- > 0;) {
+            if (extents_[r] != 1 and strides_[r] != stride) {
+                return false;
+            }
+            stride *= extents_[r];
+        }
+        return true;
+    }
+
+    /// @brief Element offset of a full index from `data()`.
+    [[nodiscard]] constexpr std::size_t offset(const extents_type &index) const noexcept {
+        std::size_t offset = 0;
+        for (std::size_t r = 0; r < Rank; ++r) {
+            offset += index[r] * strides_[r];
+        }
+        return offset;
+    }
+
+    template <std::convertible_to<std::size_t>... I>
+    requires(sizeof...(I) == Rank)
+    [[nodiscard]] constexpr T &operator[](I... index) const noexcept {
+        return data_[offset({ static_cast<std::size_t>(index)... })];
+    }
+
+    template <std::convertible_to<std::size_t>... I>
+    requires(sizeof...(I) == Rank)
+    [[nodiscard]] constexpr T &at(I... index) const {
+        const extents_type idx { static_cast<std::size_t>(index)... };
+        for (std::size_t r = 0; r < Rank; ++r) {
+            if (idx[r] >= extents_[r]) {
+                throw std::runtime_error("index is out of bounds");
+            }
+        }
+        return data_[offset(idx)];
+    }
+
+    /// @brief Views the same elements with other extents of the same total
+    /// size, only contiguous views can be reshaped.
+    template <std::convertible_to<std::size_t>... E>
+    [[nodiscard]] constexpr TensorView<T, sizeof...(E)> reshape(E... extents) const {
+        const std::array<std::size_t, sizeof...(E)> shape { static_cast<std::size_t>(extents)... };
+        std::size_t size = 1;
+        for (const auto extent : shape) {
+            size *= extent;
+        }
+        if (size != this->size()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+        if (not is_contiguous()) {
+            throw std::runtime_error("view is not contiguous");
+        }
+        return { data_, shape };
+    }
+
+    /// @brief Fixes dimension `dim` to `index`, dropping it from the view.
+    [[nodiscard]] constexpr auto slice(std::size_t dim, std::size_t index) const
+    requires(Rank > 1)
+    {
+        check_range(dim, index, 1);
+        std::array<std::size_t, Rank - 1> extents;
+        std::array<std::size_t, Rank - 1> strides;
+        for (std::size_t r = 0, s = 0; r < Rank; ++r) {
+            if (r != dim) {
+                extents[s] = extents_[r];
+                strides[s++] = strides_[r];
+            }
+        }
+        return TensorView<T, Rank - 1> { data_ + index * strides_[dim], extents, strides };
+    }
+
+    /// @brief Restricts dimension `dim` to `count` indices from `first`.
+    [[nodiscard]] constexpr TensorView subview(std::size_t dim, std::size_t first, std::size_t count) const {
+        check_range(dim, first, count);
+        TensorView result = *this;
+        result.data_ += first * strides_[dim];
+        result.extents_[dim] = count;
+        return result;
+    }
+
+    /// @brief Reverses the order of the dimensions.
+    [[nodiscard]] constexpr TensorView transpose() const noexcept {
+        TensorView result = *this;
+        std::ranges::reverse(result.extents_);
+        std::ranges::reverse(result.strides_);
+        return result;
+    }
+
+    [[nodiscard]] constexpr std::size_t rows() const noexcept
+    requires(Rank == 2)
+    {
+        return extents_[0];
+    }
+
+    [[nodiscard]] constexpr std::size_t cols() const noexcept
+    requires(Rank == 2)
+    {
+        return extents_[1];
+    }
+
+    [[nodiscard]] constexpr TensorView<T, 1> row(std::size_t x) const
+    requires(Rank == 2)
+    {
+        return slice(0, x);
+    }
+
+    [[nodiscard]] constexpr TensorView<T, 1> col(std::size_t y) const
+    requires(Rank == 2)
+    {
+        return slice(1, y);
+    }
+
+    /// @brief The `rows x cols` block whose top-left element is (`x`, `y`).
+    [[nodiscard]] constexpr TensorView block(std::size_t x, std::size_t y, std::size_t rows, std::size_t cols) const
+    requires(Rank == 2)
+    {
+        return subview(0, x, rows).subview(1, y, cols);
+    }
+
+    const TensorView &operator+=(TensorView<const value_type, Rank> other) const
+    requires(not std::is_const_v<T>)
+    {
+        detail::view_elementwise(*this, other, std::plus<T>());
+        return *this;
+    }
+
+    const TensorView &operator-=(TensorView<const value_type, Rank> other) const
+    requires(not std::is_const_v<T>)
+    {
+        detail::view_elementwise(*this, other, std::minus<T>());
+        return *this;
+    }
+
+    template <std::convertible_to<value_type> T1>
+    const TensorView &operator*=(T1 value) const
+    requires(not std::is_const_v<T>)
+    {
+        detail::view_elementwise_scalar(*this, value, std::multiplies<>());
+        return *this;
+    }
+
+    template <std::convertible_to<value_type> T1>
+    const TensorView &operator/=(T1 value) const
+    requires(not std::is_const_v<T>)
+    {
+        detail::view_elementwise_scalar(*this, value, std::divides<>());
+        return *this;
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const TensorView &view) {
+        os << '(';
+        bool first = true;
+        detail::for_each_line(view.extents_, [&](const extents_type &index) {
+            const T *line = view.data_ + view.offset(index);
+            for (std::size_t i = 0; i < view.extents_[Rank - 1]; ++i) {
+                os << (first ? "" : ", ") << line[i * view.strides_[Rank - 1]];
+                first = false;
+            }
+        });
+        return os << ')';
+    }
+
+private:
+    constexpr void check_range(std::size_t dim, std::size_t first, std::size_t count) const {
+        if (dim >= Rank or first > extents_[dim] or count > extents_[dim] - first) {
+            throw std::runtime_error("index is out of bounds");
+        }
+    }
+
+    T *data_ = nullptr;
+    extents_type extents_ {};
+    extents_type strides_ {};
+};
+
+template <typename T>
+using VectorView = TensorView<T, 1>;
+
+template <typename T>
+using MatrixView = TensorView<T, 2>;
+
+/// @brief Copies the elements of `src` into `dst`, which must have the same
+/// extents.
+template <typename T, typename U, std::size_t Rank>
+requires std::same_as<std::remove_const_t<U>, T>
+void assign(const TensorView<T, Rank> &dst, const TensorView<U, Rank> &src) {
+    detail::view_elementwise(dst, TensorView<const T, Rank> { src }, [](T, T value) { return value; });
+}
+
+template <typename L, typename R>
+requires std::same_as<std::remove_const_t<L>, std::remove_const_t<R>>
+[[nodiscard]] bool operator==(const TensorView<L, 1> &lhs, const TensorView<R, 1> &rhs) noexcept {
+    if (lhs.extents() != rhs.extents()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i] != rhs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename L, typename R>
+requires std::same_as<std::remove_const_t<L>, std::remove_const_t<R>>
+[[nodiscard]] bool operator==(const TensorView<L, 2> &lhs, const TensorView<R, 2> &rhs) noexcept {
+    if (lhs.extents() != rhs.extents()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.rows(); ++i) {
+        if (not(lhs.row(i) == rhs.row(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename L, typename R>
+requires std::same_as<std::remove_const_t<L>, std::remove_const_t<R>>
+[[nodiscard]] double dot(const TensorView<L, 1> &lhs, const TensorView<R, 1> &rhs) {
+    detail::check_extents(lhs, rhs);
+    std::remove_const_t<L> sum {};
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        sum += lhs[i] * rhs[i];
+    }
+    return static_cast<double>(sum);
+}
+
+/// @brief Computes `result = lhs * rhs` on views.
+///
+/// The operands may have any strides, transposed or sub-block views are
+/// multiplied without copying them first. Products with every extent of at
+/// least `gemm::min_blocked_dimension` and a result with unit column stride
+/// use the blocked GEMM. Smaller ones accumulate scaled rows of `rhs` when
+/// it and the result have unit column strides, and fall back to dot products
+/// otherwise. `result` must not overlap `lhs` or `rhs`.
+template <typename L, typename R, Numeric T>
+requires(std::same_as<std::remove_const_t<L>, T> and std::same_as<std::remove_const_t<R>, T>)
+void multiply_into(const TensorView<L, 2> &lhs, const TensorView<R, 2> &rhs, const TensorView<T, 2> &result) {
+    const std::size_t m = lhs.rows();
+    const std::size_t n = rhs.cols();
+    const std::size_t k = lhs.cols();
+    if (k != rhs.rows() or result.rows() != m or result.cols() != n) {
+        throw std::runtime_error("dimension mismatch");
+    }
+    if (not result.empty() and (result.data() == lhs.data() or result.data() == rhs.data())) {
+        throw std::runtime_error("product must not alias its operands");
+    }
+    if (std::min({ m, n, k }) >= gemm::min_blocked_dimension and result.stride(1) == 1) {
+        gemm::multiply<T>(
+            m, n, k, { lhs.data(), lhs.stride(0), lhs.stride(1) }, { rhs.data(), rhs.stride(0), rhs.stride(1) },
+            result.data(), result.stride(0)
+        );
+        return;
+    }
+    if (rhs.stride(1) == 1 and result.stride(1) == 1) {
+        // Accumulate scaled rows of `rhs` into a strip of each result row
+        // held locally, the inner loop stays on unit strides whatever the
+        // layout of `lhs`.
+        constexpr std::size_t strip = 64;
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j0 = 0; j0 < n; j0 += strip) {
+                const std::size_t width = std::min(strip, n - j0);
+                T acc[strip] = {};
+                for (std::size_t p = 0; p < k; ++p) {
+                    const T scale = lhs[i, p];
+                    const T *src = &rhs[p, j0];
+                    for (std::size_t j = 0; j < width; ++j) {
+                        acc[j] += scale * src[j];
+                    }
+                }
+                std::copy_n(acc, width, &result[i, j0]);
+            }
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            T sum {};
+            for (std::size_t p = 0; p < k; ++p) {
+                sum += lhs[i, p] * rhs[p, j];
+            }
+            result[i, j] = sum;
+        }
+    }
+}
+
+/// @brief Computes the matrix-vector product `result = mat * vec` on views,
+/// `result` must not overlap `mat` or `vec`.
+template <typename L, typename R, Numeric T>
+requires(std::same_as<std::remove_const_t<L>, T> and std::same_as<std::remove_const_t<R>, T>)
+void multiply_into(const TensorView<L, 2> &mat, const TensorView<R, 1> &vec, const TensorView<T, 1> &result) {
+    if (mat.cols() != vec.size() or mat.rows() != result.size()) {
+        throw std::runtime_error("dimension mismatch");
+    }
+    if (not result.empty() and (result.data() == mat.data() or result.data() == vec.data())) {
+        throw std::runtime_error("product must not alias its operands");
+    }
+    for (std::size_t i = 0; i < mat.rows(); ++i) {
+        result[i] = static_cast<T>(dot(mat.row(i), vec));
+    }
+}
+
+/// @brief Views the elements of a tensor, a `Matrix` becomes a rank 2 and a
+/// `Vector` a rank 1 view.
+template <Numeric T, std::size_t... Dims>
+[[nodiscard]] constexpr TensorView<T, sizeof...(Dims)> view(Tensor<T, Dims...> &tensor) noexcept {
+    return { tensor.data(), Dims... };
+}
+
+template <Numeric T, std::size_t... Dims>
+[[nodiscard]] constexpr TensorView<const T, sizeof...(Dims)> view(const Tensor<T, Dims...> &tensor) noexcept {
+    return { tensor.data(), Dims... };
+}
+
+template <Numeric T, std::size_t... Dims>
+void view(const Tensor<T, Dims...> &&) = delete;
+
+} // namespace dk::math
+
+#endif // DK_MATH_VIEW_HPP
@@ -0,0 +1,237 @@
+#ifndef DK_MATH_WORKSPACE_HPP
+#define DK_MATH_WORKSPACE_HPP
+
+/// @file workspace.hpp
+///
+/// Scratch memory for solvers and GEMM.
+///
+/// `Arena` is a bump allocating `std::pmr::memory_resource`: deallocation is
+/// a no-op and `reset` rewinds to the start while keeping the memory, after
+/// merging the chunks a first pass needed into one. Iterative algorithms
+/// that reset their arena once per iteration therefore stop allocating after
+/// the first one. `Workspace` wraps an arena with typed, scoped borrowing:
+///
+///     Workspace workspace;
+///     for (...) {
+///         DynMatrix<float> tmp(n, n, {}, workspace.resource());
+///         multiply_into(workspace, a, b, tmp); // packs into the workspace
+///         ...
+///         workspace.reset();
+///     }
+///
+/// `CountingResource` counts the allocations reaching its upstream resource,
+/// which is how tests check that such loops reach a steady state.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <dklib/math/aligned_allocator.hpp>
+
+namespace dk::math {
+
+class Arena final : public std::pmr::memory_resource {
+public:
+    /// Position in the arena, see `mark` and `rewind`.
+    struct Mark {
+        std::size_t chunk;
+        std::size_t offset;
+    };
+
+    /// Smallest chunk requested from the upstream resource.
+    static constexpr std::size_t min_chunk_size = 4096;
+
+    /// @brief Creates an arena drawing chunks from `upstream`.
+    /// @param  [in] capacity Size of the first chunk, zero allocates lazily.
+    explicit Arena(std::size_t capacity = 0, std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : upstream_ { upstream } {
+        if (capacity != 0) {
+            grow(capacity);
+        }
+    }
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    ~Arena() override { release(); }
+
+    [[nodiscard]] Mark mark() const noexcept { return { current_, offset_ }; }
+
+    /// @brief Frees everything allocated after `mark` was taken.
+    void rewind(Mark mark) noexcept {
+        current_ = mark.chunk;
+        offset_ = mark.offset;
+    }
+
+    /// @brief Frees every allocation. If the arena had to grow since the last
+    /// reset its chunks are replaced by a single one of the same total size,
+    /// so that the next pass fits without allocating.
+    void reset() {
+        if (chunks_.size() > 1) {
+            const std::size_t total = capacity_;
+            release();
+            grow(total);
+        }
+        rewind({ 0, 0 });
+    }
+
+    /// @brief Returns all chunks to the upstream resource.
+    void release() noexcept {
+        for (const auto &chunk : chunks_) {
+            upstream_->deallocate(chunk.data, chunk.size, cache_line_size);
+        }
+        chunks_.clear();
+        capacity_ = 0;
+        next_chunk_size_ = min_chunk_size;
+        rewind({ 0, 0 });
+    }
+
+    /// @brief Total size of the chunks held by the arena.
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    [[nodiscard]] std::pmr::memory_resource *upstream() const noexcept { return upstream_; }
+
+private:
+    struct Chunk {
+        std::byte *data;
+        std::size_t size;
+    };
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        while (true) {
+            if (current_ < chunks_.size()) {
+                const Chunk &chunk = chunks_[current_];
+                const auto base = reinterpret_cast<std::uintptr_t>(chunk.data);
+                const std::size_t start = ((base + offset_ + alignment - 1) & ~(alignment - 1)) - base;
+                if (start <= chunk.size and bytes <= chunk.size - start) {
+                    offset_ = start + bytes;
+                    return chunk.data + start;
+                }
+                if (current_ + 1 < chunks_.size()) {
+                    ++current_;
+                    offset_ = 0;
+                    continue;
+                }
+            }
+            grow(bytes + alignment);
+        }
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) noexcept override { }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    /// Appends a chunk of at least `size` bytes and makes it current, chunk
+    /// sizes double so that a growing arena needs few of them.
+    void grow(std::size_t size) {
+        size = std::max(size, next_chunk_size_);
+        auto *data = static_cast<std::byte *>(upstream_->allocate(size, cache_line_size));
+        chunks_.push_back({ data, size });
+        capacity_ += size;
+        next_chunk_size_ = 2 * size;
+        current_ = chunks_.size() - 1;
+        offset_ = 0;
+    }
+
+    std::pmr::memory_resource *upstream_;
+    std::vector<Chunk> chunks_;
+    std::size_t current_ = 0;
+    std::size_t offset_ = 0;
+    std::size_t capacity_ = 0;
+    std::size_t next_chunk_size_ = min_chunk_size;
+};
+
+/// Scratch space that algorithms borrow temporaries from.
+class Workspace {
+public:
+    /// Rewinds the workspace to where it was when the scope was opened, so
+    /// nested algorithms can borrow without disturbing their caller.
+    class Scope {
+    public:
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() { arena_.rewind(mark_); }
+
+    private:
+        friend class Workspace;
+
+        explicit Scope(Arena &arena) noexcept
+            : arena_ { arena }
+            , mark_ { arena.mark() } { }
+
+        Arena &arena_;
+        Arena::Mark mark_;
+    };
+
+    explicit Workspace(std::size_t capacity = 0, std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : arena_ { capacity, upstream } { }
+
+    /// @brief Returns `count` cache line aligned elements with unspecified
+    /// values, valid until the enclosing scope closes or the next `reset`.
+    template <typename T>
+    requires(std::is_trivially_default_constructible_v<T> and std::is_trivially_destructible_v<T>)
+    [[nodiscard]] std::span<T> borrow(std::size_t count) {
+        if (count > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        auto *data = static_cast<T *>(arena_.allocate(count * sizeof(T), std::max(cache_line_size, alignof(T))));
+        std::uninitialized_default_construct_n(data, count);
+        return { data, count };
+    }
+
+    [[nodiscard]] Scope scope() noexcept { return Scope { arena_ }; }
+
+    /// @brief Frees everything borrowed, see `Arena::reset`.
+    void reset() { arena_.reset(); }
+
+    /// @brief Memory resource for containers living in the workspace, such as
+    /// `DynMatrix` and `DynVector`.
+    [[nodiscard]] std::pmr::memory_resource *resource() noexcept { return &arena_; }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return arena_.capacity(); }
+
+private:
+    Arena arena_;
+};
+
+/// Memory resource forwarding to `upstream` and counting the calls.
+class CountingResource final : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource()) noexcept
+        : upstream_ { upstream } { }
+
+    [[nodiscard]] std::size_t allocations() const noexcept { return allocations_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t deallocations() const noexcept { return deallocations_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t bytes_allocated() const noexcept { return bytes_.load(std::memory_order_relaxed); }
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(bytes, std::memory_order_relaxed);
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override {
+        deallocations_.fetch_add(1, std::memory_order_relaxed);
+        upstream_->deallocate(pointer, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource *upstream_;
+    std::atomic<std::size_t> allocations_ = 0;
+    std::atomic<std::size_t> deallocations_ = 0;
+    std::atomic<std::size_t> bytes_ = 0;
+};
+
+} // namespace dk::math
+
+#endif // DK_MATH_WORKSPACE_HPP
@@ -0,0 +1,315 @@
+#include <doctest/doctest.h>
+#include <dklib/math/batch_decomposition.hpp>
+#include <dklib/math/decomposition.hpp>
+#include <dklib/math/matrix3d.hpp>
+#include <dklib/math/vector3_soa.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "test_utilities.hpp"
+
+using namespace dk::math;
+
+#define batch_types float, double
+#define TEST_CASE_BATCH(msg) TEST_CASE_TEMPLATE(msg, T, batch_types)
+
+namespace {
+
+/// More than two tiles, the last one partial.
+constexpr std::size_t batch_count = 2 * batch::tile_size + 37;
+
+/// `S * Sᵀ + I` for a sample `S` depending on `seed`.
+template <typename T, std::size_t N>
+Matrix<T, N, N> spd_matrix(std::size_t seed) {
+    Matrix<T, N, N> sample;
+    for (std::size_t i = 0; i < N * N; ++i) {
+        sample[i] = static_cast<T>(static_cast<int>((i * 7 + seed * 3) % 11) - 5) / T(4);
+    }
+    Matrix<T, N, N> result;
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            T sum = i == j ? T(1) : T(0);
+            for (std::size_t p = 0; p < N; ++p) {
+                sum += sample[i, p] * sample[j, p];
+            }
+            result[i, j] = sum;
+        }
+    }
+    return result;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+Matrix<T, R, C> tall_matrix(std::size_t seed) {
+    Matrix<T, R, C> result;
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) {
+            result[i, j] = static_cast<T>(static_cast<int>((i * 5 + j * 7 + seed) % 13) - 6) / T(4) + (i == j ? T(3) : T(0));
+        }
+    }
+    return result;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+bool close(const Matrix<T, R, C> &lhs, const Matrix<T, R, C> &rhs) {
+    for (std::size_t i = 0; i < R * C; ++i) {
+        if (std::abs(lhs[i] - rhs[i]) > tolerance<T> * (1 + std::abs(rhs[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, std::size_t N>
+void check_cholesky() {
+    std::vector<Matrix<T, N, N>> mats;
+    for (std::size_t p = 0; p < batch_count; ++p) {
+        mats.push_back(spd_matrix<T, N>(p));
+    }
+    MatrixSoA<T, N, N> factors(mats);
+    CHECK(batch::cholesky(factors) == 0);
+
+    VectorSoA<T, N> rhs(batch_count);
+    for (std::size_t p = 0; p < batch_count; ++p) {
+        rhs.set(p, Matrix<T, N, 1> { static_cast<T>(p % 5) - T(2) });
+    }
+    const auto expected_rhs = rhs.to_vector();
+    batch::cholesky_solve(factors, rhs);
+
+    for (std::size_t p = 0; p < batch_count; ++p) {
+        const Cholesky<T, N> cholesky(mats[p]);
+        CHECK(close(factors[p], cholesky.factor()));
+        const auto x = cholesky.solve(Matrix<T, N, 1>(expected_rhs[p]));
+        CHECK(close(rhs[p], x));
+    }
+}
+
+template <typename T, std::size_t R, std::size_t C>
+void check_qr() {
+    std::vector<Matrix<T, R, C>> mats;
+    for (std::size_t p = 0; p < batch_count; ++p) {
+        mats.push_back(tall_matrix<T, R, C>(p));
+    }
+    MatrixSoA<T, R, C> factors(mats);
+    VectorSoA<T, C> tau;
+    batch::qr(factors, tau);
+    CHECK(tau.size() == batch_count);
+
+    VectorSoA<T, R> rhs(batch_count);
+    for (std::size_t p = 0; p < batch_count; ++p) {
+        rhs.set(p, Matrix<T, R, 1> { static_cast<T>(p % 3) + T(1) });
+    }
+    batch::qr_solve(factors, tau, rhs);
+
+    for (std::size_t p = 0; p < batch_count; ++p) {
+        const QR<T, R, C> qr(mats[p]);
+        CHECK(close(factors[p], qr.factors()));
+        const auto x = qr.solve(Matrix<T, R, 1> { static_cast<T>(p % 3) + T(1) });
+        for (std::size_t i = 0; i < C; ++i) {
+            CHECK(rhs[p][i] == doctest::Approx(x[i]).epsilon(tolerance<T>));
+        }
+    }
+}
+
+/// `side x side` grid on the surface `z = height(x, y)`, and the
+/// neighborhoods of its points: the up to nine grid points around them.
+template <typename T, typename F>
+void grid_cloud(std::size_t side, F height, Vector3SoA<T> &points, std::vector<std::size_t> &offsets, std::vector<std::size_t> &neighbors) {
+    for (std::size_t i = 0; i < side; ++i) {
+        for (std::size_t j = 0; j < side; ++j) {
+            const T x = static_cast<T>(i) / T(4);
+            const T y = static_cast<T>(j) / T(4);
+            points.push_back({ x, y, height(x, y) });
+        }
+    }
+    offsets.assign(1, 0);
+    neighbors.clear();
+    for (std::size_t i = 0; i < side; ++i) {
+        for (std::size_t j = 0; j < side; ++j) {
+            for (std::size_t ni = i == 0 ? 0 : i - 1; ni <= std::min(i + 1, side - 1); ++ni) {
+                for (std::size_t nj = j == 0 ? 0 : j - 1; nj <= std::min(j + 1, side - 1); ++nj) {
+                    neighbors.push_back(ni * side + nj);
+                }
+            }
+            offsets.push_back(neighbors.size());
+        }
+    }
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Batched decompositions");
+
+TEST_CASE_BATCH("MatrixSoA stores one lane per element") {
+    MatrixSoA<T, 2, 3> mats;
+    CHECK(mats.empty());
+    Matrix<T, 2, 3> mat;
+    for (std::size_t i = 0; i < 6; ++i) {
+        mat[i] = static_cast<T>(i);
+    }
+    mats.push_back(mat);
+    mats.push_back(mat * T(2));
+    CHECK(mats.size() == 2);
+    CHECK(mats.padded_size() == MatrixSoA<T, 2, 3>::lane_width);
+    CHECK(mats[1] == mat * T(2));
+    CHECK(mats.lane(1, 2)[1] == T(10));
+    CHECK(reinterpret_cast<std::uintptr_t>(mats.lane(1, 0)) % cache_line_size == 0);
+
+    mats.resize(3);
+    CHECK(mats[2] == Matrix<T, 2, 3> { T(0) });
+    CHECK_THROWS_AS((void)mats.at(3), std::runtime_error);
+    mats.resize(1);
+    CHECK(mats.lane(0, 1)[1] == T(0));
+
+    const auto matrices = MatrixSoA<T, 2, 3>(mats.to_vector()).to_vector();
+    REQUIRE(matrices.size() == 1);
+    CHECK(matrices[0] == mat);
+}
+
+TEST_CASE_BATCH("Batched Cholesky factorizations") {
+    check_cholesky<T, 3>();
+    check_cholesky<T, 4>();
+    check_cholesky<T, 6>();
+
+    // A failing matrix does not affect the others.
+    std::vector<Matrix<T, 3, 3>> mats(5, spd_matrix<T, 3>(1));
+    mats[2][1, 1] = T(-1);
+    MatrixSoA<T, 3, 3> factors(mats);
+    CHECK(batch::cholesky(factors) == 1);
+    CHECK(std::isnan(factors[2][1, 1]));
+    CHECK(close(factors[3], Cholesky<T, 3>(mats[3]).factor()));
+}
+
+TEST_CASE_BATCH("Batched QR factorizations") {
+    check_qr<T, 3, 3>();
+    check_qr<T, 4, 4>();
+    check_qr<T, 6, 6>();
+    check_qr<T, 6, 4>();
+
+    // Columns that are zero below the diagonal are not reflected.
+    MatrixSoA<T, 3, 3> identity(std::vector<Matrix<T, 3, 3>>(3, Matrix3<T>::identity()));
+    VectorSoA<T, 3> tau;
+    batch::qr(identity, tau);
+    CHECK(identity[1] == Matrix<T, 3, 3>(Matrix3<T>::identity()));
+    CHECK(tau[1] == Matrix<T, 3, 1> { T(0) });
+}
+
+TEST_CASE_BATCH("Batched 3x3 singular value and polar decompositions") {
+    std::vector<Matrix<T, 3, 3>> mats;
+    for (std::size_t p = 0; p < batch_count; ++p) {
+        auto mat = tall_matrix<T, 3, 3>(p);
+        // Every third matrix is a reflection.
+        if (p % 3 == 0) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                mat[1, j] = -mat[1, j];
+            }
+        }
+        mats.push_back(mat);
+    }
+    const MatrixSoA<T, 3, 3> lanes(mats);
+    MatrixSoA<T, 3, 3> u;
+    VectorSoA<T, 3> sigma;
+    MatrixSoA<T, 3, 3> v;
+    batch::svd(lanes, u, sigma, v);
+    MatrixSoA<T, 3, 3> rotation;
+    MatrixSoA<T, 3, 3> stretch;
+    batch::polar(lanes, rotation, stretch);
+    REQUIRE(sigma.size() == batch_count);
+    REQUIRE(stretch.size() == batch_count);
+
+    for (std::size_t p = 0; p < batch_count; ++p) {
+        const SVD3<T> svd(mats[p]);
+        CHECK(close(u[p], svd.u()));
+        CHECK(close(v[p], svd.v()));
+        for (std::size_t i = 0; i < 3; ++i) {
+            CHECK(sigma[p][i] == doctest::Approx(svd.singular_values()[i]).epsilon(tolerance<T>));
+        }
+        const Polar3<T> polar(mats[p]);
+        CHECK(close(rotation[p], polar.rotation()));
+        CHECK(close(stretch[p], polar.stretch()));
+    }
+}
+
+TEST_CASE_BATCH("Batched symmetric 3x3 eigendecompositions") {
+    std::vector<Matrix<T, 3, 3>> mats;
+    for (std::size_t p = 0; p < batch_count; ++p) {
+        auto mat = spd_matrix<T, 3>(p);
+        // Every other matrix is indefinite.
+        if (p % 2 == 0) {
+            mat[1, 1] -= T(8);
+        }
+        mats.push_back(mat);
+    }
+    VectorSoA<T, 3> values;
+    MatrixSoA<T, 3, 3> vectors;
+    batch::symmetric_eigen(MatrixSoA<T, 3, 3>(mats), values, vectors);
+    REQUIRE(values.size() == batch_count);
+
+    for (std::size_t p = 0; p < batch_count; ++p) {
+        const SymmetricEigen3<T> eigen(mats[p]);
+        CHECK(close(vectors[p], eigen.eigenvectors()));
+        for (std::size_t i = 0; i < 3; ++i) {
+            CHECK(values[p][i] == doctest::Approx(eigen.eigenvalues()[i]).epsilon(tolerance<T>));
+        }
+    }
+}
+
+TEST_CASE_BATCH("Fused neighborhood normals") {
+    SUBCASE("plane") {
+        Vector3SoA<T> points;
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> neighbors;
+        Vector3SoA<T> normals;
+        grid_cloud<T>(15, [](T x, T y) { return T(0.5) * x - T(0.25) * y + T(1); }, points, offsets, neighbors);
+        // A point without neighbors still gets a unit normal.
+        points.push_back({ T(0), T(0), T(0) });
+        offsets.push_back(neighbors.size());
+        batch::neighborhood_normals<T>(points, offsets, neighbors, normals);
+        REQUIRE(normals.size() == points.size());
+
+        const T norm = std::sqrt(T(0.25) + T(0.0625) + T(1));
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            const auto normal = normals[p];
+            CHECK(normal.magnitude() == doctest::Approx(1.0).epsilon(tolerance<T>));
+            if (p + 1 < points.size()) {
+                const T alignment = (T(0.5) * normal[0] - T(0.25) * normal[1] - normal[2]) / norm;
+                CHECK(std::abs(alignment) == doctest::Approx(1.0).epsilon(tolerance<T>));
+            }
+        }
+    }
+    SUBCASE("curved surface") {
+        Vector3SoA<T> points;
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> neighbors;
+        Vector3SoA<T> normals;
+        grid_cloud<T>(12, [](T x, T y) { return T(0.2) * x * x - T(0.1) * x * y + T(0.3) * y; }, points, offsets, neighbors);
+        batch::neighborhood_normals<T>(points, offsets, neighbors, normals);
+
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            Vector3<T> mean { T(0) };
+            const std::size_t count = offsets[p + 1] - offsets[p];
+            for (std::size_t k = offsets[p]; k < offsets[p + 1]; ++k) {
+                mean += points[neighbors[k]];
+            }
+            mean /= static_cast<T>(count);
+            Matrix<T, 3, 3> covariance { T(0) };
+            for (std::size_t k = offsets[p]; k < offsets[p + 1]; ++k) {
+                const Vector3<T> d = points[neighbors[k]] - mean;
+                for (std::size_t i = 0; i < 3; ++i) {
+                    for (std::size_t j = 0; j < 3; ++j) {
+                        covariance[i, j] += d[i] * d[j] / static_cast<T>(count);
+                    }
+                }
+            }
+            const auto vectors = SymmetricEigen3<T>(covariance).eigenvectors();
+            const auto normal = normals[p];
+            const T alignment = normal[0] * vectors[0, 0] + normal[1] * vectors[1, 0] + normal[2] * vectors[2, 0];
+            CHECK(std::abs(alignment) == doctest::Approx(1.0).epsilon(tolerance<T>));
+        }
+    }
+}
+
+TEST_SUITE_END();
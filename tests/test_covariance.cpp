@@ -0,0 +1,271 @@
+#include <doctest/doctest.h>
+#include <dklib/math/covariance.hpp>
+#include <dklib/math/vector3d.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "test_utilities.hpp"
+
+using namespace dk::math;
+
+#define covariance_types float, double
+#define TEST_CASE_COVARIANCE(msg) TEST_CASE_TEMPLATE(msg, T, covariance_types)
+
+namespace {
+
+/// Points scattered around `offset`, far from the origin compared to their
+/// spread, where summing squares would cancel catastrophically.
+template <typename T, std::size_t D>
+std::vector<Vector<T, D>> sample_points(std::size_t count, double offset = 1000.0) {
+    std::vector<Vector<T, D>> points(count);
+    for (std::size_t k = 0; k < count; ++k) {
+        for (std::size_t i = 0; i < D; ++i) {
+            const double t = static_cast<double>(k) * (0.37 + 0.11 * static_cast<double>(i));
+            points[k][i] = static_cast<T>(offset + std::sin(t) + 0.5 * static_cast<double>(i) * std::cos(1.7 * t));
+        }
+    }
+    return points;
+}
+
+/// Two pass mean and scatter matrix in double precision.
+template <typename T, std::size_t D>
+void reference(const std::vector<Vector<T, D>> &points, std::array<double, D> &mean, std::array<double, D * D> &scatter) {
+    mean = {};
+    scatter = {};
+    for (const auto &point : points) {
+        for (std::size_t i = 0; i < D; ++i) {
+            mean[i] += static_cast<double>(point[i]);
+        }
+    }
+    for (auto &value : mean) {
+        value /= static_cast<double>(points.size());
+    }
+    for (const auto &point : points) {
+        for (std::size_t i = 0; i < D; ++i) {
+            for (std::size_t j = 0; j < D; ++j) {
+                scatter[i * D + j] += (static_cast<double>(point[i]) - mean[i]) * (static_cast<double>(point[j]) - mean[j]);
+            }
+        }
+    }
+}
+
+/// Compares with the reference, the scatter matrix relative to its largest
+/// element and the mean relative to the spread of the points.
+template <typename T, std::size_t D>
+void check_accumulator(const CovarianceAccumulator<T, D> &accumulator, const std::vector<Vector<T, D>> &points) {
+    std::array<double, D> mean;
+    std::array<double, D * D> scatter;
+    reference(points, mean, scatter);
+    REQUIRE(accumulator.count() == points.size());
+
+    double largest = 0.0;
+    for (const double value : scatter) {
+        largest = std::max(largest, std::abs(value));
+    }
+    const auto result_mean = accumulator.mean();
+    const auto result_scatter = accumulator.scatter();
+    const auto result_covariance = accumulator.covariance();
+    const double spread = std::sqrt(largest / static_cast<double>(points.size()));
+    for (std::size_t i = 0; i < D; ++i) {
+        CHECK(std::abs(static_cast<double>(result_mean[i]) - mean[i]) <= 10 * tolerance<T> * spread);
+        for (std::size_t j = 0; j < D; ++j) {
+            CHECK(std::abs(static_cast<double>(result_scatter[i, j]) - scatter[i * D + j]) <= 10 * tolerance<T> * largest);
+            CHECK(
+                std::abs(static_cast<double>(result_covariance[i, j]) - scatter[i * D + j] / static_cast<double>(points.size()))
+                <= 10 * tolerance<T> * largest / static_cast<double>(points.size())
+            );
+            CHECK(result_scatter[i, j] == result_scatter[j, i]);
+        }
+    }
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("CovarianceAccumulator");
+
+TEST_CASE_COVARIANCE("Accumulators start out empty") {
+    CovarianceAccumulator<T, 3> accumulator;
+    CHECK(accumulator.empty());
+    CHECK(accumulator.count() == 0);
+    CHECK(accumulator.mean()[0] == T(0));
+    CHECK_THROWS_AS((void)accumulator.covariance(), std::runtime_error);
+
+    accumulator.add(Vector<T, 3> { std::array<T, 3> { 1, 2, 3 } });
+    CHECK(accumulator.count() == 1);
+    CHECK(accumulator.mean()[2] == T(3));
+    CHECK(accumulator.covariance()[0, 0] == T(0));
+    CHECK_THROWS_AS((void)accumulator.sample_covariance(), std::runtime_error);
+
+    accumulator.clear();
+    CHECK(accumulator.empty());
+}
+
+TEST_CASE_COVARIANCE("Points are accumulated one at a time and in chunks") {
+    using Accumulator = CovarianceAccumulator<T, 3>;
+    // More than two chunks, the last one partial.
+    const auto points = sample_points<T, 3>(2 * Accumulator::chunk_size + 101);
+
+    Accumulator single;
+    for (const auto &point : points) {
+        single.add(point);
+    }
+    check_accumulator(single, points);
+
+    Accumulator packed;
+    packed.add(points);
+    check_accumulator(packed, points);
+
+    Accumulator two_spans;
+    const std::span<const Vector<T, 3>> all { points };
+    two_spans.add(all.first(17));
+    two_spans.add(all.subspan(17));
+    check_accumulator(two_spans, points);
+
+    const auto sample = packed.sample_covariance();
+    const auto population = packed.covariance();
+    const T ratio = static_cast<T>(points.size()) / static_cast<T>(points.size() - 1);
+    CHECK(std::abs(sample[1, 0] - population[1, 0] * ratio) <= tolerance<T> * std::abs(sample[1, 0]));
+}
+
+TEST_CASE_COVARIANCE("Structure-of-arrays points") {
+    using Accumulator = CovarianceAccumulator<T, 3>;
+    const auto points = sample_points<T, 3>(Accumulator::chunk_size + 45);
+    std::vector<Vector3<T>> packed;
+    for (const auto &point : points) {
+        packed.emplace_back(point[0], point[1], point[2]);
+    }
+
+    Accumulator from_vector3;
+    from_vector3.add(packed);
+    check_accumulator(from_vector3, points);
+
+    const Vector3SoA<T> soa { packed };
+    Accumulator from_soa;
+    from_soa.add(soa);
+    check_accumulator(from_soa, points);
+
+    VectorSoA<T, 3> lanes(points.size());
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        for (std::size_t i = 0; i < 3; ++i) {
+            lanes.lane(i, 0)[k] = points[k][i];
+        }
+    }
+    Accumulator from_vector_soa;
+    from_vector_soa.add(lanes);
+    check_accumulator(from_vector_soa, points);
+
+    Accumulator from_spans;
+    from_spans.add({ std::span<const T> { soa.x(), soa.size() }, std::span<const T> { soa.y(), soa.size() },
+                     std::span<const T> { soa.z(), soa.size() } });
+    check_accumulator(from_spans, points);
+
+    Accumulator mismatch;
+    CHECK_THROWS_AS(
+        mismatch.add({ std::span<const T> { soa.x(), soa.size() }, std::span<const T> { soa.y(), soa.size() - 1 },
+                       std::span<const T> { soa.z(), soa.size() } }),
+        std::runtime_error
+    );
+}
+
+TEST_CASE_COVARIANCE("Other dimensions") {
+    const auto pairs = sample_points<T, 2>(300);
+    CovarianceAccumulator<T, 2> accumulator_2d;
+    accumulator_2d.add(pairs);
+    check_accumulator(accumulator_2d, pairs);
+
+    const auto quadruples = sample_points<T, 4>(CovarianceAccumulator<T, 4>::chunk_size + 3);
+    CovarianceAccumulator<T, 4> accumulator_4d;
+    accumulator_4d.add(quadruples);
+    check_accumulator(accumulator_4d, quadruples);
+}
+
+TEST_CASE_COVARIANCE("Merging shards and threads") {
+    using Accumulator = CovarianceAccumulator<T, 3>;
+    const auto points = sample_points<T, 3>(3 * Accumulator::parallel_block_size + 1234);
+    const std::span<const Vector<T, 3>> all { points };
+
+    Accumulator first;
+    Accumulator second;
+    first.add(all.first(1000));
+    second.add(all.subspan(1000));
+    first.merge(second);
+    check_accumulator(first, points);
+
+    Accumulator empty;
+    first.merge(empty);
+    check_accumulator(first, points);
+    empty.merge(second);
+    CHECK(empty.count() == second.count());
+
+    ThreadPool pool { 4 };
+    Accumulator parallel;
+    parallel.add(execution::on(pool), points);
+    check_accumulator(parallel, points);
+
+    // The partial accumulators are merged in a fixed order.
+    Accumulator again;
+    again.add(execution::on(pool), points);
+    CHECK(again.state().mean == parallel.state().mean);
+    CHECK(again.state().scatter == parallel.state().scatter);
+
+    std::vector<T> x(points.size()), y(points.size()), z(points.size());
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        x[k] = points[k][0];
+        y[k] = points[k][1];
+        z[k] = points[k][2];
+    }
+    Accumulator parallel_lanes;
+    parallel_lanes.add(execution::on(pool), { std::span<const T> { x }, std::span<const T> { y }, std::span<const T> { z } });
+    check_accumulator(parallel_lanes, points);
+}
+
+TEST_CASE_COVARIANCE("Serialized states") {
+    using Accumulator = CovarianceAccumulator<T, 3>;
+    const auto points = sample_points<T, 3>(500);
+    Accumulator accumulator;
+    accumulator.add(points);
+
+    const auto bytes = accumulator.serialize();
+    static_assert(bytes.size() == Accumulator::serialized_size);
+    const auto restored = Accumulator::deserialize(bytes);
+    CHECK(restored.count() == accumulator.count());
+    CHECK(restored.state().mean == accumulator.state().mean);
+    CHECK(restored.state().scatter == accumulator.state().scatter);
+
+    // The count is stored little endian after the dimension and scalar size.
+    CHECK(bytes[0] == std::byte { 3 });
+    CHECK(bytes[4] == std::byte { sizeof(T) });
+    CHECK(bytes[8] == std::byte { 500 % 256 });
+    CHECK(bytes[9] == std::byte { 500 / 256 });
+
+    const std::span<const std::byte> all { bytes };
+    CHECK_THROWS_WITH_AS((void)Accumulator::deserialize(all.first(all.size() - 1)), "invalid serialized size", std::runtime_error);
+    std::vector<std::byte> padded(bytes.begin(), bytes.end());
+    padded.push_back(std::byte {});
+    CHECK_THROWS_WITH_AS((void)Accumulator::deserialize(padded), "invalid serialized size", std::runtime_error);
+    CHECK_THROWS_WITH_AS(
+        (void)(CovarianceAccumulator<T, 2>::deserialize(all.first(CovarianceAccumulator<T, 2>::serialized_size))), "dimension mismatch",
+        std::runtime_error
+    );
+    using Other = std::conditional_t<std::is_same_v<T, float>, double, float>;
+    const auto other = CovarianceAccumulator<Other, 3> {}.serialize();
+    CHECK_THROWS_AS((void)Accumulator::deserialize(other), std::runtime_error);
+
+    Accumulator shards;
+    shards.merge(Accumulator::deserialize(bytes));
+    shards.merge(Accumulator::deserialize(bytes));
+    CHECK(shards.count() == 2 * accumulator.count());
+    const auto mean = shards.mean();
+    const auto expected = accumulator.mean();
+    for (std::size_t i = 0; i < 3; ++i) {
+        CHECK(mean[i] == doctest::Approx(expected[i]));
+        CHECK(shards.scatter()[i, i] == doctest::Approx(2 * accumulator.scatter()[i, i]));
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,757 @@
+#include <doctest/doctest.h>
+#include <dklib/math/decomposition.hpp>
+#include <dklib/math/matrix2d.hpp>
+#include <dklib/math/matrix3d.hpp>
+#include <dklib/math/matrix4d.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "test_utilities.hpp"
+
+using namespace dk::math;
+
+#define decomposition_types float, double
+#define TEST_CASE_DECOMPOSITION(msg) TEST_CASE_TEMPLATE(msg, T, decomposition_types)
+
+namespace {
+
+/// Diagonally dominant, so well conditioned, but with large off-diagonal
+/// entries below the diagonal that make pivoting exchange rows.
+template <typename T>
+DynMatrix<T> sample_matrix(std::size_t n) {
+    DynMatrix<T> mat(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            mat[i, j] = static_cast<T>(static_cast<int>((i * 7 + j * 3) % 11) - 5) / T(8);
+        }
+        mat[i, i] += static_cast<T>(n / 4 + 2);
+    }
+    if (n > 1) {
+        mat[1, 0] = static_cast<T>(n + 5);
+    }
+    return mat;
+}
+
+/// Largest `|mat * x - rhs|` relative to the largest `|rhs|`.
+template <typename T>
+double relative_residual(const DynMatrix<T> &mat, const DynMatrix<T> &x, const DynMatrix<T> &rhs) {
+    double worst = 0.0;
+    double scale = 0.0;
+    for (std::size_t i = 0; i < rhs.rows(); ++i) {
+        for (std::size_t j = 0; j < rhs.cols(); ++j) {
+            double sum = 0.0;
+            for (std::size_t p = 0; p < mat.cols(); ++p) {
+                sum += static_cast<double>(mat[i, p]) * static_cast<double>(x[p, j]);
+            }
+            worst = std::max(worst, std::abs(sum - static_cast<double>(rhs[i, j])));
+            scale = std::max(scale, std::abs(static_cast<double>(rhs[i, j])));
+        }
+    }
+    return worst / scale;
+}
+
+/// `S * Sᵀ + n * I` for a sample `S`, symmetric positive definite.
+template <typename T>
+DynMatrix<T> spd_matrix(std::size_t n) {
+    const auto sample = sample_matrix<T>(n);
+    DynMatrix<T> mat(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            T sum {};
+            for (std::size_t p = 0; p < n; ++p) {
+                sum += sample[i, p] * sample[j, p];
+            }
+            mat[i, j] = sum + (i == j ? static_cast<T>(n) : T(0));
+        }
+    }
+    return mat;
+}
+
+/// `rows x cols` with linearly independent columns.
+template <typename T>
+DynMatrix<T> tall_matrix(std::size_t rows, std::size_t cols) {
+    DynMatrix<T> mat(rows, cols);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            mat[i, j] = static_cast<T>(static_cast<int>((i * 5 + j * 7) % 13) - 6) / T(4) + (i == j ? T(3) : T(0));
+        }
+    }
+    return mat;
+}
+
+/// Largest element of `|matᵀ * (mat * x - rhs)|`, zero for least squares solutions.
+template <typename T>
+double normal_residual(const DynMatrix<T> &mat, const DynMatrix<T> &x, const DynMatrix<T> &rhs) {
+    DynMatrix<double> residual(mat.rows(), rhs.cols());
+    for (std::size_t i = 0; i < mat.rows(); ++i) {
+        for (std::size_t j = 0; j < rhs.cols(); ++j) {
+            double sum = -static_cast<double>(rhs[i, j]);
+            for (std::size_t p = 0; p < mat.cols(); ++p) {
+                sum += static_cast<double>(mat[i, p]) * static_cast<double>(x[p, j]);
+            }
+            residual[i, j] = sum;
+        }
+    }
+    double worst = 0.0;
+    for (std::size_t p = 0; p < mat.cols(); ++p) {
+        for (std::size_t j = 0; j < rhs.cols(); ++j) {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < mat.rows(); ++i) {
+                sum += static_cast<double>(mat[i, p]) * residual[i, j];
+            }
+            worst = std::max(worst, std::abs(sum));
+        }
+    }
+    return worst;
+}
+
+/// Rotation about the axis `(1, 2, 2) / 3` by `angle` followed by the
+/// translation `(3, -2, 5)`.
+template <typename T>
+Matrix4<T> rigid_transform(T angle) {
+    const T x = T(1) / T(3), y = T(2) / T(3), z = T(2) / T(3);
+    const T c = std::cos(angle), s = std::sin(angle), t = T(1) - c;
+    return {
+        { t * x * x + c, t * x * y - s * z, t * x * z + s * y, T(3) },
+        { t * x * y + s * z, t * y * y + c, t * y * z - s * x, T(-2) },
+        { t * x * z - s * y, t * y * z + s * x, t * z * z + c, T(5) },
+        { T(0), T(0), T(0), T(1) },
+    };
+}
+
+template <typename T>
+bool is_identity(const Matrix<T, 4, 4> &mat) {
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            if (std::abs(mat[i, j] - (i == j ? T(1) : T(0))) > tolerance<T>) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool is_rotation(const Matrix<T, 3, 3> &mat) {
+    const auto gram = mat.transpose() * mat;
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            if (std::abs(gram[i, j] - (i == j ? T(1) : T(0))) > tolerance<T>) {
+                return false;
+            }
+        }
+    }
+    return std::abs(mat.determinant() - 1.0) < tolerance<T>;
+}
+
+/// Checks both decompositions of `mat` against their definitions.
+template <typename T>
+void check_svd3(const Matrix<T, 3, 3> &mat) {
+    const SVD3<T> svd(mat);
+    const auto &sigma = svd.singular_values();
+    CHECK(is_rotation(svd.u()));
+    CHECK(is_rotation(svd.v()));
+    CHECK(sigma[0] >= sigma[1] * (T(1) - T(tolerance<T>)));
+    CHECK(sigma[1] >= std::abs(sigma[2]) * (T(1) - T(tolerance<T>)));
+    const double scale = 1.0 + sigma[0];
+    CHECK(std::abs(sigma[0] * sigma[1] * sigma[2] - mat.determinant()) < tolerance<T> * scale * scale * scale);
+
+    Matrix<T, 3, 3> scaled = svd.u();
+    for (std::size_t i = 0; i < 9; ++i) {
+        scaled[i] *= sigma[i % 3];
+    }
+    const auto product = scaled * svd.v().transpose();
+    for (std::size_t i = 0; i < 9; ++i) {
+        CHECK(std::abs(product[i] - mat[i]) < tolerance<T> * scale);
+    }
+
+    const Polar3<T> polar(mat);
+    CHECK(is_rotation(polar.rotation()));
+    const auto &stretch = polar.stretch();
+    CHECK(stretch == stretch.transpose());
+    const auto recomposed = polar.rotation() * stretch;
+    for (std::size_t i = 0; i < 9; ++i) {
+        CHECK(std::abs(recomposed[i] - mat[i]) < tolerance<T> * scale);
+    }
+}
+
+/// Checks the eigendecomposition of the symmetric `mat` against its definition.
+template <typename T>
+void check_eigen3(const Matrix<T, 3, 3> &mat) {
+    const SymmetricEigen3<T> eigen(mat);
+    const auto &values = eigen.eigenvalues();
+    const auto &vectors = eigen.eigenvectors();
+    CHECK(is_rotation(vectors));
+    CHECK(values[0] <= values[1]);
+    CHECK(values[1] <= values[2]);
+
+    const double scale = 1.0 + std::max(std::abs(values[0]), std::abs(values[2]));
+    Matrix<T, 3, 3> scaled = vectors;
+    for (std::size_t i = 0; i < 9; ++i) {
+        scaled[i] *= values[i % 3];
+    }
+    const auto product = scaled * vectors.transpose();
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            CHECK(std::abs(product[i, j] - mat[i, j]) < tolerance<T> * scale);
+        }
+    }
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Decomposition");
+
+TEST_CASE("Closed form determinants") {
+    const Matrix2<int> mat2 { { 3, 8 }, { 4, 6 } };
+    CHECK(determinant(mat2) == -14.0);
+
+    const Matrix3<int> mat3 { { 6, 1, 1 }, { 4, -2, 5 }, { 2, 8, 7 } };
+    CHECK(determinant(mat3) == -306.0);
+
+    const Matrix4<double> mat4 {
+        { 1, 0, 2, -1 },
+        { 3, 0, 0, 5 },
+        { 2, 1, 4, -3 },
+        { 1, 0, 5, 0 },
+    };
+    CHECK(mat4.determinant() == doctest::Approx(30.0));
+
+    static constexpr Matrix<int, 3, 3> constant { Matrix<int, 3, 3>::storage_type_2d { { { 2, 0, 1 }, { 1, 3, 2 }, { 1, 1, 2 } } } };
+    static_assert(constant.determinant() == 6.0);
+}
+
+TEST_CASE("Determinants through the factorization") {
+    const auto dynamic = DynMatrix<double>::diagonal(DynVector<double> { 2, -1, 4, 0.5, 3 });
+    CHECK(dynamic.determinant() == doctest::Approx(-12.0));
+
+    // Upper triangular after exchanging the first two rows.
+    Matrix<int, 6, 6> mat { 0 };
+    for (std::size_t i = 0; i < 6; ++i) {
+        for (std::size_t j = i; j < 6; ++j) {
+            mat[i, j] = static_cast<int>(i + j + 1);
+        }
+    }
+    const auto swapped = [&] {
+        auto result = mat;
+        for (std::size_t j = 0; j < 6; ++j) {
+            std::swap(result[0, j], result[1, j]);
+        }
+        return result;
+    }();
+    // 1 * 3 * 5 * 7 * 9 * 11
+    CHECK(mat.determinant() == doctest::Approx(10395.0));
+    CHECK(swapped.determinant() == doctest::Approx(-10395.0));
+
+    constexpr double det = LU<double, 5>(Matrix<double, 5, 5> { 2.0 }).determinant();
+    static_assert(det == 0.0);
+}
+
+TEST_CASE_DECOMPOSITION("Fixed size factorizations are reused for many right-hand sides") {
+    const auto dynamic = sample_matrix<T>(7);
+    Matrix<T, 7, 7> mat;
+    std::copy(dynamic.data(), dynamic.data() + 49, mat.data());
+
+    const LU<T, 7> lu(mat);
+    CHECK_FALSE(lu.is_singular());
+    CHECK(lu.determinant() == doctest::Approx(mat.determinant()).epsilon(tolerance<T>));
+    // The large entry below the first pivot was moved up.
+    CHECK(lu.pivots()[0] == 1);
+
+    Matrix<T, 7, 3> rhs;
+    for (std::size_t i = 0; i < rhs.size(); ++i) {
+        rhs[i] = static_cast<T>(static_cast<int>(i % 5) - 2);
+    }
+    const auto x = lu.solve(rhs);
+    DynMatrix<T> dynamic_x(x), dynamic_rhs(rhs);
+    CHECK(relative_residual(dynamic, dynamic_x, dynamic_rhs) < tolerance<T>);
+
+    Vector<T, 7> column;
+    for (std::size_t i = 0; i < 7; ++i) {
+        column[i] = rhs[i, 1];
+    }
+    const auto y = lu.solve(column);
+    for (std::size_t i = 0; i < 7; ++i) {
+        CHECK(y[i] == doctest::Approx(x[i, 1]).epsilon(tolerance<T>));
+    }
+
+    const auto product = mat * lu.inverse();
+    for (std::size_t i = 0; i < 7; ++i) {
+        for (std::size_t j = 0; j < 7; ++j) {
+            CHECK(std::abs(product[i, j] - (i == j ? T(1) : T(0))) < tolerance<T>);
+        }
+    }
+}
+
+TEST_CASE_DECOMPOSITION("Closed form inverses and solutions") {
+    const Matrix<T, 2, 2> mat2 { typename Matrix<T, 2, 2>::storage_type_2d { { { 4, 7 }, { 2, 6 } } } };
+    const auto inv2 = inverse(mat2);
+    CHECK(inv2[0, 0] == doctest::Approx(0.6));
+    CHECK(inv2[0, 1] == doctest::Approx(-0.7));
+    CHECK(inv2[1, 0] == doctest::Approx(-0.2));
+    CHECK(inv2[1, 1] == doctest::Approx(0.4));
+
+    const Matrix<T, 3, 3> mat3 { typename Matrix<T, 3, 3>::storage_type_2d { { { 2, -1, 0 }, { -1, 2, -1 }, { 0, -1, 2 } } } };
+    const auto inv3 = inverse(mat3);
+    const auto via_lu = LU<T, 3>(mat3).inverse();
+    for (std::size_t i = 0; i < 9; ++i) {
+        CHECK(inv3[i] == doctest::Approx(via_lu[i]).epsilon(tolerance<T>));
+    }
+    CHECK(inv3[0, 0] == doctest::Approx(0.75));
+    CHECK(inv3[1, 1] == doctest::Approx(1.0));
+
+    const auto x = solve(mat3, Vector<T, 3> { { 1, 0, 1 } });
+    CHECK(x[0] == doctest::Approx(1.0));
+    CHECK(x[1] == doctest::Approx(1.0));
+    CHECK(x[2] == doctest::Approx(1.0));
+
+    // Integer matrices are solved in double precision.
+    const Matrix<int, 2, 2> integer { Matrix<int, 2, 2>::storage_type_2d { { { 1, 2 }, { 3, 4 } } } };
+    const Matrix<double, 2, 2> inv_integer = inverse(integer);
+    CHECK(inv_integer[0, 0] == doctest::Approx(-2.0));
+    CHECK(inv_integer[1, 0] == doctest::Approx(1.5));
+}
+
+TEST_CASE_DECOMPOSITION("Singular matrices") {
+    const Matrix<T, 3, 3> mat3 { typename Matrix<T, 3, 3>::storage_type_2d { { { 1, 2, 3 }, { 2, 4, 6 }, { 1, 0, 1 } } } };
+    CHECK(mat3.determinant() == 0.0);
+    CHECK_THROWS_AS((void)inverse(mat3), std::runtime_error);
+
+    Matrix<T, 5, 5> mat5 { T(1) };
+    const LU<T, 5> lu(mat5);
+    CHECK(lu.is_singular());
+    CHECK(lu.determinant() == T(0));
+    CHECK_THROWS_AS((void)lu.solve(Vector<T, 5> { T(1) }), std::runtime_error);
+
+    const DynLU<T> dynamic(DynMatrix<T>(4, 4, T(2)));
+    CHECK(dynamic.is_singular());
+    CHECK_THROWS_AS((void)dynamic.inverse(), std::runtime_error);
+}
+
+TEST_CASE_DECOMPOSITION("Dynamic factorizations, unblocked and blocked") {
+    for (std::size_t n : { std::size_t { 1 }, std::size_t { 10 }, std::size_t { 95 }, std::size_t { 150 } }) {
+        const auto mat = sample_matrix<T>(n);
+        const DynLU<T> lu(mat);
+        CHECK(lu.size() == n);
+        CHECK_FALSE(lu.is_singular());
+
+        DynMatrix<T> rhs(n, 4);
+        for (std::size_t i = 0; i < rhs.size(); ++i) {
+            rhs[i] = static_cast<T>(static_cast<int>(i % 9) - 4);
+        }
+        CHECK(relative_residual(mat, lu.solve(rhs), rhs) < tolerance<T>);
+
+        // The blocked and unblocked factorizations agree.
+        DynMatrix<T> unblocked = mat;
+        std::vector<std::size_t> pivots(n);
+        const int sign = lu::factor(unblocked.data(), n, n, pivots.data(), n);
+        CHECK(sign != 0);
+        CHECK(pivots == lu.pivots());
+        T difference {};
+        for (std::size_t i = 0; i < unblocked.size(); ++i) {
+            difference = std::max(difference, std::abs(unblocked[i] - lu.factors()[i]));
+        }
+        CHECK(difference < tolerance<T> * static_cast<double>(n));
+    }
+
+    // A zero panel width factors one column per panel.
+    {
+        const auto sample = sample_matrix<T>(10);
+        DynMatrix<T> single = sample;
+        DynMatrix<T> zero = sample;
+        std::vector<std::size_t> single_pivots(10);
+        std::vector<std::size_t> zero_pivots(10);
+        CHECK(lu::factor(single.data(), 10, 10, single_pivots.data(), 1) == lu::factor(zero.data(), 10, 10, zero_pivots.data(), 0));
+        CHECK(single_pivots == zero_pivots);
+        CHECK(single == zero);
+    }
+
+    // Constant evaluation ignores the panel width.
+    static constexpr auto blocked_determinant = [] {
+        T a[9] { 4, 2, 2, 2, 3, 1, 2, 1, 3 };
+        std::size_t pivots[3] {};
+        const int sign = lu::factor(a, 3, 3, pivots, 1);
+        return lu::determinant(a, 3, 3, sign);
+    }();
+    static_assert(blocked_determinant == T(16));
+
+    const auto mat = sample_matrix<T>(20);
+    const auto product = mat * inverse(mat);
+    CHECK(relative_residual(mat, inverse(mat), DynMatrix<T>::identity(20)) < tolerance<T>);
+    CHECK(product.rows() == 20);
+
+    DynVector<T> rhs(20, T(1));
+    const auto x = solve(mat, rhs);
+    CHECK(relative_residual(mat, DynMatrix<T>(MatrixView<const T>(x.data(), { 20, 1 })), DynMatrix<T>(20, 1, T(1))) < tolerance<T>);
+
+    CHECK_THROWS_AS(DynLU<T>(DynMatrix<T>(3, 4)), std::runtime_error);
+    CHECK_THROWS_AS((void)DynMatrix<T>(3, 4).determinant(), std::runtime_error);
+    CHECK_THROWS_AS((void)DynLU<T>(mat).solve(DynVector<T>(3)), std::runtime_error);
+}
+
+TEST_CASE_DECOMPOSITION("Cholesky factorizations") {
+    const auto dynamic = spd_matrix<T>(6);
+    Matrix<T, 6, 6> mat;
+    std::copy(dynamic.data(), dynamic.data() + 36, mat.data());
+
+    const Cholesky<T, 6> cholesky(mat);
+    REQUIRE(cholesky.is_positive_definite());
+    const auto &l = cholesky.factor();
+    CHECK(l[0, 5] == T(0));
+    const auto product = l * l.transpose();
+    for (std::size_t i = 0; i < 36; ++i) {
+        CHECK(product[i] == doctest::Approx(mat[i]).epsilon(tolerance<T>));
+    }
+    CHECK(cholesky.determinant() == doctest::Approx(LU<T, 6>(mat).determinant()).epsilon(tolerance<T>));
+
+    Matrix<T, 6, 2> rhs;
+    for (std::size_t i = 0; i < rhs.size(); ++i) {
+        rhs[i] = static_cast<T>(static_cast<int>(i % 5) - 2);
+    }
+    CHECK(relative_residual(dynamic, DynMatrix<T>(cholesky.solve(rhs)), DynMatrix<T>(rhs)) < tolerance<T>);
+    const auto inv = cholesky.inverse();
+    CHECK(relative_residual(dynamic, DynMatrix<T>(inv), DynMatrix<T>::identity(6)) < tolerance<T>);
+
+    // Only the lower triangle is read.
+    auto lower = mat;
+    lower[0, 3] = T(100);
+    CHECK(Cholesky<T, 6>(lower).factor() == l);
+
+    const Matrix<T, 2, 2> indefinite { typename Matrix<T, 2, 2>::storage_type_2d { { { 1, 2 }, { 2, 1 } } } };
+    const Cholesky<T, 2> failed(indefinite);
+    CHECK_FALSE(failed.is_positive_definite());
+    CHECK(failed.determinant() == T(0));
+    CHECK_THROWS_AS((void)failed.solve(Vector<T, 2> { T(1) }), std::runtime_error);
+
+    static constexpr Matrix<double, 2, 2> constant { Matrix<double, 2, 2>::storage_type_2d { { { 4, 2 }, { 2, 5 } } } };
+    // Runtime checks: constant evaluation would need a constexpr `std::sqrt`,
+    // which only some standard libraries provide.
+    CHECK(Cholesky<double, 2>(constant).factor()[1, 1] == 2.0);
+    CHECK(Cholesky<double, 2>(constant).determinant() == 16.0);
+}
+
+TEST_CASE_DECOMPOSITION("Dynamic Cholesky factorizations, unblocked and blocked") {
+    for (std::size_t n : { std::size_t { 1 }, std::size_t { 10 }, std::size_t { 95 }, std::size_t { 150 } }) {
+        const auto mat = spd_matrix<T>(n);
+        const DynCholesky<T> cholesky(mat);
+        CHECK(cholesky.size() == n);
+        REQUIRE(cholesky.is_positive_definite());
+
+        DynMatrix<T> rhs(n, 3);
+        for (std::size_t i = 0; i < rhs.size(); ++i) {
+            rhs[i] = static_cast<T>(static_cast<int>(i % 9) - 4);
+        }
+        CHECK(relative_residual(mat, cholesky.solve(rhs), rhs) < tolerance<T>);
+
+        DynMatrix<T> unblocked = mat;
+        CHECK(cholesky::factor(unblocked.data(), n, n, n));
+        T difference {};
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                difference = std::max(difference, std::abs(unblocked[i, j] - cholesky.factor()[i, j]));
+            }
+        }
+        CHECK(difference < tolerance<T> * static_cast<double>(n));
+    }
+
+    // A zero panel width factors one column per panel.
+    {
+        const auto sample = spd_matrix<T>(10);
+        DynMatrix<T> single = sample;
+        DynMatrix<T> zero = sample;
+        CHECK(cholesky::factor(single.data(), 10, 10, 1));
+        CHECK(cholesky::factor(zero.data(), 10, 10, 0));
+        CHECK(single == zero);
+    }
+
+#if __cpp_lib_constexpr_cmath >= 202306L
+    // Constant evaluation ignores the panel width.
+    static constexpr auto blocked_factor = [] {
+        std::array<T, 9> a { 4, 2, 2, 2, 5, 3, 2, 3, 6 };
+        cholesky::factor(a.data(), 3, 3, 1);
+        return a;
+    }();
+    static_assert(blocked_factor[4] == T(2) and blocked_factor[7] == T(1) and blocked_factor[8] == T(2));
+#endif
+
+    CHECK_THROWS_AS(DynCholesky<T>(DynMatrix<T>(3, 4)), std::runtime_error);
+    const DynCholesky<T> singular(DynMatrix<T>(3, 3, T(1)));
+    CHECK_FALSE(singular.is_positive_definite());
+    CHECK_THROWS_AS((void)singular.solve(DynVector<T>(3)), std::runtime_error);
+}
+
+TEST_CASE_DECOMPOSITION("QR factorizations") {
+    const auto dynamic = tall_matrix<T>(7, 4);
+    Matrix<T, 7, 4> mat;
+    std::copy(dynamic.data(), dynamic.data() + 28, mat.data());
+
+    const QR<T, 7, 4> qr(mat);
+    REQUIRE_FALSE(qr.is_rank_deficient());
+    const auto q = qr.q();
+    const auto r = qr.r();
+    CHECK(r[3, 0] == T(0));
+    const auto product = q * r;
+    for (std::size_t i = 0; i < 28; ++i) {
+        CHECK(product[i] == doctest::Approx(mat[i]).epsilon(tolerance<T>));
+    }
+    const auto gram = q.transpose() * q;
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            CHECK(std::abs(gram[i, j] - (i == j ? T(1) : T(0))) < tolerance<T>);
+        }
+    }
+
+    Matrix<T, 7, 2> rhs;
+    for (std::size_t i = 0; i < rhs.size(); ++i) {
+        rhs[i] = static_cast<T>(static_cast<int>(i % 5) - 2);
+    }
+    const auto x = qr.solve(rhs);
+    CHECK(normal_residual(dynamic, DynMatrix<T>(x), DynMatrix<T>(rhs)) < tolerance<T> * 10);
+    Vector<T, 7> column;
+    for (std::size_t i = 0; i < 7; ++i) {
+        column[i] = rhs[i, 1];
+    }
+    const auto y = qr.solve(column);
+    for (std::size_t i = 0; i < 4; ++i) {
+        CHECK(y[i] == doctest::Approx(x[i, 1]).epsilon(tolerance<T>));
+    }
+
+    // Square systems have the exact solution.
+    const auto square = sample_matrix<T>(5);
+    Matrix<T, 5, 5> mat5;
+    std::copy(square.data(), square.data() + 25, mat5.data());
+    const auto exact = QR<T, 5, 5>(mat5).solve(Vector<T, 5> { T(1) });
+    const auto via_lu = LU<T, 5>(mat5).solve(Vector<T, 5> { T(1) });
+    for (std::size_t i = 0; i < 5; ++i) {
+        CHECK(exact[i] == doctest::Approx(via_lu[i]).epsilon(tolerance<T>));
+    }
+
+    const QR<T, 3, 2> zero_column(Matrix<T, 3, 2> { T(0) });
+    CHECK(zero_column.is_rank_deficient());
+    CHECK_THROWS_AS((void)zero_column.solve(Vector<T, 3> { T(1) }), std::runtime_error);
+
+    static constexpr Matrix<double, 2, 1> constant { Matrix<double, 2, 1>::storage_type_2d { { { 3 }, { 4 } } } };
+    CHECK(QR<double, 2, 1>(constant).r()[0, 0] == -5.0);
+}
+
+TEST_CASE_DECOMPOSITION("Dynamic QR factorizations, unblocked and blocked") {
+    for (const auto &[rows, cols] : { std::pair { 1, 1 }, std::pair { 12, 9 }, std::pair { 90, 63 }, std::pair { 160, 100 }, std::pair { 100, 100 } }) {
+        const auto mat = tall_matrix<T>(rows, cols);
+        const DynQR<T> qr(mat);
+        CHECK(qr.rows() == static_cast<std::size_t>(rows));
+        CHECK(qr.cols() == static_cast<std::size_t>(cols));
+        REQUIRE_FALSE(qr.is_rank_deficient());
+
+        DynMatrix<T> rhs(rows, 3);
+        for (std::size_t i = 0; i < rhs.size(); ++i) {
+            rhs[i] = static_cast<T>(static_cast<int>(i % 9) - 4);
+        }
+        CHECK(normal_residual(mat, qr.solve(rhs), rhs) < tolerance<T> * rows * rows);
+
+        DynMatrix<T> unblocked = mat;
+        std::vector<T> tau(cols), work(cols);
+        qr::factor(unblocked.data(), rows, cols, cols, tau.data(), work.data(), cols);
+        T difference {};
+        for (std::size_t i = 0; i < unblocked.size(); ++i) {
+            difference = std::max(difference, std::abs(unblocked[i] - qr.factors()[i]));
+        }
+        CHECK(difference < tolerance<T> * rows);
+
+        const auto q = qr.q();
+        const auto product = q * qr.r();
+        CHECK(relative_residual(DynMatrix<T>::identity(rows), product, mat) < tolerance<T> * rows);
+    }
+
+    // A zero panel width factors one column per panel.
+    {
+        const auto sample = tall_matrix<T>(12, 9);
+        DynMatrix<T> single = sample;
+        DynMatrix<T> zero = sample;
+        std::vector<T> single_tau(9), zero_tau(9), work(9);
+        qr::factor(single.data(), 12, 9, 9, single_tau.data(), work.data(), 1);
+        qr::factor(zero.data(), 12, 9, 9, zero_tau.data(), work.data(), 0);
+        CHECK(single == zero);
+        CHECK(single_tau == zero_tau);
+    }
+
+#if __cpp_lib_constexpr_cmath >= 202306L
+    // Constant evaluation ignores the panel width.
+    static constexpr auto blocked_norm = [] {
+        std::array<T, 4> a { 3, 1, 4, 2 };
+        std::array<T, 2> tau {}, work {};
+        qr::factor(a.data(), 2, 2, 2, tau.data(), work.data(), 1);
+        return a[0];
+    }();
+    static_assert(blocked_norm == T(-5));
+#endif
+
+    CHECK_THROWS_AS(DynQR<T>(DynMatrix<T>(3, 4)), std::runtime_error);
+    CHECK_THROWS_AS((void)DynQR<T>(tall_matrix<T>(5, 3)).solve(DynVector<T>(3)), std::runtime_error);
+}
+
+TEST_CASE_DECOMPOSITION("3x3 singular value and polar decompositions") {
+    const Matrix<T, 3, 3> general = Matrix3<T> {
+        { T(2), T(-1), T(0.5) },
+        { T(0.3), T(1.5), T(-2) },
+        { T(-1), T(0.25), T(1) },
+    };
+    check_svd3(general);
+
+    SUBCASE("reflection") {
+        auto reflected = general;
+        for (std::size_t j = 0; j < 3; ++j) {
+            reflected[1, j] = -reflected[1, j];
+        }
+        REQUIRE(reflected.determinant() < 0.0);
+        check_svd3(reflected);
+        CHECK(SVD3<T>(reflected).singular_values()[2] < T(0));
+    }
+    SUBCASE("rotation") {
+        const auto rotation = rigid_transform(T(0.9));
+        Matrix<T, 3, 3> mat;
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                mat[i, j] = rotation[i, j];
+            }
+        }
+        check_svd3(mat);
+        const Polar3<T> polar(mat);
+        for (std::size_t i = 0; i < 9; ++i) {
+            CHECK(polar.rotation()[i] == doctest::Approx(mat[i]).epsilon(tolerance<T>));
+            CHECK(std::abs(polar.stretch()[i] - (i % 4 == 0 ? T(1) : T(0))) < tolerance<T>);
+        }
+    }
+    SUBCASE("rank deficient") {
+        auto flat = general;
+        for (std::size_t j = 0; j < 3; ++j) {
+            flat[2, j] = flat[0, j] - T(2) * flat[1, j];
+        }
+        check_svd3(flat);
+        CHECK(std::abs(SVD3<T>(flat).singular_values()[2]) < tolerance<T>);
+    }
+    SUBCASE("repeated singular values") {
+        check_svd3(Matrix<T, 3, 3>(Matrix3<T>::diagonal({ T(2), T(-2), T(2) })));
+        check_svd3(Matrix<T, 3, 3> { T(0) });
+    }
+
+    static constexpr auto diagonal = Matrix<double, 3, 3>(Matrix3<double>::diagonal({ 1.0, 3.0, 2.0 }));
+    CHECK(SVD3<double>(diagonal).singular_values()[0] == 3.0);
+    CHECK(SVD3<double>(diagonal).singular_values()[2] == 1.0);
+    CHECK(Polar3<double>(diagonal).stretch()[1, 1] == 3.0);
+}
+
+TEST_CASE_DECOMPOSITION("Symmetric 3x3 eigendecompositions") {
+    const Matrix<T, 3, 3> indefinite = Matrix3<T> {
+        { T(2), T(-1), T(0.5) },
+        { T(-1), T(-3), T(1.25) },
+        { T(0.5), T(1.25), T(1) },
+    };
+    check_eigen3(indefinite);
+    CHECK(SymmetricEigen3<T>(indefinite).eigenvalues()[0] < T(0));
+
+    SUBCASE("only the lower triangle is read") {
+        auto lower = indefinite;
+        lower[0, 1] = T(100);
+        lower[0, 2] = T(-7);
+        lower[1, 2] = T(0);
+        const SymmetricEigen3<T> eigen(lower);
+        const SymmetricEigen3<T> expected(indefinite);
+        CHECK(eigen.eigenvalues() == expected.eigenvalues());
+        CHECK(eigen.eigenvectors() == expected.eigenvectors());
+    }
+    SUBCASE("plane covariance") {
+        // Points spread in the plane with normal `(1, 2, 2) / 3` have it as
+        // the eigenvector of the zero eigenvalue.
+        const std::array<T, 3> u { T(2) / T(3), T(-2) / T(3), T(1) / T(3) };
+        const std::array<T, 3> w { T(2) / T(3), T(1) / T(3), T(-2) / T(3) };
+        Matrix<T, 3, 3> covariance { T(0) };
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                covariance[i, j] = T(4) * u[i] * u[j] + w[i] * w[j];
+            }
+        }
+        check_eigen3(covariance);
+        const SymmetricEigen3<T> eigen(covariance);
+        CHECK(std::abs(eigen.eigenvalues()[0]) < tolerance<T>);
+        const auto &vectors = eigen.eigenvectors();
+        const T alignment = (vectors[0, 0] + T(2) * vectors[1, 0] + T(2) * vectors[2, 0]) / T(3);
+        CHECK(std::abs(alignment) == doctest::Approx(1.0).epsilon(tolerance<T>));
+    }
+    SUBCASE("repeated eigenvalues") {
+        check_eigen3(Matrix<T, 3, 3>(Matrix3<T>::diagonal({ T(2), T(-1), T(2) })));
+        check_eigen3(Matrix<T, 3, 3> { T(1) });
+        check_eigen3(Matrix<T, 3, 3> { T(0) });
+    }
+
+    static constexpr auto diagonal = Matrix<double, 3, 3>(Matrix3<double>::diagonal({ 1.0, -3.0, 2.0 }));
+    CHECK(SymmetricEigen3<double>(diagonal).eigenvalues()[0] == -3.0);
+    CHECK(SymmetricEigen3<double>(diagonal).eigenvalues()[2] == 2.0);
+    CHECK(SymmetricEigen3<double>(diagonal).eigenvectors()[1, 0] == 1.0);
+}
+
+TEST_CASE_DECOMPOSITION("Matrix4 inverses") {
+    const Matrix4<T> mat {
+        { T(1), T(0), T(2), T(-1) },
+        { T(3), T(0), T(0), T(5) },
+        { T(2), T(1), T(4), T(-3) },
+        { T(1), T(0), T(5), T(0) },
+    };
+    const auto inv = mat.inverse();
+    CHECK(is_identity<T>(mat * inv));
+    CHECK(is_identity<T>(inv * mat));
+    const auto via_lu = LU<T, 4>(mat).inverse();
+    for (std::size_t i = 0; i < 16; ++i) {
+        CHECK(inv[i] == doctest::Approx(via_lu[i]).epsilon(tolerance<T>));
+    }
+    const Matrix<T, 4, 4> free_inverse = inverse(mat);
+    CHECK(free_inverse == static_cast<const Matrix<T, 4, 4> &>(inv));
+
+    SUBCASE("affine") {
+        auto affine = rigid_transform(T(0.7));
+        for (std::size_t j = 0; j < 3; ++j) {
+            affine[0, j] *= T(2);
+            affine[2, j] *= T(-0.5);
+        }
+        affine[1, 0] += T(0.3);
+        const auto result = affine.inverse_affine();
+        CHECK(is_identity<T>(affine * result));
+        for (std::size_t i = 0; i < 16; ++i) {
+            CHECK(result[i] == doctest::Approx(affine.inverse()[i]).epsilon(tolerance<T>));
+        }
+    }
+    SUBCASE("rigid") {
+        const auto rigid = rigid_transform(T(-1.2));
+        const auto result = rigid.inverse_rigid();
+        CHECK(is_identity<T>(rigid * result));
+        for (std::size_t i = 0; i < 16; ++i) {
+            CHECK(result[i] == doctest::Approx(rigid.inverse_affine()[i]).epsilon(tolerance<T>));
+        }
+    }
+    SUBCASE("singular") {
+        auto singular = mat;
+        for (std::size_t j = 0; j < 4; ++j) {
+            singular[2, j] = singular[0, j] + singular[1, j];
+        }
+        CHECK_THROWS_AS((void)singular.inverse(), std::runtime_error);
+        CHECK_THROWS_AS((void)inverse(singular), std::runtime_error);
+
+        auto flat = rigid_transform(T(0.4));
+        for (std::size_t j = 0; j < 3; ++j) {
+            flat[2, j] = T(0);
+        }
+        CHECK_THROWS_AS((void)flat.inverse_affine(), std::runtime_error);
+    }
+
+    static constexpr Matrix4<double> scale = Matrix4<double>::diagonal({ 2.0, 4.0, 0.5, 1.0 });
+    static_assert(scale.inverse()[1, 1] == 0.25);
+    static_assert(scale.inverse_affine()[2, 2] == 2.0);
+    static_assert(Matrix4<double>::identity().inverse_rigid() == Matrix4<double>::identity());
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,140 @@
+#include <doctest/doctest.h>
+#include <dklib/math/batch.hpp>
+#include <dklib/math/dispatch.hpp>
+
+#include <array>
+#include <span>
+#include <vector>
+
+using namespace dk::math;
+
+namespace {
+
+std::vector<Vector3D> sample_vectors(std::size_t count) {
+    std::vector<Vector3D> vectors;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<float>(i);
+        vectors.emplace_back(0.5f + v, 1.0f - 0.25f * v, 2.0f + 0.125f * v);
+    }
+    return vectors;
+}
+
+std::vector<dispatch::Isa> supported_isas() {
+    std::vector<dispatch::Isa> isas;
+    for (auto isa : { dispatch::Isa::scalar, dispatch::Isa::sse42, dispatch::Isa::avx2, dispatch::Isa::avx512 }) {
+        if (isa <= dispatch::detect_isa()) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Dispatch");
+
+TEST_CASE("Selected instruction set is supported and readable") {
+    CHECK(dispatch::active_isa() <= dispatch::detect_isa());
+    CHECK(not dispatch::to_string(dispatch::active_isa()).empty());
+    CHECK(dispatch::kernels().isa == dispatch::active_isa());
+}
+
+TEST_CASE("Every kernel variant multiplies matrices") {
+    constexpr std::size_t m = 5, n = 7, k = 3;
+    std::array<float, m * k> a;
+    std::array<float, k * n> b;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<float>(i) - 4.0f;
+    }
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        b[i] = 0.5f * static_cast<float>(i);
+    }
+    for (auto isa : supported_isas()) {
+        std::array<float, m * n> c;
+        c.fill(42.0f);
+        dispatch::kernels_for(isa).gemm(m, n, k, a.data(), b.data(), c.data());
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                float expected = 0.0f;
+                for (std::size_t p = 0; p < k; ++p) {
+                    expected += a[i * k + p] * b[p * n + j];
+                }
+                CHECK(c[i * n + j] == doctest::Approx(expected));
+            }
+        }
+    }
+}
+
+TEST_CASE("Every kernel variant computes batched dot products") {
+    const auto lhs = sample_vectors(37);
+    const auto rhs = sample_vectors(37);
+    for (auto isa : supported_isas()) {
+        std::vector<float> out(lhs.size());
+        dispatch::kernels_for(isa).dot3(lhs.size(), lhs.data()->data(), rhs.data()->data(), out.data());
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            CHECK(out[i] == doctest::Approx(dot(lhs[i], rhs[i])));
+        }
+    }
+}
+
+TEST_CASE("Every kernel variant normalizes vectors") {
+    for (auto isa : supported_isas()) {
+        auto vectors = sample_vectors(37);
+        dispatch::kernels_for(isa).normalize3(vectors.size(), vectors.data()->data());
+        for (const auto &vec : vectors) {
+            CHECK(vec.magnitude() == doctest::Approx(1.0));
+        }
+    }
+}
+
+TEST_CASE("Every kernel variant rotates vectors like the sandwich product") {
+    const auto axis = Vector3D(1.0f, 2.0f, 3.0f);
+    const auto rotation = Quaternion(axis.normalized(), 30_deg).unit_norm();
+    const float quat[4] = { rotation.imag.get_x(), rotation.imag.get_y(), rotation.imag.get_z(), rotation.real };
+    const auto vectors = sample_vectors(37);
+    for (auto isa : supported_isas()) {
+        std::vector<Vector3D> out(vectors.size());
+        dispatch::kernels_for(isa).rotate3(vectors.size(), quat, vectors.data()->data(), out.data()->data());
+        for (std::size_t i = 0; i < vectors.size(); ++i) {
+            const auto expected = Quaternion::rotate(vectors[i], 30_deg, axis);
+            CHECK(out[i].get_x() == doctest::Approx(expected.get_x()).epsilon(1e-4));
+            CHECK(out[i].get_y() == doctest::Approx(expected.get_y()).epsilon(1e-4));
+            CHECK(out[i].get_z() == doctest::Approx(expected.get_z()).epsilon(1e-4));
+        }
+    }
+}
+
+TEST_CASE("Batched wrappers work in place") {
+    auto vectors = sample_vectors(10);
+    const auto original = vectors;
+    const auto rotation = Quaternion(Vector3D::z_axis(), 90_deg).unit_norm();
+    batch::rotate(rotation, vectors, vectors);
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        CHECK(vectors[i].get_x() == doctest::Approx(-original[i].get_y()).epsilon(1e-4));
+        CHECK(vectors[i].get_y() == doctest::Approx(original[i].get_x()).epsilon(1e-4));
+        CHECK(vectors[i].get_z() == doctest::Approx(original[i].get_z()).epsilon(1e-4));
+    }
+
+    batch::normalize(vectors);
+    std::vector<float> out(vectors.size());
+    batch::dot(vectors, vectors, out);
+    for (auto value : out) {
+        CHECK(value == doctest::Approx(1.0f));
+    }
+}
+
+TEST_CASE("Batched wrappers accept empty spans") {
+    // An empty span may have a null data pointer, which must not be dereferenced.
+    const std::span<const Vector3D> none;
+    const std::span<Vector3D> none_out;
+    const auto rotation = Quaternion(Vector3D::z_axis(), 90_deg).unit_norm();
+    batch::rotate(rotation, none, none_out);
+    batch::normalize(none_out);
+    batch::dot(none, none, std::span<float> {});
+
+    std::vector<Vector3D> vectors;
+    batch::normalize(vectors);
+    CHECK(vectors.empty());
+}
+
+TEST_SUITE_END();
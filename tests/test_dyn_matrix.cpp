@@ -0,0 +1,131 @@
+#include <doctest/doctest.h>
+#include <dklib/math/dyn_matrix.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "test_utilities.hpp"
+
+using namespace dk::math;
+
+#define dyn_types int, float, double
+#define TEST_CASE_DYN(msg) TEST_CASE_TEMPLATE(msg, T, dyn_types)
+
+namespace {
+
+template <typename T>
+DynMatrix<T> sample_matrix(std::size_t rows, std::size_t cols, int seed) {
+    DynMatrix<T> mat(rows, cols);
+    fill_sample(mat, seed);
+    return mat;
+}
+
+template <typename T>
+DynMatrix<T> naive_multiply(const DynMatrix<T> &lhs, const DynMatrix<T> &rhs) {
+    const auto product = ::naive_multiply(lhs.rows(), rhs.cols(), lhs.cols(), lhs.data(), rhs.data());
+    DynMatrix<T> result(lhs.rows(), rhs.cols());
+    std::copy(product.begin(), product.end(), result.data());
+    return result;
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("DynMatrix");
+
+TEST_CASE_DYN("Construction and access") {
+    const DynMatrix<T> mat {
+        { 1, 2, 3 },
+        { 4, 5, 6 },
+    };
+    CHECK(mat.rows() == 2);
+    CHECK(mat.cols() == 3);
+    CHECK(mat[1, 2] == T { 6 });
+    CHECK(mat.row(1)[0] == T { 4 });
+    CHECK(reinterpret_cast<std::uintptr_t>(mat.data()) % cache_line_size == 0);
+    CHECK_THROWS_AS((void)mat.at(2, 0), std::runtime_error);
+    CHECK_THROWS_AS((DynMatrix<T> { { 1, 2 }, { 3 } }), std::runtime_error);
+
+    CHECK(mat.transpose() == DynMatrix<T> { { 1, 4 }, { 2, 5 }, { 3, 6 } });
+    CHECK(DynMatrix<T>::identity(2) == DynMatrix<T> { { 1, 0 }, { 0, 1 } });
+}
+
+TEST_CASE_DYN("Products match the fixed size matrices") {
+    // Both sides of the blocked GEMM threshold.
+    for (std::size_t n : { std::size_t { 5 }, std::size_t { 33 } }) {
+        const auto a = sample_matrix<T>(n, n + 3, 0);
+        const auto b = sample_matrix<T>(n + 3, n - 1, 4);
+        CHECK(a * b == naive_multiply(a, b));
+    }
+
+    auto fixed_a = std::make_unique<Matrix<T, 20, 24>>();
+    auto fixed_b = std::make_unique<Matrix<T, 24, 18>>();
+    const auto a = sample_matrix<T>(20, 24, 1);
+    const auto b = sample_matrix<T>(24, 18, 2);
+    std::copy_n(a.data(), a.size(), fixed_a->data());
+    std::copy_n(b.data(), b.size(), fixed_b->data());
+    CHECK(a * b == DynMatrix<T> { *fixed_a * *fixed_b });
+}
+
+TEST_CASE_DYN("Parallel product and reused results") {
+    const auto a = sample_matrix<T>(40, 50, 0);
+    const auto b = sample_matrix<T>(50, 30, 3);
+    const auto expected = naive_multiply(a, b);
+    CHECK(multiply(execution::par, a, b) == expected);
+
+    DynMatrix<T> result;
+    multiply_into(a, b, result);
+    const T *storage = result.data();
+    multiply_into(a, b, result);
+    CHECK(result.data() == storage);
+    CHECK(result == expected);
+    CHECK_THROWS_AS(multiply_into(a, a, result), std::runtime_error);
+}
+
+TEST_CASE_DYN("Matrix times vector") {
+    const auto mat = sample_matrix<T>(7, 5, 0);
+    DynVector<T> vec(5);
+    DynMatrix<T> column(5, 1);
+    for (std::size_t i = 0; i < 5; ++i) {
+        vec[i] = static_cast<T>(i + 1);
+        column[i] = vec[i];
+    }
+    const auto result = mat * vec;
+    const auto expected = mat * column;
+    REQUIRE(result.size() == 7);
+    for (std::size_t i = 0; i < 7; ++i) {
+        CHECK(result[i] == expected[i]);
+    }
+}
+
+TEST_CASE_DYN("Element-wise operators") {
+    auto a = sample_matrix<T>(6, 9, 0);
+    const auto b = sample_matrix<T>(6, 9, 5);
+    const auto sum = a + b;
+    const auto difference = a - b;
+    const auto scaled = a * 3;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        CHECK(sum[i] == a[i] + b[i]);
+        CHECK(difference[i] == a[i] - b[i]);
+        CHECK(scaled[i] == a[i] * 3);
+    }
+    CHECK_THROWS_AS(a += sample_matrix<T>(9, 6, 0), std::runtime_error);
+
+    auto halved = a;
+    halved /= T(2);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        CHECK(halved[i] == a[i] / T(2));
+    }
+    CHECK_THROWS_AS(halved /= 0, std::runtime_error);
+    CHECK_THROWS_AS((void)(sample_matrix<double>(2, 2, 0) / 0.0), std::runtime_error);
+
+    const T *storage = a.data();
+    const auto moved = std::move(a) + b;
+    CHECK(moved.data() == storage);
+    CHECK(a.rows() == 0);
+    CHECK(a.cols() == 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,108 @@
+#include <doctest/doctest.h>
+#include <dklib/math/dyn_vector.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+using namespace dk::math;
+
+#define dyn_types int, float, double
+#define TEST_CASE_DYN(msg) TEST_CASE_TEMPLATE(msg, T, dyn_types)
+
+namespace {
+
+template <typename T>
+DynVector<T> sample_vector(std::size_t size, int seed) {
+    DynVector<T> vec(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        vec[i] = static_cast<T>(static_cast<int>((i * 7 + seed) % 13) + 1);
+    }
+    return vec;
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("DynVector");
+
+TEST_CASE_DYN("Storage is aligned to a cache line") {
+    const DynVector<T> vec(37, T { 3 });
+    CHECK(vec.size() == 37);
+    CHECK(reinterpret_cast<std::uintptr_t>(vec.data()) % cache_line_size == 0);
+    for (const auto v : vec) {
+        CHECK(v == T { 3 });
+    }
+}
+
+TEST_CASE_DYN("Construction from a fixed size vector") {
+    const Vector<T, 5> fixed { { 1, 2, 3, 4, 5 } };
+    const DynVector<T> vec { fixed };
+    CHECK(vec == DynVector<T> { 1, 2, 3, 4, 5 });
+    CHECK(dot(vec, vec) == dot(fixed, fixed));
+    CHECK(magnitude_squared(vec) == magnitude_squared(fixed));
+}
+
+TEST_CASE_DYN("Element-wise operators match Vector") {
+    constexpr std::size_t size = 45;
+    const auto a = sample_vector<T>(size, 0);
+    const auto b = sample_vector<T>(size, 5);
+    Vector<T, size> fixed_a;
+    Vector<T, size> fixed_b;
+    for (std::size_t i = 0; i < size; ++i) {
+        fixed_a[i] = a[i];
+        fixed_b[i] = b[i];
+    }
+
+    const auto check = [](const DynVector<T> &actual, const Vector<T, size> &expected) {
+        REQUIRE(actual.size() == size);
+        for (std::size_t i = 0; i < size; ++i) {
+            CHECK(actual[i] == expected[i]);
+        }
+    };
+    check(a + b, Vector<T, size> { fixed_a + fixed_b });
+    check(a - b, Vector<T, size> { fixed_a - fixed_b });
+    check(a * b, Vector<T, size> { fixed_a * fixed_b });
+    check(a / b, Vector<T, size> { fixed_a / fixed_b });
+    check(a * 3, Vector<T, size> { fixed_a * 3 });
+    check(2 * a, Vector<T, size> { 2 * fixed_a });
+}
+
+TEST_CASE_DYN("Rvalue operands reuse their storage") {
+    auto a = sample_vector<T>(64, 0);
+    const auto b = sample_vector<T>(64, 3);
+    const auto expected = a + b;
+
+    const T *storage = a.data();
+    const auto sum = std::move(a) + b;
+    CHECK(sum.data() == storage);
+    CHECK(sum == expected);
+
+    auto c = sample_vector<T>(64, 0);
+    storage = c.data();
+    const auto swapped = b + std::move(c);
+    CHECK(swapped.data() == storage);
+    CHECK(swapped == expected);
+}
+
+TEST_CASE_DYN("Mismatching sizes and zero divisors throw") {
+    auto a = sample_vector<T>(4, 0);
+    const auto b = sample_vector<T>(5, 0);
+    CHECK_THROWS_AS(a += b, std::runtime_error);
+    CHECK_THROWS_AS((void)(a + b), std::runtime_error);
+    CHECK_THROWS_AS((void)a.dot(b), std::runtime_error);
+    CHECK_THROWS_AS(a /= DynVector<T>(4), std::runtime_error);
+    CHECK_THROWS_AS(a /= 0, std::runtime_error);
+    CHECK_THROWS_AS((void)a.at(4), std::runtime_error);
+}
+
+TEST_CASE("Normalization") {
+    DynVector<double> vec { 3, 0, 4 };
+    const auto unit = vec.normalized();
+    CHECK(unit[0] == doctest::Approx(0.6));
+    CHECK(unit[1] == 0.0);
+    CHECK(unit[2] == doctest::Approx(0.8));
+    vec.normalize();
+    CHECK(vec.magnitude() == doctest::Approx(1.0));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,79 @@
+#include <doctest/doctest.h>
+#include <dklib/math/gemm.hpp>
+#include <dklib/math/matrix.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "test_utilities.hpp"
+
+using namespace dk::math;
+
+#define gemm_types int, long, float, double
+#define TEST_CASE_GEMM(msg) TEST_CASE_TEMPLATE(msg, T, gemm_types)
+
+TEST_SUITE_BEGIN("GEMM");
+
+TEST_CASE_GEMM("Blocked product matches the triple loop") {
+    // Sizes that cover partial micro tiles and more than one block of each
+    // blocking level.
+    const std::size_t shapes[][3] = { { 1, 1, 1 }, { 5, 7, 3 }, { 17, 33, 9 }, { 131, 19, 300 }, { 9, 2100, 4 } };
+    for (const auto &[m, n, k] : shapes) {
+        const auto a = sample_values<T>(m * k, 1);
+        const auto b = sample_values<T>(k * n, 5);
+        std::vector<T> c(m * n, T { 42 });
+        gemm::multiply<T>(m, n, k, { a.data(), k, 1 }, { b.data(), n, 1 }, c.data(), n);
+        CHECK(c == naive_multiply(m, n, k, a.data(), b.data()));
+    }
+}
+
+TEST_CASE_GEMM("Blocked product accumulates into the result") {
+    const std::size_t m = 6, n = 20, k = 11;
+    const auto a = sample_values<T>(m * k, 2);
+    const auto b = sample_values<T>(k * n, 3);
+    std::vector<T> c(m * n, T { 1 });
+    gemm::multiply<T>(m, n, k, { a.data(), k, 1 }, { b.data(), n, 1 }, c.data(), n, true);
+    auto expected = naive_multiply(m, n, k, a.data(), b.data());
+    for (auto &value : expected) {
+        value += T { 1 };
+    }
+    CHECK(c == expected);
+}
+
+TEST_CASE_GEMM("Strides express transposed operands") {
+    const std::size_t m = 9, n = 18, k = 21;
+    const auto a = sample_values<T>(m * k, 4);
+    const auto b = sample_values<T>(k * n, 6);
+    std::vector<T> a_transposed(k * m);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t p = 0; p < k; ++p) {
+            a_transposed[p * m + i] = a[i * k + p];
+        }
+    }
+    std::vector<T> c(m * n);
+    gemm::multiply<T>(m, n, k, { a_transposed.data(), 1, m }, { b.data(), n, 1 }, c.data(), n);
+    CHECK(c == naive_multiply(m, n, k, a.data(), b.data()));
+}
+
+TEST_CASE("Empty inner dimension produces zero matrix") {
+    std::vector<float> c(6, 3.0f);
+    gemm::multiply<float>(2, 3, 0, { nullptr, 0, 1 }, { nullptr, 3, 1 }, c.data(), 3);
+    CHECK(c == std::vector<float>(6, 0.0f));
+}
+
+TEST_CASE_GEMM("Matrix product uses the blocked kernel for large sizes") {
+    using Lhs = Matrix<T, 40, 24>;
+    using Rhs = Matrix<T, 24, 33>;
+    auto lhs = std::make_unique<Lhs>();
+    auto rhs = std::make_unique<Rhs>();
+    const auto a = sample_values<T>(lhs->size(), 7);
+    const auto b = sample_values<T>(rhs->size(), 8);
+    std::copy(a.begin(), a.end(), lhs->data());
+    std::copy(b.begin(), b.end(), rhs->data());
+
+    const auto result = *lhs * *rhs;
+    const auto expected = naive_multiply<T>(40, 33, 24, a.data(), b.data());
+    CHECK(std::vector<T>(result.data(), result.data() + result.size()) == expected);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,67 @@
+#include <doctest/doctest.h>
+#include <dklib/math/rotation.hpp>
+
+#include <vector>
+
+using namespace dk::math;
+
+namespace {
+
+std::vector<Vector3D> sample_vectors(std::size_t count) {
+    std::vector<Vector3D> vectors;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<float>(i);
+        vectors.emplace_back(0.5f + v, 1.0f - 0.25f * v, 2.0f + 0.125f * v);
+    }
+    return vectors;
+}
+
+void check_approx(const Vector3D &actual, const Vector3D &expected) {
+    CHECK(actual.get_x() == doctest::Approx(expected.get_x()).epsilon(1e-4));
+    CHECK(actual.get_y() == doctest::Approx(expected.get_y()).epsilon(1e-4));
+    CHECK(actual.get_z() == doctest::Approx(expected.get_z()).epsilon(1e-4));
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Rotation");
+
+TEST_CASE("Rotation around the coordinate axes") {
+    const Rotation rotation { 90_deg, Vector3D::z_axis() };
+    check_approx(rotation(Vector3D::x_axis()), Vector3D::y_axis());
+    check_approx(rotation(Vector3D::y_axis()), -Vector3D::x_axis());
+    check_approx(rotation(Vector3D::z_axis()), Vector3D::z_axis());
+}
+
+TEST_CASE("Rotation matches the sandwich product") {
+    const auto axis = Vector3D(1.0f, -2.0f, 0.5f);
+    const auto unit = Quaternion(axis.normalized(), 40_deg).unit_norm();
+    const Rotation rotation { 40_deg, axis };
+    CHECK(rotation.quaternion() == unit);
+
+    for (const auto &vec : sample_vectors(17)) {
+        const auto sandwich = unit * Quaternion(vec, 0.0f) * unit.conjugate();
+        check_approx(rotation(vec), sandwich.imag);
+        check_approx(Quaternion::rotate(vec, 40_deg, axis), sandwich.imag);
+    }
+}
+
+TEST_CASE("Rotation of spans and lanes") {
+    const Rotation rotation { 75_deg, Vector3D(0.3f, 0.4f, -1.0f) };
+    const auto original = sample_vectors(45);
+
+    auto vectors = original;
+    rotation(vectors, vectors);
+
+    Vector3Stream stream { std::span<const Vector3D>(original) };
+    rotation(stream, stream);
+    REQUIRE(stream.size() == original.size());
+
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        const auto expected = rotation(original[i]);
+        check_approx(vectors[i], expected);
+        check_approx(stream[i], expected);
+    }
+}
+
+TEST_SUITE_END();
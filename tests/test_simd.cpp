@@ -0,0 +1,201 @@
+#include <doctest/doctest.h>
+#include <dklib/math/matrix4d.hpp>
+#include <dklib/math/vector4d.hpp>
+
+#include <array>
+#include <cstring>
+
+using namespace dk::math;
+
+#define simd_types float, double
+#define TEST_CASE_SIMD(msg) TEST_CASE_TEMPLATE(msg, T, simd_types)
+
+/// Compares object representations, so that the SIMD kernels are checked
+/// bit-for-bit (including signed zeros) against the scalar reference.
+template <typename T>
+bool bitwise_equal(const T *lhs, const T *rhs, std::size_t count) {
+    return std::memcmp(lhs, rhs, count * sizeof(T)) == 0;
+}
+
+template <typename T>
+std::array<T, 4> elementwise(std::array<T, 4> lhs, std::array<T, 4> rhs, char op) {
+    for (std::size_t i = 0; i < 4; ++i) {
+        switch (op) {
+        case '+': lhs[i] += rhs[i]; break;
+        case '-': lhs[i] -= rhs[i]; break;
+        case '*': lhs[i] *= rhs[i]; break;
+        case '/': lhs[i] /= rhs[i]; break;
+        }
+    }
+    return lhs;
+}
+
+TEST_SUITE_BEGIN("SIMD");
+
+TEST_CASE("Accelerated types are aligned to register width") {
+    if constexpr (simd::accelerated<float, 4>) {
+        CHECK(alignof(Vector4<float>) == 16);
+        CHECK(alignof(Matrix4<float>) == 16);
+    }
+    if constexpr (simd::accelerated<double, 4>) {
+        CHECK(alignof(Vector4<double>) == 32);
+        CHECK(alignof(Matrix4<double>) == 32);
+    }
+    CHECK(std::is_trivial_v<Vector4<float>>);
+    CHECK(std::is_standard_layout_v<Matrix4<float>>);
+}
+
+TEST_CASE_SIMD("Vector4 element-wise arithmetic matches scalar path") {
+    const std::array<T, 4> lhs = { T(1.1), T(-2.7), T(0.0), T(1e7) };
+    const std::array<T, 4> rhs = { T(3.3), T(0.3), T(-5.1), T(7e-3) };
+    for (char op : { '+', '-', '*', '/' }) {
+        auto vec = Vector4<T>(lhs);
+        switch (op) {
+        case '+': vec += Vector4<T>(rhs); break;
+        case '-': vec -= Vector4<T>(rhs); break;
+        case '*': vec *= Vector4<T>(rhs); break;
+        case '/': vec /= Vector4<T>(rhs); break;
+        }
+        const auto expected = elementwise(lhs, rhs, op);
+        CHECK(bitwise_equal(vec.data(), expected.data(), 4));
+    }
+}
+
+TEST_CASE_SIMD("Vector4 scalar arithmetic matches scalar path") {
+    const std::array<T, 4> values = { T(1.1), T(-2.7), T(0.0), T(1e7) };
+    const T factor = T(0.7);
+
+    auto scaled = Vector4<T>(values);
+    scaled *= factor;
+    auto divided = Vector4<T>(values);
+    divided /= factor;
+
+    auto expected_scaled = values;
+    auto expected_divided = values;
+    for (std::size_t i = 0; i < 4; ++i) {
+        expected_scaled[i] *= factor;
+        expected_divided[i] /= factor;
+    }
+    CHECK(bitwise_equal(scaled.data(), expected_scaled.data(), 4));
+    CHECK(bitwise_equal(divided.data(), expected_divided.data(), 4));
+}
+
+TEST_CASE_SIMD("Vector4 negation flips the sign of zero") {
+    auto vec = Vector4<T>(T(0), T(-1), T(2), T(-0.0));
+    -vec;
+    const std::array<T, 4> expected = { T(-0.0), T(1), T(-2), T(0) };
+    CHECK(bitwise_equal(vec.data(), expected.data(), 4));
+}
+
+TEST_CASE_SIMD("Vector4 division by zero still throws") {
+    auto vec = Vector4<T>(T(1));
+    CHECK_THROWS_AS(vec /= Vector4<T>(T(1), T(0), T(1), T(1)), std::runtime_error);
+}
+
+TEST_CASE_SIMD("Matrix4 product matches the scalar triple loop") {
+    Matrix4<T> lhs;
+    Matrix4<T> rhs;
+    for (std::size_t i = 0; i < 16; ++i) {
+        lhs[i] = T(0.25) * static_cast<T>(i) - T(1.5);
+        rhs[i] = T(1) / static_cast<T>(i + 3);
+    }
+    rhs[5] = T(-0.0);
+
+    std::array<T, 16> expected {};
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                expected[i * 4 + j] += lhs[i, k] * rhs[k, j];
+            }
+        }
+    }
+
+    SUBCASE("with compound assignment") {
+        auto result = lhs;
+        result *= rhs;
+        CHECK(bitwise_equal(result.data(), expected.data(), 16));
+    }
+    SUBCASE("with free operator") {
+        const auto result = lhs * rhs;
+        CHECK(bitwise_equal(result.data(), expected.data(), 16));
+    }
+}
+
+TEST_CASE_SIMD("Matrix4 addition matches scalar path") {
+    Matrix4<T> lhs;
+    Matrix4<T> rhs;
+    std::array<T, 16> expected;
+    for (std::size_t i = 0; i < 16; ++i) {
+        lhs[i] = T(0.1) * static_cast<T>(i);
+        rhs[i] = T(-0.3) * static_cast<T>(i) + T(1);
+        expected[i] = lhs[i] + rhs[i];
+    }
+    lhs += rhs;
+    CHECK(bitwise_equal(lhs.data(), expected.data(), 16));
+}
+
+TEST_CASE_SIMD("Matrix4 subtraction matches scalar path") {
+    Matrix4<T> lhs;
+    Matrix4<T> rhs;
+    std::array<T, 16> expected;
+    for (std::size_t i = 0; i < 16; ++i) {
+        lhs[i] = T(0.1) * static_cast<T>(i);
+        rhs[i] = T(-0.3) * static_cast<T>(i) + T(1);
+        expected[i] = lhs[i] - rhs[i];
+    }
+    lhs -= rhs;
+    CHECK(bitwise_equal(lhs.data(), expected.data(), 16));
+
+    constexpr auto difference = [] {
+        Matrix4<T> m = Matrix4<T>::identity();
+        m -= Matrix4<T>::identity();
+        return m;
+    }();
+    static_assert(difference[0, 0] == T(0));
+}
+
+TEST_CASE_SIMD("Matrix4 inverses match the portable kernels") {
+    Matrix4<T> mat {
+        { T(2), T(-1), T(0.5), T(3) },
+        { T(0.25), T(4), T(-2), T(-1) },
+        { T(1), T(0.75), T(3), T(0.5) },
+        { T(-0.5), T(1), T(0.25), T(2) },
+    };
+    std::array<T, 16> expected;
+
+    const T det = simd::mat4_inverse<T>(expected.data(), mat.data());
+    CHECK(bitwise_equal(mat.inverse().data(), expected.data(), 16));
+    CHECK(mat.determinant() == doctest::Approx(det));
+
+    for (std::size_t j = 0; j < 4; ++j) {
+        mat[3, j] = j == 3 ? T(1) : T(0);
+    }
+    simd::mat4_inverse_affine<T>(expected.data(), mat.data());
+    CHECK(bitwise_equal(mat.inverse_affine().data(), expected.data(), 16));
+
+    simd::mat4_inverse_rigid<T>(expected.data(), mat.data());
+    CHECK(bitwise_equal(mat.inverse_rigid().data(), expected.data(), 16));
+}
+
+TEST_CASE_SIMD("Affine Matrix4 product matches the full product") {
+    const Matrix4<T> lhs {
+        { T(2), T(-1), T(0.5), T(3) },
+        { T(0.25), T(4), T(-2), T(-1) },
+        { T(1), T(-0.75), T(3), T(0.5) },
+        { T(0), T(0), T(0), T(1) },
+    };
+    const Matrix4<T> rhs {
+        { T(-0), T(1.5), T(-2), T(0.125) },
+        { T(3), T(0.5), T(1), T(-4) },
+        { T(-1), T(2), T(0.25), T(6) },
+        { T(0), T(0), T(0), T(1) },
+    };
+    std::array<T, 16> expected;
+    std::array<T, 16> actual;
+
+    simd::mat4_mul<T>(expected.data(), lhs.data(), rhs.data());
+    simd::mat4_mul_affine(actual.data(), lhs.data(), rhs.data());
+    CHECK(bitwise_equal(actual.data(), expected.data(), 16));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,307 @@
+#include <doctest/doctest.h>
+#include <dklib/math/sparse_matrix.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace dk::math;
+
+#define sparse_types float, double
+#define TEST_CASE_SPARSE(msg) TEST_CASE_TEMPLATE(msg, T, sparse_types)
+
+namespace {
+
+template <typename T>
+constexpr double tolerance = std::is_same_v<T, float> ? 1e-5 : 1e-13;
+
+/// Rectangular matrix with a few empty rows and columns, every element
+/// added as two duplicate halves in a scrambled order.
+template <typename T>
+TripletBuilder<T> sample_builder(std::size_t rows, std::size_t cols) {
+    TripletBuilder<T> builder(rows, cols);
+    for (std::size_t k = 0; k < rows * cols; ++k) {
+        const std::size_t e = (k * 7919) % (rows * cols);
+        const std::size_t i = e / cols;
+        const std::size_t j = e % cols;
+        if (i % 5 == 3 or j % 7 == 2 or (i * 3 + j * 5) % 4 != 0) {
+            continue;
+        }
+        const T value = static_cast<T>(static_cast<int>((i * 13 + j * 7) % 17) - 8) / T(4);
+        builder.add(i, j, value / T(2));
+        builder.add(i, j, value / T(2));
+    }
+    return builder;
+}
+
+/// Graph Laplacian of a triangulated `side x side` grid, the shape of the
+/// matrices of mesh processing.
+template <typename T>
+CsrMatrix<T> grid_laplacian(std::size_t side) {
+    TripletBuilder<T> builder(side * side, side * side);
+    auto edge = [&](std::size_t a, std::size_t b) {
+        builder.add(a, b, T(-1));
+        builder.add(b, a, T(-1));
+        builder.add(a, a, T(1));
+        builder.add(b, b, T(1));
+    };
+    for (std::size_t i = 0; i < side; ++i) {
+        for (std::size_t j = 0; j < side; ++j) {
+            const std::size_t v = i * side + j;
+            if (j + 1 < side) {
+                edge(v, v + 1);
+            }
+            if (i + 1 < side) {
+                edge(v, v + side);
+            }
+            if (i + 1 < side and j + 1 < side) {
+                edge(v, v + side + 1);
+            }
+        }
+    }
+    return builder.to_csr();
+}
+
+template <typename T>
+DynVector<T> sample_vector(std::size_t size) {
+    DynVector<T> vec(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        vec[i] = static_cast<T>(std::sin(static_cast<double>(i) * 0.7));
+    }
+    return vec;
+}
+
+template <typename T>
+DynMatrix<T> sample_dense(std::size_t rows, std::size_t cols) {
+    DynMatrix<T> mat(rows, cols);
+    for (std::size_t i = 0; i < rows * cols; ++i) {
+        mat[i] = static_cast<T>(std::cos(static_cast<double>(i) * 0.3));
+    }
+    return mat;
+}
+
+template <typename T>
+void check_close(std::span<const T> result, std::span<const T> expected) {
+    REQUIRE(result.size() == expected.size());
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        CHECK(std::abs(result[i] - expected[i]) <= tolerance<T> * (1 + std::abs(expected[i])));
+    }
+}
+
+template <typename T>
+void check_close(const DynMatrix<T> &result, const DynMatrix<T> &expected) {
+    REQUIRE(result.rows() == expected.rows());
+    REQUIRE(result.cols() == expected.cols());
+    check_close<T>({ result.data(), result.size() }, { expected.data(), expected.size() });
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Sparse matrices");
+
+TEST_CASE_SPARSE("Triplets are compressed into sorted unique lines") {
+    TripletBuilder<T> builder(3, 4);
+    builder.add(2, 3, T(1));
+    builder.add(0, 2, T(2));
+    builder.add(2, 0, T(3));
+    builder.add(0, 2, T(4));
+    builder.add(0, 0, T(5));
+    CHECK(builder.size() == 5);
+    CHECK_THROWS_AS(builder.add(3, 0, T(1)), std::runtime_error);
+    CHECK_THROWS_AS(builder.add(0, 4, T(1)), std::runtime_error);
+
+    const auto csr = builder.to_csr();
+    CHECK(csr.rows() == 3);
+    CHECK(csr.cols() == 4);
+    CHECK(csr.nonzeros() == 4);
+    CHECK(std::vector<std::size_t>(csr.offsets().begin(), csr.offsets().end()) == std::vector<std::size_t> { 0, 2, 2, 4 });
+    CHECK(std::vector<std::uint32_t>(csr.indices().begin(), csr.indices().end()) == std::vector<std::uint32_t> { 0, 2, 0, 3 });
+    CHECK(std::vector<T>(csr.values().begin(), csr.values().end()) == std::vector<T> { 5, 6, 3, 1 });
+    CHECK(csr[0, 2] == T(6));
+    CHECK(csr[1, 1] == T(0));
+    CHECK(csr[2, 0] == T(3));
+    CHECK_THROWS_AS((void)csr.at(3, 0), std::runtime_error);
+
+    const auto csc = builder.to_csc();
+    CHECK(csc.outer_size() == 4);
+    CHECK(csc.inner_size() == 3);
+    CHECK(std::vector<std::size_t>(csc.offsets().begin(), csc.offsets().end()) == std::vector<std::size_t> { 0, 2, 2, 3, 4 });
+    CHECK(std::vector<std::uint32_t>(csc.indices().begin(), csc.indices().end()) == std::vector<std::uint32_t> { 0, 2, 0, 2 });
+    CHECK(csc[0, 2] == T(6));
+    CHECK(csc.to_dense() == csr.to_dense());
+
+    const CsrMatrix<T> empty(2, 5);
+    CHECK(empty.nonzeros() == 0);
+    CHECK(empty.offsets().size() == 3);
+    CHECK(empty[1, 4] == T(0));
+}
+
+TEST_CASE_SPARSE("Compressed arrays are validated") {
+    CHECK_NOTHROW(CsrMatrix<T>(2, 3, { 0, 1, 3 }, { 1, 0, 2 }, { 1, 2, 3 }));
+    // Offsets of the wrong size or not ending at the number of elements.
+    CHECK_THROWS_AS(CsrMatrix<T>(2, 3, { 0, 3 }, { 1, 0, 2 }, { 1, 2, 3 }), std::runtime_error);
+    CHECK_THROWS_AS(CsrMatrix<T>(2, 3, { 0, 1, 2 }, { 1, 0, 2 }, { 1, 2, 3 }), std::runtime_error);
+    CHECK_THROWS_AS(CsrMatrix<T>(2, 3, { 0, 1, 3 }, { 1, 0, 2 }, { 1, 2 }), std::runtime_error);
+    // Decreasing offsets, the first line would end past the indices.
+    CHECK_THROWS_AS(CsrMatrix<T>(2, 3, { 0, 5, 2 }, { 1, 2 }, { 1, 2 }), std::runtime_error);
+    // Indices out of bounds, unsorted or repeated.
+    CHECK_THROWS_AS(CsrMatrix<T>(2, 3, { 0, 1, 3 }, { 1, 0, 3 }, { 1, 2, 3 }), std::runtime_error);
+    CHECK_THROWS_AS(CsrMatrix<T>(2, 3, { 0, 1, 3 }, { 1, 2, 0 }, { 1, 2, 3 }), std::runtime_error);
+    CHECK_THROWS_AS(CscMatrix<T>(3, 2, { 0, 1, 3 }, { 1, 2, 2 }, { 1, 2, 3 }), std::runtime_error);
+}
+
+TEST_CASE_SPARSE("Conversions between layouts") {
+    const auto builder = sample_builder<T>(19, 13);
+    const auto csr = builder.to_csr();
+    const auto csc = builder.to_csc();
+    const auto dense = csr.to_dense();
+    CHECK(csc.to_dense() == dense);
+    CHECK(csr.to_csc().to_dense() == dense);
+    CHECK(csc.to_csr().to_dense() == dense);
+    CHECK(csr.to_csc().to_csr().to_dense() == dense);
+    CHECK(csr.to_csc().nonzeros() == csr.nonzeros());
+
+    const auto transpose = csr.transpose();
+    static_assert(std::is_same_v<std::remove_const_t<decltype(transpose)>, CscMatrix<T>>);
+    CHECK(transpose.rows() == 13);
+    CHECK(transpose.to_dense() == dense.transpose());
+    CHECK(CscMatrix<T>(csc).transpose().to_dense() == dense.transpose());
+}
+
+TEST_CASE_SPARSE("Sparse matrix-vector products") {
+    const auto builder = sample_builder<T>(29, 17);
+    const auto csr = builder.to_csr();
+    const auto csc = builder.to_csc();
+    const auto dense = csr.to_dense();
+    const auto x = sample_vector<T>(17);
+    const auto xt = sample_vector<T>(29);
+    const auto expected = dense * x;
+    const auto expected_t = transposed(dense) * xt;
+
+    check_close<T>(csr * x, expected);
+    check_close<T>(csc * x, expected);
+    check_close<T>(transposed(csr) * xt, expected_t);
+    check_close<T>(transposed(csc) * xt, expected_t);
+
+    ThreadPool pool { 4 };
+    const auto policy = execution::on(pool);
+    DynVector<T> y(29, T(7));
+    multiply_into(policy, csr, x, y);
+    check_close<T>(y, expected);
+    multiply_into(policy, csc, x, y);
+    check_close<T>(y, expected);
+    DynVector<T> yt(17, T(7));
+    multiply_into(policy, transposed(csr), xt, yt);
+    check_close<T>(yt, expected_t);
+    multiply_into(policy, transposed(csc), xt, yt);
+    check_close<T>(yt, expected_t);
+
+    CHECK_THROWS_AS(multiply_into(csr, xt, y), std::runtime_error);
+    CHECK_THROWS_AS(multiply_into(csr, x, yt), std::runtime_error);
+    auto square = sample_builder<T>(6, 6).to_csr();
+    DynVector<T> both(6);
+    CHECK_THROWS_AS(multiply_into(square, both, both), std::runtime_error);
+}
+
+TEST_CASE_SPARSE("Parallel products of a mesh Laplacian") {
+    // Enough rows for many blocks of `parallel_block_nonzeros` elements.
+    const std::size_t side = 160;
+    const auto laplacian = grid_laplacian<T>(side);
+    REQUIRE(laplacian.nonzeros() > 4 * sparse::parallel_block_nonzeros);
+    CHECK(laplacian[0, 0] == T(3));
+    CHECK(laplacian[side + 1, side + 1] == T(6));
+    CHECK(laplacian[side + 1, 0] == T(-1));
+    CHECK(laplacian[side + 1, 2] == T(0));
+
+    // The rows of a Laplacian add up to zero.
+    const DynVector<T> ones(side * side, T(1));
+    for (const T value : laplacian * ones) {
+        CHECK(value == T(0));
+    }
+
+    ThreadPool pool { 4 };
+    const auto x = sample_vector<T>(side * side);
+    const auto sequential = laplacian * x;
+    const auto parallel = multiply(execution::on(pool), laplacian, x);
+    // Every row is summed in the same order, whichever thread runs it.
+    CHECK(sequential == parallel);
+
+    // The Laplacian is symmetric.
+    const auto csc = laplacian.to_csc();
+    DynVector<T> transposed_product(side * side);
+    multiply_into(execution::on(pool), transposed(csc), x, transposed_product);
+    CHECK(transposed_product == sequential);
+    check_close<T>(transposed(laplacian) * x, sequential);
+
+    const auto positions = sample_dense<T>(side * side, 3);
+    const auto smoothed = multiply(execution::on(pool), laplacian, positions);
+    const auto smoothed_sequential = laplacian * positions;
+    CHECK(smoothed == smoothed_sequential);
+    for (std::size_t j = 0; j < 3; ++j) {
+        DynVector<T> column(side * side);
+        for (std::size_t i = 0; i < side * side; ++i) {
+            column[i] = positions[i, j];
+        }
+        const auto expected = laplacian * column;
+        for (std::size_t i = 0; i < side * side; i += 37) {
+            CHECK(std::abs(smoothed[i, j] - expected[i]) <= tolerance<T> * 8);
+        }
+    }
+}
+
+TEST_CASE_SPARSE("Sparse times dense matrix products") {
+    const auto builder = sample_builder<T>(23, 31);
+    const auto csr = builder.to_csr();
+    const auto csc = builder.to_csc();
+    const auto dense = csr.to_dense();
+
+    SUBCASE("Wide and narrow dense operands") {
+        for (const std::size_t n : { std::size_t { 1 }, std::size_t { 3 }, std::size_t { 70 } }) {
+            const auto b = sample_dense<T>(31, n);
+            const auto expected = dense * b;
+            check_close(csr * b, expected);
+            check_close(csc * b, expected);
+            ThreadPool pool { 3 };
+            check_close(multiply(execution::on(pool), csr, b), expected);
+            check_close(multiply(execution::on(pool), csc, b), expected);
+        }
+    }
+
+    SUBCASE("Strided views and fixed size matrices") {
+        const auto bt = sample_dense<T>(4, 31);
+        const auto expected = dense * bt.transpose();
+        DynMatrix<T> result(23, 4);
+        multiply_into(csr, view(bt).transpose(), view(result));
+        check_close(result, expected);
+        multiply_into(csc, view(bt).transpose(), view(result));
+        check_close(result, expected);
+
+        // Writing into the transpose of the result leaves it with a column
+        // stride that is not one.
+        DynMatrix<T> result_t(4, 23);
+        multiply_into(csr, view(bt).transpose(), view(result_t).transpose());
+        check_close(result_t, expected.transpose());
+
+        Matrix<T, 31, 2> fixed;
+        for (std::size_t i = 0; i < 31 * 2; ++i) {
+            fixed[i] = static_cast<T>(i % 5) - T(2);
+        }
+        Matrix<T, 23, 2> fixed_result;
+        multiply_into(csr, view(fixed), view(fixed_result));
+        const auto fixed_expected = dense * DynMatrix<T>(fixed);
+        check_close(DynMatrix<T>(fixed_result), fixed_expected);
+    }
+
+    SUBCASE("Mismatching operands") {
+        const auto b = sample_dense<T>(30, 2);
+        DynMatrix<T> result(23, 2);
+        CHECK_THROWS_AS(multiply_into(csr, view(b), view(result)), std::runtime_error);
+        auto square = sample_builder<T>(5, 5).to_csr();
+        DynMatrix<T> both(5, 5);
+        CHECK_THROWS_AS(multiply_into(square, view(both), view(both)), std::runtime_error);
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,96 @@
+#include <doctest/doctest.h>
+#include <dklib/math/gemm.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/strassen.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace dk::math;
+
+namespace {
+
+template <typename T>
+std::vector<T> sample_values(std::size_t count, unsigned seed) {
+    std::vector<T> values(count);
+    for (auto &value : values) {
+        seed = seed * 1103515245u + 12345u;
+        value = static_cast<T>((seed >> 16) % 2001) / T(1000) - T(1);
+    }
+    return values;
+}
+
+template <typename T>
+std::vector<T> classic_multiply(std::size_t n, const std::vector<T> &a, const std::vector<T> &b) {
+    std::vector<T> c(n * n);
+    gemm::multiply<T>(n, n, n, { a.data(), n, 1 }, { b.data(), n, 1 }, c.data(), n);
+    return c;
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Strassen");
+
+TEST_CASE("Scratch size covers every level of recursion") {
+    CHECK(strassen::scratch_size(64, 64) == 0);
+    CHECK(strassen::scratch_size(128, 64) == 2 * 64 * 64);
+    CHECK(strassen::scratch_size(256, 64) == 2 * 128 * 128 + 2 * 64 * 64);
+    CHECK(strassen::scratch_size(129, 64) == 2 * 64 * 64);
+}
+
+TEST_CASE("Integer products are exact") {
+    for (std::size_t n : { 16u, 17u, 32u, 37u }) {
+        std::vector<long> a(n * n);
+        std::vector<long> b(n * n);
+        for (std::size_t i = 0; i < n * n; ++i) {
+            a[i] = static_cast<long>(i % 11) - 5;
+            b[i] = static_cast<long>(i % 7) - 3;
+        }
+        std::vector<long> c(n * n);
+        strassen::multiply<long>(n, a.data(), b.data(), c.data(), 4);
+        CHECK(c == classic_multiply(n, a, b));
+    }
+}
+
+TEST_CASE("Floating point error against the classic algorithm stays small") {
+    for (std::size_t crossover : { 8u, 32u }) {
+        const std::size_t n = 128;
+        const auto a = sample_values<double>(n * n, 1);
+        const auto b = sample_values<double>(n * n, 2);
+        std::vector<double> c(n * n);
+        std::vector<double> scratch(strassen::scratch_size(n, crossover));
+        strassen::multiply<double>(n, a.data(), n, b.data(), n, c.data(), n, scratch, crossover);
+
+        const auto expected = classic_multiply(n, a, b);
+        double max_error = 0.0;
+        for (std::size_t i = 0; i < c.size(); ++i) {
+            max_error = std::max(max_error, std::fabs(c[i] - expected[i]));
+        }
+        MESSAGE("crossover ", crossover, ": max abs error ", max_error);
+        CHECK(max_error < 1e-11);
+    }
+}
+
+TEST_CASE("Matrix product of large double matrices goes through Strassen") {
+    constexpr std::size_t n = strassen::default_crossover + 2;
+    static_assert(strassen::use_strassen<double, n>);
+    using Mat = Matrix<double, n, n>;
+    auto lhs = std::make_unique<Mat>();
+    auto rhs = std::make_unique<Mat>();
+    const auto a = sample_values<double>(n * n, 3);
+    const auto b = sample_values<double>(n * n, 4);
+    std::copy(a.begin(), a.end(), lhs->data());
+    std::copy(b.begin(), b.end(), rhs->data());
+
+    auto result = std::make_unique<Mat>(*lhs * *rhs);
+    const auto expected = classic_multiply(n, a, b);
+    double max_error = 0.0;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        max_error = std::max(max_error, std::fabs((*result)[i] - expected[i]));
+    }
+    CHECK(max_error < 1e-10);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,155 @@
+#include <doctest/doctest.h>
+#include <dklib/math/decomposition.hpp>
+#include <dklib/math/matrix3d.hpp>
+#include <dklib/math/structured_matrix.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+using namespace dk::math;
+
+#define structured_types float, double
+#define TEST_CASE_STRUCTURED(msg) TEST_CASE_TEMPLATE(msg, T, structured_types)
+
+namespace {
+
+template <typename T>
+constexpr double tolerance = std::is_same_v<T, float> ? 1e-5 : 1e-12;
+
+template <typename T, std::size_t Rows, std::size_t Cols>
+Matrix<T, Rows, Cols> sample(T offset) {
+    Matrix<T, Rows, Cols> result;
+    for (std::size_t i = 0; i < Rows * Cols; ++i) {
+        result[i] = static_cast<T>(static_cast<int>((i * 5 + 3) % 7) - 3) / T(2) + offset;
+    }
+    return result;
+}
+
+template <typename T, std::size_t Rows, std::size_t Cols, typename M>
+bool dense_equal(const M &structured, const Matrix<T, Rows, Cols> &dense) {
+    for (std::size_t i = 0; i < Rows; ++i) {
+        for (std::size_t j = 0; j < Cols; ++j) {
+            if (std::abs(structured[i, j] - dense[i, j]) > tolerance<T> * (1 + std::abs(dense[i, j]))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Structured matrices");
+
+TEST_CASE_STRUCTURED("Identity") {
+    const IdentityMatrix<T, 3> identity;
+    const auto mat = sample<T, 3, 2>(T(0.25));
+    CHECK(identity * mat == mat);
+    CHECK(sample<T, 2, 3>(T(1)) * identity == sample<T, 2, 3>(T(1)));
+    CHECK(identity.determinant() == 1.0);
+    CHECK(identity.inverse() == identity);
+    CHECK(identity.to_dense() == Matrix3<T>::identity());
+
+    const Vector<T, 3> vec { { T(1), T(-2), T(3) } };
+    CHECK(identity * vec == vec);
+}
+
+TEST_CASE_STRUCTURED("Diagonal") {
+    const DiagonalMatrix<T, 4> diagonal { { T(2), T(-0.5), T(4), T(0.25) } };
+    const auto dense = diagonal.to_dense();
+    CHECK(dense == Matrix<T, 4, 4>(Matrix4<T>::diagonal({ T(2), T(-0.5), T(4), T(0.25) })));
+
+    const auto rhs = sample<T, 4, 3>(T(0.5));
+    CHECK(diagonal * rhs == dense * rhs);
+    const auto lhs = sample<T, 2, 4>(T(-1));
+    CHECK(lhs * diagonal == lhs * dense);
+
+    const auto squared = diagonal * diagonal;
+    CHECK(dense_equal(squared, dense * dense));
+    CHECK(diagonal.determinant() == doctest::Approx(-1.0));
+    CHECK(dense_equal(diagonal.inverse(), inverse(dense)));
+    CHECK(diagonal.inverse() * diagonal == DiagonalMatrix<T, 4>::identity());
+    CHECK(diagonal.transpose() == diagonal);
+
+    const Vector<T, 4> vec { { T(1), T(2), T(3), T(4) } };
+    const auto scaled = diagonal * vec;
+    CHECK(scaled[1] == T(-1));
+    CHECK(scaled[3] == T(1));
+
+    CHECK(DiagonalMatrix<T, 3>::scaling(T(3)).determinant() == doctest::Approx(27.0));
+    const DiagonalMatrix<T, 2> singular { { T(1), T(0) } };
+    CHECK_THROWS_AS((void)singular.inverse(), std::runtime_error);
+}
+
+TEST_CASE_STRUCTURED("Rotation") {
+    const auto rotation = RotationMatrix3<T>::about(Vector<T, 3> { { T(1), T(2), T(2) } }, Angle { 0.7 });
+    const auto &dense = rotation.to_dense();
+    CHECK(dense.determinant() == doctest::Approx(1.0).epsilon(tolerance<T>));
+    CHECK(dense_equal(rotation * rotation.inverse(), Matrix3<T>::identity()));
+    CHECK(dense_equal(rotation.inverse(), inverse(dense)));
+
+    // A quarter turn around z maps x onto y.
+    const auto quarter = RotationMatrix3<T>::about(Vector<T, 3> { { T(0), T(0), T(3) } }, Angle { std::numbers::pi / 2 });
+    const auto turned = quarter * Vector<T, 3> { { T(1), T(0), T(0) } };
+    CHECK(std::abs(turned[0]) < tolerance<T>);
+    CHECK(turned[1] == doctest::Approx(1.0));
+
+    const auto composed = rotation * quarter;
+    CHECK(dense_equal(composed, dense * quarter.to_dense()));
+    const auto rhs = sample<T, 3, 2>(T(0));
+    CHECK(rotation * rhs == dense * rhs);
+    CHECK(RotationMatrix3<T>() == RotationMatrix3<T>::identity());
+}
+
+TEST_CASE_STRUCTURED("Affine") {
+    const auto rotation = RotationMatrix3<T>::about(Vector<T, 3> { { T(-1), T(0.5), T(2) } }, Angle { 1.1 });
+    const Vector<T, 3> translation { { T(3), T(-2), T(0.5) } };
+    const AffineMatrix4<T> rigid(rotation, translation);
+    const AffineMatrix4<T> scale(DiagonalMatrix<T, 3>({ T(2), T(0.5), T(-1) }), translation);
+    const AffineMatrix4<T> sheared(sample<T, 3, 3>(T(0.1)), Vector<T, 3> { { T(1), T(1), T(-1) } });
+    const Matrix4<T> dense = sheared.to_dense();
+    CHECK(dense[3, 0] == T(0));
+    CHECK(dense[3, 3] == T(1));
+
+    const auto composed = rigid * sheared;
+    CHECK(dense_equal(composed, rigid.to_dense() * dense));
+    CHECK(dense_equal(scale * sample<T, 4, 2>(T(0.5)), scale.to_dense() * sample<T, 4, 2>(T(0.5))));
+    CHECK(dense_equal(sample<T, 2, 4>(T(0.5)) * sheared, sample<T, 2, 4>(T(0.5)) * dense));
+
+    CHECK(sheared.determinant() == doctest::Approx(dense.determinant()));
+    CHECK(dense_equal(sheared.inverse(), Matrix<T, 4, 4>(dense.inverse())));
+    CHECK(dense_equal(rigid * rigid.inverse(), Matrix4<T>::identity()));
+
+    const Vector<T, 3> point { { T(1), T(2), T(3) } };
+    const auto moved = scale.transform_point(point);
+    CHECK(moved[0] == doctest::Approx(5.0));
+    CHECK(moved[1] == doctest::Approx(-1.0));
+    CHECK(moved[2] == doctest::Approx(-2.5));
+    CHECK(scale.transform_direction(point)[0] == doctest::Approx(2.0));
+    const auto homogeneous = sheared * Vector4<T> { T(1), T(2), T(3), T(1) };
+    const auto expected = dense * Vector4<T> { T(1), T(2), T(3), T(1) };
+    for (std::size_t i = 0; i < 4; ++i) {
+        CHECK(homogeneous[i] == doctest::Approx(expected[i]));
+    }
+
+    CHECK(AffineMatrix4<T>::translate(translation).translation() == translation);
+    CHECK(AffineMatrix4<T>(dense).linear() == sheared.linear());
+
+    const AffineMatrix4<T> flat(DiagonalMatrix<T, 3>({ T(1), T(0), T(1) }), translation);
+    CHECK_THROWS_AS((void)flat.inverse(), std::runtime_error);
+}
+
+TEST_CASE("Structured matrices in constant expressions") {
+    static constexpr DiagonalMatrix<double, 3> diagonal { { 2.0, 4.0, 8.0 } };
+    static_assert(diagonal.determinant() == 64.0);
+    static_assert(diagonal.inverse().diagonal()[2] == 0.125);
+    static_assert((diagonal * diagonal).diagonal()[1] == 16.0);
+
+    static constexpr AffineMatrix4<double> shift = AffineMatrix4<double>::translate(Vector<double, 3> { { 1.0, 2.0, 3.0 } });
+    static_assert((shift * shift).translation()[2] == 6.0);
+    static_assert(shift.inverse().translation()[0] == -1.0);
+    static_assert(IdentityMatrix<int, 2> {}[1, 1] == 1);
+}
+
+TEST_SUITE_END();
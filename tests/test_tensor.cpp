@@ -161,4 +161,17 @@ TEST_CASE_TENSOR("Data access") {
     }
 }
 
+TEST_CASE_TENSOR("Reshape keeps the elements in order") {
+    TENSOR_TYPE(Tensor)
+    auto t = Tensor();
+    for (std::size_t i = 0; i < t.size(); ++i) {
+        t[i] = static_cast<typename Tensor::value_type>(i);
+    }
+    const auto reshaped = t.template reshape<3, 2>();
+    CHECK(reshaped.get_shape() == std::vector<std::size_t> { 3, 2 });
+    for (std::size_t i = 0; i < t.size(); ++i) {
+        CHECK(reshaped[i] == t[i]);
+    }
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,115 @@
+#include <doctest/doctest.h>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/vector.hpp>
+#include <dklib/math/vector3d.hpp>
+
+#include <stdexcept>
+#include <type_traits>
+
+using namespace dk::math;
+
+#define expression_types float, double, int
+#define TEST_CASE_EXPRESSION(msg) TEST_CASE_TEMPLATE(msg, T, expression_types)
+
+namespace {
+
+template <typename V>
+V sequence(typename V::value_type start) {
+    V result;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        result[i] = static_cast<typename V::value_type>(start + static_cast<typename V::value_type>(i % 13));
+    }
+    return result;
+}
+
+template <typename L, typename R>
+concept Addable = requires(const L &lhs, const R &rhs) { lhs + rhs; };
+
+} // namespace
+
+TEST_SUITE_BEGIN("TensorExpression");
+
+TEST_CASE("Small tensors stay eager") {
+    CHECK(std::is_same_v<decltype(Vector3D() + Vector3D()), Vector3D>);
+    CHECK(std::is_same_v<decltype(Vector<float, 16>() * 2.0f), Vector<float, 16>>);
+}
+
+TEST_CASE("Large tensors build expressions") {
+    using V = Vector<float, 64>;
+    CHECK(TensorExpressionType<decltype(V() + V())>);
+    CHECK(TensorExpressionType<decltype(V() + V() * 2.0f - V())>);
+    CHECK(std::is_same_v<typename decltype(V() + V() * 2.0f - V())::result_type, V>);
+}
+
+TEST_CASE("Mismatched shapes are rejected") {
+    CHECK(Addable<Vector<float, 64>, Vector<float, 64>>);
+    CHECK_FALSE(Addable<Vector<float, 64>, Vector<float, 65>>);
+    CHECK_FALSE(Addable<Vector<float, 64>, Vector<double, 64>>);
+    CHECK_FALSE(Addable<Matrix<float, 8, 4>, Matrix<float, 4, 8>>);
+    CHECK_FALSE(Addable<decltype(Vector<float, 64>() * 2.0f), Vector<float, 32>>);
+}
+
+TEST_CASE_EXPRESSION("Fused expression matches element-wise evaluation") {
+    using V = Vector<T, 100>;
+    const V a = sequence<V>(1);
+    const V b = sequence<V>(3);
+    const V c = sequence<V>(2);
+
+    const V result = a + b * 2.0f - c;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        CHECK(result[i] == static_cast<T>(a[i] + static_cast<T>(b[i] * 2.0f) - c[i]));
+    }
+}
+
+TEST_CASE_EXPRESSION("Element-wise product and quotient") {
+    using V = Vector<T, 40>;
+    const V a = sequence<V>(5);
+    const V b = sequence<V>(1);
+
+    V result = a * b;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        CHECK(result[i] == static_cast<T>(a[i] * b[i]));
+    }
+    result = a / b;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        CHECK(result[i] == static_cast<T>(a[i] / b[i]));
+    }
+}
+
+TEST_CASE("Assignment can alias the operands") {
+    using V = Vector<double, 64>;
+    V a = sequence<V>(1);
+    const V b = sequence<V>(2);
+    const V expected = a + b + a;
+
+    a = a + b + a;
+    CHECK(a == expected);
+}
+
+TEST_CASE("Division by zero") {
+    using V = Vector<double, 32>;
+    const V a = sequence<V>(1);
+    V b = sequence<V>(1);
+    b[17] = 0;
+
+    CHECK_THROWS_AS((void)(a / b), std::runtime_error);
+    CHECK_THROWS_AS((void)(a / 0.0), std::runtime_error);
+}
+
+TEST_CASE("Matrix sums are fused, products evaluate their operands") {
+    using M = Matrix<double, 8, 8>;
+    const M a { sequence<M>(1) };
+    const M b { sequence<M>(4) };
+
+    M sum = a + b * 0.5;
+    for (std::size_t i = 0; i < sum.size(); ++i) {
+        CHECK(sum[i] == a[i] + b[i] * 0.5);
+    }
+
+    const M product = (a + b) * a;
+    const M evaluated = a + b;
+    CHECK(product == evaluated * a);
+    CHECK(std::is_same_v<decltype(a * b), M>);
+}
+
+TEST_SUITE_END();
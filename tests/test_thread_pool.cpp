@@ -0,0 +1,89 @@
+#include <doctest/doctest.h>
+#include <dklib/math/execution.hpp>
+#include <dklib/math/thread_pool.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace dk::math;
+
+TEST_SUITE_BEGIN("ThreadPool");
+
+TEST_CASE("Every index is visited exactly once") {
+    ThreadPool pool { 4 };
+    for (std::size_t count : { 1u, 3u, 4u, 1000u, 12345u }) {
+        std::vector<std::atomic<int>> visits(count);
+        pool.parallel_for(count, [&](std::size_t i) { visits[i].fetch_add(1); });
+        std::size_t wrong = 0;
+        for (const auto &visit : visits) {
+            wrong += visit.load() != 1;
+        }
+        CHECK(wrong == 0);
+    }
+}
+
+TEST_CASE("Jobs can be submitted repeatedly") {
+    ThreadPool pool { 3 };
+    std::atomic<std::size_t> sum { 0 };
+    for (int job = 0; job < 200; ++job) {
+        pool.parallel_for(50, [&](std::size_t i) { sum.fetch_add(i); });
+    }
+    CHECK(sum.load() == 200 * (49 * 50 / 2));
+}
+
+TEST_CASE("Nested jobs run on the calling worker") {
+    ThreadPool pool { 4 };
+    std::atomic<int> count { 0 };
+    pool.parallel_for(8, [&](std::size_t) {
+        pool.parallel_for(8, [&](std::size_t) { count.fetch_add(1); });
+    });
+    CHECK(count.load() == 64);
+}
+
+TEST_CASE("Single threaded pool runs on the caller") {
+    ThreadPool pool { 1 };
+    CHECK(pool.size() == 1);
+    int count = 0;
+    pool.parallel_for(10, [&](std::size_t) { ++count; });
+    CHECK(count == 10);
+}
+
+TEST_CASE("Exceptions of the body reach the caller") {
+    ThreadPool pool { 4 };
+    std::atomic<int> calls { 0 };
+    const auto body = [&](std::size_t i) {
+        calls.fetch_add(1);
+        if (i == 500) {
+            throw std::runtime_error("index 500");
+        }
+    };
+    CHECK_THROWS_WITH_AS(pool.parallel_for(1000, body), "index 500", std::runtime_error);
+    CHECK(calls.load() <= 1000);
+
+    // The pool stays usable and does not rethrow the exception again.
+    std::atomic<int> count { 0 };
+    pool.parallel_for(100, [&](std::size_t) { count.fetch_add(1); });
+    CHECK(count.load() == 100);
+}
+
+TEST_CASE("Parallel matrix product matches the sequential one") {
+    using Lhs = Matrix<float, 150, 70>;
+    using Rhs = Matrix<float, 70, 600>;
+    auto lhs = std::make_unique<Lhs>();
+    auto rhs = std::make_unique<Rhs>();
+    for (std::size_t i = 0; i < lhs->size(); ++i) {
+        (*lhs)[i] = static_cast<float>(i % 13) * 0.25f - 1.0f;
+    }
+    for (std::size_t i = 0; i < rhs->size(); ++i) {
+        (*rhs)[i] = static_cast<float>(i % 7) - 3.0f;
+    }
+
+    ThreadPool pool { 4 };
+    const auto expected = std::make_unique<Matrix<float, 150, 600>>(multiply(execution::seq, *lhs, *rhs));
+    const auto parallel = std::make_unique<Matrix<float, 150, 600>>(multiply(execution::on(pool), *lhs, *rhs));
+    CHECK(*parallel == *expected);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,116 @@
+#include <doctest/doctest.h>
+#include <dklib/math/transform.hpp>
+
+#include <vector>
+
+using namespace dk::math;
+
+namespace {
+
+Matrix4<float> sample_matrix() {
+    return {
+        { 0.5f, -1.0f, 2.0f, 3.0f },
+        { 1.5f, 0.25f, -0.5f, -2.0f },
+        { -1.0f, 2.0f, 0.75f, 1.0f },
+        { 0.0f, 0.5f, 0.25f, 1.0f },
+    };
+}
+
+std::vector<Vector3D> sample_vectors(std::size_t count) {
+    std::vector<Vector3D> vectors;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<float>(i);
+        vectors.emplace_back(0.5f + v, 1.0f - 0.25f * v, 2.0f + 0.125f * v);
+    }
+    return vectors;
+}
+
+std::vector<dispatch::Isa> supported_isas() {
+    std::vector<dispatch::Isa> isas;
+    for (auto isa : { dispatch::Isa::scalar, dispatch::Isa::sse42, dispatch::Isa::avx2, dispatch::Isa::avx512 }) {
+        if (isa <= dispatch::detect_isa()) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+void check_approx(const Vector3D &actual, const Vector4D &expected) {
+    CHECK(actual.get_x() == doctest::Approx(expected.get_x()));
+    CHECK(actual.get_y() == doctest::Approx(expected.get_y()));
+    CHECK(actual.get_z() == doctest::Approx(expected.get_z()));
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Transform");
+
+TEST_CASE("Matrix4 times Vector4") {
+    const auto matrix = sample_matrix();
+    const auto result = matrix * Vector4D(1.0f, 2.0f, 3.0f, 1.0f);
+    CHECK(result == Vector4D(7.5f, -1.5f, 6.25f, 2.75f));
+    CHECK(Matrix4<float>::identity() * Vector4D(1.0f, 2.0f, 3.0f, 4.0f) == Vector4D(1.0f, 2.0f, 3.0f, 4.0f));
+}
+
+TEST_CASE("Every kernel variant transforms Vector4 in place") {
+    const auto matrix = sample_matrix();
+    for (auto isa : supported_isas()) {
+        std::vector<Vector4D> vectors;
+        for (const auto &v : sample_vectors(37)) {
+            vectors.emplace_back(v.get_x(), v.get_y(), v.get_z(), 0.5f);
+        }
+        const auto original = vectors;
+        const float *in = vectors.data()->data();
+        dispatch::kernels_for(isa).transform4(vectors.size(), matrix.data(), in, vectors.data()->data());
+        for (std::size_t i = 0; i < vectors.size(); ++i) {
+            const auto expected = matrix * original[i];
+            for (std::size_t c = 0; c < 4; ++c) {
+                CHECK(vectors[i][c] == doctest::Approx(expected[c]));
+            }
+        }
+    }
+}
+
+TEST_CASE("Every kernel variant transforms points and directions") {
+    const auto matrix = sample_matrix();
+    const auto vectors = sample_vectors(37);
+    for (auto isa : supported_isas()) {
+        for (float w : { 0.0f, 1.0f }) {
+            std::vector<Vector3D> out(vectors.size());
+            dispatch::kernels_for(isa).transform3(vectors.size(), matrix.data(), w, vectors.data()->data(), out.data()->data());
+            for (std::size_t i = 0; i < vectors.size(); ++i) {
+                check_approx(out[i], matrix * Vector4D(vectors[i].get_x(), vectors[i].get_y(), vectors[i].get_z(), w));
+            }
+        }
+    }
+}
+
+TEST_CASE("Batched wrappers") {
+    const auto matrix = sample_matrix();
+    auto vectors = sample_vectors(21);
+    const auto original = vectors;
+
+    const Vector3Stream stream { std::span<const Vector3D>(original) };
+    Vector3Stream points;
+    Vector3Stream directions;
+    batch::transform_points(matrix, stream, points);
+    batch::transform_directions(matrix, stream, directions);
+    REQUIRE(points.size() == original.size());
+    REQUIRE(directions.size() == original.size());
+
+    batch::transform_points(matrix, vectors, vectors);
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        const auto &v = original[i];
+        check_approx(vectors[i], matrix * Vector4D(v.get_x(), v.get_y(), v.get_z(), 1.0f));
+        check_approx(points[i], matrix * Vector4D(v.get_x(), v.get_y(), v.get_z(), 1.0f));
+        check_approx(directions[i], matrix * Vector4D(v.get_x(), v.get_y(), v.get_z(), 0.0f));
+    }
+
+    std::vector<Vector4D> homogeneous(3, Vector4D(1.0f, 2.0f, 3.0f, 1.0f));
+    batch::transform(matrix, homogeneous, homogeneous);
+    for (const auto &v : homogeneous) {
+        CHECK(v == Vector4D(7.5f, -1.5f, 6.25f, 2.75f));
+    }
+}
+
+TEST_SUITE_END();
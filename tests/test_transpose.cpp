@@ -0,0 +1,125 @@
+#include <doctest/doctest.h>
+#include <dklib/math/dyn_matrix.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/transpose.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace dk::math;
+
+#define transpose_types int, float, double
+#define TEST_CASE_TRANSPOSE(msg) TEST_CASE_TEMPLATE(msg, T, transpose_types)
+
+namespace {
+
+template <typename T>
+std::vector<T> sample(std::size_t size) {
+    std::vector<T> values(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        values[i] = static_cast<T>(i);
+    }
+    return values;
+}
+
+/// Runs `transpose_into` on a `rows x cols` block of a padded buffer, the
+/// padding of the destination must be left alone.
+template <typename T>
+bool transposes_into(std::size_t rows, std::size_t cols) {
+    const std::size_t lds = cols + 3;
+    const std::size_t ldd = rows + 5;
+    const auto src = sample<T>(rows * lds);
+    std::vector<T> dst(cols * ldd, T { -1 });
+    transposition::transpose_into(src.data(), rows, cols, lds, dst.data(), ldd);
+    for (std::size_t i = 0; i < cols; ++i) {
+        for (std::size_t j = 0; j < ldd; ++j) {
+            const T expected = j < rows ? src[j * lds + i] : T { -1 };
+            if (dst[i * ldd + j] != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool transposes_square(std::size_t n) {
+    const std::size_t ld = n + 2;
+    auto data = sample<T>(n * ld);
+    const auto original = data;
+    transposition::transpose_square(data.data(), n, ld);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < ld; ++j) {
+            const T expected = j < n ? original[j * ld + i] : original[i * ld + j];
+            if (data[i * ld + j] != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Transpose");
+
+TEST_CASE_TRANSPOSE("Out of place transpose of strided blocks") {
+    // Leaves only, partial tiles, and several levels of recursion.
+    for (std::size_t rows : { 1, 3, 8, 31, 32, 33, 100 }) {
+        for (std::size_t cols : { 1, 4, 9, 32, 47, 129 }) {
+            CHECK(transposes_into<T>(rows, cols));
+        }
+    }
+}
+
+TEST_CASE_TRANSPOSE("In place transpose of square blocks") {
+    for (std::size_t n : { 0, 1, 2, 7, 8, 16, 31, 33, 64, 95, 130 }) {
+        CHECK(transposes_square<T>(n));
+    }
+}
+
+TEST_CASE_TRANSPOSE("Fixed size matrices") {
+    auto square = std::make_unique<Matrix<T, 70, 70>>();
+    for (std::size_t i = 0; i < square->size(); ++i) {
+        (*square)[i] = static_cast<T>(i % 97);
+    }
+    const auto copy = square->transpose();
+    square->transpose_inplace();
+    CHECK(*square == copy);
+    CHECK((*square)[3, 5] == static_cast<T>((5 * 70 + 3) % 97));
+
+    auto wide = std::make_unique<Matrix<T, 40, 90>>();
+    for (std::size_t i = 0; i < wide->size(); ++i) {
+        (*wide)[i] = static_cast<T>(i % 89);
+    }
+    const auto tall = wide->transpose();
+    CHECK(tall[89, 39] == (*wide)[39, 89]);
+    CHECK(tall.transpose() == *wide);
+}
+
+TEST_CASE("Transpose in place in constant expressions") {
+    constexpr auto mat = [] {
+        Matrix<int, 2, 2> result { Matrix<int, 2, 2>::storage_type_2d { { { 1, 2 }, { 3, 4 } } } };
+        result.transpose_inplace();
+        return result;
+    }();
+    static_assert(mat[0, 1] == 3 and mat[1, 0] == 2);
+}
+
+TEST_CASE_TRANSPOSE("Dynamic matrices") {
+    DynMatrix<T> mat(45, 45);
+    for (std::size_t i = 0; i < mat.size(); ++i) {
+        mat[i] = static_cast<T>(i % 31);
+    }
+    const auto copy = mat.transpose();
+    mat.transpose_inplace();
+    CHECK(mat == copy);
+    CHECK(mat[1, 2] == static_cast<T>((2 * 45 + 1) % 31));
+
+    DynMatrix<T> wide(3, 50);
+    CHECK(wide.transpose().rows() == 50);
+    CHECK_THROWS_AS(wide.transpose_inplace(), std::runtime_error);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,115 @@
+#include <doctest/doctest.h>
+#include <dklib/math/dyn_matrix.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/matrix4d.hpp>
+
+#include <memory>
+
+#include "test_utilities.hpp"
+
+using namespace dk::math;
+
+#define transposed_types int, float, double
+#define TEST_CASE_TRANSPOSED(msg) TEST_CASE_TEMPLATE(msg, T, transposed_types)
+
+namespace {
+
+/// Checks the three transposed products of `M x K` and `K x N` operands
+/// against products of the explicitly transposed matrices.
+template <typename T, std::size_t M, std::size_t K, std::size_t N>
+void check_products() {
+    auto a = std::make_unique<Matrix<T, K, M>>();
+    auto b = std::make_unique<Matrix<T, K, N>>();
+    auto c = std::make_unique<Matrix<T, N, K>>();
+    auto d = std::make_unique<Matrix<T, M, K>>();
+    fill_sample(*a, 0);
+    fill_sample(*b, 3);
+    fill_sample(*c, 5);
+    fill_sample(*d, 1);
+
+    CHECK(transposed(*a) * *b == a->transpose() * *b);
+    CHECK(*d * transposed(*c) == *d * c->transpose());
+    CHECK(transposed(*a) * transposed(*c) == a->transpose() * c->transpose());
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Transposed");
+
+TEST_CASE_TRANSPOSED("Transposed products of small matrices") {
+    check_products<T, 3, 5, 4>();
+    check_products<T, 4, 4, 4>();
+}
+
+TEST_CASE_TRANSPOSED("Transposed products through the blocked GEMM") {
+    check_products<T, 20, 33, 17>();
+    check_products<T, 64, 64, 64>();
+}
+
+TEST_CASE_TRANSPOSED("Transposed matrix times vector") {
+    Matrix<T, 6, 4> mat;
+    fill_sample(mat, 2);
+    Vector<T, 6> vec;
+    for (std::size_t i = 0; i < 6; ++i) {
+        vec[i] = static_cast<T>(i) - T { 2 };
+    }
+    const auto result = transposed(mat) * vec;
+    const auto transpose = mat.transpose();
+    for (std::size_t r = 0; r < 4; ++r) {
+        T expected {};
+        for (std::size_t p = 0; p < 6; ++p) {
+            expected += transpose[r, p] * vec[p];
+        }
+        CHECK(result[r] == expected);
+    }
+}
+
+TEST_CASE("Transposed products in constant expressions") {
+    static constexpr Matrix<int, 2, 3> a { Matrix<int, 2, 3>::storage_type_2d { { { 1, 2, 3 }, { 4, 5, 6 } } } };
+    constexpr auto normal = transposed(a) * a;
+    static_assert(normal[0, 0] == 17 and normal[1, 2] == 36);
+    constexpr auto gram = a * transposed(a);
+    static_assert(gram[0, 1] == 32 and gram[1, 1] == 77);
+}
+
+TEST_CASE_TRANSPOSED("Matrix4 transpose") {
+    const Matrix4<T> mat {
+        { 1, 2, 3, 4 },
+        { 5, 6, 7, 8 },
+        { 9, 10, 11, 12 },
+        { 13, 14, 15, 16 },
+    };
+    const Matrix4<T> expected {
+        { 1, 5, 9, 13 },
+        { 2, 6, 10, 14 },
+        { 3, 7, 11, 15 },
+        { 4, 8, 12, 16 },
+    };
+    CHECK(mat.transpose() == expected);
+    CHECK(transposed(mat)[1, 3] == T { 14 });
+}
+
+TEST_CASE_TRANSPOSED("Transposed dynamic matrices") {
+    for (std::size_t n : { std::size_t { 5 }, std::size_t { 37 } }) {
+        DynMatrix<T> a(n + 2, n);
+        DynMatrix<T> b(n + 2, n - 1);
+        DynMatrix<T> c(n + 3, n);
+        DynMatrix<T> d(n + 1, n + 2);
+        fill_sample(a, 0);
+        fill_sample(b, 4);
+        fill_sample(c, 9);
+        fill_sample(d, 2);
+        CHECK(transposed(a) * b == a.transpose() * b);
+        CHECK(a * transposed(c) == a * c.transpose());
+        CHECK(transposed(a) * transposed(d) == a.transpose() * d.transpose());
+        CHECK_THROWS_AS((void)(transposed(a) * c), std::runtime_error);
+
+        DynVector<T> vec(n + 2);
+        for (std::size_t i = 0; i < vec.size(); ++i) {
+            vec[i] = static_cast<T>(i % 3);
+        }
+        CHECK(transposed(a) * vec == a.transpose() * vec);
+    }
+}
+
+TEST_SUITE_END();
@@ -2,6 +2,9 @@
 #define DK_MATH_TEST_UTILITIES_HPP
 
 #include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
 
 template <typename T, std::size_t S>
 struct TypeSizePair {
@@ -19,4 +22,45 @@ std::array<T, S> incremental_values() {
     return ret;
 }
 
+/// Tolerance of results computed in the floating point type `T`.
+template <typename T>
+constexpr double tolerance = std::is_same_v<T, float> ? 1e-4 : 1e-11;
+
+/// Sample element `index` for `seed`, a small integer that every arithmetic
+/// type represents exactly, so products can be compared exactly.
+template <typename T>
+T sample_value(std::size_t index, int seed) {
+    return static_cast<T>(static_cast<int>((index * 7 + seed) % 13) - 6);
+}
+
+/// Sets every element `i` of `values` to `sample_value(i, seed)`.
+template <typename C>
+void fill_sample(C &values, int seed) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = sample_value<typename C::value_type>(i, seed);
+    }
+}
+
+/// Returns `count` sample values for `seed`.
+template <typename T>
+std::vector<T> sample_values(std::size_t count, int seed) {
+    std::vector<T> values(count);
+    fill_sample(values, seed);
+    return values;
+}
+
+/// Row-major reference product of `a` of `m x k` and `b` of `k x n`.
+template <typename T>
+std::vector<T> naive_multiply(std::size_t m, std::size_t n, std::size_t k, const T *a, const T *b) {
+    std::vector<T> c(m * n, T {});
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            for (std::size_t p = 0; p < k; ++p) {
+                c[i * n + j] += a[i * k + p] * b[p * n + j];
+            }
+        }
+    }
+    return c;
+}
+
 #endif // DK_MATH_TEST_UTILITIES_HPP
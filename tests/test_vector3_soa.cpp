@@ -0,0 +1,127 @@
+#include <doctest/doctest.h>
+#include <dklib/math/vector3_soa.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace dk::math;
+
+#define soa_types float, double
+#define TEST_CASE_SOA(msg) TEST_CASE_TEMPLATE(msg, T, soa_types)
+
+namespace {
+
+template <typename T>
+std::vector<Vector3<T>> sample_vectors(std::size_t count) {
+    std::vector<Vector3<T>> vectors;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<T>(i);
+        vectors.emplace_back(T(0.5) + v, T(1) - T(0.25) * v, T(2) + T(0.125) * v);
+    }
+    return vectors;
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Vector3SoA");
+
+TEST_CASE_SOA("Lanes are aligned and padded") {
+    Vector3SoA<T> soa(13);
+    CHECK(soa.size() == 13);
+    CHECK(soa.padded_size() % Vector3SoA<T>::lane_width == 0);
+    CHECK(soa.padded_size() >= 13);
+    CHECK(reinterpret_cast<std::uintptr_t>(soa.x()) % cache_line_size == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(soa.y()) % cache_line_size == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(soa.z()) % cache_line_size == 0);
+    for (std::size_t i = 0; i < soa.padded_size(); ++i) {
+        CHECK(soa.x()[i] == 0);
+    }
+}
+
+TEST_CASE_SOA("Gather and scatter round trip") {
+    const auto vectors = sample_vectors<T>(37);
+    const Vector3SoA<T> soa { std::span<const Vector3<T>>(vectors) };
+    REQUIRE(soa.size() == vectors.size());
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        CHECK(soa[i] == vectors[i]);
+    }
+    CHECK(soa.to_vector() == vectors);
+}
+
+TEST_CASE_SOA("Resizing zeroes new vectors") {
+    Vector3SoA<T> soa;
+    soa.push_back({ 1, 2, 3 });
+    soa.push_back({ 4, 5, 6 });
+    soa.resize(1);
+    soa.resize(3);
+    CHECK(soa[0] == Vector3<T>(1, 2, 3));
+    CHECK(soa[1] == Vector3<T>(0, 0, 0));
+    CHECK(soa[2] == Vector3<T>(0, 0, 0));
+    CHECK_THROWS_AS((void)soa.at(3), std::runtime_error);
+}
+
+TEST_CASE_SOA("Kernels match Vector3") {
+    const auto lhs = sample_vectors<T>(45);
+    auto rhs = sample_vectors<T>(45);
+    std::reverse(rhs.begin(), rhs.end());
+    const Vector3SoA<T> a { std::span<const Vector3<T>>(lhs) };
+    const Vector3SoA<T> b { std::span<const Vector3<T>>(rhs) };
+
+    std::vector<T> values(lhs.size());
+    batch::dot(a, b, std::span<T>(values));
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        CHECK(values[i] == static_cast<T>(lhs[i].dot(rhs[i])));
+    }
+
+    batch::magnitude(a, std::span<T>(values));
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        CHECK(values[i] == static_cast<T>(lhs[i].magnitude()));
+    }
+
+    Vector3SoA<T> out;
+    batch::cross(a, b, out);
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        CHECK(out[i] == lhs[i].cross(rhs[i]));
+    }
+
+    batch::add(a, b, out);
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        CHECK(out[i] == lhs[i] + rhs[i]);
+    }
+
+    batch::scale(a, 2.5, out);
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        CHECK(out[i] == lhs[i] * 2.5);
+    }
+
+    out = a;
+    batch::normalize(out);
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        CHECK(out[i] == lhs[i].normalized());
+    }
+}
+
+TEST_CASE("Cross product does not produce negative zeros") {
+    Vector3Stream a;
+    Vector3Stream b;
+    a.push_back({ 1, 0, 0 });
+    b.push_back({ 1, 0, 0 });
+    batch::cross(a, b, a);
+    CHECK(not std::signbit(a[0].get_x()));
+    CHECK(not std::signbit(a[0].get_y()));
+    CHECK(not std::signbit(a[0].get_z()));
+}
+
+TEST_CASE("Integer vectors") {
+    Vector3SoA<int> a(3);
+    a.set(1, { 1, 2, 3 });
+    Vector3SoA<int> out;
+    batch::add(a, a, out);
+    batch::scale(out, 3, out);
+    CHECK(out[1] == Vector3<int>(6, 12, 18));
+    CHECK(out[2] == Vector3<int>(0, 0, 0));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,201 @@
+#include <doctest/doctest.h>
+#include <dklib/math/dyn_matrix.hpp>
+#include <dklib/math/matrix.hpp>
+#include <dklib/math/view.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace dk::math;
+
+#define view_types int, float, double
+#define TEST_CASE_VIEW(msg) TEST_CASE_TEMPLATE(msg, T, view_types)
+
+namespace {
+
+template <typename T>
+DynMatrix<T> sample_matrix(std::size_t rows, std::size_t cols, int seed) {
+    DynMatrix<T> mat(rows, cols);
+    for (std::size_t i = 0; i < mat.size(); ++i) {
+        mat[i] = static_cast<T>(static_cast<int>((i * 7 + seed) % 13) - 6);
+    }
+    return mat;
+}
+
+/// Copies a view into a matrix with the plain element access.
+template <typename T>
+DynMatrix<T> copy_of(MatrixView<const T> source) {
+    DynMatrix<T> result(source.rows(), source.cols());
+    for (std::size_t i = 0; i < source.rows(); ++i) {
+        for (std::size_t j = 0; j < source.cols(); ++j) {
+            result[i, j] = source[i, j];
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("View");
+
+TEST_CASE_VIEW("Views of fixed size types") {
+    Matrix<T, 3, 4> mat;
+    std::iota(mat.data(), mat.data() + mat.size(), T { 0 });
+    const auto mat_view = view(mat);
+    CHECK(mat_view.rows() == 3);
+    CHECK(mat_view.cols() == 4);
+    CHECK(mat_view.stride(0) == 4);
+    CHECK(mat_view.stride(1) == 1);
+    CHECK(mat_view.is_contiguous());
+    CHECK(mat_view[2, 1] == mat[2, 1]);
+
+    mat_view[1, 3] = T { 42 };
+    CHECK(mat[1, 3] == T { 42 });
+
+    const MatrixView<const T> read_only = mat_view;
+    CHECK(read_only.data() == mat.data());
+
+    const Vector<T, 5> vec { { 1, 2, 3, 4, 5 } };
+    const auto vec_view = view(vec);
+    CHECK(vec_view.size() == 5);
+    CHECK(vec_view[4] == T { 5 });
+
+    Tensor<T, 2, 3, 4> tensor;
+    std::iota(tensor.data(), tensor.data() + tensor.size(), T { 0 });
+    const auto tensor_view = view(tensor);
+    CHECK(tensor_view.rank() == 3);
+    CHECK(tensor_view[1, 2, 3] == T { 23 });
+    CHECK(tensor_view.slice(0, 1)[0, 2] == T { 14 });
+    CHECK(tensor_view.slice(2, 3)[1, 0] == T { 15 });
+}
+
+TEST_CASE_VIEW("Rows, columns, blocks and transposes alias the matrix") {
+    auto mat = sample_matrix<T>(6, 7, 0);
+    const auto mat_view = view(mat);
+
+    const auto row = mat_view.row(2);
+    const auto col = mat_view.col(5);
+    CHECK(row.size() == 7);
+    CHECK(col.size() == 6);
+    CHECK(col.stride(0) == 7);
+    for (std::size_t i = 0; i < 7; ++i) {
+        CHECK(&row[i] == &mat[2, i]);
+    }
+    for (std::size_t i = 0; i < 6; ++i) {
+        CHECK(&col[i] == &mat[i, 5]);
+    }
+
+    const auto block = mat_view.block(1, 2, 3, 4);
+    CHECK(block.rows() == 3);
+    CHECK(block.cols() == 4);
+    CHECK(not block.is_contiguous());
+    CHECK(&block[2, 3] == &mat[3, 5]);
+
+    const auto transposed = mat_view.transpose();
+    CHECK(transposed.rows() == 7);
+    CHECK(transposed.cols() == 6);
+    CHECK(&transposed[4, 1] == &mat[1, 4]);
+    CHECK(copy_of<T>(transposed) == mat.transpose());
+    CHECK(DynMatrix<T> { transposed } == mat.transpose());
+
+    CHECK_THROWS_AS((void)mat_view.block(4, 0, 3, 1), std::runtime_error);
+    CHECK_THROWS_AS((void)mat_view.row(6), std::runtime_error);
+    CHECK_THROWS_AS((void)mat_view.at(0, 7), std::runtime_error);
+}
+
+TEST_CASE_VIEW("Reshaping contiguous views") {
+    auto mat = sample_matrix<T>(4, 6, 1);
+    const auto flat = view(mat).reshape(24);
+    CHECK(flat.data() == mat.data());
+    CHECK(flat[13] == mat[2, 1]);
+
+    const auto cube = view(mat).reshape(2, 3, 4);
+    CHECK(cube[1, 0, 2] == mat[14]);
+
+    CHECK_THROWS_AS((void)view(mat).reshape(5, 5), std::runtime_error);
+    CHECK_THROWS_AS((void)view(mat).block(0, 0, 2, 3).reshape(6), std::runtime_error);
+    CHECK_NOTHROW((void)view(mat).block(1, 0, 2, 6).reshape(12));
+}
+
+TEST_CASE_VIEW("Element-wise operators on strided views") {
+    auto mat = sample_matrix<T>(8, 9, 0);
+    const auto other = sample_matrix<T>(9, 8, 5);
+    auto expected = mat;
+
+    // A block of `mat` combined with a transposed block of `other`.
+    const auto block = view(mat).block(1, 2, 5, 6);
+    const auto source = view(other).transpose().block(1, 2, 5, 6);
+    block += source;
+    block *= 3;
+    for (std::size_t i = 0; i < 5; ++i) {
+        for (std::size_t j = 0; j < 6; ++j) {
+            expected[i + 1, j + 2] = static_cast<T>((expected[i + 1, j + 2] + other[j + 2, i + 1]) * 3);
+        }
+    }
+    CHECK(mat == expected);
+
+    const auto column = view(mat).col(0);
+    column -= view(other).row(0);
+    for (std::size_t i = 0; i < 8; ++i) {
+        expected[i, 0] -= other[0, i];
+    }
+    CHECK(mat == expected);
+
+    CHECK_THROWS_AS(block += view(other).block(0, 0, 6, 5), std::runtime_error);
+}
+
+TEST_CASE_VIEW("Products of views use the strides") {
+    // Large enough for the blocked GEMM on the full matrices.
+    const auto a = sample_matrix<T>(40, 30, 0);
+    const auto b = sample_matrix<T>(40, 36, 3);
+
+    DynMatrix<T> result(30, 36);
+    multiply_into(view(a).transpose(), view(b), view(result));
+    CHECK(result == a.transpose() * b);
+
+    // Sub-blocks in place, the result being a block of a larger matrix.
+    auto target = sample_matrix<T>(50, 50, 1);
+    const auto expected_block = copy_of<T>(view(a).block(2, 3, 20, 17)) * copy_of<T>(view(b).block(5, 1, 17, 18));
+    multiply_into(view(a).block(2, 3, 20, 17), view(b).block(5, 1, 17, 18), view(target).block(10, 20, 20, 18));
+    CHECK(copy_of<T>(view(target).block(10, 20, 20, 18)) == expected_block);
+
+    // Small products and transposed results take the plain loop.
+    DynMatrix<T> small(4, 3);
+    multiply_into(view(a).block(0, 0, 4, 5), view(b).block(0, 0, 5, 3), view(small).reshape(3, 4).transpose());
+    CHECK(copy_of<T>(view(small).reshape(3, 4).transpose()) == copy_of<T>(view(a).block(0, 0, 4, 5)) * copy_of<T>(view(b).block(0, 0, 5, 3)));
+
+    CHECK_THROWS_AS(multiply_into(view(a), view(b), view(result)), std::runtime_error);
+
+    // Products in place would read elements they already overwrote.
+    auto square = sample_matrix<T>(8, 8, 2);
+    const auto unchanged = square;
+    CHECK_THROWS_AS(multiply_into(view(square), view(unchanged), view(square)), std::runtime_error);
+    CHECK_THROWS_AS(multiply_into(view(unchanged), view(square), view(square)), std::runtime_error);
+    CHECK_THROWS_AS(multiply_into(view(square), view(square).col(0), view(square).col(0)), std::runtime_error);
+    CHECK(square == unchanged);
+}
+
+TEST_CASE("External buffers") {
+    // A staging buffer holding a 3x4 matrix with rows padded to 8 floats.
+    std::vector<float> buffer(3 * 8, -1.0f);
+    const MatrixView<float> mat(buffer.data(), { 3, 4 }, { 8, 1 });
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            mat[i, j] = static_cast<float>(i * 4 + j);
+        }
+    }
+    mat *= 2.0f;
+    CHECK(buffer[8 + 1] == 10.0f);
+    CHECK(buffer[4] == -1.0f);
+
+    const std::vector<float> x { 1, 0, 0, 1 };
+    std::vector<float> y(3);
+    multiply_into(mat, VectorView<const float>(x.data(), 4), VectorView<float>(y.data(), 3));
+    CHECK(y == std::vector<float> { 6, 22, 38 });
+
+    const Vector<float, 4> weights { { 1, 2, 3, 4 } };
+    CHECK(dot(mat.row(1), view(weights)) == 8.0f + 20.0f + 36.0f + 56.0f);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,170 @@
+#include <doctest/doctest.h>
+#include <dklib/math/dyn_matrix.hpp>
+#include <dklib/math/workspace.hpp>
+
+#include <cstdint>
+#include <memory_resource>
+
+using namespace dk::math;
+
+#define workspace_types int, float, double
+#define TEST_CASE_WORKSPACE(msg) TEST_CASE_TEMPLATE(msg, T, workspace_types)
+
+namespace {
+
+/// Installs `resource` as the default memory resource for its lifetime.
+class DefaultResourceGuard {
+public:
+    explicit DefaultResourceGuard(std::pmr::memory_resource *resource)
+        : previous_ { std::pmr::set_default_resource(resource) } { }
+
+    DefaultResourceGuard(const DefaultResourceGuard &) = delete;
+    DefaultResourceGuard &operator=(const DefaultResourceGuard &) = delete;
+
+    ~DefaultResourceGuard() { std::pmr::set_default_resource(previous_); }
+
+private:
+    std::pmr::memory_resource *previous_;
+};
+
+template <typename T>
+DynMatrix<T> sample_matrix(std::size_t rows, std::size_t cols, int seed) {
+    DynMatrix<T> mat(rows, cols);
+    for (std::size_t i = 0; i < mat.size(); ++i) {
+        mat[i] = static_cast<T>(static_cast<int>((i * 5 + seed) % 11) - 5);
+    }
+    return mat;
+}
+
+bool is_aligned(const void *pointer) {
+    return reinterpret_cast<std::uintptr_t>(pointer) % cache_line_size == 0;
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("Workspace");
+
+TEST_CASE("Arena rewinds and merges its chunks on reset") {
+    CountingResource upstream;
+    Arena arena(0, &upstream);
+    CHECK(arena.capacity() == 0);
+
+    const auto mark = arena.mark();
+    void *first = arena.allocate(100, 64);
+    void *second = arena.allocate(8, 8);
+    CHECK(is_aligned(first));
+    CHECK(second != first);
+    CHECK(upstream.allocations() == 1);
+
+    arena.rewind(mark);
+    CHECK(arena.allocate(100, 64) == first);
+
+    // Outgrow the first chunk, the reset replaces both by a single one.
+    (void)arena.allocate(3 * Arena::min_chunk_size, 64);
+    CHECK(upstream.allocations() == 2);
+    const std::size_t capacity = arena.capacity();
+    arena.reset();
+    CHECK(upstream.allocations() == 3);
+    CHECK(upstream.deallocations() == 2);
+    CHECK(arena.capacity() == capacity);
+
+    (void)arena.allocate(100, 64);
+    (void)arena.allocate(3 * Arena::min_chunk_size, 64);
+    arena.reset();
+    CHECK(upstream.allocations() == 3);
+
+    arena.release();
+    CHECK(upstream.deallocations() == 3);
+    CHECK(arena.capacity() == 0);
+}
+
+TEST_CASE("Scopes give borrowed memory back") {
+    Workspace workspace;
+    const auto outer = workspace.borrow<float>(10);
+    CHECK(is_aligned(outer.data()));
+
+    double *inner_data = nullptr;
+    {
+        const auto scope = workspace.scope();
+        const auto inner = workspace.borrow<double>(33);
+        CHECK(inner.size() == 33);
+        CHECK(is_aligned(inner.data()));
+        inner_data = inner.data();
+    }
+    const auto again = workspace.borrow<double>(33);
+    CHECK(again.data() == inner_data);
+}
+
+TEST_CASE_WORKSPACE("Dynamic types allocate from the workspace") {
+    Workspace workspace;
+    DynMatrix<T> mat(8, 5, T { 2 }, workspace.resource());
+    DynVector<T> vec(7, T { 1 }, workspace.resource());
+    CHECK(mat.get_allocator().resource() == workspace.resource());
+    CHECK(vec.get_allocator().resource() == workspace.resource());
+    CHECK(is_aligned(mat.data()));
+    CHECK(is_aligned(vec.data()));
+
+    // Copies go back to the default resource, moves keep the workspace.
+    const DynMatrix<T> copy = mat;
+    CHECK(copy.get_allocator().resource() == std::pmr::get_default_resource());
+    CHECK(copy == mat);
+    const DynMatrix<T> moved = std::move(mat);
+    CHECK(moved.get_allocator().resource() == workspace.resource());
+
+    const DynMatrix<T> placed(copy, workspace.resource());
+    CHECK(placed.get_allocator().resource() == workspace.resource());
+    CHECK(placed == copy);
+}
+
+TEST_CASE_WORKSPACE("GEMM packs into the workspace") {
+    const auto a = sample_matrix<T>(37, 45, 0);
+    const auto b = sample_matrix<T>(45, 29, 3);
+    Workspace workspace;
+    const T *start = nullptr;
+    {
+        const auto scope = workspace.scope();
+        start = workspace.borrow<T>(1).data();
+    }
+
+    DynMatrix<T> result;
+    multiply_into(workspace, a, b, result);
+    CHECK(result == a * b);
+    CHECK(workspace.capacity() > 0);
+    // The packing buffers were given back when the product returned.
+    CHECK(workspace.borrow<T>(1).data() == start);
+}
+
+TEST_CASE_WORKSPACE("Steady state iterations do not allocate") {
+    CountingResource counter;
+    const DefaultResourceGuard guard(&counter);
+
+    const auto a = sample_matrix<T>(40, 40, 1);
+    const auto b = sample_matrix<T>(40, 40, 2);
+    Workspace workspace;
+    DynMatrix<T> result;
+    DynVector<T> x(40, T { 1 });
+
+    const auto iterate = [&] {
+        {
+            DynMatrix<T> product(workspace.resource());
+            multiply_into(workspace, a, b, product);
+            DynVector<T> residual(40, T {}, workspace.resource());
+            for (std::size_t i = 0; i < 40; ++i) {
+                residual[i] = product[i, i] - x[i];
+            }
+            x += residual;
+            multiply_into(workspace, product, a, result);
+        }
+        workspace.reset();
+    };
+
+    // The first iteration sizes the workspace and the result.
+    iterate();
+    const std::size_t allocations = counter.allocations();
+    for (int i = 0; i < 10; ++i) {
+        iterate();
+    }
+    CHECK(counter.allocations() == allocations);
+}
+
+TEST_SUITE_END();